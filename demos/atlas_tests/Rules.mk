@@ -13,6 +13,15 @@ include $(dir)/Rules.mk
 dir := $(d)/glyph_test
 include $(dir)/Rules.mk
 
+dir := $(d)/glyph_bake
+include $(dir)/Rules.mk
+
+dir := $(d)/glyph_atlas_packing
+include $(dir)/Rules.mk
+
+dir := $(d)/distance_field_bands
+include $(dir)/Rules.mk
+
 # Begin standard footer
 d		:= $(dirstack_$(sp))
 sp		:= $(basename $(sp))
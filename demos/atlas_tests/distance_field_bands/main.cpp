@@ -0,0 +1,408 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <fastuidraw/text/freetype_font.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+#include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+
+using namespace fastuidraw;
+
+namespace
+{
+  uint64_t
+  fnv1a(const uint8_t *bytes, unsigned int count, uint64_t hash)
+  {
+    for(unsigned int i = 0; i < count; ++i)
+      {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+      }
+    return hash;
+  }
+
+  /* checksum of the resolution and distance values of
+     a distance field, 0 indicates no distance field.
+   */
+  uint64_t
+  distance_field_checksum(const GlyphRenderDataDistanceField *data)
+  {
+    uint64_t hash(14695981039346656037ull);
+    const_c_array<uint8_t> values;
+    uint8_t res[8];
+
+    if(data == NULL)
+      {
+        return 0;
+      }
+
+    for(int c = 0; c < 2; ++c)
+      {
+        uint32_t v(data->resolution()[c]);
+        for(int b = 0; b < 4; ++b)
+          {
+            res[4 * c + b] = (v >> (8 * b)) & 0xFF;
+          }
+      }
+    hash = fnv1a(res, 8, hash);
+
+    values = data->distance_values();
+    if(!values.empty())
+      {
+        hash = fnv1a(values.c_ptr(), values.size(), hash);
+      }
+    return hash;
+  }
+
+  uint64_t
+  file_checksum(const std::string &filename)
+  {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    uint64_t hash(14695981039346656037ull);
+    char buffer[4096];
+
+    while(file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+      {
+        hash = fnv1a(reinterpret_cast<const uint8_t*>(buffer), file.gcount(), hash);
+      }
+    return hash;
+  }
+
+  /* checksums of the distance fields of the glyphs of
+     a font computed with a pixel size and max distance;
+     the file is text of the form:
+       font_checksum <checksum of the font file>
+       pixel_size <pixel size>
+       max_distance <max distance>
+       <glyph code> <checksum of the distance field>
+       ...
+     lines starting with '#' are ignored.
+   */
+  class golden_data
+  {
+  public:
+    golden_data(void):
+      m_font_checksum(0),
+      m_pixel_size(0),
+      m_max_distance(0.0f)
+    {}
+
+    bool
+    load(const std::string &filename)
+    {
+      std::ifstream file(filename.c_str());
+      std::string token;
+
+      if(!file)
+        {
+          return false;
+        }
+
+      while(file >> token)
+        {
+          if(token[0] == '#')
+            {
+              std::getline(file, token);
+            }
+          else if(token == "font_checksum")
+            {
+              file >> m_font_checksum;
+            }
+          else if(token == "pixel_size")
+            {
+              file >> m_pixel_size;
+            }
+          else if(token == "max_distance")
+            {
+              file >> m_max_distance;
+            }
+          else
+            {
+              uint32_t glyph_code(strtoul(token.c_str(), NULL, 10));
+              file >> m_checksums[glyph_code];
+            }
+        }
+      return true;
+    }
+
+    bool
+    save(const std::string &filename, const std::string &font) const
+    {
+      std::ofstream file(filename.c_str());
+      std::string::size_type dir(font.find_last_of("/\\"));
+
+      if(!file)
+        {
+          return false;
+        }
+
+      file << "# distance field checksums of the glyphs of "
+           << ((dir == std::string::npos) ? font : font.substr(dir + 1)) << "\n"
+           << "font_checksum " << m_font_checksum << "\n"
+           << "pixel_size " << m_pixel_size << "\n"
+           << "max_distance " << m_max_distance << "\n";
+      for(std::map<uint32_t, uint64_t>::const_iterator iter = m_checksums.begin(),
+            end = m_checksums.end(); iter != end; ++iter)
+        {
+          file << iter->first << " " << iter->second << "\n";
+        }
+      return true;
+    }
+
+    uint64_t m_font_checksum;
+    int m_pixel_size;
+    float m_max_distance;
+    std::map<uint32_t, uint64_t> m_checksums;
+  };
+}
+
+class distance_field_bands:public command_line_register
+{
+public:
+  distance_field_bands(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  reference_counted_ptr<const FontBase>
+  create_font(unsigned int max_threads);
+
+  GlyphRenderDataDistanceField*
+  compute_distance_field(const reference_counted_ptr<const FontBase> &font,
+                         uint32_t glyph_code, int64_t &time_us);
+
+  command_about m_about;
+  command_line_argument_value<std::string> m_font;
+  command_line_argument_value<int> m_font_index;
+  command_line_argument_value<int> m_pixel_size;
+  command_line_argument_value<float> m_max_distance;
+  command_line_argument_value<int> m_max_threads;
+  command_line_argument_value<int> m_max_glyphs;
+  command_line_argument_value<int> m_passes;
+  command_line_argument_value<std::string> m_golden_file;
+  command_line_argument_value<bool> m_write_golden;
+};
+
+distance_field_bands::
+distance_field_bands(void):
+  m_about("Checks that the distance field glyphs computed with the "
+          "rows and columns split into bands processed in parallel "
+          "(see FontFreeType::RenderParams::distance_field_max_threads()) "
+          "match byte for byte those computed serially, and reports "
+          "the time taken by each. If golden_file is given, also checks "
+          "the distance fields against the checksums of the file.", *this),
+  m_font("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", "font", "font file from which to take the glyphs", *this),
+  m_font_index(0, "font_index", "face index into font file to use if font file has multiple fonts", *this),
+  m_pixel_size(256, "pixel_size", "Pixel size at which to create distance field glyphs", *this),
+  m_max_distance(96.0f, "max_distance",
+                 "value to use for max distance in 64'ths of a pixel "
+                 "when generating distance field glyphs", *this),
+  m_max_threads(4, "max_threads", "value for distance_field_max_threads() of the banded computation", *this),
+  m_max_glyphs(100, "max_glyphs", "maximum number of glyphs of the font to check, a value of 0 indicates all", *this),
+  m_passes(1, "passes", "number of times to compute the distance field of each glyph", *this),
+  m_golden_file("", "golden_file",
+                "if non-empty, file of checksums of the distance fields of the glyphs of "
+                "a font at a pixel size and max distance against which to check the "
+                "distance fields; demo_data/distance_fields holds such files written "
+                "with the distance field generator that precedes the banded computation",
+                *this),
+  m_write_golden(false, "write_golden",
+                 "if true, write the checksums of the distance fields to golden_file "
+                 "instead of checking against it", *this)
+{}
+
+reference_counted_ptr<const FontBase>
+distance_field_bands::
+create_font(unsigned int max_threads)
+{
+  return FontFreeType::create(m_font.m_value.c_str(),
+                              FontFreeType::RenderParams()
+                              .distance_field_max_distance(m_max_distance.m_value)
+                              .distance_field_pixel_size(m_pixel_size.m_value)
+                              .distance_field_max_threads(max_threads),
+                              m_font_index.m_value);
+}
+
+GlyphRenderDataDistanceField*
+distance_field_bands::
+compute_distance_field(const reference_counted_ptr<const FontBase> &font,
+                       uint32_t glyph_code, int64_t &time_us)
+{
+  GlyphRenderData *data(NULL);
+  simple_time timer;
+
+  timer.restart_us();
+  for(int pass = 0; pass < std::max(1, m_passes.m_value); ++pass)
+    {
+      GlyphLayoutData layout;
+      Path path;
+
+      if(data)
+        {
+          FASTUIDRAWdelete(data);
+        }
+      data = font->compute_rendering_data(GlyphRender(distance_field_glyph),
+                                          glyph_code, layout, path);
+    }
+  time_us += timer.elapsed_us();
+
+  return dynamic_cast<GlyphRenderDataDistanceField*>(data);
+}
+
+int
+distance_field_bands::
+main(int argc, char **argv)
+{
+  reference_counted_ptr<const FontBase> serial_font, banded_font;
+  unsigned int num_glyphs, num_checked(0), num_mismatched(0);
+  unsigned int num_golden_checked(0), num_golden_mismatched(0);
+  int64_t serial_us(0), banded_us(0);
+  golden_data golden;
+  bool check_golden;
+
+  if(argc == 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  check_golden = !m_golden_file.m_value.empty() && !m_write_golden.m_value;
+  if(check_golden)
+    {
+      if(!golden.load(m_golden_file.m_value))
+        {
+          std::cerr << "Unable to read golden file \"" << m_golden_file.m_value << "\"\n";
+          return -1;
+        }
+
+      if(golden.m_font_checksum != file_checksum(m_font.m_value))
+        {
+          std::cerr << "Font \"" << m_font.m_value << "\" is not the font of golden file \""
+                    << m_golden_file.m_value << "\"\n";
+          return -1;
+        }
+
+      if(golden.m_pixel_size != m_pixel_size.m_value
+         || golden.m_max_distance != m_max_distance.m_value)
+        {
+          std::cerr << "Golden file \"" << m_golden_file.m_value << "\" is for pixel_size "
+                    << golden.m_pixel_size << " and max_distance " << golden.m_max_distance << "\n";
+          return -1;
+        }
+    }
+  golden.m_font_checksum = file_checksum(m_font.m_value);
+  golden.m_pixel_size = m_pixel_size.m_value;
+  golden.m_max_distance = m_max_distance.m_value;
+
+  serial_font = create_font(1);
+  banded_font = create_font(std::max(1, m_max_threads.m_value));
+  if(!serial_font || !banded_font)
+    {
+      std::cerr << "Unable to load font \"" << m_font.m_value << "\"\n";
+      return -1;
+    }
+
+  num_glyphs = static_cast<const FontFreeType*>(serial_font.get())->face()->num_glyphs;
+  if(m_max_glyphs.m_value > 0)
+    {
+      num_glyphs = std::min(num_glyphs, static_cast<unsigned int>(m_max_glyphs.m_value));
+    }
+
+  for(unsigned int g = 0; g < num_glyphs; ++g)
+    {
+      GlyphRenderDataDistanceField *serial, *banded;
+      bool same;
+
+      serial = compute_distance_field(serial_font, g, serial_us);
+      banded = compute_distance_field(banded_font, g, banded_us);
+      if(serial == NULL || banded == NULL)
+        {
+          same = (serial == banded);
+        }
+      else
+        {
+          const_c_array<uint8_t> serial_values(serial->distance_values());
+          const_c_array<uint8_t> banded_values(banded->distance_values());
+
+          same = serial->resolution() == banded->resolution()
+            && serial_values.size() == banded_values.size()
+            && (serial_values.empty()
+                || memcmp(serial_values.c_ptr(), banded_values.c_ptr(), serial_values.size()) == 0);
+        }
+
+      ++num_checked;
+      if(!same)
+        {
+          ++num_mismatched;
+          std::cout << "Glyph " << g << ": banded distance field differs from serial\n";
+        }
+
+      if(check_golden)
+        {
+          std::map<uint32_t, uint64_t>::const_iterator iter(golden.m_checksums.find(g));
+          if(iter != golden.m_checksums.end())
+            {
+              ++num_golden_checked;
+              if(iter->second != distance_field_checksum(serial))
+                {
+                  ++num_golden_mismatched;
+                  std::cout << "Glyph " << g << ": distance field differs from golden file\n";
+                }
+            }
+        }
+      else if(m_write_golden.m_value)
+        {
+          golden.m_checksums[g] = distance_field_checksum(serial);
+        }
+
+      if(serial)
+        {
+          FASTUIDRAWdelete(serial);
+        }
+      if(banded)
+        {
+          FASTUIDRAWdelete(banded);
+        }
+    }
+
+  std::cout << num_checked << " glyphs checked at pixel size " << m_pixel_size.m_value
+            << ", " << num_mismatched << " mismatched\n"
+            << "serial: " << serial_us / 1000 << " ms\n"
+            << "banded (max_threads = " << m_max_threads.m_value << "): "
+            << banded_us / 1000 << " ms\n";
+
+  if(check_golden)
+    {
+      std::cout << num_golden_checked << " glyphs checked against golden file, "
+                << num_golden_mismatched << " mismatched\n";
+    }
+  else if(m_write_golden.m_value)
+    {
+      if(m_golden_file.m_value.empty() || !golden.save(m_golden_file.m_value, m_font.m_value))
+        {
+          std::cerr << "Unable to write golden file \"" << m_golden_file.m_value << "\"\n";
+          return -1;
+        }
+      std::cout << "Wrote checksums of " << num_checked << " glyphs to \""
+                << m_golden_file.m_value << "\"\n";
+    }
+
+  return (num_mismatched == 0 && num_golden_mismatched == 0) ? 0 : -1;
+}
+
+int
+main(int argc, char **argv)
+{
+  distance_field_bands D;
+  return D.main(argc, argv);
+}
@@ -0,0 +1,489 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <fastuidraw/text/freetype_font.hpp>
+#include <fastuidraw/text/glyph_atlas.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+
+using namespace fastuidraw;
+
+/* texel store that only records the sizes of
+   the regions to which data is set.
+ */
+class SizeRecordingTexelStore:public GlyphAtlasTexelBackingStoreBase
+{
+public:
+  SizeRecordingTexelStore(ivec3 whl, bool presizable,
+                          std::vector<ivec2> *recorded_sizes = NULL):
+    GlyphAtlasTexelBackingStoreBase(whl, presizable),
+    m_recorded_sizes(recorded_sizes)
+  {}
+
+  virtual
+  void
+  set_data(int x, int y, int l, int w, int h,
+           const_c_array<uint8_t> data)
+  {
+    FASTUIDRAWunused(x);
+    FASTUIDRAWunused(y);
+    FASTUIDRAWunused(l);
+    FASTUIDRAWunused(data);
+    if(m_recorded_sizes)
+      {
+        m_recorded_sizes->push_back(ivec2(w, h));
+      }
+  }
+
+  virtual
+  void
+  flush(void)
+  {}
+
+protected:
+  virtual
+  void
+  resize_implement(int new_num_layers)
+  {
+    FASTUIDRAWunused(new_num_layers);
+  }
+
+private:
+  std::vector<ivec2> *m_recorded_sizes;
+};
+
+class NullGeometryStore:public GlyphAtlasGeometryBackingStoreBase
+{
+public:
+  NullGeometryStore(void):
+    GlyphAtlasGeometryBackingStoreBase(4, 1024, true)
+  {}
+
+  virtual
+  void
+  set_values(unsigned int location, const_c_array<generic_data> pdata)
+  {
+    FASTUIDRAWunused(location);
+    FASTUIDRAWunused(pdata);
+  }
+
+  virtual
+  void
+  flush(void)
+  {}
+
+protected:
+  virtual
+  void
+  resize_implement(unsigned int new_size)
+  {
+    FASTUIDRAWunused(new_size);
+  }
+};
+
+class packing_results
+{
+public:
+  packing_results(void):
+    m_first_fail_regions(0),
+    m_first_fail_occupancy(0.0f),
+    m_fill_regions(0),
+    m_fill_occupancy(0.0f),
+    m_fill_time_us(0),
+    m_fill_attempts(0),
+    m_churn_occupancy(0.0f),
+    m_churn_fragmentation(0.0f),
+    m_churn_time_us(0),
+    m_churn_operations(0)
+  {}
+
+  unsigned int m_first_fail_regions;
+  float m_first_fail_occupancy;
+  unsigned int m_fill_regions;
+  float m_fill_occupancy;
+  int64_t m_fill_time_us;
+  unsigned int m_fill_attempts;
+  float m_churn_occupancy;
+  float m_churn_fragmentation;
+  int64_t m_churn_time_us;
+  unsigned int m_churn_operations;
+};
+
+class glyph_atlas_packing:public command_line_register
+{
+public:
+  glyph_atlas_packing(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  enum return_code
+  compute_glyph_sizes(void);
+
+  void
+  record_glyph_sizes(const reference_counted_ptr<GlyphAtlas> &atlas,
+                     const reference_counted_ptr<const FontBase> &font,
+                     GlyphRender render);
+
+  packing_results
+  run_packer(enum GlyphAtlas::packer_t packer);
+
+  const ivec2&
+  random_glyph_size(void)
+  {
+    return m_glyph_sizes[rand() % m_glyph_sizes.size()];
+  }
+
+  command_about m_about;
+  command_line_argument_value<std::string> m_font;
+  command_line_argument_value<int> m_font_index;
+  command_line_argument_value<std::string> m_coverage_pixel_sizes;
+  command_line_argument_value<bool> m_use_distance_field;
+  command_line_argument_value<int> m_distance_pixel_size;
+  command_line_argument_value<float> m_max_distance;
+  command_line_argument_value<bool> m_use_curve_pair;
+  command_line_argument_value<int> m_curve_pair_pixel_size;
+  command_line_argument_value<int> m_max_glyphs;
+  command_line_argument_value<int> m_texel_store_width, m_texel_store_height;
+  command_line_argument_value<int> m_churn_rounds;
+  command_line_argument_value<float> m_churn_fraction;
+  enumerated_command_line_argument_value<enum GlyphAtlas::packer_t> m_packer;
+
+  std::vector<ivec2> m_glyph_sizes;
+};
+
+glyph_atlas_packing::
+glyph_atlas_packing(void):
+  m_about("Compares the packers of GlyphAtlas (see GlyphAtlas::packer_t) "
+          "on the sizes of the regions that the glyphs of a font take. "
+          "A single layer of the texel store is first filled with the "
+          "glyphs in a random order, then the churn of a long running "
+          "glyph cache is simulated by repeatedly freeing a random "
+          "fraction of the regions and allocating regions of random "
+          "glyphs until an allocation fails.", *this),
+  m_font("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", "font", "font file from which to take the glyphs", *this),
+  m_font_index(0, "font_index", "face index into font file to use if font file has multiple fonts", *this),
+  m_coverage_pixel_sizes("12 16 24 32", "coverage_pixel_sizes",
+                         "list of pixel sizes of coverage glyphs whose regions to use", *this),
+  m_use_distance_field(true, "use_distance_field", "if true use the regions of distance field glyphs", *this),
+  m_distance_pixel_size(48, "distance_pixel_size", "Pixel size at which to create distance field glyphs", *this),
+  m_max_distance(96.0f, "max_distance",
+                 "value to use for max distance in 64'ths of a pixel "
+                 "when generating distance field glyphs", *this),
+  m_use_curve_pair(true, "use_curvepair", "if true use the regions of curve pair glyphs", *this),
+  m_curve_pair_pixel_size(48, "curvepair_pixel_size", "Pixel size at which to create distance curve pair glyphs", *this),
+  m_max_glyphs(1000, "max_glyphs", "maximum number of glyphs of the font to use, a value of 0 indicates all", *this),
+  m_texel_store_width(1024, "texel_store_width", "width of texel store", *this),
+  m_texel_store_height(1024, "texel_store_height", "height of texel store", *this),
+  m_churn_rounds(200, "churn_rounds", "number of rounds of freeing and allocating regions", *this),
+  m_churn_fraction(0.25f, "churn_fraction", "fraction of the regions freed in each round", *this),
+  m_packer(GlyphAtlas::number_packers,
+           enumerated_string_type<enum GlyphAtlas::packer_t>()
+           .add_entry("tree", GlyphAtlas::tree_packer, "GlyphAtlas::tree_packer")
+           .add_entry("skyline", GlyphAtlas::skyline_packer, "GlyphAtlas::skyline_packer")
+           .add_entry("max_rects", GlyphAtlas::max_rects_packer, "GlyphAtlas::max_rects_packer")
+           .add_entry("all", GlyphAtlas::number_packers, "compare all packers"),
+           "packer", "packer to benchmark", *this)
+{}
+
+void
+glyph_atlas_packing::
+record_glyph_sizes(const reference_counted_ptr<GlyphAtlas> &atlas,
+                   const reference_counted_ptr<const FontBase> &font,
+                   GlyphRender render)
+{
+  unsigned int num_glyphs;
+
+  num_glyphs = static_cast<const FontFreeType*>(font.get())->face()->num_glyphs;
+  if(m_max_glyphs.m_value > 0)
+    {
+      num_glyphs = std::min(num_glyphs, static_cast<unsigned int>(m_max_glyphs.m_value));
+    }
+
+  for(unsigned int g = 0; g < num_glyphs; ++g)
+    {
+      GlyphLayoutData layout;
+      Path path;
+      GlyphRenderData *data;
+      GlyphLocation location, secondary_location;
+      int geometry_offset, geometry_length;
+
+      data = font->compute_rendering_data(render, g, layout, path);
+      if(data == NULL)
+        {
+          continue;
+        }
+
+      /* the texel store of atlas records the size of each
+         region the glyph takes, padding included.
+       */
+      if(data->upload_to_atlas(atlas, location, secondary_location,
+                               geometry_offset, geometry_length) == routine_success)
+        {
+          if(location.valid())
+            {
+              atlas->deallocate(location);
+            }
+          if(secondary_location.valid())
+            {
+              atlas->deallocate(secondary_location);
+            }
+          if(geometry_offset != -1)
+            {
+              atlas->deallocate_geometry_data(geometry_offset, geometry_length);
+            }
+        }
+      FASTUIDRAWdelete(data);
+    }
+}
+
+enum return_code
+glyph_atlas_packing::
+compute_glyph_sizes(void)
+{
+  reference_counted_ptr<const FontBase> font;
+  reference_counted_ptr<GlyphAtlas> atlas;
+  std::vector<ivec2> recorded_sizes;
+  std::istringstream pixel_sizes(m_coverage_pixel_sizes.m_value);
+  int pixel_size;
+
+  font = FontFreeType::create(m_font.m_value.c_str(),
+                              FontFreeType::RenderParams()
+                              .distance_field_max_distance(m_max_distance.m_value)
+                              .distance_field_pixel_size(m_distance_pixel_size.m_value)
+                              .curve_pair_pixel_size(m_curve_pair_pixel_size.m_value),
+                              m_font_index.m_value);
+  if(!font)
+    {
+      std::cerr << "Unable to load font \"" << m_font.m_value << "\"\n";
+      return routine_fail;
+    }
+
+  atlas = FASTUIDRAWnew GlyphAtlas(FASTUIDRAWnew SizeRecordingTexelStore(ivec3(4096, 4096, 1), true, &recorded_sizes),
+                                   FASTUIDRAWnew NullGeometryStore());
+
+  while(pixel_sizes >> pixel_size)
+    {
+      if(pixel_size > 0)
+        {
+          record_glyph_sizes(atlas, font, GlyphRender(pixel_size));
+        }
+    }
+
+  if(m_use_distance_field.m_value)
+    {
+      record_glyph_sizes(atlas, font, GlyphRender(distance_field_glyph));
+    }
+
+  if(m_use_curve_pair.m_value)
+    {
+      record_glyph_sizes(atlas, font, GlyphRender(curve_pair_glyph));
+    }
+
+  /* regions of no area (e.g. the glyph of a space)
+     take no room of the atlas.
+   */
+  for(unsigned int i = 0, endi = recorded_sizes.size(); i < endi; ++i)
+    {
+      if(recorded_sizes[i].x() > 0 && recorded_sizes[i].y() > 0
+         && recorded_sizes[i].x() <= m_texel_store_width.m_value
+         && recorded_sizes[i].y() <= m_texel_store_height.m_value)
+        {
+          m_glyph_sizes.push_back(recorded_sizes[i]);
+        }
+    }
+
+  return m_glyph_sizes.empty() ? routine_fail : routine_success;
+}
+
+packing_results
+glyph_atlas_packing::
+run_packer(enum GlyphAtlas::packer_t packer)
+{
+  packing_results R;
+  reference_counted_ptr<GlyphAtlas> atlas;
+  std::vector<GlyphLocation> live;
+  std::vector<ivec2> order(m_glyph_sizes);
+  GlyphAtlas::Padding padding;
+  simple_time timer;
+  float occupancy_sum(0.0f), fragmentation_sum(0.0f);
+
+  /* each packer sees the same sequence of glyph sizes */
+  srand(0);
+  atlas = FASTUIDRAWnew GlyphAtlas(FASTUIDRAWnew SizeRecordingTexelStore(ivec3(m_texel_store_width.m_value,
+                                                                               m_texel_store_height.m_value,
+                                                                               1), false),
+                                   FASTUIDRAWnew NullGeometryStore(), packer);
+
+  for(unsigned int i = order.size(); i > 1; --i)
+    {
+      std::swap(order[i - 1], order[rand() % i]);
+    }
+
+  /* fill: place the glyphs in a random order */
+  timer.restart_us();
+  for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+    {
+      GlyphLocation G;
+
+      G = atlas->allocate(order[i], padding);
+      if(G.valid())
+        {
+          live.push_back(G);
+        }
+      else if(R.m_first_fail_regions == 0)
+        {
+          R.m_first_fail_regions = live.size();
+          R.m_first_fail_occupancy = atlas->packing_statistics().occupancy();
+        }
+    }
+  R.m_fill_time_us = timer.elapsed_us();
+  R.m_fill_attempts = order.size();
+  R.m_fill_regions = live.size();
+  R.m_fill_occupancy = atlas->packing_statistics().occupancy();
+  if(R.m_first_fail_regions == 0)
+    {
+      R.m_first_fail_regions = live.size();
+      R.m_first_fail_occupancy = R.m_fill_occupancy;
+    }
+
+  /* churn: free a random fraction of the regions and
+     allocate random glyphs until an allocation fails.
+   */
+  R.m_churn_time_us = 0;
+  for(int round = 0; round < m_churn_rounds.m_value; ++round)
+    {
+      unsigned int num_free;
+      GlyphAtlas::PackingStatistics stats;
+
+      num_free = static_cast<unsigned int>(m_churn_fraction.m_value * static_cast<float>(live.size()));
+      timer.restart_us();
+      for(unsigned int i = 0; i < num_free && !live.empty(); ++i)
+        {
+          unsigned int k(rand() % live.size());
+
+          atlas->deallocate(live[k]);
+          live[k] = live.back();
+          live.pop_back();
+          ++R.m_churn_operations;
+        }
+
+      for(bool room = true; room;)
+        {
+          GlyphLocation G;
+
+          G = atlas->allocate(random_glyph_size(), padding);
+          ++R.m_churn_operations;
+          room = G.valid();
+          if(room)
+            {
+              live.push_back(G);
+            }
+        }
+      R.m_churn_time_us += timer.elapsed_us();
+
+      stats = atlas->packing_statistics();
+      occupancy_sum += stats.occupancy();
+      fragmentation_sum += stats.fragmentation();
+    }
+
+  if(m_churn_rounds.m_value > 0)
+    {
+      R.m_churn_occupancy = occupancy_sum / static_cast<float>(m_churn_rounds.m_value);
+      R.m_churn_fragmentation = fragmentation_sum / static_cast<float>(m_churn_rounds.m_value);
+    }
+
+  return R;
+}
+
+int
+glyph_atlas_packing::
+main(int argc, char **argv)
+{
+  const char *packer_labels[GlyphAtlas::number_packers] =
+    {
+      "tree",
+      "skyline",
+      "max_rects",
+    };
+
+  if(argc == 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  if(compute_glyph_sizes() == routine_fail)
+    {
+      std::cerr << "No glyph regions to pack\n";
+      return -1;
+    }
+
+  uint64_t total_area(0);
+  for(unsigned int i = 0, endi = m_glyph_sizes.size(); i < endi; ++i)
+    {
+      total_area += m_glyph_sizes[i].x() * m_glyph_sizes[i].y();
+    }
+
+  std::cout << m_glyph_sizes.size() << " glyph regions of average area "
+            << static_cast<float>(total_area) / static_cast<float>(m_glyph_sizes.size())
+            << " packed into a layer of " << m_texel_store_width.m_value
+            << "x" << m_texel_store_height.m_value << "\n\n"
+            << std::setw(10) << "packer"
+            << std::setw(14) << "first fail"
+            << std::setw(14) << "fill rate"
+            << std::setw(14) << "us/alloc"
+            << std::setw(16) << "churn occupancy"
+            << std::setw(16) << "churn fragment"
+            << std::setw(14) << "us/op"
+            << "\n";
+
+  for(int p = 0; p < GlyphAtlas::number_packers; ++p)
+    {
+      enum GlyphAtlas::packer_t packer;
+      packing_results R;
+
+      packer = static_cast<enum GlyphAtlas::packer_t>(p);
+      if(m_packer.m_value.m_value != GlyphAtlas::number_packers
+         && m_packer.m_value.m_value != packer)
+        {
+          continue;
+        }
+
+      R = run_packer(packer);
+      std::cout << std::setw(10) << packer_labels[p]
+                << std::setw(14) << R.m_first_fail_occupancy
+                << std::setw(14) << R.m_fill_occupancy
+                << std::setw(14) << static_cast<float>(R.m_fill_time_us) / static_cast<float>(std::max(1u, R.m_fill_attempts))
+                << std::setw(16) << R.m_churn_occupancy
+                << std::setw(16) << R.m_churn_fragmentation
+                << std::setw(14) << static_cast<float>(R.m_churn_time_us) / static_cast<float>(std::max(1u, R.m_churn_operations))
+                << "\n";
+    }
+
+  std::cout << "\nfirst fail: occupancy when an allocation first fails"
+            << "\nfill rate: occupancy after trying to place every glyph"
+            << "\nchurn occupancy/fragment: average of GlyphAtlas::PackingStatistics when"
+            << "\n\tan allocation fails in each churn round"
+            << "\nus/op: time per allocation or deallocation while churning\n";
+
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  glyph_atlas_packing G;
+  return G.main(argc, argv);
+}
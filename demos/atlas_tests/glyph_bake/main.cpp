@@ -0,0 +1,373 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <set>
+#include <fastuidraw/text/freetype_font.hpp>
+#include <fastuidraw/text/baked_glyph_atlas.hpp>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "ostream_utility.hpp"
+
+using namespace fastuidraw;
+
+/* a string command line argument that can be given several
+   times, each value given is appended to m_values.
+ */
+class string_list_argument:public command_line_argument_value<std::string>
+{
+public:
+  string_list_argument(const std::string &nm, const std::string &desc,
+                       command_line_register &p):
+    command_line_argument_value<std::string>("", nm, desc, p)
+  {}
+
+  virtual
+  void
+  on_set_by_command_line(void)
+  {
+    m_values.push_back(m_value);
+  }
+
+  std::vector<std::string> m_values;
+};
+
+class glyph_bake:public command_line_register
+{
+public:
+  glyph_bake(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  enum return_code
+  create_fonts(void);
+
+  void
+  compute_character_codes(void);
+
+  void
+  bake_glyphs(GlyphRender render);
+
+  command_about m_about;
+  string_list_argument m_fonts;
+  command_line_argument_value<int> m_font_index;
+  command_line_argument_value<int> m_coverage_pixel_size;
+  command_line_argument_value<int> m_distance_pixel_size;
+  command_line_argument_value<float> m_max_distance;
+  command_line_argument_value<int> m_curve_pair_pixel_size;
+  command_line_argument_value<bool> m_bake_distance_field;
+  command_line_argument_value<bool> m_bake_curve_pair;
+  command_line_argument_value<std::string> m_text;
+  command_line_argument_value<bool> m_use_file;
+  command_line_argument_value<bool> m_bake_glyph_set;
+  command_line_argument_value<int> m_texel_store_width, m_texel_store_height;
+  command_line_argument_value<int> m_geometry_store_alignment;
+  enumerated_command_line_argument_value<enum GlyphAtlas::packer_t> m_packer;
+  command_line_argument_value<std::string> m_output;
+
+  std::vector<reference_counted_ptr<const FontFreeType> > m_font_objects;
+  std::vector<uint32_t> m_character_codes;
+  reference_counted_ptr<BakedGlyphAtlas> m_baked;
+  unsigned int m_number_failed;
+};
+
+/* decode UTF-8, invalid bytes are taken as Latin-1 characters
+ */
+void
+decode_utf8(const std::string &str, std::vector<uint32_t> &out_character_codes)
+{
+  for(std::string::size_type i = 0, endi = str.size(); i < endi;)
+    {
+      uint8_t b(str[i]);
+      uint32_t code;
+      unsigned int num_continue;
+
+      if(b < 0x80)
+        {
+          code = b;
+          num_continue = 0;
+        }
+      else if((b & 0xE0) == 0xC0)
+        {
+          code = b & 0x1F;
+          num_continue = 1;
+        }
+      else if((b & 0xF0) == 0xE0)
+        {
+          code = b & 0x0F;
+          num_continue = 2;
+        }
+      else if((b & 0xF8) == 0xF0)
+        {
+          code = b & 0x07;
+          num_continue = 3;
+        }
+      else
+        {
+          code = b;
+          num_continue = endi;
+        }
+
+      if(i + num_continue >= endi)
+        {
+          out_character_codes.push_back(b);
+          ++i;
+          continue;
+        }
+
+      bool valid(true);
+      for(unsigned int c = 1; c <= num_continue && valid; ++c)
+        {
+          uint8_t v(str[i + c]);
+          valid = (v & 0xC0) == 0x80;
+          code = (code << 6) | (v & 0x3F);
+        }
+
+      if(valid)
+        {
+          out_character_codes.push_back(code);
+          i += num_continue + 1;
+        }
+      else
+        {
+          out_character_codes.push_back(b);
+          ++i;
+        }
+    }
+}
+
+glyph_bake::
+glyph_bake(void):
+  m_about("Bakes the glyphs of a set of characters of fonts into a file "
+          "that BakedGlyphAtlas::load() reads; the glyphs are packed as a "
+          "GlyphAtlas packs them so that BakedGlyphAtlas::load_into() "
+          "sets the texels and geometry data of a GlyphAtlas in bulk. "
+          "The values of the options that affect glyph generation must be "
+          "the same as those of the fonts with which the file is loaded.", *this),
+  m_fonts("font", "font file from which to bake glyphs, give several times "
+          "to bake glyphs from several fonts", *this),
+  m_font_index(0, "font_index", "face index into font files to use if a font file has multiple fonts", *this),
+  m_coverage_pixel_size(24, "coverage_pixel_size",
+                        "Pixel size at which to bake coverage glyphs, a value of 0 "
+                        "indicates to not bake coverage glyphs", *this),
+  m_distance_pixel_size(48, "distance_pixel_size", "Pixel size at which to create distance field glyphs", *this),
+  m_max_distance(96.0f, "max_distance",
+                 "value to use for max distance in 64'ths of a pixel "
+                 "when generating distance field glyphs", *this),
+  m_curve_pair_pixel_size(48, "curvepair_pixel_size", "Pixel size at which to create distance curve pair glyphs", *this),
+  m_bake_distance_field(true, "bake_distance_field", "if true bake distance field glyphs", *this),
+  m_bake_curve_pair(true, "bake_curvepair", "if true bake curve pair glyphs", *this),
+  m_text(" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~",
+         "text", "characters whose glyphs to bake, as UTF-8", *this),
+  m_use_file(false, "use_file", "if true the value for text gives a filename whose characters to bake", *this),
+  m_bake_glyph_set(false, "bake_glyph_set", "if true, bake all glyphs of the fonts instead of the glyphs of text", *this),
+  m_texel_store_width(1024, "texel_store_width", "width of texel store", *this),
+  m_texel_store_height(1024, "texel_store_height", "height of texel store", *this),
+  m_geometry_store_alignment(4, "geometry_store_alignment",
+                             "alignment of the geometry store, must be one of 1, 2, 3 or 4", *this),
+  m_packer(GlyphAtlas::tree_packer,
+           enumerated_string_type<enum GlyphAtlas::packer_t>()
+           .add_entry("tree", GlyphAtlas::tree_packer, "GlyphAtlas::tree_packer")
+           .add_entry("skyline", GlyphAtlas::skyline_packer, "GlyphAtlas::skyline_packer")
+           .add_entry("max_rects", GlyphAtlas::max_rects_packer, "GlyphAtlas::max_rects_packer"),
+           "packer", "how glyphs are packed, must match the packer of the GlyphAtlas the "
+           "file is loaded into", *this),
+  m_output("glyphs.baked", "output", "file to which to write the baked glyphs", *this),
+  m_number_failed(0)
+{}
+
+enum return_code
+glyph_bake::
+create_fonts(void)
+{
+  reference_counted_ptr<FreetypeLib> lib;
+  FontFreeType::RenderParams render_params;
+
+  lib = FASTUIDRAWnew FreetypeLib();
+  render_params
+    .distance_field_max_distance(m_max_distance.m_value)
+    .distance_field_pixel_size(m_distance_pixel_size.m_value)
+    .curve_pair_pixel_size(m_curve_pair_pixel_size.m_value);
+
+  for(unsigned int i = 0, endi = m_fonts.m_values.size(); i < endi; ++i)
+    {
+      reference_counted_ptr<const FontFreeType> font;
+
+      font = FontFreeType::create(m_fonts.m_values[i].c_str(), lib,
+                                  render_params, m_font_index.m_value);
+      if(!font)
+        {
+          std::cerr << "Failed to load font at index " << m_font_index.m_value
+                    << " from file \"" << m_fonts.m_values[i] << "\"\n";
+          return routine_fail;
+        }
+
+      if(font->persistent_key() == 0)
+        {
+          std::cerr << "Font \"" << m_fonts.m_values[i] << "\" cannot be baked\n";
+          return routine_fail;
+        }
+      m_font_objects.push_back(font);
+    }
+  return routine_success;
+}
+
+void
+glyph_bake::
+compute_character_codes(void)
+{
+  std::string text;
+  std::set<uint32_t> seen;
+
+  if(m_use_file.m_value)
+    {
+      std::ifstream istr(m_text.m_value.c_str(), std::ios::binary);
+      if(!istr)
+        {
+          std::cerr << "Unable to open \"" << m_text.m_value << "\"\n";
+          return;
+        }
+      text.assign(std::istreambuf_iterator<char>(istr), std::istreambuf_iterator<char>());
+    }
+  else
+    {
+      text = m_text.m_value;
+    }
+
+  std::vector<uint32_t> codes;
+  decode_utf8(text, codes);
+
+  /* remove duplicates and control characters, but keep
+     the order in which the characters are given.
+   */
+  for(unsigned int i = 0, endi = codes.size(); i < endi; ++i)
+    {
+      if(codes[i] >= 32 && seen.insert(codes[i]).second)
+        {
+          m_character_codes.push_back(codes[i]);
+        }
+    }
+}
+
+void
+glyph_bake::
+bake_glyphs(GlyphRender render)
+{
+  for(unsigned int f = 0, endf = m_font_objects.size(); f < endf; ++f)
+    {
+      reference_counted_ptr<const FontBase> font(m_font_objects[f]);
+      std::vector<uint32_t> glyph_codes;
+
+      if(m_bake_glyph_set.m_value)
+        {
+          for(long g = 0, endg = m_font_objects[f]->face()->num_glyphs; g < endg; ++g)
+            {
+              glyph_codes.push_back(g);
+            }
+        }
+      else
+        {
+          std::set<uint32_t> seen;
+          for(unsigned int c = 0, endc = m_character_codes.size(); c < endc; ++c)
+            {
+              uint32_t g;
+
+              /* characters a font does not have map to glyph
+                 code 0, only bake that glyph once.
+               */
+              g = font->glyph_code(m_character_codes[c]);
+              if(seen.insert(g).second)
+                {
+                  glyph_codes.push_back(g);
+                }
+            }
+        }
+
+      for(unsigned int g = 0, endg = glyph_codes.size(); g < endg; ++g)
+        {
+          if(m_baked->add_glyph(render, font, glyph_codes[g]) != routine_success)
+            {
+              ++m_number_failed;
+            }
+        }
+    }
+}
+
+int
+glyph_bake::
+main(int argc, char **argv)
+{
+  simple_time timer;
+
+  if(argc == 1 || (argc == 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")))
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  if(m_fonts.m_values.empty())
+    {
+      std::cerr << "No fonts given\n";
+      return -1;
+    }
+
+  if(create_fonts() == routine_fail)
+    {
+      return -1;
+    }
+
+  if(!m_bake_glyph_set.m_value)
+    {
+      compute_character_codes();
+    }
+
+  m_baked = FASTUIDRAWnew BakedGlyphAtlas(ivec2(m_texel_store_width.m_value, m_texel_store_height.m_value),
+                                          m_geometry_store_alignment.m_value,
+                                          m_packer.m_value.m_value);
+
+  if(m_coverage_pixel_size.m_value > 0)
+    {
+      bake_glyphs(GlyphRender(m_coverage_pixel_size.m_value));
+    }
+
+  if(m_bake_distance_field.m_value)
+    {
+      bake_glyphs(GlyphRender(distance_field_glyph));
+    }
+
+  if(m_bake_curve_pair.m_value)
+    {
+      bake_glyphs(GlyphRender(curve_pair_glyph));
+    }
+
+  if(m_baked->save(m_output.m_value.c_str()) != routine_success)
+    {
+      std::cerr << "Failed to write \"" << m_output.m_value << "\"\n";
+      return -1;
+    }
+
+  std::cout << "Baked " << m_baked->number_glyphs() << " glyphs into \""
+            << m_output.m_value << "\" in " << timer.elapsed() << " ms"
+            << "\n\tlayers: " << m_baked->number_layers()
+            << " of " << m_baked->texel_dimensions()
+            << "\n\tgeometry blocks: " << m_baked->number_geometry_blocks()
+            << " of alignment " << m_baked->geometry_alignment()
+            << "\n\tglyphs that could not be baked: " << m_number_failed
+            << "\n";
+
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  glyph_bake G;
+  return G.main(argc, argv);
+}
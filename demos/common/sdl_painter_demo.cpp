@@ -116,6 +116,20 @@ sdl_painter_demo(const std::string &about_text,
                                "glyph_atlas_delayed_upload",
                                "if true delay uploading of data to GL from glyph atlas until atlas flush",
                                *this),
+  m_glyph_atlas_packer(m_glyph_atlas_params.packer(),
+                       enumerated_string_type<enum fastuidraw::GlyphAtlas::packer_t>()
+                       .add_entry("tree",
+                                  fastuidraw::GlyphAtlas::tree_packer,
+                                  "recursively split the free region in two (historical behavior)")
+                       .add_entry("skyline",
+                                  fastuidraw::GlyphAtlas::skyline_packer,
+                                  "skyline bottom-left packing with a waste map")
+                       .add_entry("max_rects",
+                                  fastuidraw::GlyphAtlas::max_rects_packer,
+                                  "maximal free rectangles with best short side fit"),
+                       "glyph_atlas_packer",
+                       "Determines how glyphs are packed into the texel store of the glyph atlas",
+                       *this),
   m_glyph_geometry_backing_store_type(glyph_geometry_backing_store_auto,
                                       enumerated_string_type<enum glyph_geometry_backing_store_t>()
                                       .add_entry("buffer",
@@ -269,7 +283,8 @@ init_gl(int w, int h)
     .texel_store_dimensions(texel_dims)
     .number_floats(m_geometry_store_size.m_value)
     .alignment(m_geometry_store_alignment.m_value)
-    .delayed(m_glyph_atlas_delayed_upload.m_value);
+    .delayed(m_glyph_atlas_delayed_upload.m_value)
+    .packer(m_glyph_atlas_packer.m_value.m_value);
 
   switch(m_glyph_geometry_backing_store_type.m_value.m_value)
     {
@@ -75,6 +75,7 @@ private:
   command_line_argument_value<int> m_texel_store_num_layers, m_geometry_store_size;
   command_line_argument_value<int> m_geometry_store_alignment;
   command_line_argument_value<bool> m_glyph_atlas_delayed_upload;
+  enumerated_command_line_argument_value<enum fastuidraw::GlyphAtlas::packer_t> m_glyph_atlas_packer;
   enumerated_command_line_argument_value<enum glyph_geometry_backing_store_t> m_glyph_geometry_backing_store_type;
   command_line_argument_value<int> m_glyph_geometry_backing_texture_log2_w, m_glyph_geometry_backing_texture_log2_h;
 
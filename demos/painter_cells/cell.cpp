@@ -1,7 +1,5 @@
 #include <sstream>
-#include <fastuidraw/painter/painter_attribute_data_filler_glyphs.hpp>
 #include "cell.hpp"
-#include "text_helper.hpp"
 
 namespace
 {
@@ -52,17 +50,10 @@ Cell(PainterWidget *p, const CellParams &params):
        << "\n" << params.m_text
        << "\n" << params.m_image_name;
 
-  std::istringstream str(ostr.str());
-  std::vector<Glyph> glyphs;
-  std::vector<vec2> positions;
-  std::vector<uint32_t> character_codes;
-  create_formatted_text(str, params.m_text_render, params.m_pixel_size,
-                        params.m_font, params.m_glyph_selector,
-                        glyphs, positions, character_codes);
-
-  m_text.set_data(PainterAttributeDataFillerGlyphs(cast_c_array(positions),
-                                                   cast_c_array(glyphs),
-                                                   params.m_pixel_size));
+  m_layout = FASTUIDRAWnew TextLayout(params.m_glyph_selector, params.m_text_render);
+  m_layout->append(ostr.str().c_str(), params.m_font->properties(), params.m_pixel_size);
+  m_layout->fill_attribute_data(m_text);
+
   m_dimensions = params.m_size;
   m_table_pos = m_dimensions * vec2(params.m_table_pos);
 }
@@ -162,6 +153,13 @@ paint_pre_children(const reference_counted_ptr<Painter> &painter)
 
   if(m_shared_state->m_draw_text)
     {
+      /* glyphs not drawn in a while may have been taken
+         out of the GlyphAtlas to make room for others
+       */
+      if(m_layout->attribute_data_evicted())
+        {
+          m_layout->fill_attribute_data(m_text);
+        }
       painter->draw_glyphs(PainterData(m_text_brush), m_text);
     }
 
@@ -3,6 +3,7 @@
 #include <fastuidraw/text/glyph_selector.hpp>
 #include <fastuidraw/text/glyph_cache.hpp>
 #include <fastuidraw/text/font.hpp>
+#include <fastuidraw/text/text_layout.hpp>
 #include <fastuidraw/painter/painter.hpp>
 
 #include "ostream_utility.hpp"
@@ -91,6 +92,7 @@ private:
 
   vec2 m_item_location;
   float m_item_rotation;
+  reference_counted_ptr<TextLayout> m_layout;
   PainterAttributeData m_text;
   CellSharedState *m_shared_state;
   bool m_timer_based_animation;
@@ -40,6 +40,12 @@ private:
   void
   ready_glyph_attribute_data(void);
 
+  void
+  fill_glyph_attribute_data(unsigned int draw);
+
+  bool
+  glyph_attribute_data_evicted(unsigned int draw);
+
   void
   compute_glyphs_and_positions(GlyphRender renderer,
                                float pixel_size_formatting,
@@ -82,6 +88,7 @@ private:
   vecN<PainterAttributeData, number_draw_modes> m_draws;
   vecN<std::string, number_draw_modes> m_draw_labels;
   vecN<std::vector<Glyph>, number_draw_modes> m_glyphs;
+  vecN<std::vector<unsigned int>, number_draw_modes> m_upload_generations;
   std::vector<vec2> m_glyph_positions;
 
   bool m_use_anisotropic_anti_alias;
@@ -341,9 +348,7 @@ ready_glyph_attribute_data(void)
     GlyphRender renderer(m_coverage_pixel_size.m_value);
     compute_glyphs_and_positions(renderer, m_render_pixel_size.m_value,
                                  m_glyphs[draw_glyph_coverage], character_codes);
-    m_draws[draw_glyph_coverage].set_data(PainterAttributeDataFillerGlyphs(cast_c_array(m_glyph_positions),
-                                                                           cast_c_array(m_glyphs[draw_glyph_coverage]),
-                                                                           m_render_pixel_size.m_value));
+    fill_glyph_attribute_data(draw_glyph_coverage);
     m_draw_labels[draw_glyph_coverage] = "draw_glyph_coverage";
   }
 
@@ -353,9 +358,7 @@ ready_glyph_attribute_data(void)
                           cast_c_array(m_glyphs[draw_glyph_coverage]),
                           m_glyphs[draw_glyph_distance],
                           cast_c_array(character_codes));
-    m_draws[draw_glyph_distance].set_data(PainterAttributeDataFillerGlyphs(cast_c_array(m_glyph_positions),
-                                                                           cast_c_array(m_glyphs[draw_glyph_distance]),
-                                                                           m_render_pixel_size.m_value));
+    fill_glyph_attribute_data(draw_glyph_distance);
     m_draw_labels[draw_glyph_distance] = "draw_glyph_distance";
   }
 
@@ -365,13 +368,43 @@ ready_glyph_attribute_data(void)
                           cast_c_array(m_glyphs[draw_glyph_coverage]),
                           m_glyphs[draw_glyph_curvepair],
                           cast_c_array(character_codes));
-    m_draws[draw_glyph_curvepair].set_data(PainterAttributeDataFillerGlyphs(cast_c_array(m_glyph_positions),
-                                                                            cast_c_array(m_glyphs[draw_glyph_curvepair]),
-                                                                            m_render_pixel_size.m_value));
+    fill_glyph_attribute_data(draw_glyph_curvepair);
     m_draw_labels[draw_glyph_curvepair] = "draw_glyph_curvepair";
   }
 }
 
+void
+painter_glyph_test::
+fill_glyph_attribute_data(unsigned int draw)
+{
+  m_draws[draw].set_data(PainterAttributeDataFillerGlyphs(cast_c_array(m_glyph_positions),
+                                                          cast_c_array(m_glyphs[draw]),
+                                                          m_render_pixel_size.m_value));
+
+  m_upload_generations[draw].resize(m_glyphs[draw].size());
+  for(unsigned int i = 0, endi = m_glyphs[draw].size(); i < endi; ++i)
+    {
+      m_upload_generations[draw][i] = (m_glyphs[draw][i].valid()) ?
+        m_glyphs[draw][i].upload_generation() : 0;
+    }
+}
+
+bool
+painter_glyph_test::
+glyph_attribute_data_evicted(unsigned int draw)
+{
+  for(unsigned int i = 0, endi = m_glyphs[draw].size(); i < endi; ++i)
+    {
+      if(m_glyphs[draw][i].valid()
+         && (m_glyphs[draw][i].upload_generation() == 0
+             || m_glyphs[draw][i].upload_generation() != m_upload_generations[draw][i]))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 void
 painter_glyph_test::
 draw_frame(void)
@@ -385,6 +418,14 @@ draw_frame(void)
   m = proj * m_zoomer.transformation().matrix3();
   m_painter->transformation(m);
 
+  /* the glyphs of a mode not drawn in a while may have been
+     taken out of the GlyphAtlas to make room for other glyphs
+   */
+  if(glyph_attribute_data_evicted(m_current_drawer))
+    {
+      fill_glyph_attribute_data(m_current_drawer);
+    }
+
   PainterBrush brush;
   brush.pen(1.0, 1.0, 1.0, 1.0);
   m_painter->draw_glyphs(PainterData(&brush),
@@ -428,6 +469,7 @@ draw_frame(void)
     }
 
   m_painter->end();
+  m_glyph_cache->advance_frame();
 }
 
 void
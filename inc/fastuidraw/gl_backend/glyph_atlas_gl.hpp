@@ -115,6 +115,20 @@ namespace gl
       params&
       delayed(bool v);
 
+      /*!
+        How the GlyphAtlasGL places the regions it allocates
+        within each layer of its texel store, initial value
+        is \ref GlyphAtlas::tree_packer.
+       */
+      enum GlyphAtlas::packer_t
+      packer(void) const;
+
+      /*!
+        Set the value for packer(void) const
+       */
+      params&
+      packer(enum GlyphAtlas::packer_t v);
+
       /*!
         Returns what kind of GL object is used to back
         the glyph geometry data. Default value is
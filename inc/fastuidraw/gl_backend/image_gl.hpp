@@ -46,6 +46,39 @@ namespace gl
   class ImageAtlasGL:public ImageAtlas
   {
   public:
+    /*!
+      Counters of the uploads of data to a GL texture
+      issued by a flush of the texture. If the ImageAtlasGL
+      was constructed as delayed, the regions set since the
+      previous flush are packed into a single buffer and
+      the regions that are adjacent are uploaded with
+      a single call.
+     */
+    class upload_stats
+    {
+    public:
+      upload_stats(void):
+        m_number_regions(0),
+        m_number_calls(0),
+        m_number_bytes(0)
+      {}
+
+      /*!
+        Number of regions of the texture that were set.
+       */
+      unsigned int m_number_regions;
+
+      /*!
+        Number of calls to glTexSubImage3D issued.
+       */
+      unsigned int m_number_calls;
+
+      /*!
+        Number of bytes uploaded.
+       */
+      unsigned int m_number_bytes;
+    };
+
     /*!
       Class to hold the construction parameters for creating
       a ImageAtlasGL.
@@ -214,6 +247,24 @@ namespace gl
     const params&
     param_values(void) const;
 
+    /*!
+      Returns the upload_stats of the last flush of the color
+      texture (see color_texture()) that uploaded data to the
+      texture. If the ImageAtlasGL is not delayed, the values
+      are all 0.
+     */
+    upload_stats
+    color_upload_stats(void) const;
+
+    /*!
+      Returns the upload_stats of the last flush of the index
+      texture (see index_texture()) that uploaded data to the
+      texture. If the ImageAtlasGL is not delayed, the values
+      are all 0.
+     */
+    upload_stats
+    index_upload_stats(void) const;
+
     /*!
       Returns the coordinates to use for the corners
       of drawing an image that are fed as the 1st
@@ -0,0 +1,325 @@
+/*!
+ * \file painter_backend_headless.hpp
+ * \brief file painter_backend_headless.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/glsl/painter_backend_glsl.hpp>
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+/*!\addtogroup GLSLShaderBuilder
+  @{
+ */
+    /*!
+      A PainterBackendHeadless implements PainterBackend without
+      any 3D API. The PainterDraw objects returned by map_draw()
+      are backed by CPU memory and PainterDraw::draw() does not
+      draw anything; instead the backend only records counters
+      of what would have been sent to a 3D API. The shaders and
+      shader grouping are those of PainterBackendGLSL, so that a
+      PainterPacker (and Painter) drive a PainterBackendHeadless
+      exactly as they would drive a GL backend. The purpose is
+      to measure the CPU cost of Painter and PainterPacker on
+      machines that do not have a GPU.
+     */
+    class PainterBackendHeadless:public PainterBackendGLSL
+    {
+    public:
+      /*!
+        Enumeration to query the counters recorded by
+        a PainterBackendHeadless.
+       */
+      enum counter_t
+        {
+          /*!
+            Number of PainterDraw objects returned by map_draw()
+           */
+          draws_mapped_counter,
+
+          /*!
+            Number of PainterAttribute values written to the
+            PainterDraw objects (i.e. the sum of the attributes
+            written passed to PainterDraw::unmap()).
+           */
+          attributes_written_counter,
+
+          /*!
+            Number of PainterIndex values written to the
+            PainterDraw objects.
+           */
+          indices_written_counter,
+
+          /*!
+            Number of generic_data values written to
+            PainterDraw::m_store of the PainterDraw
+            objects.
+           */
+          store_written_counter,
+
+          /*!
+            Number of bytes written to the PainterDraw objects,
+            i.e. the bytes for the attributes, header attributes,
+            indices and data store combined.
+           */
+          bytes_written_counter,
+
+          /*!
+            Number of times PainterDraw::draw_break() was called.
+           */
+          draw_breaks_counter,
+
+          /*!
+            Number of draw calls a 3D API would have issued, i.e. the
+            number of draw breaks plus one for each PainterDraw that
+            has been drawn.
+           */
+          draw_calls_counter,
+
+          /*!
+            Number of on_pre_draw()/on_post_draw() pairs.
+           */
+          frames_counter,
+
+          number_counters
+        };
+
+      /*!
+        A ConfigurationHeadless gives parameters how to contruct
+        a PainterBackendHeadless.
+       */
+      class ConfigurationHeadless
+      {
+      public:
+        /*!
+          Ctor.
+         */
+        ConfigurationHeadless(void);
+
+        /*!
+          Copy ctor.
+          \param obj value from which to copy
+         */
+        ConfigurationHeadless(const ConfigurationHeadless &obj);
+
+        ~ConfigurationHeadless();
+
+        /*!
+          Assignment operator
+          \param rhs value from which to copy
+         */
+        ConfigurationHeadless&
+        operator=(const ConfigurationHeadless &rhs);
+
+        /*!
+          The ImageAtlas to be used by the painter. If NULL,
+          the PainterBackendHeadless creates an ImageAtlas
+          whose backing stores are CPU memory. Default value
+          is NULL.
+         */
+        const reference_counted_ptr<ImageAtlas>&
+        image_atlas(void) const;
+
+        /*!
+          Set the value returned by image_atlas(void) const.
+         */
+        ConfigurationHeadless&
+        image_atlas(const reference_counted_ptr<ImageAtlas> &v);
+
+        /*!
+          The ColorStopAtlas to be used by the painter. If NULL,
+          the PainterBackendHeadless creates a ColorStopAtlas
+          whose backing store is CPU memory. Default value
+          is NULL.
+         */
+        const reference_counted_ptr<ColorStopAtlas>&
+        colorstop_atlas(void) const;
+
+        /*!
+          Set the value returned by colorstop_atlas(void) const.
+         */
+        ConfigurationHeadless&
+        colorstop_atlas(const reference_counted_ptr<ColorStopAtlas> &v);
+
+        /*!
+          The GlyphAtlas to be used by the painter. If NULL,
+          the PainterBackendHeadless creates a GlyphAtlas
+          whose backing stores are CPU memory. Default value
+          is NULL.
+         */
+        const reference_counted_ptr<GlyphAtlas>&
+        glyph_atlas(void) const;
+
+        /*!
+          Set the value returned by glyph_atlas(void) const.
+         */
+        ConfigurationHeadless&
+        glyph_atlas(const reference_counted_ptr<GlyphAtlas> &v);
+
+        /*!
+          Specifies the maximum number of attributes
+          a PainterDraw returned by
+          map_draw() may store, i.e. the size
+          of PainterDraw::m_attributes.
+          Initial value is 512 * 512.
+         */
+        unsigned int
+        attributes_per_buffer(void) const;
+
+        /*!
+          Set the value for attributes_per_buffer(void) const
+        */
+        ConfigurationHeadless&
+        attributes_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of indices
+          a PainterDraw returned by
+          map_draw() may store, i.e. the size
+          of PainterDraw::m_indices.
+          Initial value is 1.5 times the initial value
+          for attributes_per_buffer(void) const.
+         */
+        unsigned int
+        indices_per_buffer(void) const;
+
+        /*!
+          Set the value for indices_per_buffer(void) const
+        */
+        ConfigurationHeadless&
+        indices_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of blocks of
+          data a PainterDraw returned by
+          map_draw() may store. The size of
+          PainterDraw::m_store is given by
+          data_blocks_per_store_buffer() *
+          PainterBackend::ConfigurationBase::alignment(),
+          Initial value is 1024 * 64.
+         */
+        unsigned int
+        data_blocks_per_store_buffer(void) const;
+
+        /*!
+          Set the value for data_blocks_per_store_buffer(void) const
+        */
+        ConfigurationHeadless&
+        data_blocks_per_store_buffer(unsigned int v);
+
+        /*!
+          If true, each item and blend shader is placed into
+          its own shader group, thus a change in shader
+          triggers a PainterDraw::draw_break(). This mirrors
+          gl::PainterBackendGL::ConfigurationGL::break_on_shader_change().
+          Default value is false.
+         */
+        bool
+        break_on_shader_change(void) const;
+
+        /*!
+          Set the value for break_on_shader_change(void) const
+        */
+        ConfigurationHeadless&
+        break_on_shader_change(bool v);
+
+      private:
+        void *m_d;
+      };
+
+      /*!
+        Ctor.
+        \param config_headless parameters for the PainterBackendHeadless
+        \param config_base ConfigurationBase parameters inherited from PainterBackend
+        \param config_glsl ConfigurationGLSL providing the configuration of the
+                           shaders of PainterBackendGLSL
+       */
+      explicit
+      PainterBackendHeadless(const ConfigurationHeadless &config_headless =
+                             ConfigurationHeadless(),
+                             const ConfigurationBase &config_base =
+                             ConfigurationBase(),
+                             const ConfigurationGLSL &config_glsl =
+                             ConfigurationGLSL());
+
+      ~PainterBackendHeadless();
+
+      /*!
+        Returns the ConfigurationHeadless passed in the ctor.
+       */
+      const ConfigurationHeadless&
+      configuration_headless(void) const;
+
+      /*!
+        Returns the value of a counter as recorded for the
+        last on_pre_draw()/on_post_draw() pair, i.e. what
+        was mapped, written and drawn since the previous
+        call to on_post_draw().
+        \param tp which counter to query
+       */
+      uint64_t
+      counter(enum counter_t tp) const;
+
+      /*!
+        Returns the value of a counter summed over all
+        on_pre_draw()/on_post_draw() pairs since the
+        ctor or the last call to reset_counters().
+        \param tp which counter to query
+       */
+      uint64_t
+      total_counter(enum counter_t tp) const;
+
+      /*!
+        Reset all counters to zero.
+       */
+      void
+      reset_counters(void);
+
+      virtual
+      void
+      on_pre_draw(void);
+
+      virtual
+      void
+      on_post_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(void);
+
+    protected:
+
+      virtual
+      uint32_t
+      compute_item_shader_group(PainterShader::Tag tag,
+                                const reference_counted_ptr<PainterItemShader> &shader);
+
+      virtual
+      uint32_t
+      compute_blend_shader_group(PainterShader::Tag tag,
+                                 const reference_counted_ptr<PainterBlendShader> &shader);
+
+    private:
+      void *m_d;
+    };
+/*! @} */
+
+  }
+}
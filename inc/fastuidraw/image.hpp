@@ -312,6 +312,18 @@ namespace fastuidraw
     ivec3
     add_index_tile(const_c_array<ivec3> data, int slack);
 
+    /*!
+      Set the data of an index tile that indexes into color data,
+      replacing the data the tile was added with. Used to change
+      which color tiles an index tile references, for example
+      by Image::make_resident().
+      \param tile tile to set as returned by add_index_tile()
+      \param data array of tiles as returned by add_color_tile()
+      \param slack slack of the color tiles, as in add_index_tile()
+     */
+    void
+    set_index_tile(ivec3 tile, const_c_array<ivec3> data, int slack);
+
     /*!
       Adds an index tile that indexes into the index data. This is needed
       for large images where more than one level of index look up is
@@ -338,12 +350,48 @@ namespace fastuidraw
     add_color_tile(const_c_array<u8vec4> data);
 
     /*!
-      Mark a tile as free in the atlas
-      \param tile tile to free as returned by add_color_tile().
+      Adds a tile to the atlas whose texels may be shared
+      with other tiles. If a tile with the same texel values
+      was added with add_shared_color_tile() and is not yet
+      deleted, that tile is returned and its reference count
+      incremented instead of adding a new tile. Tiles are
+      identified by a 128-bit hash of their texels; the texels
+      themselves are not kept by the ImageAtlas, so tiles with
+      different texels are only shared on a collision of the
+      128-bit hash. The returned
+      tile is to be released with delete_color_tile() once for
+      each time it was returned.
+      \param data color/image data to which to set the tile
+     */
+    ivec3
+    add_shared_color_tile(const_c_array<u8vec4> data);
+
+    /*!
+      Mark a tile as free in the atlas; if the tile was
+      returned by add_shared_color_tile(), decrement its
+      reference count and free it when it reaches zero.
+      \param tile tile to free as returned by add_color_tile()
+                  or add_shared_color_tile().
      */
     void
     delete_color_tile(ivec3 tile);
 
+    /*!
+      Returns the number of distinct tiles in the atlas that
+      were added with add_shared_color_tile().
+     */
+    int
+    number_shared_color_tiles(void) const;
+
+    /*!
+      Returns the sum of the reference counts of the tiles
+      in the atlas that were added with add_shared_color_tile();
+      the difference with number_shared_color_tiles() is the
+      number of tiles saved by sharing.
+     */
+    int
+    number_shared_color_tile_references(void) const;
+
     /*!
       Returns the number of free color tiles that are available
       in the atlas without resizing the AtlasColorBackingStoreBase
@@ -395,9 +443,79 @@ namespace fastuidraw
     void *m_d;
   };
 
+  /*!
+    An ImageSourceBase provides the texels of an image to
+    Image::create() on demand so that the texels of the
+    entire image need not be held in memory at once. The
+    rows of the image are fetched in increasing order and
+    each row is fetched exactly once, thus an ImageSourceBase
+    can be a decoder that decodes the image row by row. At
+    any time, Image::create() holds only as many rows as the
+    color tile size (see ImageAtlas::color_tile_size()) of
+    the ImageAtlas.
+   */
+  class ImageSourceBase
+  {
+  public:
+    virtual
+    ~ImageSourceBase()
+    {}
+
+    /*!
+      To be implemented by a derived class to write the
+      texels of consecutive rows of the image.
+      \param y first row to fetch, the first call is with
+               y = 0 and each following call is with y one
+               more than the last row of the previous call
+      \param num_rows number of rows to fetch
+      \param dst location to which to write the texels, the
+                 texel at column x of row y + r is written to
+                 dst[x + r * W] where W is the width of the
+                 image
+     */
+    virtual
+    void
+    fetch_rows(int y, int num_rows, c_array<u8vec4> dst) = 0;
+  };
+
+  /*!
+    A VirtualImageSourceBase provides the texels of a virtual
+    Image (see Image::create_virtual()) when color tiles of
+    the Image are made resident by Image::make_resident().
+   */
+  class VirtualImageSourceBase:
+    public reference_counted<VirtualImageSourceBase>::default_base
+  {
+  public:
+    virtual
+    ~VirtualImageSourceBase()
+    {}
+
+    /*!
+      To be implemented by a derived class to write the texels
+      of a rectangle of the image. The rectangle is always
+      contained in the image. Called from the thread that
+      calls Image::make_resident().
+      \param x left side of the rectangle
+      \param y top side of the rectangle
+      \param w width of the rectangle
+      \param h height of the rectangle
+      \param dst location to which to write the texels, the
+                 texel at (x + i, y + j) is written to
+                 dst[i + j * w]
+     */
+    virtual
+    void
+    fetch_texels(int x, int y, int w, int h, c_array<u8vec4> dst) = 0;
+  };
+
   /*!
     An Image represents an image comprising of RGBA8 values.
     The texel values themselves are stored in a ImageAtlas.
+    The color tiles of an Image are added with
+    ImageAtlas::add_shared_color_tile(), thus color tiles
+    with the same texels, within an Image or across the
+    Image objects of an ImageAtlas, are stored only once.
    */
   class Image:
     public reference_counted<Image>::default_base
@@ -405,7 +523,11 @@ namespace fastuidraw
   public:
     /*!
       Construct an image. If there is insufficient room on the atlas,
-      returns a NULL handle.
+      returns a NULL handle. Optionally, a mipmap chain of the image
+      is computed and stored with the image, see number_mipmap_levels().
+      The mipmap level L + 1 is computed from the mipmap level L by
+      averaging each 2x2 block of texels, weighting the color of each
+      texel by its alpha (the texels are not pre-multiplied by alpha).
       \param atlas ImageAtlas atlas onto which to place the image
       \param w width of the image
       \param h height of the image
@@ -413,11 +535,59 @@ namespace fastuidraw
       \param pslack number of pixels allowed to sample outside of color tile
                     for the image. A value of one allows for bilinear
                     filtering and a value of two allows for cubic filtering.
+      \param pmax_number_mipmap_levels maximum number of mipmap levels,
+                                       including the image itself, to
+                                       store; a value of 1 indicates
+                                       to not compute a mipmap chain
      */
     static
     reference_counted_ptr<Image>
     create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-           const_c_array<u8vec4> image_data, unsigned int pslack);
+           const_c_array<u8vec4> image_data, unsigned int pslack,
+           unsigned int pmax_number_mipmap_levels = 1);
+
+    /*!
+      Construct an image whose texels are fetched from an
+      ImageSourceBase as the color tiles of the image are made.
+      If there is insufficient room on the atlas, returns a NULL
+      handle without fetching any texels.
+      \param atlas ImageAtlas atlas onto which to place the image
+      \param w width of the image
+      \param h height of the image
+      \param image_source ImageSourceBase from which to fetch the
+                          texels of the image
+      \param pslack number of pixels allowed to sample outside of color tile
+                    for the image. A value of one allows for bilinear
+                    filtering and a value of two allows for cubic filtering.
+     */
+    static
+    reference_counted_ptr<Image>
+    create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
+           ImageSourceBase &image_source, unsigned int pslack);
+
+    /*!
+      Construct a virtual image. A virtual image has all of its
+      index tiles in the ImageAtlas, but its color tiles are
+      only in the ImageAtlas once made resident with
+      make_resident(); the color tiles that are not resident
+      are drawn as transparent black. The texels of a color
+      tile are fetched from a VirtualImageSourceBase when the
+      color tile is made resident. If there is insufficient
+      room on the atlas, returns a NULL handle.
+      \param atlas ImageAtlas atlas onto which to place the image
+      \param w width of the image
+      \param h height of the image
+      \param image_source VirtualImageSourceBase from which to fetch
+                          the texels of the image
+      \param pslack number of pixels allowed to sample outside of color tile
+                    for the image. A value of one allows for bilinear
+                    filtering and a value of two allows for cubic filtering.
+     */
+    static
+    reference_counted_ptr<Image>
+    create_virtual(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
+                   const reference_counted_ptr<VirtualImageSourceBase> &image_source,
+                   unsigned int pslack);
 
     ~Image();
 
@@ -453,7 +623,8 @@ namespace fastuidraw
       If number_index_lookups() > 0, returns the number of texels in
       each dimension of the master index tile this Image lies.
       If number_index_lookups() is 0, the returns the same value
-      as dimensions().
+      as dimensions(). For an Image with more than one mipmap
+      level, the value is for the mipmap level 0 only.
      */
     vec2
     master_index_tile_dims(void) const;
@@ -471,9 +642,169 @@ namespace fastuidraw
     const reference_counted_ptr<ImageAtlas>&
     atlas(void) const;
 
+    /*!
+      Returns the number of mipmap levels of the Image, including
+      the mipmap level 0 (i.e. the image itself). The mipmap level L
+      has the dimensions max(1, W >> L) by max(1, H >> L) where
+      (W, H) is dimensions(). The texels of all mipmap levels are
+      stored in the index tiles of the Image: the mipmap level 0
+      is at (0, 0) and the mipmap levels 1, 2, ... are stacked
+      vertically to its right, each surrounded by slack() texels
+      that repeat the border texels of the level so that filtering
+      a mipmap level does not sample texels of another level.
+      See mipmap_location() and mipmap_dimensions().
+     */
+    unsigned int
+    number_mipmap_levels(void) const;
+
+    /*!
+      Returns the dimensions of a mipmap level.
+      \param level mipmap level with 0 <= level < number_mipmap_levels()
+     */
+    ivec2
+    mipmap_dimensions(unsigned int level) const;
+
+    /*!
+      Returns the location of the texel (0, 0) of a mipmap level
+      relative to the texel (0, 0) of the mipmap level 0, i.e.
+      relative to the location of the texels of the Image as
+      given by master_index_tile().
+      \param level mipmap level with 0 <= level < number_mipmap_levels()
+     */
+    ivec2
+    mipmap_location(unsigned int level) const;
+
+    /*!
+      Returns true if this Image was made with create_virtual().
+     */
+    bool
+    is_virtual(void) const;
+
+    /*!
+      Returns the number of color tiles of the Image in
+      each dimension. The color tile (x, y) holds the
+      texels of the Image from x * I to (x + 1) * I
+      horizontally and from y * I to (y + 1) * I vertically,
+      where I is ImageAtlas::color_tile_size() less twice
+      the slack().
+     */
+    ivec2
+    number_color_tiles(void) const;
+
+    /*!
+      Compute the color tiles that are needed to draw a region
+      of the Image, i.e. those color tiles that hold a texel of
+      the region. The region is clamped to the Image. Returns
+      false if the region does not intersect the Image.
+      \param min_corner minimum corner of the region in coordinates
+                        of the Image, i.e. in units of texels
+      \param max_corner maximum corner of the region in coordinates
+                        of the Image, i.e. in units of texels
+      \param[out] out_min_tile minimum corner of the rectangle of
+                               the color tiles needed
+      \param[out] out_max_tile maximum corner (inclusive) of the
+                               rectangle of the color tiles needed
+     */
+    bool
+    color_tiles_of_region(vec2 min_corner, vec2 max_corner,
+                          ivec2 &out_min_tile, ivec2 &out_max_tile) const;
+
+    /*!
+      Make color tiles of a virtual Image resident, i.e. place
+      the tiles in the ImageAtlas, fetching their texels from
+      the VirtualImageSourceBase of the Image. The passed tiles
+      are marked as used in the current frame (see advance_frame()).
+      Afterwards, if more tiles are resident than resident_tile_budget(),
+      the tiles used least recently are evicted until the budget
+      is met; tiles used in the current frame, by this call or
+      an earlier one, are never evicted. Does nothing if the
+      Image is not virtual.
+      Returns the number of tiles that were made resident.
+      \param tiles color tiles to make resident, see number_color_tiles()
+     */
+    unsigned int
+    make_resident(const_c_array<ivec2> tiles);
+
+    /*!
+      Make the color tiles of a rectangle of color tiles resident,
+      as if calling make_resident(const_c_array<ivec2>) with the
+      tiles of the rectangle.
+      \param min_tile minimum corner of the rectangle of tiles
+      \param max_tile maximum corner (inclusive) of the rectangle of tiles
+     */
+    unsigned int
+    make_resident(ivec2 min_tile, ivec2 max_tile);
+
+    /*!
+      Returns true if a color tile is resident. For an
+      Image that is not virtual, always returns true.
+      \param tile color tile to query
+     */
+    bool
+    resident(ivec2 tile) const;
+
+    /*!
+      Evict all color tiles of a virtual Image.
+     */
+    void
+    evict_all(void);
+
+    /*!
+      Returns the number of color tiles that are resident.
+     */
+    unsigned int
+    number_resident_tiles(void) const;
+
+    /*!
+      Returns the total number of color tiles evicted
+      by make_resident() and evict_all().
+     */
+    unsigned int
+    number_evicted_tiles(void) const;
+
+    /*!
+      Set the maximum number of color tiles of a virtual Image
+      to keep resident, see make_resident(). Default value is
+      the number of color tiles that fit in a layer of the
+      color store of the ImageAtlas.
+      \param v value
+     */
+    void
+    resident_tile_budget(unsigned int v);
+
+    /*!
+      Returns the value set by resident_tile_budget(unsigned int).
+     */
+    unsigned int
+    resident_tile_budget(void) const;
+
+    /*!
+      Start a new frame. A color tile passed to make_resident()
+      is not evicted by make_resident() until advance_frame()
+      is called, so that the tiles drawn by earlier draws are
+      kept until those draws are sent to the 3D API. Thus, a
+      caller should call advance_frame() once the draws of a
+      frame that use the Image are sent to the 3D API (for
+      example after Painter::end()). If advance_frame() is
+      never called, tiles are never evicted by make_resident().
+     */
+    void
+    advance_frame(void);
+
+    /*!
+      Returns the number of times advance_frame() was called.
+     */
+    unsigned int
+    current_frame(void) const;
+
   private:
     Image(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-          const_c_array<u8vec4> image_data, unsigned int pslack);
+          ImageSourceBase &image_source, unsigned int pslack,
+          unsigned int pmax_number_mipmap_levels);
+
+    Image(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
+          const reference_counted_ptr<VirtualImageSourceBase> &image_source,
+          unsigned int pslack);
 
     void *m_d;
   };
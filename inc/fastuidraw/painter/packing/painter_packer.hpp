@@ -79,6 +79,235 @@ namespace fastuidraw
       header_added(const PainterHeader &original_value, c_array<generic_data> mapped_location) = 0;
     };
 
+    /*!
+      Enumeration to query the statistics of how
+      much data has been packed, see query_stat().
+     */
+    enum stats_t
+      {
+        /*!
+          Number of attributes written to the
+          PainterDraw objects
+         */
+        num_attributes,
+
+        /*!
+          Number of indices written to the
+          PainterDraw objects
+         */
+        num_indices,
+
+        /*!
+          Number of blocks of data written to PainterDraw::m_store,
+          a block is PainterBackend::ConfigurationBase::alignment()
+          generic_data values.
+         */
+        num_store_blocks,
+
+        /*!
+          Number of PainterDraw objects mapped, i.e. the number
+          of PainterDraw objects returned by PainterBackend::map_draw()
+         */
+        num_draws,
+
+        /*!
+          Number of headers (i.e. PainterHeader values)
+          written to the PainterDraw objects
+         */
+        num_headers,
+
+        /*!
+          Number of calls to PainterDraw::draw_break()
+         */
+        num_draw_breaks,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() where
+          PainterShaderGroup::item_group() changed
+         */
+        num_item_shader_breaks,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() where
+          PainterShaderGroup::blend_group() changed
+         */
+        num_blend_shader_breaks,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() where
+          the brush shader (masked by
+          PainterBackend::ConfigurationBase::brush_shader_mask())
+          changed
+         */
+        num_brush_shader_breaks,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() where
+          PainterShaderGroup::packed_blend_mode() changed
+         */
+        num_blend_mode_breaks,
+
+        /*!
+          Number of times the data of a PainterPackedValue was
+          already present in the current PainterDraw and was
+          reused instead of being copied
+         */
+        num_packed_value_reuses,
+
+        /*!
+          Number of times state data (from a PainterPackedValue or
+          from a value) was packed into a PainterDraw::m_store
+         */
+        num_state_packs,
+
+        /*!
+          Number of times state data was the same as the state
+          data of the same kind of the previous draw and the
+          data of the previous draw was used instead
+         */
+        num_state_reuses,
+
+        /*!
+          Number of times a header was the same as the
+          header of the previous draw and the attributes
+          used the header of the previous draw
+         */
+        num_header_reuses,
+
+        number_stats
+      };
+
+    /*!
+      A Stream records draw commands into CPU memory independently
+      of the PainterPacker that created it. The purpose is to allow
+      several threads to each pack draws into their own Stream
+      simultaneously; the recorded draws are then added to the
+      PainterPacker by submit_stream() from the thread of the
+      PainterPacker. A single Stream may only be used from one
+      thread at a time. The shaders used to draw into a Stream
+      must already be registered to the PainterPacker and the
+      PainterPackedValue objects of a PainterPackerData may be
+      shared across threads, but the values are always copied
+      into a Stream (i.e. the PainterPacker reuse of packed
+      values within a PainterDraw does not happen for draws
+      made to a Stream).
+     */
+    class Stream:public reference_counted<Stream>::default_base
+    {
+    public:
+      ~Stream();
+
+      /*!
+        Sets the active blend shader of the Stream, initial
+        value is the blend shader of the PainterPacker when
+        the Stream was created. It is a crashing error for h
+        to be NULL.
+        \param h blend shader to use for blending.
+        \param packed_blend_mode 3D API blend mode packed via BlendMode::packed().
+       */
+      void
+      blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
+                   BlendMode::packed_value packed_blend_mode);
+
+      /*!
+        Record drawing generic attribute data, see
+        PainterPacker::draw_generic(const reference_counted_ptr<PainterItemShader>&, const PainterPackerData&, const_c_array<const_c_array<PainterAttribute> >, const_c_array<const_c_array<PainterIndex> >, unsigned int, const reference_counted_ptr<DataCallBack>&).
+        \param data data for how to draw
+        \param attrib_chunks attribute data to draw
+        \param index_chunks the i'th element is index data into attrib_chunks[i]
+        \param shader shader with which to draw data
+        \param z z-value z value placed into the header
+       */
+      void
+      draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+                   const PainterPackerData &data,
+                   const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+                   const_c_array<const_c_array<PainterIndex> > index_chunks,
+                   unsigned int z);
+
+      /*!
+        Record drawing generic attribute data, see
+        PainterPacker::draw_generic(const reference_counted_ptr<PainterItemShader>&, const PainterPackerData&, const_c_array<const_c_array<PainterAttribute> >, const_c_array<const_c_array<PainterIndex> >, const_c_array<unsigned int>, unsigned int, const reference_counted_ptr<DataCallBack>&).
+        \param data data for how to draw
+        \param attrib_chunks attribute data to draw
+        \param index_chunks the i'th element is index data into attrib_chunks[K]
+                            where K = attrib_chunk_selector[i]
+        \param attrib_chunk_selector selects which attribute chunk to use for
+               each index chunk
+        \param shader shader with which to draw data
+        \param z z-value z value placed into the header
+       */
+      void
+      draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+                   const PainterPackerData &data,
+                   const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+                   const_c_array<const_c_array<PainterIndex> > index_chunks,
+                   const_c_array<unsigned int> attrib_chunk_selector,
+                   unsigned int z);
+
+      /*!
+        Discard all draws recorded to the Stream.
+       */
+      void
+      clear(void);
+
+    private:
+      friend class PainterPacker;
+
+      explicit
+      Stream(void *d);
+
+      void *m_d;
+    };
+
+    /*!
+      A DisplayList holds draws recorded between begin_display_list()
+      and end_display_list(). Drawing a DisplayList with
+      draw_display_list() copies the recorded attributes, indices
+      and data store into the current PainterDraw, modifying only
+      the headers, item matrices and clip equations, instead of
+      performing again all the work that created the draws.
+     */
+    class DisplayList:public reference_counted<DisplayList>::default_base
+    {
+    public:
+      ~DisplayList();
+
+      /*!
+        Returns the number of bytes copied into PainterDraw
+        objects each time the DisplayList is drawn; this is
+        the same as the number of bytes written to PainterDraw
+        objects when the draws were packed into the DisplayList.
+       */
+      unsigned int
+      bytes(void) const;
+
+      /*!
+        Returns the number of headers (i.e. the number of
+        calls to draw_generic() that drew something)
+        recorded to the DisplayList.
+       */
+      unsigned int
+      number_headers(void) const;
+
+      /*!
+        Returns one more than the largest z-value of the
+        draws recorded relative to the base z value passed
+        to begin_display_list(), i.e. the number of
+        z-values the DisplayList occupies.
+       */
+      unsigned int
+      z_span(void) const;
+
+    private:
+      friend class PainterPacker;
+
+      explicit
+      DisplayList(void *d);
+
+      void *m_d;
+    };
+
     /*!
       Ctor.
       \param backend handle to PainterBackend for the constructed PainterPacker
@@ -136,6 +365,33 @@ namespace fastuidraw
     blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
                  BlendMode::packed_value packed_blend_mode);
 
+    /*!
+      If true, the draws within each PainterDraw are reordered
+      just before the PainterDraw is unmapped so that draws sharing
+      the state that triggers PainterDraw::draw_break() are drawn
+      together, reducing the number of draw breaks. The order of
+      reordered draws is resolved by the depth test, which is only
+      correct for draws that replace what is underneath them. Hence
+      draws are only reordered within a run of consecutive draws
+      whose blend mode and PainterBlendShader do not read the
+      framebuffer (for example with blending disabled or with
+      a blend mode whose destination factors are BlendMode::ZERO)
+      and that share the same blend mode; draws that blend are
+      never reordered, nor are draws reordered across a change
+      of blend mode. Draws sharing the same z-value are never
+      reordered relative to each other. Default value is false.
+     */
+    bool
+    reorder_draws(void) const;
+
+    /*!
+      Set the value returned by reorder_draws(void) const.
+      The value takes effect on the next PainterDraw
+      taken into use.
+     */
+    void
+    reorder_draws(bool v);
+
     /*!
       Indicate to start drawing. Commands are buffered and not
       set to the backend until end() or flush() is called.
@@ -152,12 +408,103 @@ namespace fastuidraw
     void
     end(void);
 
+    /*!
+      Returns the value of a statistic for the last begin() /
+      end() pair. A single draw break is counted for each of
+      the causes that triggered it, so the sum of the breaks
+      by cause may exceed num_draw_breaks. The draws made
+      to a Stream or DisplayList are counted (excluding
+      num_packed_value_reuses, num_state_packs, num_state_reuses
+      and num_header_reuses) when they are added to the
+      PainterPacker.
+      \param st which statistic to query
+     */
+    unsigned int
+    query_stat(enum stats_t st) const;
+
     /*!
       Flush all buffered rendering commands.
      */
     void
     flush(void);
 
+    /*!
+      Create a Stream to which draws can be recorded from another
+      thread. A Stream needs the sizes of the PainterDraw objects
+      of the PainterBackend, which are known only after begin()
+      has been called at least once; before that, returns a null
+      handle.
+     */
+    reference_counted_ptr<Stream>
+    create_stream(void);
+
+    /*!
+      Adds the draws recorded to a Stream to this PainterPacker;
+      the draws are placed after all draws made to the PainterPacker
+      so far. After the call the Stream is empty and may be used
+      to record draws again. Must be called between a begin() /
+      end() pair, and no thread may be recording draws to the
+      Stream during the call.
+      \param stream Stream whose draws to add, the Stream must
+                    have been created by this PainterPacker.
+     */
+    void
+    submit_stream(const reference_counted_ptr<Stream> &stream);
+
+    /*!
+      Start recording a DisplayList; all draws until end_display_list()
+      are recorded to the DisplayList instead of added to the current
+      PainterDraw. May only be called after begin() has been called
+      at least once. Recording DisplayList objects does not nest.
+      \param base_transformation the transformation from which the draws
+                                 of the DisplayList are relative
+      \param base_clip draws whose clip equations are base_clip take
+                       the clip equations passed to draw_display_list()
+                       when the DisplayList is drawn
+      \param base_z the z-value from which the z-values of the
+                    draws of the DisplayList are relative
+     */
+    void
+    begin_display_list(const float3x3 &base_transformation,
+                       const PainterClipEquations &base_clip,
+                       unsigned int base_z);
+
+    /*!
+      End recording a DisplayList and return the DisplayList.
+      Any PainterDraw::DelayedAction added by a DataCallBack
+      to the recorded draws must have been performed before
+      end_display_list() is called.
+     */
+    reference_counted_ptr<DisplayList>
+    end_display_list(void);
+
+    /*!
+      Add the draws of a DisplayList. For each draw of the DisplayList,
+      - the item matrix is M * inverse(B) * R where M is the passed
+        transformation, B is the base transformation passed to
+        begin_display_list() and R is the item matrix of the draw
+        when it was recorded,
+      - the clip equations are the passed clip equations if the
+        clip equations of the draw were the base clip equations
+        passed to begin_display_list(), otherwise they are the
+        clip equations of the draw transformed by M * inverse(B),
+      - the z-value is z + (Z - base_z) where Z is the z-value of
+        the draw when it was recorded.
+      Returns the number of bytes copied, see DisplayList::bytes().
+      Must be called between a begin() / end() pair and not while
+      recording a DisplayList.
+      \param list DisplayList to draw, must have been made by this
+                  PainterPacker
+      \param transformation transformation M
+      \param clip clip equations
+      \param z z-value for the draws
+     */
+    unsigned int
+    draw_display_list(const reference_counted_ptr<const DisplayList> &list,
+                      const float3x3 &transformation,
+                      const PainterClipEquations &clip,
+                      unsigned int z);
+
     /*!
       Return the default shaders for common drawing types.
      */
@@ -747,6 +747,82 @@ namespace fastuidraw
                  const_c_array<unsigned int> attrib_chunk_selector,
                  const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Start recording a PainterPacker::DisplayList; all draws until
+      end_display_list() are recorded instead of drawn. The recorded
+      draws are relative to the transformation, clipping and z-value
+      of the Painter when begin_display_list() is called. Must be
+      called between a begin() / end() pair; recording does not nest.
+     */
+    void
+    begin_display_list(void);
+
+    /*!
+      End recording a PainterPacker::DisplayList and return it. Any
+      occluders (from clipOutPath() and the like) pushed after
+      begin_display_list() are popped, as in end().
+     */
+    reference_counted_ptr<PainterPacker::DisplayList>
+    end_display_list(void);
+
+    /*!
+      Draw a PainterPacker::DisplayList made by end_display_list(). The
+      draws are transformed by the current transformation (relative to
+      the transformation when the recording began), draws that were
+      recorded with the clipping present when the recording began are
+      clipped by the current clipping, and current_z() is incremented
+      by PainterPacker::DisplayList::z_span(). Returns the number of
+      bytes copied, see PainterPacker::DisplayList::bytes().
+      \param list PainterPacker::DisplayList to draw
+     */
+    unsigned int
+    draw_display_list(const reference_counted_ptr<const PainterPacker::DisplayList> &list);
+
+    /*!
+      Returns the value of a statistic of the last begin() / end()
+      pair as reported by PainterPacker::query_stat() of the
+      underlying PainterPacker of this Painter.
+      \param st which statistic to query
+     */
+    unsigned int
+    query_stat(enum PainterPacker::stats_t st) const;
+
+    /*!
+      Returns the maximum distance, in pixels, between a curve
+      of a Path and the line segments approximating it when
+      the Path is drawn (stroked, filled or used for clipping).
+      If positive, the methods taking a Path use the
+      TessellatedPath returned by Path::tessellation(const float3x3&, float) const
+      for the current transformation and target resolution, so
+      that curves are tessellated finer as they are magnified
+      and coarser as they are minified. If not positive, the
+      TessellatedPath returned by Path::tessellation(void) const
+      is used. Default value is -1.0.
+     */
+    float
+    curve_flatness(void) const;
+
+    /*!
+      Set the value returned by curve_flatness(void) const.
+      \param v value to use
+     */
+    void
+    curve_flatness(float v);
+
+    /*!
+      Returns PainterPacker::reorder_draws() of the
+      underlying PainterPacker of this Painter.
+     */
+    bool
+    reorder_draws(void) const;
+
+    /*!
+      Sets PainterPacker::reorder_draws() of the
+      underlying PainterPacker of this Painter.
+     */
+    void
+    reorder_draws(bool v);
+
     /*!
       Return the z-depth value that the next item will have.
      */
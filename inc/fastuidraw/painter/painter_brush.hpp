@@ -94,6 +94,12 @@ namespace fastuidraw
          */
         image_number_index_lookups_num_bits = 5,
 
+        /*!
+          Number bits used to store the value of
+          Image::number_mipmap_levels() - 1
+         */
+        image_number_mipmap_levels_num_bits = 4,
+
         /*!
           Number of bits needed to encode filter for image,
           the value packed into the shader ID encodes both
@@ -149,6 +155,11 @@ namespace fastuidraw
           first bit used to store Image::slack()
          */
         image_slack_bit0 = image_number_index_lookups_bit0 + image_number_index_lookups_num_bits,
+
+        /*!
+          first bit used to store Image::number_mipmap_levels() - 1
+         */
+        image_number_mipmap_levels_bit0 = image_slack_bit0 + image_slack_num_bits,
       };
 
     /*!
@@ -164,6 +175,10 @@ namespace fastuidraw
         /*! max value storeable for Image::slack()
          */
         image_slack_max = FASTUIDRAW_MAX_VALUE_FROM_NUM_BITS(image_slack_num_bits),
+
+        /*! max value storeable for Image::number_mipmap_levels() - 1
+         */
+        image_number_mipmap_levels_max = FASTUIDRAW_MAX_VALUE_FROM_NUM_BITS(image_number_mipmap_levels_num_bits),
       };
 
     /*!
@@ -224,6 +239,12 @@ namespace fastuidraw
           bit mask for how much slack for image used in brush
          */
         image_slack_mask = FASTUIDRAW_MASK(image_slack_bit0, image_slack_num_bits),
+
+        /*!
+          bit mask for how many mipmap levels beyond level 0
+          the image used in brush has
+         */
+        image_number_mipmap_levels_mask = FASTUIDRAW_MASK(image_number_mipmap_levels_bit0, image_number_mipmap_levels_num_bits),
       };
 
     /*!
@@ -360,6 +381,15 @@ namespace fastuidraw
          */
         image_start_xy_offset,
 
+        /*!
+          Width and height of the mipmap level 0 of the image
+          (Image::dimensions()) encoded in a single uint32, used
+          to locate the other mipmap levels of the image (see
+          Image::mipmap_location()). Encoding is the same as
+          image_size_xy_offset, see image_size_encoding
+         */
+        image_level0_size_xy_offset,
+
         /*!
           Number of elements packed for image support
           for a brush.
@@ -529,7 +559,11 @@ namespace fastuidraw
     }
 
     /*!
-      Sets the brush to have an image.
+      Sets the brush to have an image. If the image has more
+      than one mipmap level (see Image::number_mipmap_levels()),
+      the mipmap level sampled is selected per pixel as the
+      mipmap level whose texels are closest in size to a pixel,
+      never magnifying a level beyond the level 0.
       \param im handle to image to use. If handle is invalid,
                 then sets brush to not have an image.
       \param f filter to apply to image, only has effect if im
@@ -539,7 +573,10 @@ namespace fastuidraw
     image(const reference_counted_ptr<const Image> &im, enum image_filter f = image_filter_nearest);
 
     /*!
-      Set the brush to source from a sub-rectangle of an image
+      Set the brush to source from a sub-rectangle of an image.
+      As with image(), the mipmap level sampled is selected
+      per pixel, the sub-rectangle is given in coordinates
+      of the mipmap level 0.
       \param im handle to image to use
       \param xy top-left corner of sub-rectangle of image to use
       \param wh width and height of sub-rectangle of image to use
@@ -71,10 +71,15 @@ namespace fastuidraw
     packed state data and tracks if that underlying data is already is
     already copied to PainterDraw::m_store. If already
     on a store, then rather than copying the data again, the data is
-    reused. The object behind the handle is NOT thread safe. In addition
-    the underlying reference count is not either. Hence any access
-    (even dtor, copy ctor and equality operator) on a fixed object cannot
-    be done from multiple threads simutaneously. A fixed
+    reused. Unless created by a PainterPackedValuePool constructed as
+    thread safe, the object behind the handle is NOT thread safe and
+    neither is the underlying reference count. Hence any access (even
+    dtor, copy ctor and equality operator) on a fixed object cannot
+    be done from multiple threads simutaneously. The reference count of
+    a value created by a thread safe PainterPackedValuePool is thread
+    safe, so such a value may be copied, compared and released from
+    several threads at the same time; it must still not be used by two
+    PainterPacker objects at the same time. A fixed
     PainterPackedValue can be used by different Painter (and PainterPacker)
     objects subject to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of these
@@ -186,14 +191,21 @@ namespace fastuidraw
 
   /*!
     A PainterPackedValuePool can be used to create PainterPackedValue
-    objects. Just like PainterPackedValue, PainterPackedValuePool is
-    NOT thread safe, as such it is not a safe operation to use the
-    same PainterPackedValuePool object from multiple threads at the
-    same time. A fixed PainterPackedValuePool can create PainterPackedValue
-    objects used by different Painter (and PainterPacker) objects subject
-    to the condition that the data store alignment (see
-    PainterPacker::Configuration::alignment()) is the same for each of
-    these objects.
+    objects. Unless constructed as thread safe, just like PainterPackedValue,
+    PainterPackedValuePool is NOT thread safe, as such it is not a safe
+    operation to use the same PainterPackedValuePool object from multiple
+    threads at the same time. A PainterPackedValuePool constructed as
+    thread safe can create PainterPackedValue objects from several threads
+    simultaneously, and the reference count of the PainterPackedValue
+    objects it creates is thread safe, so that such values may be made
+    on one thread and copied, used and released on another. Each thread
+    takes free values from its own list and values are returned to the
+    pool without any locking. A value being used by a PainterPacker must
+    still not be used by another PainterPacker at the same time. A fixed
+    PainterPackedValuePool can create PainterPackedValue objects used by
+    different Painter (and PainterPacker) objects subject to the condition
+    that the data store alignment (see PainterPacker::Configuration::alignment())
+    is the same for each of these objects.
    */
   class PainterPackedValuePool:noncopyable
   {
@@ -202,9 +214,11 @@ namespace fastuidraw
       Ctor.
       \param painter_alignment the alignment to create packed data, see
                                 PainterPacker::Configuration::alignment()
+      \param thread_safe if true, the created PainterPackedValuePool is
+                         thread safe, see the class description
      */
     explicit
-    PainterPackedValuePool(int painter_alignment);
+    PainterPackedValuePool(int painter_alignment, bool thread_safe = false);
 
     ~PainterPackedValuePool();
 
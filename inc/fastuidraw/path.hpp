@@ -23,6 +23,7 @@
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/matrix.hpp>
 #include <fastuidraw/util/reference_counted.hpp>
 #include <fastuidraw/tessellated_path.hpp>
 
@@ -92,7 +93,10 @@ public:
       are to be filled; the other fields of TessellatedPath::point are
       filled by TessellatedPath using the named fields. In addition to
       filling the output array, the function shall return the number of
-      points needed to perform the required tessellation.
+      points needed to perform the required tessellation. If out_data is
+      too small to hold the tessellation, the function shall not write
+      past its end and still return the number of points needed; the
+      caller is then to call again with a large enough array.
 
       \param tess_params tessellation parameters
       \param out_data location to which to write the edge tessellated
@@ -181,6 +185,23 @@ public:
     void
     compute(float in_t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const = 0;
 
+    /*!
+      To be optionally implemented by a derived class to return an
+      upper bound of the magnitude of the second derivative of the
+      curve for 0 <= t <= 1. The bound is used to find how finely
+      the curve must be tessellated to honor
+      TessellatedPath::TessellationParams::m_max_distance. A negative
+      value indicates that no bound is known, in which case the
+      tessellation is only limited by a large safety limit. Default
+      implementation returns -1.0.
+     */
+    virtual
+    float
+    second_derivative_bound(void) const
+    {
+      return -1.0f;
+    }
+
   private:
   };
 
@@ -222,10 +243,22 @@ public:
     virtual
     ~bezier();
 
+    /*!
+      Returns the control points of the curve, i.e. the
+      points of the curve not including start_pt() and
+      end_pt().
+     */
+    const_c_array<vec2>
+    control_pts(void) const;
+
     virtual
     void
     compute(float in_t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const;
 
+    virtual
+    float
+    second_derivative_bound(void) const;
+
     virtual
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
@@ -788,6 +821,42 @@ public:
   const reference_counted_ptr<const TessellatedPath>&
   tessellation(void) const;
 
+  /*!
+    Return a tessellation of this Path whose curve segments
+    are within a given distance of the curves of this Path,
+    i.e. a tessellation with TessellatedPath::TessellationParams::m_max_distance
+    set. The other fields of the TessellatedPath::TessellationParams
+    are taken from tessellation_params(void) const. The distance
+    is rounded down to a power of 2 and a tessellation is constructed
+    lazily and kept for each power of 2, so that a Path drawn at
+    many different scales only has a few tessellations. As with
+    tessellation(void) const, the tessellations are discarded
+    if this Path changes its geometry or tessellation parameters.
+    If max_distance is not positive, returns tessellation(void) const.
+    \param max_distance maximum distance, in coordinates of the
+                        Path, between a curve of this Path and
+                        the line segments approximating it
+   */
+  const reference_counted_ptr<const TessellatedPath>&
+  tessellation(float max_distance) const;
+
+  /*!
+    Return a tessellation of this Path suitable for drawing this Path
+    with a given transformation, i.e. returns tessellation(float) const
+    passing max_pixel_distance divided by how much the transformation
+    magnifies distances over the bounding box of this Path. If the
+    transformation maps a point of the bounding box to behind the
+    viewer (i.e. a non-positive w) or if max_pixel_distance is not
+    positive, returns tessellation(void) const.
+    \param transformation transformation from the coordinates of the
+                          Path to pixel coordinates
+    \param max_pixel_distance maximum distance, in pixels, between a
+                              curve of this Path and the line segments
+                              approximating it
+   */
+  const reference_counted_ptr<const TessellatedPath>&
+  tessellation(const float3x3 &transformation, float max_pixel_distance) const;
+
 private:
   void *m_d;
 };
@@ -507,11 +507,51 @@ public:
 
   /*!
     Ctor. Construct a StrokedPath from the data
-    of a TessellatedPath.
+    of a TessellatedPath. After the edge data is
+    made, the data of each join and cap style
+    (see point_set_t) is independent of the
+    other join and cap styles and so is made
+    concurrently when max_threads is more than one.
+    The threads helping the calling thread are taken
+    from a pool of threads shared across the library
+    that is made the first time it is needed.
     \param P source TessellatedPath
+    \param max_threads maximum number of threads, including
+                       the calling thread, to use to make
+                       the join and cap data
    */
   explicit
-  StrokedPath(const TessellatedPath &P);
+  StrokedPath(const TessellatedPath &P, unsigned int max_threads = 1);
+
+  /*!
+    Ctor. Construct a StrokedPath from the data of a
+    TessellatedPath, copying the data of those contours
+    that are unchanged from a StrokedPath made earlier.
+    The data of a contour of a StrokedPath is only a
+    function of the points of that contour of the
+    TessellatedPath and of its TessellationParams, so
+    the data of a contour whose points are the same
+    is copied (with its indices and depth values moved)
+    instead of being made. Note that reuse must have
+    been made from a TessellatedPath with the same
+    TessellationParams as P.
+    \param P source TessellatedPath
+    \param reuse StrokedPath from which to copy the data
+                 of contours; if NULL, all data is made
+    \param reuse_contours reuse_contours[c] is the contour
+                          of reuse whose points are the
+                          same as those of the contour c
+                          of P, or -1 if there is no such
+                          contour. Ignored if its size is
+                          not P.number_contours().
+    \param max_threads maximum number of threads, including
+                       the calling thread, to use to make
+                       the join and cap data
+   */
+  StrokedPath(const TessellatedPath &P,
+              const reference_counted_ptr<const StrokedPath> &reuse,
+              const_c_array<int> reuse_contours,
+              unsigned int max_threads = 1);
 
   ~StrokedPath();
 
@@ -56,7 +56,8 @@ public:
      */
     TessellationParams(void):
       m_curve_tessellation(float(M_PI)/30.0f),
-      m_max_segments(32)
+      m_max_segments(32),
+      m_max_distance(-1.0f)
     {}
 
     /*!
@@ -67,7 +68,8 @@ public:
     operator!=(const TessellationParams &rhs) const
     {
       return m_curve_tessellation != rhs.m_curve_tessellation
-        || m_max_segments != rhs.m_max_segments;
+        || m_max_segments != rhs.m_max_segments
+        || m_max_distance != rhs.m_max_distance;
     }
 
     /*!
@@ -81,9 +83,31 @@ public:
     /*!
       Maximum number of segments to tessellate each
       PathContour::interpolator_base from each
-      PathContour of a Path.
+      PathContour of a Path. Ignored if m_max_distance
+      is positive.
      */
     unsigned int m_max_segments;
+
+    /*!
+      If positive, the curves are tessellated so that
+      the distance between each curve segment and the
+      line segment approximating it is no more than
+      m_max_distance (in the coordinates of the Path),
+      and m_curve_tessellation is ignored. Unlike
+      m_curve_tessellation, the tessellation then
+      depends on the size of the curves, so that for
+      drawing a Path the value should be chosen from
+      how much the Path is magnified, see
+      Path::tessellation(float) const. The number of
+      segments of a curve is then not limited by
+      m_max_segments but by how finely the curve needs
+      to be tessellated (see
+      PathContour::interpolator_generic::second_derivative_bound()),
+      up to a safety limit of 65536 segments per curve.
+      Initial value is -1.0, i.e. the tessellation is only
+      determined by m_curve_tessellation.
+     */
+    float m_max_distance;
   };
 
   /*!
@@ -140,8 +164,27 @@ public:
     Ctor. Construct a TessellatedPath from a Path
     \param input source path to tessellate
     \param P parameters on how to tessellate the source Path
+    \param reuse if non-NULL and tessellated with the same
+                 TessellationParams, the tessellation of those
+                 edges of input that are also edges of the Path
+                 from which reuse was made (i.e. the same
+                 PathContour::interpolator_base objects) is
+                 copied from reuse instead of being computed.
+                 Since only the edges added to a Path get new
+                 interpolator objects, this makes tessellating
+                 a Path to which edges or contours are added
+                 proportional to the number of new edges,
+                 plus copying the points of the old edges.
+                 In addition, if reuse was already stroked,
+                 stroked() copies the stroking data of each
+                 contour all of whose edges are copied from
+                 reuse instead of making it. The FilledPath
+                 is always made from the entire path since
+                 its triangulation spans all contours.
    */
-  TessellatedPath(const Path &input, TessellationParams P);
+  TessellatedPath(const Path &input, TessellationParams P,
+                  const reference_counted_ptr<const TessellatedPath> &reuse =
+                  reference_counted_ptr<const TessellatedPath>());
 
   ~TessellatedPath();
 
@@ -245,11 +288,22 @@ public:
 
   /*!
     Returns this TessellatedPath stroked. The StrokedPath object
-    is constructed lazily.
+    is constructed lazily, copying the data of unchanged contours
+    from the StrokedPath of the TessellatedPath passed as reuse
+    at construction if that was stroked (see StrokedPath::StrokedPath()).
    */
   const reference_counted_ptr<const StrokedPath>&
   stroked(void) const;
 
+  /*!
+    Returns this TessellatedPath stroked. If the StrokedPath
+    object has not yet been constructed, it is constructed
+    using up to max_threads threads, see StrokedPath::StrokedPath().
+    \param max_threads maximum number of threads to use
+   */
+  const reference_counted_ptr<const StrokedPath>&
+  stroked(unsigned int max_threads) const;
+
   /*!
     Returns this TessellatedPath filled. The FilledPath object
     is constructed lazily.
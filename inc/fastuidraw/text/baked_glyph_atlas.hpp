@@ -0,0 +1,180 @@
+/*!
+ * \file baked_glyph_atlas.hpp
+ * \brief file baked_glyph_atlas.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/text/font.hpp>
+#include <fastuidraw/text/glyph_cache.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    A BakedGlyphAtlas holds the texels and geometry data of a
+    set of glyphs packed as a GlyphAtlas packs them, together
+    with the GlyphLocation values and the GlyphLayoutData and
+    Path of each glyph. A BakedGlyphAtlas is made offline,
+    adding the glyphs with add_glyph() and writing the result
+    to a file with save(). At run time, the file is read with
+    load() and load_into() places the glyphs into a GlyphCache,
+    setting the texels of each layer and the geometry data of
+    the GlyphAtlas of the GlyphCache each with one call, so
+    that no glyph data is generated at run time. The glyphs
+    are identified by the value of FontBase::persistent_key()
+    of their font, thus only glyphs of fonts for which that
+    value is non-zero can be baked. The file format uses the
+    byte order and floating point format of the machine. The
+    methods of BakedGlyphAtlas are NOT thread safe.
+   */
+  class BakedGlyphAtlas:
+    public reference_counted<BakedGlyphAtlas>::default_base
+  {
+  public:
+    /*!
+      Ctor, makes an empty BakedGlyphAtlas to which
+      to add glyphs with add_glyph().
+      \param texel_dimensions width and height of each layer of
+                              the texel store, must be the same as
+                              the width and height of the texel store
+                              of the GlyphAtlas passed to load_into()
+      \param geometry_alignment alignment of the geometry store, must be the
+                                same as the alignment of the geometry store
+                                of the GlyphAtlas passed to load_into()
+      \param packer how the glyphs are packed, must be the same as
+                    GlyphAtlas::packer() of the GlyphAtlas passed
+                    to load_into()
+     */
+    BakedGlyphAtlas(ivec2 texel_dimensions, unsigned int geometry_alignment,
+                    enum GlyphAtlas::packer_t packer = GlyphAtlas::tree_packer);
+
+    ~BakedGlyphAtlas();
+
+    /*!
+      Read a BakedGlyphAtlas from a file written by save().
+      Returns NULL if the file cannot be read or is not
+      a valid file.
+      \param filename name of file from which to read
+     */
+    static
+    reference_counted_ptr<BakedGlyphAtlas>
+    load(const char *filename);
+
+    /*!
+      Returns the width and height of each layer
+      of the texel store as passed in the ctor.
+     */
+    ivec2
+    texel_dimensions(void) const;
+
+    /*!
+      Returns the number of layers of the texel store
+      that the glyphs of this BakedGlyphAtlas use.
+     */
+    unsigned int
+    number_layers(void) const;
+
+    /*!
+      Returns the alignment of the geometry
+      store as passed in the ctor.
+     */
+    unsigned int
+    geometry_alignment(void) const;
+
+    /*!
+      Returns how the glyphs are packed
+      as passed in the ctor.
+     */
+    enum GlyphAtlas::packer_t
+    packer(void) const;
+
+    /*!
+      Returns the number of blocks of the geometry store,
+      where each block is geometry_alignment() generic_data
+      values, that the glyphs of this BakedGlyphAtlas use.
+     */
+    unsigned int
+    number_geometry_blocks(void) const;
+
+    /*!
+      Returns the number of glyphs of this BakedGlyphAtlas.
+     */
+    unsigned int
+    number_glyphs(void) const;
+
+    /*!
+      Generate the data of a glyph with FontBase::compute_rendering_data()
+      and pack it. Returns routine_fail if FontBase::persistent_key()
+      of the font returns 0, if the font cannot create the glyph
+      data for the GlyphRender, if the Path of the glyph cannot be
+      stored or if the glyph does not fit in a layer. Adding a glyph
+      that is already in the BakedGlyphAtlas returns routine_success
+      and does nothing.
+      \param render how the glyph is rendered
+      \param font font of the glyph
+      \param glyph_code glyph code of the glyph
+     */
+    enum return_code
+    add_glyph(GlyphRender render,
+              const reference_counted_ptr<const FontBase> &font,
+              uint32_t glyph_code);
+
+    /*!
+      Write this BakedGlyphAtlas to a file.
+      \param filename name of file to which to write
+     */
+    enum return_code
+    save(const char *filename) const;
+
+    /*!
+      Place the glyphs of this BakedGlyphAtlas into a GlyphCache.
+      The regions of the glyphs are allocated from the GlyphAtlas
+      of the GlyphCache (see GlyphCache::atlas()) in the same
+      order as they were when baked, so the GlyphAtlas must not
+      have any allocated regions or geometry data; the texels and
+      geometry data are then set with one call per layer of the
+      texel store and one call for the geometry store. The glyphs
+      are added to the GlyphCache with GlyphCache::add_uploaded_glyph().
+      The font of a glyph is the element of fonts whose
+      FontBase::persistent_key() is the same as that of the font
+      the glyph was baked with; the regions of glyphs that have
+      no font in fonts are freed. Returns routine_fail, leaving
+      the GlyphAtlas as it was, if the dimensions or alignment
+      of its stores or its GlyphAtlas::packer() do not match,
+      if it is too small or if the regions allocated differ
+      from those baked (as happens when the GlyphAtlas is not
+      empty). The caller is to call GlyphAtlas::flush()
+      afterwards, as it would after uploading glyphs.
+      \param cache GlyphCache to which to add the glyphs
+      \param fonts fonts of the glyphs
+     */
+    enum return_code
+    load_into(const reference_counted_ptr<GlyphCache> &cache,
+              const_c_array<reference_counted_ptr<const FontBase> > fonts) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+} //namespace fastuidraw
@@ -100,6 +100,71 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const = 0;
 
+    /*!
+      To be optionally implemented by a derived class to return
+      the kerning between two glyphs of the font, i.e. by how
+      much to move the pen, in addition to the advance of the
+      left glyph, when the glyph right_glyph_code follows the
+      glyph left_glyph_code. The value is for a pixel size of 1,
+      i.e. it is to be multiplied by the pixel size at which
+      the text is laid out. Default implementation returns
+      (0, 0).
+      \param left_glyph_code glyph code of the left glyph
+      \param right_glyph_code glyph code of the right glyph
+     */
+    virtual
+    vec2
+    kerning(uint32_t left_glyph_code, uint32_t right_glyph_code) const
+    {
+      FASTUIDRAWunused(left_glyph_code);
+      FASTUIDRAWunused(right_glyph_code);
+      return vec2(0.0f, 0.0f);
+    }
+
+    /*!
+      To be optionally implemented by a derived class to give
+      the vertical metrics of the font for horizontal layout.
+      The values are for a pixel size of 1, i.e. they are
+      to be multiplied by the pixel size at which the text
+      is laid out. Returns routine_fail if the font does not
+      have the metrics. Default implementation returns
+      routine_fail.
+      \param[out] ascender distance from the baseline to the
+                           top of the tallest glyphs of the font
+      \param[out] descender distance from the baseline to the
+                            bottom of the lowest glyphs of the
+                            font, a positive value is below the
+                            baseline
+      \param[out] line_height distance between the baselines
+                              of consecutive lines
+     */
+    virtual
+    enum return_code
+    line_metrics(float &ascender, float &descender, float &line_height) const
+    {
+      FASTUIDRAWunused(ascender);
+      FASTUIDRAWunused(descender);
+      FASTUIDRAWunused(line_height);
+      return routine_fail;
+    }
+
+    /*!
+      To be optionally implemented by a derived class to return
+      a value that identifies the glyph data the font generates
+      across runs of a program, so that the glyph data can be
+      stored in a GlyphDiskCache or a BakedGlyphAtlas. Two
+      fonts are to return the same value only if they generate
+      the same glyph data. A return value of 0 indicates that
+      the glyph data of the font is not to be stored. Default
+      implementation returns 0.
+     */
+    virtual
+    uint64_t
+    persistent_key(void) const
+    {
+      return 0;
+    }
+
   private:
     FontProperties m_props;
   };
@@ -38,7 +38,14 @@ namespace fastuidraw
     from a scalable font loaded by libfreetype. The conversion
     from character codes to glyph codes for FontFreeType,
     i.e. glyph_code(uint32_t) const, is performed by libfreetype's
-    FT_Get_Char_Index().
+    FT_Get_Char_Index(). An FT_Face can only be used by one thread
+    at a time; a FontFreeType made by create() from a file creates
+    (lazily) an additional FT_Face from the same file for each
+    thread that generates glyph data while the other FT_Face
+    objects of the font are in use, so that several threads can
+    generate glyph data of the same font concurrently. A
+    FontFreeType made from an FT_Face only has that FT_Face and
+    so generates glyph data one thread at a time.
    */
   class FontFreeType:public FontBase
   {
@@ -103,6 +110,28 @@ namespace fastuidraw
       RenderParams&
       distance_field_max_distance(float v);
 
+      /*!
+        Maximum number of threads used to compute the distance
+        field of a single glyph; the rows and columns of the
+        distance field are split into bands processed in
+        parallel by the calling thread and the threads of a
+        pool shared by all fonts, so no threads are created per
+        glyph. The generated values do not depend on the
+        number of threads. Only worthwhile for large values of
+        distance_field_pixel_size(); to generate many glyphs
+        concurrently, see GlyphCache::fetch_glyphs_async().
+       */
+      unsigned int
+      distance_field_max_threads(void) const;
+
+      /*!
+        Set the value returned by distance_field_max_threads(void) const,
+        initial value is 1.
+        \param v value
+       */
+      RenderParams&
+      distance_field_max_threads(unsigned int v);
+
       /*!
         Pixel size at which to render curve pair scalable glyphs.
        */
@@ -212,7 +241,12 @@ namespace fastuidraw
     render_params(void) const;
 
     /*!
-      Return the FT_Face of this FontFreeType object.
+      Return the FT_Face of this FontFreeType object. The
+      FT_Face is also used by the threads that generate the
+      glyph data of this font, so FreeType functions should
+      only be called on it while no glyph data of this font
+      is being generated; fields of the FT_Face that do not
+      change (for example num_glyphs) can be read anytime.
      */
     FT_Face
     face(void) const;
@@ -246,6 +280,38 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const;
 
+    /*!
+      Returns the kerning of the FT_Face between two glyphs
+      from its kerning table. Returns (0, 0) if the FT_Face
+      does not have a kerning table. The kerning of recently
+      asked glyph pairs is kept in a cache of fixed size by
+      the FontFreeType, so repeated pairs are not read from
+      the FT_Face again.
+     */
+    virtual
+    vec2
+    kerning(uint32_t left_glyph_code, uint32_t right_glyph_code) const;
+
+    /*!
+      Returns the ascender, descender and line height of
+      the FT_Face.
+     */
+    virtual
+    enum return_code
+    line_metrics(float &ascender, float &descender, float &line_height) const;
+
+    /*!
+      Returns a hash of the font file, the face index, the
+      RenderParams (except RenderParams::distance_field_max_threads(),
+      which does not affect the glyph data) and the version of
+      libfreetype. The value is computed on the first call,
+      which reads the entire font file. Returns 0 if the font
+      data cannot be read.
+     */
+    virtual
+    uint64_t
+    persistent_key(void) const;
+
   private:
     void *m_d;
   };
@@ -67,8 +67,25 @@ namespace fastuidraw
       return m_lib != NULL;
     }
 
+    /*!
+      Lock the mutex of this FreetypeLib. An FT_Library may
+      only be modified by one thread at a time; functions
+      of libFreeType that modify the FT_Library, such as
+      FT_New_Face() and FT_Done_Face(), should be called
+      with this FreetypeLib locked.
+     */
+    void
+    lock(void);
+
+    /*!
+      Unlock the mutex of this FreetypeLib.
+     */
+    void
+    unlock(void);
+
   private:
     FT_Library m_lib;
+    void *m_mutex;
   };
 /*! @} */
 };
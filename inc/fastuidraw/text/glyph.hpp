@@ -126,14 +126,35 @@ namespace fastuidraw
     cache_location(void) const;
 
     /*!
-      If returns \ref routine_fail, then the GlyphCache
-      on which the glyph resides needs to be cleared
-      first. If the glyph is already uploaded returns
-      immediately with \ref routine_success.
+      Upload the glyph to the GlyphAtlas of its GlyphCache.
+      If there is not enough room, the glyphs of the
+      GlyphCache not used in the current frame are removed
+      from the GlyphAtlas, least recently used first (see
+      GlyphCache::advance_frame()). If returns \ref routine_fail,
+      then the GlyphCache on which the glyph resides needs
+      to be cleared first. If the glyph is already uploaded
+      returns immediately with \ref routine_success.
      */
     enum return_code
     upload_to_atlas(void) const;
 
+    /*!
+      Returns a value identifying the upload of the glyph
+      to the GlyphAtlas of its GlyphCache; the value changes
+      each time the glyph is uploaded and is 0 if the glyph
+      is not uploaded. Data that refers to the location of
+      the glyph in the GlyphAtlas, such as a PainterAttributeData
+      filled by PainterAttributeDataFillerGlyphs, remains valid
+      as long as the value for each of its glyphs is non-zero
+      and the same as when the data was filled; otherwise the
+      glyph was removed from the GlyphAtlas (see
+      GlyphCache::advance_frame()) and the data needs to be
+      filled again. The return value of valid() must be true.
+      If not, debug builds assert and release builds crash.
+     */
+    unsigned int
+    upload_generation(void) const;
+
     /*!
       Returns the path of the Glyph.
      */
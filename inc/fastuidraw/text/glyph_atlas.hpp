@@ -229,6 +229,113 @@ namespace fastuidraw
     public reference_counted<GlyphAtlas>::default_base
   {
   public:
+    /*!
+      Enumeration to specify how a GlyphAtlas chooses where to
+      place the regions it allocates within each layer of its
+      texel store.
+     */
+    enum packer_t
+      {
+        /*!
+          Place regions with a tree whose nodes are split
+          each time a region is added to them. Allocation
+          is fast, but freed room is only merged again when
+          all the regions of a node are freed, so a GlyphAtlas
+          whose regions are often freed fragments over time.
+         */
+        tree_packer,
+
+        /*!
+          Place regions by the bottom left rule on a skyline,
+          the top of the used room of a layer. The room below
+          the skyline that is left when placing a region and
+          regions freed below the skyline are tracked as a
+          list of free rectangles that is tried first.
+         */
+        skyline_packer,
+
+        /*!
+          Track the free room of a layer as a list of maximal
+          free rectangles and place a region where it leaves
+          the least room along its shorter side. Freed regions
+          are merged with the free rectangles they line up
+          with. Allocation is slower than with the other
+          packers, but the layers are filled the most and
+          fragment the least.
+         */
+        max_rects_packer,
+
+        number_packers
+      };
+
+    /*!
+      A PackingStatistics holds how much of the texel store of a
+      GlyphAtlas is in use and how fragmented the free room is.
+      All areas are in texels and include the padding of the
+      regions.
+     */
+    class PackingStatistics
+    {
+    public:
+      PackingStatistics(void):
+        m_number_layers(0),
+        m_number_regions(0),
+        m_total_area(0),
+        m_allocated_area(0),
+        m_largest_free_area(0),
+        m_free_rectangle_area(0)
+      {}
+
+      /*!
+        Returns the fraction of m_total_area that is allocated.
+       */
+      float
+      occupancy(void) const;
+
+      /*!
+        Returns the fraction of the free room that cannot be
+        allocated as one region per layer, i.e. one minus the
+        ratio of m_free_rectangle_area to the free area. A value
+        of 0 indicates that the free room of each layer is one
+        rectangle, a value near 1 that the free room is in
+        many small pieces.
+       */
+      float
+      fragmentation(void) const;
+
+      /*!
+        Number of layers of the texel store.
+       */
+      unsigned int m_number_layers;
+
+      /*!
+        Number of regions allocated.
+       */
+      unsigned int m_number_regions;
+
+      /*!
+        Sum of the areas of all layers.
+       */
+      uint64_t m_total_area;
+
+      /*!
+        Sum of the areas of the regions allocated.
+       */
+      uint64_t m_allocated_area;
+
+      /*!
+        Area of the largest region that can be allocated
+        without resizing the texel store.
+       */
+      uint64_t m_largest_free_area;
+
+      /*!
+        Sum over the layers of the area of the
+        largest region that can be allocated
+        from the layer.
+       */
+      uint64_t m_free_rectangle_area;
+    };
 
     /*!
       A Padding object holds how much of the data allocated
@@ -269,9 +376,11 @@ namespace fastuidraw
       Ctor.
       \param ptexel_store GlyphAtlasTexelBackingStoreBase to which to store texel data
       \param pgeometry_store GlyphAtlasGeometryBackingStoreBase to which to store geometry data
+      \param packer how to place the regions allocated within each layer of the texel store
      */
     GlyphAtlas(reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> ptexel_store,
-               reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store);
+               reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+               enum packer_t packer = tree_packer);
 
     virtual
     ~GlyphAtlas();
@@ -287,6 +396,33 @@ namespace fastuidraw
     GlyphLocation
     allocate(ivec2 size, const_c_array<uint8_t> data, const Padding &padding);
 
+    /*!
+      Allocate a rectangular region without setting the texels
+      of the region, the texels are set with set_texel_data().
+      If allocation is not possible, return a GlyphLocation
+      where GlyphLocation::valid() return false. The region
+      allocated depends only on the sequence of allocations
+      and deallocations made on the GlyphAtlas, so replaying
+      the allocations of a GlyphAtlas on an empty GlyphAtlas
+      whose texel store has the same width and height gives
+      the same regions.
+      \param size size of region to allocate
+      \param padding amount of padding of the region
+     */
+    GlyphLocation
+    allocate(ivec2 size, const Padding &padding);
+
+    /*!
+      Set texels of the texel store, see
+      GlyphAtlasTexelBackingStoreBase::set_data().
+      \param xy position of the texels
+      \param layer layer of the texels
+      \param wh width and height of the texels
+      \param data 8-bit values
+     */
+    void
+    set_texel_data(ivec2 xy, int layer, ivec2 wh, const_c_array<uint8_t> data);
+
     /*!
       Free a region previously allocated by allocate().
       \param G region to free as returned by allocate().
@@ -301,6 +437,25 @@ namespace fastuidraw
     int
     allocate_geometry_data(const_c_array<generic_data> pdata);
 
+    /*!
+      Allocate geometry data without setting the values, the
+      values are set with set_geometry_data(). Negative return
+      value indicates failure. Location and count are in units
+      of geometry_store()->alignment().
+      \param count number of blocks to allocate
+     */
+    int
+    allocate_geometry_blocks(unsigned int count);
+
+    /*!
+      Set values of the geometry store, see
+      GlyphAtlasGeometryBackingStoreBase::set_values().
+      \param location given in units of geometry_store()->alignment()
+      \param pdata data to load, must be a multiple of geometry_store()->alignment().
+     */
+    void
+    set_geometry_data(int location, const_c_array<generic_data> pdata);
+
     /*!
       Location and count are in units of geometry_store()->alignment().
      */
@@ -322,6 +477,20 @@ namespace fastuidraw
     void
     flush(void) const;
 
+    /*!
+      Returns how this GlyphAtlas places the regions
+      it allocates, as passed in the ctor.
+     */
+    enum packer_t
+    packer(void) const;
+
+    /*!
+      Returns the PackingStatistics of the texel
+      store of this GlyphAtlas.
+     */
+    PackingStatistics
+    packing_statistics(void) const;
+
     /*!
       Returns the texel store for this GlyphAtlas.
      */
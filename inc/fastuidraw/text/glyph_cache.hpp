@@ -24,6 +24,8 @@
 #include <fastuidraw/text/font.hpp>
 #include <fastuidraw/text/glyph_layout_data.hpp>
 #include <fastuidraw/text/glyph.hpp>
+#include <fastuidraw/text/glyph_disk_cache.hpp>
+#include <fastuidraw/text/glyph_usage_profile.hpp>
 
 namespace fastuidraw
 {
@@ -33,11 +35,67 @@ namespace fastuidraw
 
   /*!
     A GlyphCache represents a cache of glyphs and manages the uploading
-    of the data to a GlyphAtlas. Methods are NOT thread safe.
+    of the data to a GlyphAtlas. Methods are NOT thread safe;
+    however the data of glyphs can be generated on worker
+    threads with fetch_glyphs_async().
    */
   class GlyphCache:public reference_counted<GlyphCache>::default_base
   {
   public:
+    /*!
+      A Batch represents a set of glyphs whose data is generated
+      by worker threads, see fetch_glyphs_async(). The methods of
+      a Batch are to be called from the same thread as that of
+      the GlyphCache that made it.
+     */
+    class Batch:public reference_counted<Batch>::default_base
+    {
+    public:
+      ~Batch();
+
+      /*!
+        Returns true if the data of all glyphs of this
+        Batch is generated.
+       */
+      bool
+      ready(void) const;
+
+      /*!
+        Wait until the data of all glyphs of this Batch
+        is generated.
+       */
+      void
+      wait(void) const;
+
+      /*!
+        Returns the glyphs of this Batch, waiting until
+        the data of the glyphs is generated first. An element
+        is an invalid Glyph if the font of the element is NULL
+        or cannot generate the GlyphRender of the Batch.
+        The values are only valid as long as the GlyphCache
+        that made the Batch is.
+       */
+      const_c_array<Glyph>
+      glyphs(void) const;
+
+      /*!
+        Upload the glyphs of this Batch to the GlyphAtlas
+        in the order of glyphs(), waiting until the data of
+        the glyphs is generated first. Returns the number of
+        glyphs that were uploaded, i.e. the number of valid
+        glyphs for which Glyph::upload_to_atlas() succeeded.
+       */
+      unsigned int
+      upload_to_atlas(void) const;
+
+    private:
+      friend class GlyphCache;
+
+      Batch(void);
+
+      void *m_d;
+    };
+
     /*!
       Ctor
       \param patlas GlyphAtlas to store glyph data
@@ -57,6 +115,113 @@ namespace fastuidraw
                 const reference_counted_ptr<const FontBase> &font,
                 uint32_t glyph_code);
 
+    /*!
+      Fetch, and if necessary create, a set of glyphs. The data
+      of the glyphs that are not yet in this GlyphCache is
+      generated by the threads of a pool shared with the rest of
+      the library (a thread waiting on a Batch generates glyphs
+      as well) and the returned Batch is used
+      to wait for that data; the glyphs of the Batch are not to
+      be used until Batch::ready() returns true or after calling
+      Batch::wait(). Fetching a glyph with fetch_glyph() that is
+      still being generated waits for that glyph. The glyphs
+      are NOT uploaded to the GlyphAtlas, that is still done with
+      Glyph::upload_to_atlas() from the thread of this GlyphCache.
+      The method FontBase::compute_rendering_data() of each of the
+      fonts must be safe to call concurrently from several threads.
+      \param render GlyphRender specifying how to render the glyphs
+      \param fonts fonts of the glyphs; either a single font used
+                   for all glyphs or one font per glyph code
+      \param glyph_codes glyph codes of the glyphs to fetch
+     */
+    reference_counted_ptr<Batch>
+    fetch_glyphs_async(GlyphRender render,
+                       const_c_array<reference_counted_ptr<const FontBase> > fonts,
+                       const_c_array<uint32_t> glyph_codes);
+
+    /*!
+      Add to a GlyphUsageProfile the glyphs of this GlyphCache
+      together with the number of times each was fetched with
+      fetch_glyph() or fetch_glyphs_async() since it was added
+      to this GlyphCache. Glyphs whose font returns 0 for
+      FontBase::persistent_key() and glyphs that were never
+      fetched (for example those added by prewarm()) are not
+      added. Glyphs removed by delete_glyph() or clear_cache()
+      are not recorded, so a caller should call record_usage()
+      before those.
+      \param profile GlyphUsageProfile to which to add the glyphs
+     */
+    void
+    record_usage(GlyphUsageProfile &profile) const;
+
+    /*!
+      Generate and upload to the GlyphAtlas the glyphs of a
+      GlyphUsageProfile, in the order of GlyphUsageProfile::entries(),
+      i.e. the glyphs fetched most often first. A glyph of the
+      GlyphUsageProfile is generated with the font in fonts whose
+      FontBase::persistent_key() is the same as GlyphUsageProfile::Entry::m_font_key;
+      glyphs for which no font is given are skipped. Glyphs are
+      uploaded until max_glyphs glyphs are uploaded or until a glyph
+      does not fit in the GlyphAtlas without removing other glyphs
+      of the current frame (see advance_frame()). The glyphs are
+      generated by the calling thread and do not count as fetched
+      for record_usage(). Returns the number of glyphs uploaded.
+      \param profile GlyphUsageProfile whose glyphs to generate
+      \param fonts fonts with which to generate the glyphs
+      \param max_glyphs maximum number of glyphs to upload
+     */
+    unsigned int
+    prewarm(const GlyphUsageProfile &profile,
+            const_c_array<reference_counted_ptr<const FontBase> > fonts,
+            unsigned int max_glyphs = ~0u);
+
+    /*!
+      Same as prewarm(), except that the data of the glyphs
+      is generated by the worker threads of fetch_glyphs_async().
+      The glyphs are uploaded to the GlyphAtlas by calling
+      Batch::upload_to_atlas() on the returned Batch, which
+      uploads them in the order of GlyphUsageProfile::entries();
+      a caller can check Batch::ready() each frame so that the
+      upload does not wait on the worker threads. The glyphs do
+      not count as fetched for record_usage().
+      \param profile GlyphUsageProfile whose glyphs to generate
+      \param fonts fonts with which to generate the glyphs
+      \param max_glyphs maximum number of glyphs to generate
+     */
+    reference_counted_ptr<Batch>
+    prewarm_async(const GlyphUsageProfile &profile,
+                  const_c_array<reference_counted_ptr<const FontBase> > fonts,
+                  unsigned int max_glyphs = ~0u);
+
+    /*!
+      Add to this GlyphCache a glyph whose data is already
+      uploaded to the GlyphAtlas of this GlyphCache, for
+      example by BakedGlyphAtlas::load_into(). The GlyphCache
+      takes ownership of the regions of the GlyphAtlas passed,
+      i.e. the regions are deallocated when the glyph is
+      removed from the GlyphAtlas. The glyph keeps no
+      GlyphRenderData, so if the glyph is removed from the
+      GlyphAtlas, Glyph::upload_to_atlas() generates the data
+      of the glyph again from the font of the glyph. If the
+      glyph is already in this GlyphCache, the passed regions
+      are deallocated and the glyph already present is returned.
+      \param render GlyphRender of the glyph
+      \param layout GlyphLayoutData of the glyph, the glyph code and
+                    font of the glyph are GlyphLayoutData::m_glyph_code
+                    and GlyphLayoutData::m_font
+      \param path Path of the glyph
+      \param atlas_location value for Glyph::atlas_location()
+      \param secondary_atlas_location value for Glyph::secondary_atlas_location()
+      \param geometry_offset value for Glyph::geometry_offset()
+      \param geometry_length length in blocks of the geometry data of the glyph
+     */
+    Glyph
+    add_uploaded_glyph(GlyphRender render,
+                       const GlyphLayoutData &layout, const Path &path,
+                       GlyphLocation atlas_location,
+                       GlyphLocation secondary_atlas_location,
+                       int geometry_offset, int geometry_length);
+
     /*!
       Removes a glyph from the -CACHE-, i.e. the GlyphCache,
       thus to use that glyph again requires calling fetch_glyph()
@@ -77,6 +242,64 @@ namespace fastuidraw
     void
     clear_atlas(void);
 
+    /*!
+      Returns the GlyphAtlas of this GlyphCache as passed in the ctor.
+     */
+    const reference_counted_ptr<GlyphAtlas>&
+    atlas(void) const;
+
+    /*!
+      Set the GlyphDiskCache of this GlyphCache. The data of a
+      glyph that is not in this GlyphCache is fetched from the
+      GlyphDiskCache if it holds the glyph instead of being
+      generated by FontBase::compute_rendering_data(); glyph
+      data that is generated is added to the GlyphDiskCache.
+      The added glyphs are written to the file of the
+      GlyphDiskCache by GlyphDiskCache::save(). A NULL value
+      indicates to not use a GlyphDiskCache. Default value
+      is NULL.
+      \param v GlyphDiskCache to use
+     */
+    void
+    disk_cache(const reference_counted_ptr<GlyphDiskCache> &v);
+
+    /*!
+      Returns the value set by disk_cache(const reference_counted_ptr<GlyphDiskCache>&).
+     */
+    const reference_counted_ptr<GlyphDiskCache>&
+    disk_cache(void) const;
+
+    /*!
+      Start a new frame. Each glyph records the frame in which
+      it was last fetched or uploaded (see Glyph::upload_to_atlas()).
+      When a glyph does not fit in the GlyphAtlas, the glyphs used
+      least recently are removed from the GlyphAtlas until the
+      glyph fits; glyphs used in the current frame are never
+      removed. Thus, a caller should call advance_frame() once
+      the data drawn with the glyphs of a frame is sent to the
+      3D API. A glyph removed from the GlyphAtlas remains in
+      this GlyphCache and is re-uploaded by Glyph::upload_to_atlas().
+      Data kept across frames that refers to the location of
+      glyphs in the GlyphAtlas (for example a PainterAttributeData
+      filled by PainterAttributeDataFillerGlyphs) can detect that
+      one of its glyphs was removed with Glyph::upload_generation().
+     */
+    void
+    advance_frame(void);
+
+    /*!
+      Returns the number of times advance_frame() was called.
+     */
+    unsigned int
+    current_frame(void) const;
+
+    /*!
+      Returns the total number of times a glyph was removed
+      from the GlyphAtlas to make room for another glyph.
+     */
+    unsigned int
+    number_evicted_glyphs(void) const;
+
     /*!
       Clear this GlyphCache and the GlyphAtlas. Essentially NUKE.
      */
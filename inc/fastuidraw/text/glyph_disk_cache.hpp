@@ -0,0 +1,159 @@
+/*!
+ * \file glyph_disk_cache.hpp
+ * \brief file glyph_disk_cache.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/text/font.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    A GlyphDiskCache stores the data of glyphs (i.e. the
+    GlyphRenderData, GlyphLayoutData and Path of a glyph) in
+    a file so that the glyph data does not need to be generated
+    again each time a program runs. A glyph is identified by
+    the value of FontBase::persistent_key() of its font, its
+    glyph code and its GlyphRender; the glyphs of fonts for
+    which FontBase::persistent_key() returns 0 are not stored.
+    Only the glyph data types GlyphRenderDataCoverage,
+    GlyphRenderDataDistanceField and GlyphRenderDataCurvePair
+    with paths made of line segments and Bezier curves are
+    stored. The file is memory mapped when the GlyphDiskCache
+    is constructed; glyphs added with store_glyph() are held
+    in memory until save() writes them to the file. The file
+    format uses the byte order and floating point format of
+    the machine, a file written on a machine with a different
+    byte order is ignored. A GlyphDiskCache is typically
+    given to a GlyphCache with GlyphCache::disk_cache(). The
+    methods of a GlyphDiskCache are thread safe.
+   */
+  class GlyphDiskCache:
+    public reference_counted<GlyphDiskCache>::default_base
+  {
+  public:
+    /*!
+      Ctor. If the file exists and is a valid glyph cache
+      file, the file is memory mapped and its glyphs can
+      be fetched with fetch_glyph().
+      \param filename name of the file from which to read
+                      and to which to save the glyphs
+     */
+    explicit
+    GlyphDiskCache(const char *filename);
+
+    ~GlyphDiskCache();
+
+    /*!
+      Returns the name of the file passed in the ctor.
+     */
+    const char*
+    filename(void) const;
+
+    /*!
+      Returns the number of glyphs in the file as of
+      the ctor or the last successful call to save().
+     */
+    unsigned int
+    number_glyphs_in_file(void) const;
+
+    /*!
+      Returns the number of glyphs added by store_glyph()
+      that are not yet written to the file by save().
+     */
+    unsigned int
+    number_glyphs_added(void) const;
+
+    /*!
+      Returns the number of times fetch_glyph() found
+      the requested glyph.
+     */
+    unsigned int
+    number_hits(void) const;
+
+    /*!
+      Returns the number of times fetch_glyph() did not
+      find the requested glyph.
+     */
+    unsigned int
+    number_misses(void) const;
+
+    /*!
+      Fetch the data of a glyph. Returns NULL if the glyph is
+      not stored in this GlyphDiskCache. Otherwise returns a
+      newly created GlyphRenderData (the caller is responsible
+      for deleting it with FASTUIDRAWdelete) and sets layout
+      and path as FontBase::compute_rendering_data() would.
+      \param render how the glyph is rendered
+      \param font font of the glyph
+      \param glyph_code glyph code of the glyph
+      \param[out] layout location to which to place the GlyphLayoutData of the glyph
+      \param[out] path location to which to place the Path of the glyph
+     */
+    GlyphRenderData*
+    fetch_glyph(GlyphRender render,
+                const reference_counted_ptr<const FontBase> &font,
+                uint32_t glyph_code,
+                GlyphLayoutData &layout, Path &path);
+
+    /*!
+      Add the data of a glyph, as generated by FontBase::compute_rendering_data(),
+      to this GlyphDiskCache; the data is written to the file on the next
+      call to save(). Returns routine_fail if the glyph cannot be stored,
+      i.e. if FontBase::persistent_key() of the font returns 0 or if the
+      type of data or the path is not supported.
+      \param render how the glyph is rendered
+      \param font font of the glyph
+      \param glyph_code glyph code of the glyph
+      \param layout GlyphLayoutData of the glyph
+      \param path Path of the glyph
+      \param data GlyphRenderData of the glyph
+     */
+    enum return_code
+    store_glyph(GlyphRender render,
+                const reference_counted_ptr<const FontBase> &font,
+                uint32_t glyph_code,
+                const GlyphLayoutData &layout, const Path &path,
+                const GlyphRenderData *data);
+
+    /*!
+      Write the glyphs of the file and the glyphs added by
+      store_glyph() to the file. The file is written under
+      a temporary name, unique to the process and the call,
+      in the same directory first which then replaces the
+      file, so a program that is killed while saving, or
+      several processes saving the same file, do not leave
+      a corrupt file. Does nothing if no glyphs were
+      added since the last save().
+     */
+    enum return_code
+    save(void);
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+} //namespace fastuidraw
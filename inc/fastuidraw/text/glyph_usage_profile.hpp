@@ -0,0 +1,150 @@
+/*!
+ * \file glyph_usage_profile.hpp
+ * \brief file glyph_usage_profile.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    A GlyphUsageProfile is a set of glyphs together with how
+    many times each glyph was fetched from a GlyphCache. A glyph
+    is identified by the value of FontBase::persistent_key() of
+    its font, its glyph code and its GlyphRender, so that a
+    GlyphUsageProfile recorded during one run of a program (see
+    GlyphCache::record_usage()) can be saved to a file and used
+    in a later run to generate and upload the glyphs most likely
+    to be needed before they are first drawn (see
+    GlyphCache::prewarm()). The file format uses the byte order
+    of the machine, a file written on a machine with a different
+    byte order is not loaded.
+   */
+  class GlyphUsageProfile:
+    public reference_counted<GlyphUsageProfile>::default_base
+  {
+  public:
+    /*!
+      An Entry gives a glyph of a GlyphUsageProfile
+      and the number of times it was fetched.
+     */
+    class Entry
+    {
+    public:
+      /*!
+        Value of FontBase::persistent_key() of the font of the glyph.
+       */
+      uint64_t m_font_key;
+
+      /*!
+        Glyph code of the glyph.
+       */
+      uint32_t m_glyph_code;
+
+      /*!
+        How the glyph is rendered.
+       */
+      GlyphRender m_render;
+
+      /*!
+        Number of times the glyph was fetched.
+       */
+      uint32_t m_hit_count;
+    };
+
+    /*!
+      Ctor, the created GlyphUsageProfile has no entries.
+     */
+    GlyphUsageProfile(void);
+
+    ~GlyphUsageProfile();
+
+    /*!
+      Load a GlyphUsageProfile from a file written by save().
+      Returns NULL if the file cannot be read or is not a
+      valid glyph usage profile file.
+      \param filename name of the file to read
+     */
+    static
+    reference_counted_ptr<GlyphUsageProfile>
+    load(const char *filename);
+
+    /*!
+      Write this GlyphUsageProfile to a file.
+      \param filename name of the file to write
+     */
+    enum return_code
+    save(const char *filename) const;
+
+    /*!
+      Add hits to a glyph; if the glyph is already in this
+      GlyphUsageProfile, the hits are added to those of the
+      glyph (saturating at the largest value of uint32_t).
+      Does nothing if font_key is 0, render is not valid
+      or hit_count is 0.
+      \param font_key value of FontBase::persistent_key() of the font of the glyph
+      \param glyph_code glyph code of the glyph
+      \param render how the glyph is rendered
+      \param hit_count number of hits to add
+     */
+    void
+    add_glyph(uint64_t font_key, uint32_t glyph_code,
+              GlyphRender render, uint32_t hit_count);
+
+    /*!
+      Add the hits of all the glyphs of another
+      GlyphUsageProfile to this GlyphUsageProfile,
+      as if by add_glyph().
+      \param obj GlyphUsageProfile whose glyphs to add
+     */
+    void
+    merge(const GlyphUsageProfile &obj);
+
+    /*!
+      Returns the entries of this GlyphUsageProfile sorted by
+      decreasing hit count, i.e. in the order in which to
+      generate the glyphs. The returned value is only valid
+      until this GlyphUsageProfile is modified.
+     */
+    const_c_array<Entry>
+    entries(void) const;
+
+    /*!
+      Returns the number of glyphs of this GlyphUsageProfile.
+     */
+    unsigned int
+    number_entries(void) const;
+
+    /*!
+      Remove all glyphs from this GlyphUsageProfile.
+     */
+    void
+    clear(void);
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
@@ -0,0 +1,309 @@
+/*!
+ * \file text_layout.hpp
+ * \brief file text_layout.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/text/font_properties.hpp>
+#include <fastuidraw/text/glyph.hpp>
+#include <fastuidraw/text/glyph_selector.hpp>
+#include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/painter_attribute_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    A TextLayout lays out a block of text for drawing. The
+    text is a sequence of characters (given as UTF-8) where
+    each character has a style, a FontProperties and a pixel
+    size; the text is added as runs of characters of the
+    same style. The character '\\n' starts a new line and
+    a line longer than max_line_width() is broken at spaces
+    (or, if a word does not fit on a line by itself, within
+    the word). Glyphs are fetched from a GlyphSelector with
+    font merging and are positioned with the kerning of their
+    font (see FontBase::kerning()).
+
+    Layout is done lazily, i.e. on the first query after the
+    text is changed, and is incremental: the text is held as
+    paragraphs (the text between '\\n' characters) and only
+    the paragraphs that an edit touches are laid out again.
+    Within a paragraph, the glyphs and advances of each word
+    are cached by the word's characters and style, so that
+    laying out a paragraph again only fetches glyphs for
+    the words that changed.
+
+    The glyphs of the layout reference the GlyphCache of the
+    GlyphSelector; if GlyphCache::clear_cache() is called,
+    then clear_word_cache() must also be called. As with
+    any PainterAttributeData holding glyphs, the data filled
+    by fill_attribute_data() needs to be filled again after
+    the glyphs are removed from the GlyphAtlas, which
+    attribute_data_evicted() reports.
+
+    The methods of a TextLayout are not thread safe.
+   */
+  class TextLayout:public reference_counted<TextLayout>::default_base
+  {
+  public:
+    /*!
+      Ctor.
+      \param glyph_selector GlyphSelector from which to fetch glyphs
+      \param render specifies the glyph type; if the type is
+                    \ref coverage_glyph, the glyphs of a run are
+                    rendered at the pixel size of the run
+      \param orientation orientation of the y-coordinate, for
+                         both the layout is such that the top
+                         left corner of the text is at the origin
+     */
+    TextLayout(const reference_counted_ptr<GlyphSelector> &glyph_selector,
+               GlyphRender render,
+               enum PainterEnums::glyph_orientation orientation
+               = PainterEnums::y_increases_downwards);
+
+    ~TextLayout();
+
+    /*!
+      Returns the GlyphSelector passed in the ctor.
+     */
+    const reference_counted_ptr<GlyphSelector>&
+    glyph_selector(void) const;
+
+    /*!
+      Returns the GlyphRender passed in the ctor.
+     */
+    GlyphRender
+    glyph_render(void) const;
+
+    /*!
+      Returns the orientation passed in the ctor.
+     */
+    enum PainterEnums::glyph_orientation
+    orientation(void) const;
+
+    /*!
+      Set the width at which lines are broken. A value
+      that is zero or negative indicates that lines are
+      only broken at '\\n'. Default value is 0.
+      \param v value
+     */
+    TextLayout&
+    max_line_width(float v);
+
+    /*!
+      Returns the value set by max_line_width(float).
+     */
+    float
+    max_line_width(void) const;
+
+    /*!
+      Set the space added between consecutive lines, in
+      addition to the line height of the fonts of the lines.
+      Default value is 0.
+      \param v value
+     */
+    TextLayout&
+    line_spacing(float v);
+
+    /*!
+      Returns the value set by line_spacing(float).
+     */
+    float
+    line_spacing(void) const;
+
+    /*!
+      Set if kerning is applied between glyphs of the
+      same font. Default value is true.
+      \param v value
+     */
+    TextLayout&
+    kerning(bool v);
+
+    /*!
+      Returns the value set by kerning(bool).
+     */
+    bool
+    kerning(void) const;
+
+    /*!
+      Add characters to the end of the text.
+      \param utf8_begin pointer to first byte of UTF-8 text
+      \param utf8_end pointer to one past the last byte of UTF-8 text
+      \param props FontProperties to select the font of the characters
+      \param pixel_size pixel size of the characters
+     */
+    void
+    append(const char *utf8_begin, const char *utf8_end,
+           const FontProperties &props, float pixel_size);
+
+    /*!
+      Add characters to the end of the text.
+      \param utf8 UTF-8 text, terminated by a 0
+      \param props FontProperties to select the font of the characters
+      \param pixel_size pixel size of the characters
+     */
+    void
+    append(const char *utf8, const FontProperties &props, float pixel_size);
+
+    /*!
+      Insert characters into the text.
+      \param location character location at which to insert the
+                      characters, values greater than number_characters()
+                      are clamped to number_characters()
+      \param utf8_begin pointer to first byte of UTF-8 text
+      \param utf8_end pointer to one past the last byte of UTF-8 text
+      \param props FontProperties to select the font of the characters
+      \param pixel_size pixel size of the characters
+     */
+    void
+    insert(unsigned int location,
+           const char *utf8_begin, const char *utf8_end,
+           const FontProperties &props, float pixel_size);
+
+    /*!
+      Insert characters into the text.
+      \param location character location at which to insert the
+                      characters, values greater than number_characters()
+                      are clamped to number_characters()
+      \param utf8 UTF-8 text, terminated by a 0
+      \param props FontProperties to select the font of the characters
+      \param pixel_size pixel size of the characters
+     */
+    void
+    insert(unsigned int location, const char *utf8,
+           const FontProperties &props, float pixel_size);
+
+    /*!
+      Remove characters from the text.
+      \param location character location of the first character to remove
+      \param count number of characters to remove
+     */
+    void
+    erase(unsigned int location, unsigned int count);
+
+    /*!
+      Change the style of characters of the text.
+      \param location character location of the first character to change
+      \param count number of characters to change
+      \param props FontProperties to select the font of the characters
+      \param pixel_size pixel size of the characters
+     */
+    void
+    set_style(unsigned int location, unsigned int count,
+              const FontProperties &props, float pixel_size);
+
+    /*!
+      Remove all characters.
+     */
+    void
+    clear(void);
+
+    /*!
+      Returns the number of characters of the text,
+      including the '\\n' characters.
+     */
+    unsigned int
+    number_characters(void) const;
+
+    /*!
+      Returns the number of lines of the layout.
+     */
+    unsigned int
+    number_lines(void) const;
+
+    /*!
+      Returns the width of the widest line and the
+      distance from the top of the first line to the
+      bottom of the last line.
+     */
+    vec2
+    dimensions(void) const;
+
+    /*!
+      Returns the glyphs to draw; spaces, '\\n' and
+      characters for which no font has a glyph do
+      not have a glyph.
+     */
+    const_c_array<Glyph>
+    glyphs(void) const;
+
+    /*!
+      Returns the position of each glyph of glyphs() as
+      taken by PainterAttributeDataFillerGlyphs.
+     */
+    const_c_array<vec2>
+    glyph_positions(void) const;
+
+    /*!
+      Returns the scale factor of each glyph of glyphs() as
+      taken by PainterAttributeDataFillerGlyphs.
+     */
+    const_c_array<float>
+    glyph_scale_factors(void) const;
+
+    /*!
+      Returns the character location of each glyph of glyphs().
+     */
+    const_c_array<unsigned int>
+    glyph_character_locations(void) const;
+
+    /*!
+      Set the data of a PainterAttributeData to draw the
+      text with PainterAttributeDataFillerGlyphs. Returns
+      the value of PainterAttributeDataFillerGlyphs::number_glyphs().
+      \param dst PainterAttributeData to which to set the data
+     */
+    unsigned int
+    fill_attribute_data(PainterAttributeData &dst) const;
+
+    /*!
+      Returns true if a glyph of the data set by the last call
+      to fill_attribute_data() was removed from the GlyphAtlas
+      since that call (see Glyph::upload_generation()), in which
+      case the data needs to be filled again before it is drawn.
+     */
+    bool
+    attribute_data_evicted(void) const;
+
+    /*!
+      Clear the cache of the glyphs and advances of words.
+      Needed if the GlyphCache of glyph_selector() is
+      cleared with GlyphCache::clear_cache().
+     */
+    void
+    clear_word_cache(void);
+
+    /*!
+      Returns the number of words in the cache of the
+      glyphs and advances of words.
+     */
+    unsigned int
+    number_cached_words(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
@@ -64,6 +64,12 @@ namespace
       return m_backing_store.texture();
     }
 
+    const fastuidraw::gl::detail::TextureUploadStats&
+    last_upload_stats(void) const
+    {
+      return m_backing_store.last_upload_stats();
+    }
+
     static
     fastuidraw::ivec3
     store_size(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers);
@@ -132,6 +138,12 @@ namespace
       return m_backing_store.texture();
     }
 
+    const fastuidraw::gl::detail::TextureUploadStats&
+    last_upload_stats(void) const
+    {
+      return m_backing_store.last_upload_stats();
+    }
+
     static
     fastuidraw::ivec3
     store_size(int log2_tile_size,
@@ -207,6 +219,17 @@ namespace
     fastuidraw::gl::ImageAtlasGL::params m_params;
   };
 
+
+  fastuidraw::gl::ImageAtlasGL::upload_stats
+  make_upload_stats(const fastuidraw::gl::detail::TextureUploadStats &stats)
+  {
+    fastuidraw::gl::ImageAtlasGL::upload_stats return_value;
+
+    return_value.m_number_regions = stats.m_number_regions;
+    return_value.m_number_calls = stats.m_number_calls;
+    return_value.m_number_bytes = stats.m_number_bytes;
+    return return_value;
+  }
 } //namespace
 
 
@@ -463,6 +486,26 @@ index_texture(void) const
   return p->texture();
 }
 
+fastuidraw::gl::ImageAtlasGL::upload_stats
+fastuidraw::gl::ImageAtlasGL::
+color_upload_stats(void) const
+{
+  const ColorBackingStoreGL *p;
+  assert(dynamic_cast<const ColorBackingStoreGL*>(color_store().get()));
+  p = static_cast<const ColorBackingStoreGL*>(color_store().get());
+  return make_upload_stats(p->last_upload_stats());
+}
+
+fastuidraw::gl::ImageAtlasGL::upload_stats
+fastuidraw::gl::ImageAtlasGL::
+index_upload_stats(void) const
+{
+  const IndexBackingStoreGL *p;
+  assert(dynamic_cast<const IndexBackingStoreGL*>(index_store().get()));
+  p = static_cast<const IndexBackingStoreGL*>(index_store().get());
+  return make_upload_stats(p->last_upload_stats());
+}
+
 fastuidraw::vecN<fastuidraw::vec2, 2>
 fastuidraw::gl::ImageAtlasGL::
 shader_coords(reference_counted_ptr<Image> image)
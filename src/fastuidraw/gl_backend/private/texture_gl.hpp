@@ -21,6 +21,7 @@
 
 #include <list>
 #include <vector>
+#include <utility>
 #include <algorithm>
 
 #include <fastuidraw/util/c_array.hpp>
@@ -238,9 +239,94 @@ template<size_t N>
 class EntryLocationN
 {
 public:
-  typedef std::pair<EntryLocationN, std::vector<uint8_t> > with_data;
   vecN<int, N> m_location;
   vecN<GLsizei, N> m_size;
+
+  /* returns true if the region rhs is directly after this
+     region along the coordinate 0 and the regions agree on
+     all other coordinates, i.e. the union of the regions is
+     a region.
+   */
+  bool
+  can_append_along_x(const EntryLocationN &rhs) const
+  {
+    if(rhs.m_location[0] != m_location[0] + m_size[0])
+      {
+        return false;
+      }
+    for(size_t i = 1; i < N; ++i)
+      {
+        if(rhs.m_location[i] != m_location[i] || rhs.m_size[i] != m_size[i])
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  /* returns true if the region rhs is directly after this
+     region along the coordinate 1, the regions agree on all
+     other coordinates and are only one texel thick along the
+     coordinates after 1; in that case the texels of the union
+     of the regions are the texels of this region followed by
+     the texels of rhs.
+   */
+  bool
+  can_append_along_y(const EntryLocationN &rhs) const
+  {
+    if(N < 2
+       || rhs.m_location[0] != m_location[0] || rhs.m_size[0] != m_size[0]
+       || rhs.m_location[1] != m_location[1] + m_size[1])
+      {
+        return false;
+      }
+    for(size_t i = 2; i < N; ++i)
+      {
+        if(rhs.m_location[i] != m_location[i] || rhs.m_size[i] != 1 || m_size[i] != 1)
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  /* number of rows of the region, i.e. the product of the
+     size of the region along the coordinates after 0.
+   */
+  unsigned int
+  number_rows(void) const
+  {
+    unsigned int return_value(1);
+    for(size_t i = 1; i < N; ++i)
+      {
+        return_value *= m_size[i];
+      }
+    return return_value;
+  }
+};
+
+/* Counters of the uploads of a TextureGLGeneric issued
+   by a flush() of the TextureGLGeneric.
+ */
+class TextureUploadStats
+{
+public:
+  TextureUploadStats(void):
+    m_number_regions(0),
+    m_number_calls(0),
+    m_number_bytes(0)
+  {}
+
+  /* number of regions set with set_data_vector()
+     and set_data_c_array()
+   */
+  unsigned int m_number_regions;
+
+  /* number of calls to glTexSubImage */
+  unsigned int m_number_calls;
+
+  /* number of bytes uploaded */
+  unsigned int m_number_bytes;
 };
 
 template<GLenum texture_target>
@@ -283,11 +369,45 @@ public:
     m_dims = new_num_layers;
   }
 
+  /* returns the counters of the last flush()
+     that uploaded data to the texture.
+   */
+  const TextureUploadStats&
+  last_upload_stats(void) const
+  {
+    return m_last_upload_stats;
+  }
+
 private:
 
+  /* a region to upload whose texels are at m_offset
+     within m_pending_data.
+   */
+  class PendingUpload
+  {
+  public:
+    EntryLocation m_entry;
+    unsigned int m_offset;
+    unsigned int m_size;
+  };
+
   void
   create_texture(void) const;
 
+  /* add a region to upload at the next flush(), the texels
+     are copied into m_pending_data.
+   */
+  void
+  add_pending_upload(const EntryLocation &loc,
+                     const_c_array<uint8_t> data);
+
+  /* pack the pending uploads into dst, merging pending uploads
+     of adjacent regions, and fill m_merged_uploads with
+     the regions to upload and their offsets into dst.
+   */
+  void
+  pack_pending_uploads(c_array<uint8_t> dst);
+
   void
   tex_subimage(const EntryLocation &loc,
                const_c_array<uint8_t> data);
@@ -305,13 +425,23 @@ private:
   vecN<int, N> m_texture_dimension;
   mutable GLuint m_texture;
   mutable bool m_use_tex_storage;
+  mutable bool m_use_pixel_buffer;
   mutable int m_number_times_create_texture_called;
   CopyImageSubData m_blitter;
 
-  typedef typename EntryLocation::with_data with_data;
-  typedef std::list<with_data> list_type;
-
-  list_type m_unflushed_commands;
+  /* The regions set since the last flush() and their texels;
+     the texels are held in a single array whose capacity is
+     kept across flushes. At flush(), the texels are packed
+     into a pixel unpack buffer (or m_staging if pixel buffers
+     are not supported) with the texels of adjacent regions
+     merged so that they are uploaded with one call.
+   */
+  std::vector<PendingUpload> m_pending_uploads;
+  std::vector<uint8_t> m_pending_data;
+  std::vector<std::pair<EntryLocation, unsigned int> > m_merged_uploads;
+  std::vector<uint8_t> m_staging;
+  GLuint m_pixel_buffer;
+  TextureUploadStats m_last_upload_stats;
 };
 
 ///////////////////////////////////////
@@ -330,7 +460,9 @@ TextureGLGeneric(GLenum internal_format,
   m_delayed(delayed),
   m_dims(dims),
   m_texture(0),
-  m_number_times_create_texture_called(0)
+  m_use_pixel_buffer(false),
+  m_number_times_create_texture_called(0),
+  m_pixel_buffer(0)
 {
   if(!m_delayed)
     {
@@ -347,6 +479,11 @@ TextureGLGeneric<texture_target>::
     {
       delete_texture();
     }
+
+  if(m_pixel_buffer != 0)
+    {
+      glDeleteBuffers(1, &m_pixel_buffer);
+    }
 }
 
 template<GLenum texture_target>
@@ -449,6 +586,9 @@ create_texture(void) const
       ContextProperties ctx;
       m_use_tex_storage = ctx.is_es() || ctx.version() >= ivec2(4, 2)
         || ctx.has_extension("GL_ARB_texture_storage");
+      m_use_pixel_buffer = ctx.is_es() ?
+        ctx.version() >= ivec2(3, 0) :
+        ctx.version() >= ivec2(2, 1) || ctx.has_extension("GL_ARB_pixel_buffer_object");
     }
   tex_storage(m_use_tex_storage, texture_target, m_internal_format, m_dims);
   glTexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, m_filter);
@@ -457,6 +597,64 @@ create_texture(void) const
 }
 
 
+template<GLenum texture_target>
+void
+TextureGLGeneric<texture_target>::
+pack_pending_uploads(c_array<uint8_t> dst)
+{
+  unsigned int current(0);
+
+  m_merged_uploads.clear();
+  for(unsigned int i = 0, j = 0, endi = m_pending_uploads.size(); i < endi; i = j)
+    {
+      EntryLocation R(m_pending_uploads[i].m_entry);
+      unsigned int number_rows, row_begin, run_offset;
+
+      /* find the run [i, j) of consecutive regions each directly
+         after the previous one along x; only consecutive regions
+         are merged so that uploads to overlapping regions still
+         land in the order in which they were set.
+       */
+      for(j = i + 1; j < endi && R.can_append_along_x(m_pending_uploads[j].m_entry); ++j)
+        {
+          R.m_size[0] += m_pending_uploads[j].m_entry.m_size[0];
+        }
+
+      /* interleave the rows of the regions of the run */
+      run_offset = current;
+      number_rows = R.number_rows();
+      for(unsigned int row = 0; row < number_rows; ++row)
+        {
+          for(unsigned int k = i; k < j; ++k)
+            {
+              const PendingUpload &P(m_pending_uploads[k]);
+              unsigned int row_size;
+
+              row_size = P.m_size / number_rows;
+              row_begin = P.m_offset + row * row_size;
+              std::copy(m_pending_data.begin() + row_begin,
+                        m_pending_data.begin() + row_begin + row_size,
+                        dst.begin() + current);
+              current += row_size;
+            }
+        }
+
+      /* the texels of a run directly after the previous run
+         along y follow the texels of the previous run, so the
+         two runs are uploaded together.
+       */
+      if(!m_merged_uploads.empty() && m_merged_uploads.back().first.can_append_along_y(R))
+        {
+          m_merged_uploads.back().first.m_size[1] += R.m_size[1];
+        }
+      else
+        {
+          m_merged_uploads.push_back(std::make_pair(R, run_offset));
+        }
+    }
+  assert(current == dst.size());
+}
+
 template<GLenum texture_target>
 void
 TextureGLGeneric<texture_target>::
@@ -468,24 +666,107 @@ flush(void)
       create_texture();
     }
 
-  if(!m_unflushed_commands.empty())
+  if(!m_pending_uploads.empty())
     {
+      c_array<uint8_t> dst;
+      const uint8_t *src_base(NULL);
+
+      if(m_use_pixel_buffer)
+        {
+          void *mapped;
+
+          if(m_pixel_buffer == 0)
+            {
+              glGenBuffers(1, &m_pixel_buffer);
+              assert(m_pixel_buffer != 0);
+            }
+
+          /* orphan the previous storage of the buffer so that
+             the GL implementation need not wait for the uploads
+             of the previous flush to complete before the buffer
+             is written to.
+           */
+          glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixel_buffer);
+          glBufferData(GL_PIXEL_UNPACK_BUFFER, m_pending_data.size(), NULL, GL_STREAM_DRAW);
+          mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, m_pending_data.size(),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+          if(mapped != NULL)
+            {
+              dst = c_array<uint8_t>(static_cast<uint8_t*>(mapped), m_pending_data.size());
+              pack_pending_uploads(dst);
+              if(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_TRUE)
+                {
+                  /* the contents of the buffer were lost,
+                     upload from client memory instead.
+                   */
+                  dst = c_array<uint8_t>();
+                }
+            }
+
+          if(dst.empty())
+            {
+              glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+        }
+
+      if(dst.empty())
+        {
+          m_staging.resize(m_pending_data.size());
+          dst = c_array<uint8_t>(&m_staging[0], m_staging.size());
+          pack_pending_uploads(dst);
+          src_base = &m_staging[0];
+        }
+
       glBindTexture(texture_target, m_texture);
       glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-      for(typename list_type::iterator iter = m_unflushed_commands.begin(),
-            end = m_unflushed_commands.end(); iter != end; ++iter)
+      for(unsigned int i = 0, endi = m_merged_uploads.size(); i < endi; ++i)
         {
-          assert(!iter->second.empty());
+          const void *pixels;
+
+          /* with a pixel unpack buffer bound, the pixels
+             pointer is an offset into the buffer.
+           */
+          pixels = (src_base != NULL) ?
+            static_cast<const void*>(src_base + m_merged_uploads[i].second) :
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(m_merged_uploads[i].second));
+
           tex_sub_image(texture_target,
-                        iter->first.m_location,
-                        iter->first.m_size,
+                        m_merged_uploads[i].first.m_location,
+                        m_merged_uploads[i].first.m_size,
                         m_external_format, m_external_type,
-                        &iter->second[0]);
+                        pixels);
         }
-      m_unflushed_commands.clear();
+
+      if(src_base == NULL)
+        {
+          glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+      m_last_upload_stats.m_number_regions = m_pending_uploads.size();
+      m_last_upload_stats.m_number_calls = m_merged_uploads.size();
+      m_last_upload_stats.m_number_bytes = m_pending_data.size();
+
+      m_pending_uploads.clear();
+      m_pending_data.clear();
     }
 }
 
+template<GLenum texture_target>
+void
+TextureGLGeneric<texture_target>::
+add_pending_upload(const EntryLocation &loc,
+                   const_c_array<uint8_t> data)
+{
+  PendingUpload P;
+
+  P.m_entry = loc;
+  P.m_offset = m_pending_data.size();
+  P.m_size = data.size();
+  assert(P.m_size % loc.number_rows() == 0);
+
+  m_pending_uploads.push_back(P);
+  m_pending_data.insert(m_pending_data.end(), data.begin(), data.end());
+}
 
 template<GLenum texture_target>
 void
@@ -498,24 +779,7 @@ set_data_vector(const EntryLocation &loc,
       return;
     }
 
-  if(m_delayed)
-    {
-      m_unflushed_commands.push_back(typename EntryLocation::with_data());
-      typename EntryLocation::with_data &R(m_unflushed_commands.back());
-      R.first = loc;
-      R.second.swap(data);
-    }
-  else
-    {
-      flush_size_change();
-      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-      glBindTexture(texture_target, m_texture);
-      tex_sub_image(texture_target,
-                    loc.m_location,
-                    loc.m_size,
-                    m_external_format, m_external_type,
-                    &data[0]);
-    }
+  set_data_c_array(loc, const_c_array<uint8_t>(&data[0], data.size()));
 }
 
 template<GLenum texture_target>
@@ -531,10 +795,7 @@ set_data_c_array(const EntryLocation &loc,
 
   if(m_delayed)
     {
-      std::vector<uint8_t> data_copy;
-      data_copy.resize(data.size());
-      std::copy(data.begin(), data.end(), data_copy.begin());
-      set_data_vector(loc, data_copy);
+      add_pending_upload(loc, data);
     }
   else
     {
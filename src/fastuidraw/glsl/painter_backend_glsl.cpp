@@ -346,6 +346,12 @@ ready_brush_varyings(void)
                                      coordinate goes beyond image size)
        - fastuidraw_brush_image_factor ratio of master index tile size to
                                        dimension of image
+       - fastuidraw_brush_image_master (x,y) texel coordinate in INDEX texture
+                                       of the master index tile, i.e. of the
+                                       mipmap level 0 of the image
+       - fastuidraw_brush_image_level0_size size of the mipmap level 0 of the
+                                            image (needed to locate the other
+                                            mipmap levels of the image)
     */
     .add_float_varying("fastuidraw_brush_image_x", varying_list::interpolation_flat)
     .add_float_varying("fastuidraw_brush_image_y", varying_list::interpolation_flat)
@@ -353,6 +359,10 @@ ready_brush_varyings(void)
     .add_float_varying("fastuidraw_brush_image_size_x", varying_list::interpolation_flat)
     .add_float_varying("fastuidraw_brush_image_size_y", varying_list::interpolation_flat)
     .add_float_varying("fastuidraw_brush_image_factor", varying_list::interpolation_flat)
+    .add_float_varying("fastuidraw_brush_image_master_x", varying_list::interpolation_flat)
+    .add_float_varying("fastuidraw_brush_image_master_y", varying_list::interpolation_flat)
+    .add_float_varying("fastuidraw_brush_image_level0_size_x", varying_list::interpolation_flat)
+    .add_float_varying("fastuidraw_brush_image_level0_size_y", varying_list::interpolation_flat)
 
     /* ColorStop paremeters (only active if gradient active)
        - fastuidraw_brush_color_stop_xy (x,y) texture coordinates of start of color stop
@@ -444,6 +454,8 @@ add_enums(fastuidraw::glsl::ShaderSource &src)
     .add_macro("fastuidraw_image_number_index_lookup_num_bits", PainterBrush::image_number_index_lookups_num_bits)
     .add_macro("fastuidraw_image_slack_bit0", PainterBrush::image_slack_bit0)
     .add_macro("fastuidraw_image_slack_num_bits", PainterBrush::image_slack_num_bits)
+    .add_macro("fastuidraw_image_number_mipmap_levels_bit0", PainterBrush::image_number_mipmap_levels_bit0)
+    .add_macro("fastuidraw_image_number_mipmap_levels_num_bits", PainterBrush::image_number_mipmap_levels_num_bits)
     .add_macro("fastuidraw_image_master_index_x_bit0",     PainterBrush::image_atlas_location_x_bit0)
     .add_macro("fastuidraw_image_master_index_x_num_bits", PainterBrush::image_atlas_location_x_num_bits)
     .add_macro("fastuidraw_image_master_index_y_bit0",     PainterBrush::image_atlas_location_y_bit0)
@@ -561,6 +573,7 @@ stream_unpack_code(fastuidraw::glsl::ShaderSource &str)
       .set(PainterBrush::image_atlas_location_xyz_offset, ".image_atlas_location_xyz", shader_unpack_value::uint_type)
       .set(PainterBrush::image_size_xy_offset, ".image_size_xy", shader_unpack_value::uint_type)
       .set(PainterBrush::image_start_xy_offset, ".image_start_xy", shader_unpack_value::uint_type)
+      .set(PainterBrush::image_level0_size_xy_offset, ".image_level0_size_xy", shader_unpack_value::uint_type)
       .stream_unpack_function(alignment, str,
                               "fastuidraw_read_brush_image_raw_data",
                               "fastuidraw_brush_image_data_raw");
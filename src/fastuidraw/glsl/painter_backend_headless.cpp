@@ -0,0 +1,698 @@
+/*!
+ * \file painter_backend_headless.cpp
+ * \brief file painter_backend_headless.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/glsl/painter_backend_headless.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* Copies a rectangle of values into a layered 2D array
+     stored in a std::vector.
+   */
+  template<typename T>
+  void
+  copy_rect(std::vector<T> &dst, fastuidraw::ivec3 dims,
+            int x, int y, int l, int w, int h,
+            fastuidraw::const_c_array<T> src)
+  {
+    assert(x >= 0 && x + w <= dims.x());
+    assert(y >= 0 && y + h <= dims.y());
+    assert(l >= 0 && l < dims.z());
+    assert(src.size() >= static_cast<unsigned int>(w * h));
+
+    for(int r = 0; r < h; ++r)
+      {
+        unsigned int dst_offset, src_offset;
+
+        dst_offset = x + (y + r) * dims.x() + l * dims.x() * dims.y();
+        src_offset = r * w;
+        std::copy(src.begin() + src_offset, src.begin() + src_offset + w,
+                  dst.begin() + dst_offset);
+      }
+  }
+
+  class TexelStoreMemory:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    explicit
+    TexelStoreMemory(fastuidraw::ivec3 dims):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(dims, true),
+      m_data(dims.x() * dims.y() * dims.z(), 0)
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<uint8_t> data)
+    {
+      copy_rect(m_data, dimensions(), x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_data.resize(dimensions().x() * dimensions().y() * new_num_layers, 0);
+    }
+
+  private:
+    std::vector<uint8_t> m_data;
+  };
+
+  class GeometryStoreMemory:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    GeometryStoreMemory(unsigned int alignment, unsigned int size):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(alignment, size, true),
+      m_data(alignment * size)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int location,
+               fastuidraw::const_c_array<fastuidraw::generic_data> pdata)
+    {
+      unsigned int offset(location * alignment());
+      assert(offset + pdata.size() <= m_data.size());
+      std::copy(pdata.begin(), pdata.end(), m_data.begin() + offset);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(unsigned int new_size)
+    {
+      m_data.resize(new_size * alignment());
+    }
+
+  private:
+    std::vector<fastuidraw::generic_data> m_data;
+  };
+
+  class ColorStoreMemory:public fastuidraw::AtlasColorBackingStoreBase
+  {
+  public:
+    explicit
+    ColorStoreMemory(fastuidraw::ivec3 dims):
+      fastuidraw::AtlasColorBackingStoreBase(dims, true),
+      m_data(dims.x() * dims.y() * dims.z())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+    {
+      copy_rect(m_data, dimensions(), x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_data.resize(dimensions().x() * dimensions().y() * new_num_layers);
+    }
+
+  private:
+    std::vector<fastuidraw::u8vec4> m_data;
+  };
+
+  class IndexStoreMemory:public fastuidraw::AtlasIndexBackingStoreBase
+  {
+  public:
+    explicit
+    IndexStoreMemory(fastuidraw::ivec3 dims):
+      fastuidraw::AtlasIndexBackingStoreBase(dims, true),
+      m_data(dims.x() * dims.y() * dims.z())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::ivec3> data,
+             int slack,
+             const fastuidraw::AtlasColorBackingStoreBase *c,
+             int color_tile_size)
+    {
+      FASTUIDRAWunused(slack);
+      FASTUIDRAWunused(c);
+      FASTUIDRAWunused(color_tile_size);
+      copy_rect(m_data, dimensions(), x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::ivec3> data)
+    {
+      copy_rect(m_data, dimensions(), x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_data.resize(dimensions().x() * dimensions().y() * new_num_layers);
+    }
+
+  private:
+    std::vector<fastuidraw::ivec3> m_data;
+  };
+
+  class ColorStopStoreMemory:public fastuidraw::ColorStopBackingStore
+  {
+  public:
+    explicit
+    ColorStopStoreMemory(fastuidraw::ivec2 dims):
+      fastuidraw::ColorStopBackingStore(dims, true),
+      m_data(dims.x() * dims.y())
+    {}
+
+    virtual
+    void
+    set_data(int x, int l, int w,
+             fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+    {
+      assert(x >= 0 && x + w <= dimensions().x());
+      assert(l >= 0 && l < dimensions().y());
+      std::copy(data.begin(), data.begin() + w,
+                m_data.begin() + x + l * dimensions().x());
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_data.resize(dimensions().x() * new_num_layers);
+    }
+
+  private:
+    std::vector<fastuidraw::u8vec4> m_data;
+  };
+
+  class ConfigurationHeadlessPrivate
+  {
+  public:
+    ConfigurationHeadlessPrivate(void):
+      m_attributes_per_buffer(512 * 512),
+      m_indices_per_buffer((m_attributes_per_buffer * 6) / 4),
+      m_data_blocks_per_store_buffer(1024 * 64),
+      m_break_on_shader_change(false)
+    {}
+
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> m_image_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas> m_colorstop_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_glyph_atlas;
+    unsigned int m_attributes_per_buffer;
+    unsigned int m_indices_per_buffer;
+    unsigned int m_data_blocks_per_store_buffer;
+    bool m_break_on_shader_change;
+  };
+
+  /* The buffers of a DrawCommand; the buffers are recycled
+     so that mapping a PainterDraw does not allocate memory
+     every time.
+   */
+  class DrawBuffers
+  {
+  public:
+    DrawBuffers(unsigned int num_attributes,
+                unsigned int num_indices,
+                unsigned int num_store):
+      m_attributes(num_attributes),
+      m_header_attributes(num_attributes),
+      m_indices(num_indices),
+      m_store(num_store)
+    {}
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+  };
+
+  class PainterBackendHeadlessPrivate
+  {
+  public:
+    typedef fastuidraw::glsl::PainterBackendHeadless PainterBackendHeadless;
+    typedef fastuidraw::vecN<uint64_t, PainterBackendHeadless::number_counters> counter_values;
+
+    PainterBackendHeadlessPrivate(const PainterBackendHeadless::ConfigurationHeadless &P,
+                                  const fastuidraw::PainterBackend::ConfigurationBase &config_base);
+
+    ~PainterBackendHeadlessPrivate();
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+    compute_glyph_atlas(const PainterBackendHeadless::ConfigurationHeadless &P);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+    compute_image_atlas(const PainterBackendHeadless::ConfigurationHeadless &P);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+    compute_colorstop_atlas(const PainterBackendHeadless::ConfigurationHeadless &P);
+
+    DrawBuffers*
+    acquire_buffers(void);
+
+    void
+    release_buffers(DrawBuffers *b);
+
+    void
+    increment(enum PainterBackendHeadless::counter_t tp, uint64_t v)
+    {
+      m_current[tp] += v;
+    }
+
+    PainterBackendHeadless::ConfigurationHeadless m_params;
+    unsigned int m_store_size;
+    std::vector<DrawBuffers*> m_free_buffers;
+
+    counter_values m_current, m_last_frame, m_total;
+  };
+
+  class DrawCommand:public fastuidraw::PainterDraw
+  {
+  public:
+    explicit
+    DrawCommand(PainterBackendHeadlessPrivate *pr);
+
+    virtual
+    ~DrawCommand();
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+               const fastuidraw::PainterShaderGroup &new_shaders,
+               unsigned int attributes_written, unsigned int indices_written) const;
+
+    virtual
+    void
+    draw(void) const;
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int attributes_written,
+                    unsigned int indices_written,
+                    unsigned int data_store_written) const;
+
+  private:
+    PainterBackendHeadlessPrivate *m_pr;
+    DrawBuffers *m_buffers;
+    mutable unsigned int m_number_breaks;
+  };
+}
+
+///////////////////////////////////////////
+// PainterBackendHeadlessPrivate methods
+PainterBackendHeadlessPrivate::
+PainterBackendHeadlessPrivate(const PainterBackendHeadless::ConfigurationHeadless &P,
+                              const fastuidraw::PainterBackend::ConfigurationBase &config_base):
+  m_params(P),
+  m_store_size(P.data_blocks_per_store_buffer() * config_base.alignment()),
+  m_current(0),
+  m_last_frame(0),
+  m_total(0)
+{
+}
+
+PainterBackendHeadlessPrivate::
+~PainterBackendHeadlessPrivate()
+{
+  for(std::vector<DrawBuffers*>::iterator iter = m_free_buffers.begin(),
+        end = m_free_buffers.end(); iter != end; ++iter)
+    {
+      FASTUIDRAWdelete(*iter);
+    }
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+PainterBackendHeadlessPrivate::
+compute_glyph_atlas(const PainterBackendHeadless::ConfigurationHeadless &P)
+{
+  if(P.glyph_atlas())
+    {
+      return P.glyph_atlas();
+    }
+
+  fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase> texels;
+  fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> geometry;
+
+  texels = FASTUIDRAWnew TexelStoreMemory(fastuidraw::ivec3(1024, 1024, 1));
+  geometry = FASTUIDRAWnew GeometryStoreMemory(4, 1024 * 64);
+  return FASTUIDRAWnew fastuidraw::GlyphAtlas(texels, geometry);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+PainterBackendHeadlessPrivate::
+compute_image_atlas(const PainterBackendHeadless::ConfigurationHeadless &P)
+{
+  if(P.image_atlas())
+    {
+      return P.image_atlas();
+    }
+
+  /* same tile sizes as the default of gl::ImageAtlasGL, but
+     with fewer tiles per layer to keep memory usage modest.
+   */
+  const int color_tile_size(32), index_tile_size(4);
+  fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase> color;
+  fastuidraw::reference_counted_ptr<fastuidraw::AtlasIndexBackingStoreBase> index;
+
+  color = FASTUIDRAWnew ColorStoreMemory(fastuidraw::ivec3(32 * color_tile_size, 32 * color_tile_size, 1));
+  index = FASTUIDRAWnew IndexStoreMemory(fastuidraw::ivec3(64 * index_tile_size, 64 * index_tile_size, 4));
+  return FASTUIDRAWnew fastuidraw::ImageAtlas(color_tile_size, index_tile_size, color, index);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+PainterBackendHeadlessPrivate::
+compute_colorstop_atlas(const PainterBackendHeadless::ConfigurationHeadless &P)
+{
+  if(P.colorstop_atlas())
+    {
+      return P.colorstop_atlas();
+    }
+
+  fastuidraw::reference_counted_ptr<fastuidraw::ColorStopBackingStore> store;
+  store = FASTUIDRAWnew ColorStopStoreMemory(fastuidraw::ivec2(1024, 32));
+  return FASTUIDRAWnew fastuidraw::ColorStopAtlas(store);
+}
+
+DrawBuffers*
+PainterBackendHeadlessPrivate::
+acquire_buffers(void)
+{
+  DrawBuffers *return_value;
+  if(m_free_buffers.empty())
+    {
+      return_value = FASTUIDRAWnew DrawBuffers(m_params.attributes_per_buffer(),
+                                               m_params.indices_per_buffer(),
+                                               m_store_size);
+    }
+  else
+    {
+      return_value = m_free_buffers.back();
+      m_free_buffers.pop_back();
+    }
+  return return_value;
+}
+
+void
+PainterBackendHeadlessPrivate::
+release_buffers(DrawBuffers *b)
+{
+  m_free_buffers.push_back(b);
+}
+
+///////////////////////////////////////////
+// DrawCommand methods
+DrawCommand::
+DrawCommand(PainterBackendHeadlessPrivate *pr):
+  m_pr(pr),
+  m_number_breaks(0)
+{
+  m_buffers = m_pr->acquire_buffers();
+  m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+  m_store = fastuidraw::make_c_array(m_buffers->m_store);
+  m_pr->increment(fastuidraw::glsl::PainterBackendHeadless::draws_mapped_counter, 1);
+}
+
+DrawCommand::
+~DrawCommand()
+{
+  m_pr->release_buffers(m_buffers);
+}
+
+void
+DrawCommand::
+draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+           const fastuidraw::PainterShaderGroup &new_shaders,
+           unsigned int attributes_written, unsigned int indices_written) const
+{
+  FASTUIDRAWunused(old_shaders);
+  FASTUIDRAWunused(new_shaders);
+  FASTUIDRAWunused(attributes_written);
+  FASTUIDRAWunused(indices_written);
+
+  ++m_number_breaks;
+  m_pr->increment(fastuidraw::glsl::PainterBackendHeadless::draw_breaks_counter, 1);
+}
+
+void
+DrawCommand::
+draw(void) const
+{
+  m_pr->increment(fastuidraw::glsl::PainterBackendHeadless::draw_calls_counter, m_number_breaks + 1);
+}
+
+void
+DrawCommand::
+unmap_implement(unsigned int attributes_written,
+                unsigned int indices_written,
+                unsigned int data_store_written) const
+{
+  using namespace fastuidraw;
+  uint64_t bytes;
+
+  bytes = attributes_written * (sizeof(PainterAttribute) + sizeof(uint32_t))
+    + indices_written * sizeof(PainterIndex)
+    + data_store_written * sizeof(generic_data);
+
+  m_pr->increment(glsl::PainterBackendHeadless::attributes_written_counter, attributes_written);
+  m_pr->increment(glsl::PainterBackendHeadless::indices_written_counter, indices_written);
+  m_pr->increment(glsl::PainterBackendHeadless::store_written_counter, data_store_written);
+  m_pr->increment(glsl::PainterBackendHeadless::bytes_written_counter, bytes);
+}
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless methods
+fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::
+ConfigurationHeadless(void)
+{
+  m_d = FASTUIDRAWnew ConfigurationHeadlessPrivate();
+}
+
+fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::
+ConfigurationHeadless(const ConfigurationHeadless &obj)
+{
+  ConfigurationHeadlessPrivate *d;
+  d = reinterpret_cast<ConfigurationHeadlessPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ConfigurationHeadlessPrivate(*d);
+}
+
+fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::
+~ConfigurationHeadless()
+{
+  ConfigurationHeadlessPrivate *d;
+  d = reinterpret_cast<ConfigurationHeadlessPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless&
+fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::
+operator=(const ConfigurationHeadless &rhs)
+{
+  if(this != &rhs)
+    {
+      ConfigurationHeadlessPrivate *d, *rhs_d;
+      d = reinterpret_cast<ConfigurationHeadlessPrivate*>(m_d);
+      rhs_d = reinterpret_cast<ConfigurationHeadlessPrivate*>(rhs.m_d);
+      *d = *rhs_d;
+    }
+  return *this;
+}
+
+#define setget_implement(type, name)                                    \
+  fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless&      \
+  fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::     \
+  name(type v)                                                          \
+  {                                                                     \
+    ConfigurationHeadlessPrivate *d;                                    \
+    d = reinterpret_cast<ConfigurationHeadlessPrivate*>(m_d);           \
+    d->m_##name = v;                                                    \
+    return *this;                                                       \
+  }                                                                     \
+                                                                        \
+  type                                                                  \
+  fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless::     \
+  name(void) const                                                      \
+  {                                                                     \
+    ConfigurationHeadlessPrivate *d;                                    \
+    d = reinterpret_cast<ConfigurationHeadlessPrivate*>(m_d);           \
+    return d->m_##name;                                                 \
+  }
+
+setget_implement(unsigned int, attributes_per_buffer)
+setget_implement(unsigned int, indices_per_buffer)
+setget_implement(unsigned int, data_blocks_per_store_buffer)
+setget_implement(bool, break_on_shader_change)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>&, image_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>&, colorstop_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&, glyph_atlas)
+
+#undef setget_implement
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendHeadless methods
+fastuidraw::glsl::PainterBackendHeadless::
+PainterBackendHeadless(const ConfigurationHeadless &config_headless,
+                       const ConfigurationBase &config_base,
+                       const ConfigurationGLSL &config_glsl):
+  PainterBackendGLSL(PainterBackendHeadlessPrivate::compute_glyph_atlas(config_headless),
+                     PainterBackendHeadlessPrivate::compute_image_atlas(config_headless),
+                     PainterBackendHeadlessPrivate::compute_colorstop_atlas(config_headless),
+                     config_glsl, config_base)
+{
+  m_d = FASTUIDRAWnew PainterBackendHeadlessPrivate(config_headless, config_base);
+}
+
+fastuidraw::glsl::PainterBackendHeadless::
+~PainterBackendHeadless()
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+const fastuidraw::glsl::PainterBackendHeadless::ConfigurationHeadless&
+fastuidraw::glsl::PainterBackendHeadless::
+configuration_headless(void) const
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  return d->m_params;
+}
+
+uint64_t
+fastuidraw::glsl::PainterBackendHeadless::
+counter(enum counter_t tp) const
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  assert(tp < number_counters);
+  return d->m_last_frame[tp];
+}
+
+uint64_t
+fastuidraw::glsl::PainterBackendHeadless::
+total_counter(enum counter_t tp) const
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  assert(tp < number_counters);
+  return d->m_total[tp];
+}
+
+void
+fastuidraw::glsl::PainterBackendHeadless::
+reset_counters(void)
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  d->m_current = PainterBackendHeadlessPrivate::counter_values(0);
+  d->m_last_frame = PainterBackendHeadlessPrivate::counter_values(0);
+  d->m_total = PainterBackendHeadlessPrivate::counter_values(0);
+}
+
+uint32_t
+fastuidraw::glsl::PainterBackendHeadless::
+compute_item_shader_group(PainterShader::Tag tag,
+                          const reference_counted_ptr<PainterItemShader> &shader)
+{
+  FASTUIDRAWunused(shader);
+  return (configuration_headless().break_on_shader_change()) ? tag.m_ID : 0u;
+}
+
+uint32_t
+fastuidraw::glsl::PainterBackendHeadless::
+compute_blend_shader_group(PainterShader::Tag tag,
+                           const reference_counted_ptr<PainterBlendShader> &shader)
+{
+  FASTUIDRAWunused(shader);
+  return (configuration_headless().break_on_shader_change()) ? tag.m_ID : 0u;
+}
+
+void
+fastuidraw::glsl::PainterBackendHeadless::
+on_pre_draw(void)
+{
+  /* flush the atlases just as a real backend would, so
+     that their cost is part of what is measured.
+   */
+  image_atlas()->flush();
+  glyph_atlas()->flush();
+  colorstop_atlas()->flush();
+}
+
+void
+fastuidraw::glsl::PainterBackendHeadless::
+on_post_draw(void)
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+
+  d->increment(frames_counter, 1);
+  d->m_last_frame = d->m_current;
+  for(unsigned int i = 0; i < number_counters; ++i)
+    {
+      d->m_total[i] += d->m_current[i];
+    }
+  d->m_current = PainterBackendHeadlessPrivate::counter_values(0);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::glsl::PainterBackendHeadless::
+map_draw(void)
+{
+  PainterBackendHeadlessPrivate *d;
+  d = reinterpret_cast<PainterBackendHeadlessPrivate*>(m_d);
+  return FASTUIDRAWnew DrawCommand(d);
+}
@@ -17,6 +17,10 @@
  */
 
 
+#include <map>
+#include <list>
+#include <vector>
+#include <algorithm>
 #include <boost/multi_array.hpp>
 #include <fastuidraw/image.hpp>
 #include "private/util_private.hpp"
@@ -148,6 +152,104 @@ namespace
     return return_value;
   }
 
+  /* 128-bit hash of the texels of a color tile, the two
+     halves are computed with independent hash functions.
+   */
+  typedef std::pair<uint64_t, uint64_t> texel_hash;
+
+  uint64_t
+  rotate_left(uint64_t v, unsigned int r)
+  {
+    return (v << r) | (v >> (64u - r));
+  }
+
+  uint64_t
+  finalize_hash(uint64_t v)
+  {
+    v ^= v >> 33u;
+    v *= 0xFF51AFD7ED558CCDull;
+    v ^= v >> 33u;
+    v *= 0xC4CEB9FE1A85EC53ull;
+    v ^= v >> 33u;
+    return v;
+  }
+
+  texel_hash
+  compute_texel_hash(fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+  {
+    uint64_t h0(0xCBF29CE484222325ull), h1(0x9E3779B97F4A7C15ull ^ data.size());
+
+    for(unsigned int i = 0, endi = data.size(); i < endi; ++i)
+      {
+        uint64_t v;
+
+        v = uint64_t(data[i].x())
+          | (uint64_t(data[i].y()) << 8u)
+          | (uint64_t(data[i].z()) << 16u)
+          | (uint64_t(data[i].w()) << 24u);
+
+        /* FNV-1a on h0 and a round of xxHash64 on h1 */
+        h0 = (h0 ^ v) * 0x100000001B3ull;
+        h1 = rotate_left(h1 + v * 0xC2B2AE3D27D4EB4Full, 31u) * 0x9E3779B185EBCA87ull;
+      }
+    return texel_hash(finalize_hash(h0), finalize_hash(h1));
+  }
+
+  /* compute a mipmap level from the previous mipmap level by
+     averaging 2x2 blocks of texels. The texels are not
+     pre-multiplied by alpha, so the color of each texel is
+     weighted by its alpha; that way the (meaningless) color
+     of transparent texels does not bleed into the level.
+   */
+  void
+  compute_next_mipmap_level(fastuidraw::ivec2 src_dims,
+                            fastuidraw::const_c_array<fastuidraw::u8vec4> src,
+                            fastuidraw::ivec2 dst_dims,
+                            fastuidraw::c_array<fastuidraw::u8vec4> dst)
+  {
+    for(int y = 0; y < dst_dims.y(); ++y)
+      {
+        int y0, y1;
+
+        y0 = std::min(2 * y, src_dims.y() - 1);
+        y1 = std::min(2 * y + 1, src_dims.y() - 1);
+        for(int x = 0; x < dst_dims.x(); ++x)
+          {
+            int x0, x1;
+            fastuidraw::vecN<fastuidraw::u8vec4, 4> block;
+            fastuidraw::uvec4 sum(0u, 0u, 0u, 0u), weighted_sum(0u, 0u, 0u, 0u);
+            fastuidraw::u8vec4 &texel(dst[x + y * dst_dims.x()]);
+
+            x0 = std::min(2 * x, src_dims.x() - 1);
+            x1 = std::min(2 * x + 1, src_dims.x() - 1);
+            block[0] = src[x0 + y0 * src_dims.x()];
+            block[1] = src[x1 + y0 * src_dims.x()];
+            block[2] = src[x0 + y1 * src_dims.x()];
+            block[3] = src[x1 + y1 * src_dims.x()];
+
+            for(unsigned int i = 0; i < 4; ++i)
+              {
+                for(unsigned int c = 0; c < 4; ++c)
+                  {
+                    sum[c] += block[i][c];
+                    weighted_sum[c] += block[i][c] * block[i].w();
+                  }
+              }
+
+            for(unsigned int c = 0; c < 3; ++c)
+              {
+                uint32_t v;
+
+                v = (sum.w() != 0u) ?
+                  (weighted_sum[c] + sum.w() / 2u) / sum.w() :
+                  (sum[c] + 2u) / 4u;
+                texel[c] = static_cast<uint8_t>(v);
+              }
+            texel.w() = static_cast<uint8_t>((sum.w() + 2u) / 4u);
+          }
+      }
+  }
+
   /* TODO: take into account for repeated tile colors. */
   bool
   enough_room_in_atlas(fastuidraw::ivec2 number_color_tiles,
@@ -166,6 +268,51 @@ namespace
       && total_index <= C->number_free_index_tiles();
   }
 
+  /* returns true if there is room on an atlas for an
+     image whose texels have the given dimensions, making
+     room on the atlas if the atlas is resizeable.
+   */
+  bool
+  make_room_in_atlas(fastuidraw::ImageAtlas *atlas,
+                     fastuidraw::ivec2 dims, unsigned int slack)
+  {
+    int tile_interior_size;
+    fastuidraw::ivec2 num_color_tiles;
+    int index_tiles;
+
+    tile_interior_size = atlas->color_tile_size() - 2 * slack;
+    if(tile_interior_size <= 0)
+      {
+        return false;
+      }
+
+    num_color_tiles = divide_up(dims, tile_interior_size);
+    if(!enough_room_in_atlas(num_color_tiles, atlas, index_tiles))
+      {
+        /*TODO:
+           for an atlas that is not resizeable, there actually might
+           be enough room if we take into account the tiles shared
+           with other images. The correct thing is to delay this until
+           image construction, check if it succeeded and if not then
+           delete it and return an invalid handle.
+         */
+        if(atlas->resizeable())
+          {
+            /* only make room for the index tiles, the color
+               tiles that are not shared with tiles already in
+               the atlas are made room for by the atlas as they
+               are added.
+             */
+            atlas->resize_to_fit(0, index_tiles);
+          }
+        else
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
   class BackingStorePrivate
   {
   public:
@@ -220,6 +367,20 @@ namespace
     #endif
   };
 
+  class shared_color_tile
+  {
+  public:
+    shared_color_tile(fastuidraw::ivec3 t):
+      m_tile(t),
+      m_reference_count(1)
+    {}
+
+    fastuidraw::ivec3 m_tile;
+    int m_reference_count;
+  };
+
+  typedef std::map<texel_hash, shared_color_tile> shared_color_tile_map;
+
   class ImageAtlasPrivate
   {
   public:
@@ -230,9 +391,13 @@ namespace
       m_color_tiles(pcolor_tile_size, pcolor_store->dimensions()),
       m_index_store(pindex_store),
       m_index_tiles(pindex_tile_size, pindex_store->dimensions()),
-      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable())
+      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable()),
+      m_number_shared_color_tile_references(0)
     {}
 
+    fastuidraw::ivec3
+    allocate_color_tile(fastuidraw::const_c_array<fastuidraw::u8vec4> data);
+
     boost::mutex m_mutex;
 
     fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase> m_color_store;
@@ -242,22 +407,83 @@ namespace
     tile_allocator m_index_tiles;
 
     bool m_resizeable;
+
+    /* tiles added with ImageAtlas::add_shared_color_tile()
+       keyed by the hash of their texels, and the same
+       tiles keyed by their location.
+     */
+    shared_color_tile_map m_shared_color_tiles;
+    std::map<fastuidraw::ivec3, shared_color_tile_map::iterator> m_shared_color_tile_locations;
+    int m_number_shared_color_tile_references;
   };
 
-  class per_color_tile
+  /* ImageSourceBase whose texels are from
+     an array holding the entire image.
+   */
+  class ArrayImageSource:public fastuidraw::ImageSourceBase
   {
   public:
-    per_color_tile(const fastuidraw::ivec3 t, bool b):
-      m_tile(t), m_non_repeat_color(b)
+    ArrayImageSource(fastuidraw::const_c_array<fastuidraw::u8vec4> image_data, int w):
+      m_image_data(image_data),
+      m_width(w)
     {}
 
-    operator fastuidraw::ivec3() const
+    virtual
+    void
+    fetch_rows(int y, int num_rows, fastuidraw::c_array<fastuidraw::u8vec4> dst)
     {
-      return m_tile;
+      fastuidraw::const_c_array<fastuidraw::u8vec4> src;
+
+      src = m_image_data.sub_array(y * m_width, num_rows * m_width);
+      std::copy(src.begin(), src.end(), dst.begin());
     }
 
-    fastuidraw::ivec3 m_tile;
-    bool m_non_repeat_color;
+  private:
+    fastuidraw::const_c_array<fastuidraw::u8vec4> m_image_data;
+    int m_width;
+  };
+
+  /* Dimensions and locations of the mipmap levels of
+     an Image, see Image::number_mipmap_levels().
+   */
+  class MipmapLayout
+  {
+  public:
+    MipmapLayout(fastuidraw::ivec2 dims, unsigned int max_number_levels, int slack);
+
+    /* returns the mipmap level from which the texels
+       of a column of levels 1, 2, ... are taken for a
+       row of the texels of all the levels.
+     */
+    unsigned int
+    level_of_row(int y) const;
+
+    std::vector<fastuidraw::ivec2> m_dimensions;
+    std::vector<fastuidraw::ivec2> m_locations;
+    int m_slack;
+
+    /* dimensions of the texels of all the levels */
+    fastuidraw::ivec2 m_total_dimensions;
+  };
+
+  /* ImageSourceBase that computes the mipmap levels of
+     an image held in an array and gives the texels of
+     all the levels as laid out by a MipmapLayout.
+   */
+  class MipmapImageSource:public fastuidraw::ImageSourceBase
+  {
+  public:
+    MipmapImageSource(fastuidraw::const_c_array<fastuidraw::u8vec4> image_data,
+                      const MipmapLayout &layout);
+
+    virtual
+    void
+    fetch_rows(int y, int num_rows, fastuidraw::c_array<fastuidraw::u8vec4> dst);
+
+  private:
+    const MipmapLayout &m_layout;
+    std::vector<fastuidraw::const_c_array<fastuidraw::u8vec4> > m_levels;
+    std::vector<std::vector<fastuidraw::u8vec4> > m_level_data;
   };
 
   class ImagePrivate
@@ -265,13 +491,53 @@ namespace
   public:
     ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
                  int w, int h,
-                 fastuidraw::const_c_array<fastuidraw::u8vec4> image_data,
+                 fastuidraw::ImageSourceBase &image_source,
+                 unsigned int pslack,
+                 unsigned int pmax_number_mipmap_levels);
+
+    ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
+                 int w, int h,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::VirtualImageSourceBase> &image_source,
                  unsigned int pslack);
 
     ~ImagePrivate();
 
     void
-    create_color_tiles(fastuidraw::const_c_array<fastuidraw::u8vec4> image_data);
+    compute_color_tile_counts(void);
+
+    void
+    create_color_tiles(fastuidraw::ImageSourceBase &image_source);
+
+    /* set all color tiles of a virtual image
+       to the non-resident tile.
+     */
+    void
+    create_virtual_color_tiles(void);
+
+    unsigned int
+    make_resident(fastuidraw::const_c_array<fastuidraw::ivec2> tiles);
+
+    /* fetch the texels of a color tile from m_virtual_source
+       and add the tile to the atlas.
+     */
+    void
+    make_tile_resident(fastuidraw::ivec2 tile, std::vector<fastuidraw::u8vec4> &tile_data,
+                       std::vector<fastuidraw::u8vec4> &texels);
+
+    void
+    evict_tile(unsigned int idx);
+
+    /* evict the resident tiles used least recently until
+       at most max_resident tiles are resident, never evicting
+       tiles used in the current frame, i.e. with the current
+       value of m_current_frame.
+     */
+    void
+    evict_to(unsigned int max_resident);
+
+    /* set the data of the index tiles of m_dirty_index_tiles */
+    void
+    update_dirty_index_tiles(void);
 
     void
     create_index_tiles(void);
@@ -283,14 +549,31 @@ namespace
                        std::list<std::vector<fastuidraw::ivec3> > &destination);
 
     fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> m_atlas;
+    MipmapLayout m_mipmaps;
+
+    /* dimensions of the texels of all mipmap levels */
     fastuidraw::ivec2 m_dimensions;
     unsigned int m_slack;
     fastuidraw::ivec2 m_num_color_tiles;
 
-    std::map<fastuidraw::u8vec4, fastuidraw::ivec3> m_repeated_tiles;
-    std::vector<per_color_tile> m_color_tiles;
+    std::vector<fastuidraw::ivec3> m_color_tiles;
     std::list<std::vector<fastuidraw::ivec3> > m_index_tiles;
 
+    /* for virtual images, m_color_tiles of a tile that is not
+       resident is m_non_resident_tile; m_tile_last_used gives for
+       each color tile the value of m_current_frame when the tile
+       was last made resident with 0 indicating not resident and
+       m_resident_tiles lists the indices of the resident tiles.
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::VirtualImageSourceBase> m_virtual_source;
+    fastuidraw::ivec3 m_non_resident_tile;
+    std::vector<unsigned int> m_tile_last_used;
+    std::vector<unsigned int> m_resident_tiles;
+    std::vector<unsigned int> m_dirty_index_tiles;
+    unsigned int m_current_frame;
+    unsigned int m_resident_tile_budget;
+    unsigned int m_number_evicted;
+
     fastuidraw::ivec3 m_master_index_tile;
     fastuidraw::vec2 m_master_index_tile_dims;
     unsigned int m_number_index_lookups;
@@ -298,41 +581,196 @@ namespace
   };
 }
 
+/////////////////////////////////////////////
+// MipmapLayout methods
+MipmapLayout::
+MipmapLayout(fastuidraw::ivec2 dims, unsigned int max_number_levels, int slack):
+  m_dimensions(1, dims),
+  m_locations(1, fastuidraw::ivec2(0, 0)),
+  m_slack(slack),
+  m_total_dimensions(dims)
+{
+  fastuidraw::ivec2 level_dims(dims);
+  int y(0);
+
+  /* the levels 1, 2, ... are stacked vertically to the right
+     of level 0 with 2 * slack texels between consecutive levels,
+     the texels between the levels repeat the border texels
+     of the levels, see fetch_rows().
+   */
+  while(m_dimensions.size() < max_number_levels
+        && (level_dims.x() > 1 || level_dims.y() > 1))
+    {
+      level_dims.x() = std::max(1, level_dims.x() / 2);
+      level_dims.y() = std::max(1, level_dims.y() / 2);
+      m_dimensions.push_back(level_dims);
+      m_locations.push_back(fastuidraw::ivec2(dims.x() + 2 * slack, y));
+      y += level_dims.y() + 2 * slack;
+    }
+
+  if(m_dimensions.size() > 1)
+    {
+      m_total_dimensions.x() += 2 * slack + m_dimensions[1].x();
+      m_total_dimensions.y() = std::max(dims.y(), y - 2 * slack);
+    }
+}
+
+unsigned int
+MipmapLayout::
+level_of_row(int y) const
+{
+  unsigned int L;
+
+  assert(m_dimensions.size() > 1);
+  for(L = 1; L + 1 < m_dimensions.size()
+        && y >= m_locations[L].y() + m_dimensions[L].y() + m_slack; ++L)
+    {}
+  return L;
+}
+
+/////////////////////////////////////////////
+// MipmapImageSource methods
+MipmapImageSource::
+MipmapImageSource(fastuidraw::const_c_array<fastuidraw::u8vec4> image_data,
+                  const MipmapLayout &layout):
+  m_layout(layout),
+  m_levels(layout.m_dimensions.size()),
+  m_level_data(layout.m_dimensions.size())
+{
+  m_levels[0] = image_data;
+  for(unsigned int L = 1, endL = m_levels.size(); L < endL; ++L)
+    {
+      fastuidraw::ivec2 dims(m_layout.m_dimensions[L]);
+
+      m_level_data[L].resize(dims.x() * dims.y());
+      compute_next_mipmap_level(m_layout.m_dimensions[L - 1], m_levels[L - 1],
+                                dims, fastuidraw::make_c_array(m_level_data[L]));
+      m_levels[L] = fastuidraw::make_c_array(m_level_data[L]);
+    }
+}
+
+void
+MipmapImageSource::
+fetch_rows(int y, int num_rows, fastuidraw::c_array<fastuidraw::u8vec4> dst)
+{
+  const int slack(m_layout.m_slack);
+  const fastuidraw::ivec2 dims0(m_layout.m_dimensions[0]);
+  const int width(m_layout.m_total_dimensions.x());
+
+  for(int r = 0; r < num_rows; ++r)
+    {
+      fastuidraw::c_array<fastuidraw::u8vec4> dst_row;
+      fastuidraw::const_c_array<fastuidraw::u8vec4> src_row;
+      int x, sy;
+
+      dst_row = dst.sub_array(r * width, width);
+
+      /* level 0 and the slack texels to its right and below it */
+      sy = std::min(y + r, dims0.y() - 1);
+      src_row = m_levels[0].sub_array(sy * dims0.x(), dims0.x());
+      for(x = 0; x < dims0.x(); ++x)
+        {
+          dst_row[x] = src_row[x];
+        }
+      for(; x < dims0.x() + slack && x < width; ++x)
+        {
+          dst_row[x] = src_row[dims0.x() - 1];
+        }
+
+      if(x < width)
+        {
+          unsigned int L;
+          fastuidraw::ivec2 dimsL, locationL;
+
+          L = m_layout.level_of_row(y + r);
+          dimsL = m_layout.m_dimensions[L];
+          locationL = m_layout.m_locations[L];
+
+          sy = std::max(0, std::min(y + r - locationL.y(), dimsL.y() - 1));
+          src_row = m_levels[L].sub_array(sy * dimsL.x(), dimsL.x());
+          for(; x < width; ++x)
+            {
+              int sx;
+
+              sx = std::max(0, std::min(x - locationL.x(), dimsL.x() - 1));
+              dst_row[x] = src_row[sx];
+            }
+        }
+    }
+}
+
 /////////////////////////////////////////////
 //ImagePrivate methods
 ImagePrivate::
 ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
              int w, int h,
-             fastuidraw::const_c_array<fastuidraw::u8vec4> image_data,
+             fastuidraw::ImageSourceBase &image_source,
+             unsigned int pslack,
+             unsigned int pmax_number_mipmap_levels):
+  m_atlas(patlas),
+  m_mipmaps(fastuidraw::ivec2(w, h), pmax_number_mipmap_levels, pslack),
+  m_dimensions(m_mipmaps.m_total_dimensions),
+  m_slack(pslack),
+  m_current_frame(1),
+  m_resident_tile_budget(0),
+  m_number_evicted(0)
+{
+  assert(m_dimensions.x() > 0);
+  assert(m_dimensions.y() > 0);
+  assert(m_atlas);
+
+  create_color_tiles(image_source);
+  create_index_tiles();
+}
+
+ImagePrivate::
+ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
+             int w, int h,
+             const fastuidraw::reference_counted_ptr<fastuidraw::VirtualImageSourceBase> &image_source,
              unsigned int pslack):
   m_atlas(patlas),
+  m_mipmaps(fastuidraw::ivec2(w, h), 1, pslack),
   m_dimensions(w,h),
-  m_slack(pslack)
+  m_slack(pslack),
+  m_virtual_source(image_source),
+  m_current_frame(1),
+  m_number_evicted(0)
 {
+  fastuidraw::ivec3 store_dims;
+  int color_tile_size;
+
   assert(m_dimensions.x() > 0);
   assert(m_dimensions.y() > 0);
   assert(m_atlas);
+  assert(m_virtual_source);
+
+  store_dims = m_atlas->color_store()->dimensions();
+  color_tile_size = m_atlas->color_tile_size();
+  m_resident_tile_budget = (store_dims.x() / color_tile_size) * (store_dims.y() / color_tile_size);
 
-  create_color_tiles(image_data);
+  create_virtual_color_tiles();
   create_index_tiles();
 }
 
 ImagePrivate::
 ~ImagePrivate()
 {
-  for(std::vector<per_color_tile>::const_iterator iter = m_color_tiles.begin(),
-        end = m_color_tiles.end(); iter != end; ++iter)
+  if(m_virtual_source)
     {
-      if (iter->m_non_repeat_color)
+      for(std::vector<unsigned int>::const_iterator iter = m_resident_tiles.begin(),
+            end = m_resident_tiles.end(); iter != end; ++iter)
         {
-          m_atlas->delete_color_tile(iter->m_tile);
+          m_atlas->delete_color_tile(m_color_tiles[*iter]);
         }
+      m_atlas->delete_color_tile(m_non_resident_tile);
     }
-
-  for(std::map<fastuidraw::u8vec4, fastuidraw::ivec3>::const_iterator iter = m_repeated_tiles.begin(),
-        end = m_repeated_tiles.end(); iter != end; ++iter)
+  else
     {
-      m_atlas->delete_color_tile(iter->second);
+      for(std::vector<fastuidraw::ivec3>::const_iterator iter = m_color_tiles.begin(),
+            end = m_color_tiles.end(); iter != end; ++iter)
+        {
+          m_atlas->delete_color_tile(*iter);
+        }
     }
 
   for(std::list<std::vector<fastuidraw::ivec3> >::const_iterator viter = m_index_tiles.begin(),
@@ -348,72 +786,287 @@ ImagePrivate::
 
 void
 ImagePrivate::
-create_color_tiles(fastuidraw::const_c_array<fastuidraw::u8vec4> image_data)
+compute_color_tile_counts(void)
+{
+  int tile_interior_size;
+
+  tile_interior_size = m_atlas->color_tile_size() - 2 * m_slack;
+  m_num_color_tiles = divide_up(m_dimensions, tile_interior_size);
+  m_master_index_tile_dims = fastuidraw::vec2(m_mipmaps.m_dimensions[0]) / static_cast<float>(tile_interior_size);
+  m_dimensions_index_divisor = static_cast<float>(tile_interior_size);
+}
+
+void
+ImagePrivate::
+create_color_tiles(fastuidraw::ImageSourceBase &image_source)
 {
   int tile_interior_size;
   int color_tile_size;
 
   color_tile_size = m_atlas->color_tile_size();
   tile_interior_size = color_tile_size - 2 * m_slack;
-  m_num_color_tiles = divide_up(m_dimensions, tile_interior_size);
-  m_master_index_tile_dims = fastuidraw::vec2(m_dimensions) / static_cast<float>(tile_interior_size);
-  m_dimensions_index_divisor = static_cast<float>(tile_interior_size);
+  compute_color_tile_counts();
+
+  /* the rows of the image that the current row of color
+     tiles samples, i.e. the rows [rows_begin, rows_end);
+     rows shared with the previous row of color tiles (from
+     the slack) are kept instead of fetched again.
+   */
+  std::vector<fastuidraw::u8vec4> rows(m_dimensions.x() * std::min(color_tile_size, m_dimensions.y()));
+  int rows_begin(0), rows_end(0);
 
-  unsigned int savings(0);
   std::vector<fastuidraw::u8vec4> tile_data(color_tile_size * color_tile_size);
+  m_color_tiles.reserve(m_num_color_tiles.x() * m_num_color_tiles.y());
   for(int ty = 0, source_y = -m_slack;
       ty < m_num_color_tiles.y();
       ++ty, source_y += tile_interior_size)
     {
+      int begin, end;
+      fastuidraw::const_c_array<fastuidraw::u8vec4> rows_data;
+
+      begin = std::max(0, source_y);
+      end = std::min(m_dimensions.y(), source_y + color_tile_size);
+      assert(begin >= rows_begin && end >= rows_end);
+
+      if(begin < rows_end)
+        {
+          std::copy(rows.begin() + (begin - rows_begin) * m_dimensions.x(),
+                    rows.begin() + (rows_end - rows_begin) * m_dimensions.x(),
+                    rows.begin());
+        }
+      else
+        {
+          rows_end = begin;
+        }
+      rows_begin = begin;
+
+      if(end > rows_end)
+        {
+          fastuidraw::c_array<fastuidraw::u8vec4> dst;
+
+          dst = fastuidraw::make_c_array(rows).sub_array((rows_end - rows_begin) * m_dimensions.x(),
+                                                         (end - rows_end) * m_dimensions.x());
+          image_source.fetch_rows(rows_end, end - rows_end, dst);
+          rows_end = end;
+        }
+
+      /* the clamping of copy_sub_data() to the rows of rows_data
+         is the same as clamping to the rows of the image because
+         rows_data starts at row 0 if source_y is negative and
+         ends at the last row if the tiles go past the image.
+       */
+      rows_data = fastuidraw::make_c_array(rows).sub_array(0, (rows_end - rows_begin) * m_dimensions.x());
       for(int tx = 0, source_x = -m_slack;
           tx < m_num_color_tiles.x();
           ++tx, source_x += tile_interior_size)
         {
-          fastuidraw::ivec3 new_tile;
-          bool all_same_color;
+          /* tiles with the same texels, for example tiles of a
+             single color, are shared by the atlas across images.
+           */
+          copy_sub_data<fastuidraw::u8vec4>(make_c_array(tile_data), color_tile_size,
+                                            rows_data, source_x, source_y - rows_begin,
+                                            fastuidraw::ivec2(m_dimensions.x(), rows_end - rows_begin));
+          m_color_tiles.push_back(m_atlas->add_shared_color_tile(make_c_array(tile_data)));
+        }
+    }
+}
+
+
+void
+ImagePrivate::
+create_virtual_color_tiles(void)
+{
+  int color_tile_size;
+
+  color_tile_size = m_atlas->color_tile_size();
+  compute_color_tile_counts();
+
+  std::vector<fastuidraw::u8vec4> tile_data(color_tile_size * color_tile_size,
+                                            fastuidraw::u8vec4(0, 0, 0, 0));
+  m_non_resident_tile = m_atlas->add_shared_color_tile(make_c_array(tile_data));
+  m_color_tiles.resize(m_num_color_tiles.x() * m_num_color_tiles.y(), m_non_resident_tile);
+  m_tile_last_used.resize(m_color_tiles.size(), 0);
+}
+
+void
+ImagePrivate::
+make_tile_resident(fastuidraw::ivec2 tile, std::vector<fastuidraw::u8vec4> &tile_data,
+                   std::vector<fastuidraw::u8vec4> &texels)
+{
+  int tile_interior_size, color_tile_size;
+  fastuidraw::ivec2 source, begin, end;
+  unsigned int idx, index_tile_size, index_tile;
+
+  color_tile_size = m_atlas->color_tile_size();
+  tile_interior_size = color_tile_size - 2 * m_slack;
+  source = tile * tile_interior_size - fastuidraw::ivec2(m_slack, m_slack);
+
+  /* fetch the texels of the image that the tile covers,
+     copy_sub_data() then clamps to those texels as it
+     would to the entire image.
+   */
+  for(int c = 0; c < 2; ++c)
+    {
+      begin[c] = std::max(0, source[c]);
+      end[c] = std::min(m_dimensions[c], source[c] + color_tile_size);
+    }
+  texels.resize((end.x() - begin.x()) * (end.y() - begin.y()));
+  m_virtual_source->fetch_texels(begin.x(), begin.y(),
+                                 end.x() - begin.x(), end.y() - begin.y(),
+                                 make_c_array(texels));
+  copy_sub_data<fastuidraw::u8vec4>(make_c_array(tile_data), color_tile_size,
+                                    fastuidraw::const_c_array<fastuidraw::u8vec4>(make_c_array(texels)),
+                                    source.x() - begin.x(), source.y() - begin.y(),
+                                    end - begin);
+
+  idx = tile.x() + tile.y() * m_num_color_tiles.x();
+  m_color_tiles[idx] = m_atlas->add_shared_color_tile(make_c_array(tile_data));
+  m_resident_tiles.push_back(idx);
+
+  index_tile_size = m_atlas->index_tile_size();
+  index_tile = tile.x() / index_tile_size
+    + (tile.y() / index_tile_size) * divide_up(m_num_color_tiles, index_tile_size).x();
+  m_dirty_index_tiles.push_back(index_tile);
+}
+
+void
+ImagePrivate::
+evict_tile(unsigned int idx)
+{
+  unsigned int index_tile_size, index_tile;
+  fastuidraw::ivec2 tile(idx % m_num_color_tiles.x(), idx / m_num_color_tiles.x());
+
+  m_atlas->delete_color_tile(m_color_tiles[idx]);
+  m_color_tiles[idx] = m_non_resident_tile;
+  m_tile_last_used[idx] = 0;
+  ++m_number_evicted;
+
+  index_tile_size = m_atlas->index_tile_size();
+  index_tile = tile.x() / index_tile_size
+    + (tile.y() / index_tile_size) * divide_up(m_num_color_tiles, index_tile_size).x();
+  m_dirty_index_tiles.push_back(index_tile);
+}
+
+void
+ImagePrivate::
+evict_to(unsigned int max_resident)
+{
+  std::vector<std::pair<unsigned int, unsigned int> > by_use;
+  std::vector<unsigned int> kept;
+  unsigned int num_evict;
+
+  if(m_resident_tiles.size() <= max_resident)
+    {
+      return;
+    }
+
+  for(unsigned int i = 0, endi = m_resident_tiles.size(); i < endi; ++i)
+    {
+      unsigned int idx(m_resident_tiles[i]);
+      if(m_tile_last_used[idx] != m_current_frame)
+        {
+          by_use.push_back(std::make_pair(m_tile_last_used[idx], idx));
+        }
+    }
+
+  num_evict = std::min(static_cast<unsigned int>(by_use.size()),
+                       static_cast<unsigned int>(m_resident_tiles.size()) - max_resident);
+  std::sort(by_use.begin(), by_use.end());
+  for(unsigned int i = 0; i < num_evict; ++i)
+    {
+      evict_tile(by_use[i].second);
+    }
+
+  for(unsigned int i = 0, endi = m_resident_tiles.size(); i < endi; ++i)
+    {
+      if(m_tile_last_used[m_resident_tiles[i]] != 0)
+        {
+          kept.push_back(m_resident_tiles[i]);
+        }
+    }
+  m_resident_tiles.swap(kept);
+}
+
+void
+ImagePrivate::
+update_dirty_index_tiles(void)
+{
+  int index_tile_size;
+  unsigned int num_index_tiles_x;
+
+  if(m_dirty_index_tiles.empty())
+    {
+      return;
+    }
+
+  std::sort(m_dirty_index_tiles.begin(), m_dirty_index_tiles.end());
+  m_dirty_index_tiles.erase(std::unique(m_dirty_index_tiles.begin(), m_dirty_index_tiles.end()),
+                            m_dirty_index_tiles.end());
+
+  index_tile_size = m_atlas->index_tile_size();
+  num_index_tiles_x = divide_up(m_num_color_tiles, index_tile_size).x();
+
+  std::vector<fastuidraw::ivec3> tile_data(index_tile_size * index_tile_size);
+  for(unsigned int i = 0, endi = m_dirty_index_tiles.size(); i < endi; ++i)
+    {
+      unsigned int index_tile(m_dirty_index_tiles[i]);
+
+      /* same as create_index_layer() does for the index tile */
+      copy_sub_data<fastuidraw::ivec3, fastuidraw::ivec3>(fastuidraw::make_c_array(tile_data),
+                                                          index_tile_size,
+                                                          fastuidraw::make_c_array(m_color_tiles),
+                                                          (index_tile % num_index_tiles_x) * index_tile_size,
+                                                          (index_tile / num_index_tiles_x) * index_tile_size,
+                                                          m_num_color_tiles);
+      m_atlas->set_index_tile(m_index_tiles.front()[index_tile],
+                              fastuidraw::make_c_array(tile_data),
+                              m_slack);
+    }
+  m_dirty_index_tiles.clear();
+}
+
+unsigned int
+ImagePrivate::
+make_resident(fastuidraw::const_c_array<fastuidraw::ivec2> tiles)
+{
+  unsigned int return_value(0);
+  int color_tile_size;
+  std::vector<fastuidraw::u8vec4> tile_data, texels;
+
+  if(!m_virtual_source)
+    {
+      return 0;
+    }
 
-          all_same_color = copy_sub_data<fastuidraw::u8vec4>(make_c_array(tile_data), color_tile_size,
-                                                            image_data, source_x, source_y,
-                                                            m_dimensions);
-          if(all_same_color)
-            {
-              std::map<fastuidraw::u8vec4, fastuidraw::ivec3>::iterator iter;
-              fastuidraw::u8vec4 same_color_value;
+  color_tile_size = m_atlas->color_tile_size();
+  tile_data.resize(color_tile_size * color_tile_size);
 
-              same_color_value = tile_data[0];
-              iter = m_repeated_tiles.find(same_color_value);
-              if(iter != m_repeated_tiles.end())
-                {
-                  new_tile = iter->second;
-                  ++savings;
-                }
-              else
-                {
-                  /* we only need to call std::fill if the color tile
-                     is only partially filled, but I am lazy and just
-                     call it always.
-                   */
-                  std::fill(tile_data.begin(), tile_data.end(), same_color_value);
-                  new_tile = m_atlas->add_color_tile(make_c_array(tile_data));
-                  m_repeated_tiles[same_color_value] = new_tile;
-                }
-            }
-          else
-            {
-              new_tile = m_atlas->add_color_tile(make_c_array(tile_data));
-            }
+  for(unsigned int i = 0, endi = tiles.size(); i < endi; ++i)
+    {
+      fastuidraw::ivec2 tile(tiles[i]);
+      unsigned int idx;
 
-          m_color_tiles.push_back(per_color_tile(new_tile, !all_same_color) );
+      if(tile.x() < 0 || tile.y() < 0
+         || tile.x() >= m_num_color_tiles.x()
+         || tile.y() >= m_num_color_tiles.y())
+        {
+          continue;
+        }
+
+      idx = tile.x() + tile.y() * m_num_color_tiles.x();
+      if(m_tile_last_used[idx] == 0)
+        {
+          make_tile_resident(tile, tile_data, texels);
+          ++return_value;
         }
+      m_tile_last_used[idx] = m_current_frame;
     }
 
-  FASTUIDRAWunused(savings);
-  //std::cout << "Saved " << savings << " out of "
-  //        << m_num_color_tiles.x() * m_num_color_tiles.y()
-  //        << " tiles from repeat color magicks\n";
+  evict_to(m_resident_tile_budget);
+  update_dirty_index_tiles();
+  return return_value;
 }
 
-
 /*
   returns the number of index tiles needed to
   store the created index data.
@@ -471,7 +1124,7 @@ create_index_tiles(void)
   float findex_tile_size;
 
   findex_tile_size = static_cast<float>(m_atlas->index_tile_size());
-  num_index_tiles = create_index_layer<per_color_tile>(fastuidraw::make_c_array(m_color_tiles),
+  num_index_tiles = create_index_layer<fastuidraw::ivec3>(fastuidraw::make_c_array(m_color_tiles),
                                                        m_num_color_tiles,
                                                        m_slack,
                                                        m_index_tiles);
@@ -491,6 +1144,29 @@ create_index_tiles(void)
   m_number_index_lookups = m_index_tiles.size();
 }
 
+///////////////////////////////////////////
+// ImageAtlasPrivate methods
+fastuidraw::ivec3
+ImageAtlasPrivate::
+allocate_color_tile(fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+{
+  fastuidraw::ivec3 return_value;
+
+  if(m_resizeable && m_color_tiles.resize_to_fit(1))
+    {
+      m_color_store->resize(m_color_tiles.m_num_tiles.z());
+    }
+
+  return_value = m_color_tiles.allocate_tile();
+  m_color_store->set_data(return_value.x() * m_color_tiles.m_tile_size,
+                          return_value.y() * m_color_tiles.m_tile_size,
+                          return_value.z(),
+                          m_color_tiles.m_tile_size,
+                          m_color_tiles.m_tile_size,
+                          data);
+  return return_value;
+}
+
 ///////////////////////////////////////////
 // tile_allocator methods
 tile_allocator::
@@ -813,6 +1489,25 @@ add_index_tile(fastuidraw::const_c_array<fastuidraw::ivec3> data, int slack)
   return return_value;
 }
 
+void
+fastuidraw::ImageAtlas::
+set_index_tile(ivec3 tile, fastuidraw::const_c_array<fastuidraw::ivec3> data, int slack)
+{
+  ImageAtlasPrivate *d;
+  d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
+
+  autolock_mutex M(d->m_mutex);
+  d->m_index_store->set_data(tile.x() * d->m_index_tiles.m_tile_size,
+                             tile.y() * d->m_index_tiles.m_tile_size,
+                             tile.z(),
+                             d->m_index_tiles.m_tile_size,
+                             d->m_index_tiles.m_tile_size,
+                             data,
+                             slack,
+                             d->m_color_store.get(),
+                             d->m_color_tiles.m_tile_size);
+}
+
 fastuidraw::ivec3
 fastuidraw::ImageAtlas::
 add_index_tile_index_data(fastuidraw::const_c_array<fastuidraw::ivec3> data)
@@ -862,17 +1557,32 @@ add_color_tile(fastuidraw::const_c_array<u8vec4> data)
 {
   ImageAtlasPrivate *d;
   d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
-  ivec3 return_value;
   autolock_mutex M(d->m_mutex);
+  return d->allocate_color_tile(data);
+}
 
-  return_value = d->m_color_tiles.allocate_tile();
-  d->m_color_store->set_data(return_value.x() * d->m_color_tiles.m_tile_size,
-                             return_value.y() * d->m_color_tiles.m_tile_size,
-                             return_value.z(),
-                             d->m_color_tiles.m_tile_size,
-                             d->m_color_tiles.m_tile_size,
-                             data);
-  return return_value;
+fastuidraw::ivec3
+fastuidraw::ImageAtlas::
+add_shared_color_tile(fastuidraw::const_c_array<u8vec4> data)
+{
+  ImageAtlasPrivate *d;
+  d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
+
+  texel_hash hash(compute_texel_hash(data));
+  shared_color_tile_map::iterator iter;
+  autolock_mutex M(d->m_mutex);
+
+  ++d->m_number_shared_color_tile_references;
+  iter = d->m_shared_color_tiles.find(hash);
+  if(iter != d->m_shared_color_tiles.end())
+    {
+      ++iter->second.m_reference_count;
+      return iter->second.m_tile;
+    }
+
+  iter = d->m_shared_color_tiles.insert(std::make_pair(hash, shared_color_tile(d->allocate_color_tile(data)))).first;
+  d->m_shared_color_tile_locations[iter->second.m_tile] = iter;
+  return iter->second.m_tile;
 }
 
 void
@@ -881,10 +1591,44 @@ delete_color_tile(fastuidraw::ivec3 tile)
 {
   ImageAtlasPrivate *d;
   d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
+
+  std::map<ivec3, shared_color_tile_map::iterator>::iterator iter;
   autolock_mutex M(d->m_mutex);
+
+  iter = d->m_shared_color_tile_locations.find(tile);
+  if(iter != d->m_shared_color_tile_locations.end())
+    {
+      --d->m_number_shared_color_tile_references;
+      if(--iter->second->second.m_reference_count > 0)
+        {
+          return;
+        }
+      d->m_shared_color_tiles.erase(iter->second);
+      d->m_shared_color_tile_locations.erase(iter);
+    }
   d->m_color_tiles.delete_tile(tile);
 }
 
+int
+fastuidraw::ImageAtlas::
+number_shared_color_tiles(void) const
+{
+  ImageAtlasPrivate *d;
+  d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
+  autolock_mutex M(d->m_mutex);
+  return d->m_shared_color_tiles.size();
+}
+
+int
+fastuidraw::ImageAtlas::
+number_shared_color_tile_references(void) const
+{
+  ImageAtlasPrivate *d;
+  d = reinterpret_cast<ImageAtlasPrivate*>(m_d);
+  autolock_mutex M(d->m_mutex);
+  return d->m_number_shared_color_tile_references;
+}
+
 void
 fastuidraw::ImageAtlas::
 flush(void) const
@@ -946,38 +1690,75 @@ resize_to_fit(int num_color_tiles, int num_index_tiles)
 fastuidraw::reference_counted_ptr<fastuidraw::Image>
 fastuidraw::Image::
 create(fastuidraw::reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-       const_c_array<u8vec4> image_data, unsigned int pslack)
+       const_c_array<u8vec4> image_data, unsigned int pslack,
+       unsigned int pmax_number_mipmap_levels)
+{
+  if(pmax_number_mipmap_levels <= 1)
+    {
+      ArrayImageSource image_source(image_data, w);
+      return create(atlas, w, h, image_source, pslack);
+    }
+
+  if(w <= 0 || h <= 0)
+    {
+      return reference_counted_ptr<Image>();
+    }
+
+  MipmapLayout layout(ivec2(w, h), pmax_number_mipmap_levels, pslack);
+  if(!make_room_in_atlas(atlas.get(), layout.m_total_dimensions, pslack))
+    {
+      return reference_counted_ptr<Image>();
+    }
+
+  MipmapImageSource image_source(image_data, layout);
+  return FASTUIDRAWnew Image(atlas, w, h, image_source, pslack, pmax_number_mipmap_levels);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::Image>
+fastuidraw::Image::
+create(fastuidraw::reference_counted_ptr<ImageAtlas> atlas, int w, int h,
+       ImageSourceBase &image_source, unsigned int pslack)
+{
+  if(w <= 0 || h <= 0 || !make_room_in_atlas(atlas.get(), ivec2(w, h), pslack))
+    {
+      return reference_counted_ptr<Image>();
+    }
+
+  return FASTUIDRAWnew Image(atlas, w, h, image_source, pslack, 1);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::Image>
+fastuidraw::Image::
+create_virtual(fastuidraw::reference_counted_ptr<ImageAtlas> atlas, int w, int h,
+               const reference_counted_ptr<VirtualImageSourceBase> &image_source,
+               unsigned int pslack)
 {
   int tile_interior_size;
-  int color_tile_size;
   ivec2 num_color_tiles;
   int index_tiles;
 
-  if(w <= 0 || h <= 0)
+  if(w <= 0 || h <= 0 || !image_source)
     {
       return reference_counted_ptr<Image>();
     }
 
-  color_tile_size = atlas->color_tile_size();
-  tile_interior_size = color_tile_size - 2 * pslack;
-
+  tile_interior_size = atlas->color_tile_size() - 2 * pslack;
   if(tile_interior_size <= 0)
     {
       return reference_counted_ptr<Image>();
     }
 
+  /* only the index tiles and the tile drawn for
+     non-resident tiles need room up front.
+   */
   num_color_tiles = divide_up(ivec2(w, h), tile_interior_size);
-  if(!enough_room_in_atlas(num_color_tiles, atlas.get(), index_tiles))
+  index_tiles = number_index_tiles_needed(num_color_tiles, atlas->index_tile_size());
+  if(index_tiles > atlas->number_free_index_tiles()
+     || atlas->number_free_color_tiles() < 1)
     {
-      /*TODO:
-         there actually might be enough room if we take into account
-         the savings from repeated tiles. The correct thing is to
-         delay this until iamge construction, check if it succeeded
-         and if not then delete it and return an invalid handle.
-       */
       if(atlas->resizeable())
         {
-          atlas->resize_to_fit(num_color_tiles.x() * num_color_tiles.y(), index_tiles);
+          atlas->resize_to_fit(1, index_tiles);
         }
       else
         {
@@ -985,16 +1766,26 @@ create(fastuidraw::reference_counted_ptr<ImageAtlas> atlas, int w, int h,
         }
     }
 
-  return FASTUIDRAWnew Image(atlas, w, h, image_data, pslack);
+  return FASTUIDRAWnew Image(atlas, w, h, image_source, pslack);
+}
+
+fastuidraw::Image::
+Image(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
+      int w, int h,
+      ImageSourceBase &image_source,
+      unsigned int pslack,
+      unsigned int pmax_number_mipmap_levels)
+{
+  m_d = FASTUIDRAWnew ImagePrivate(patlas, w, h, image_source, pslack, pmax_number_mipmap_levels);
 }
 
 fastuidraw::Image::
 Image(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
       int w, int h,
-      fastuidraw::const_c_array<fastuidraw::u8vec4> image_data,
+      const reference_counted_ptr<VirtualImageSourceBase> &image_source,
       unsigned int pslack)
 {
-  m_d = FASTUIDRAWnew ImagePrivate(patlas, w, h, image_data, pslack);
+  m_d = FASTUIDRAWnew ImagePrivate(patlas, w, h, image_source, pslack);
 }
 
 fastuidraw::Image::
@@ -1022,7 +1813,7 @@ dimensions(void) const
 {
   ImagePrivate *d;
   d = reinterpret_cast<ImagePrivate*>(m_d);
-  return d->m_dimensions;
+  return d->m_mipmaps.m_dimensions[0];
 }
 
 unsigned int
@@ -1069,3 +1860,199 @@ atlas(void) const
   d = reinterpret_cast<ImagePrivate*>(m_d);
   return d->m_atlas;
 }
+
+unsigned int
+fastuidraw::Image::
+number_mipmap_levels(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_mipmaps.m_dimensions.size();
+}
+
+fastuidraw::ivec2
+fastuidraw::Image::
+mipmap_dimensions(unsigned int level) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  assert(level < d->m_mipmaps.m_dimensions.size());
+  return d->m_mipmaps.m_dimensions[level];
+}
+
+fastuidraw::ivec2
+fastuidraw::Image::
+mipmap_location(unsigned int level) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  assert(level < d->m_mipmaps.m_locations.size());
+  return d->m_mipmaps.m_locations[level];
+}
+
+bool
+fastuidraw::Image::
+is_virtual(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_virtual_source.get() != NULL;
+}
+
+fastuidraw::ivec2
+fastuidraw::Image::
+number_color_tiles(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_num_color_tiles;
+}
+
+bool
+fastuidraw::Image::
+color_tiles_of_region(vec2 min_corner, vec2 max_corner,
+                      ivec2 &out_min_tile, ivec2 &out_max_tile) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+
+  float tile_interior_size;
+
+  tile_interior_size = static_cast<float>(d->m_atlas->color_tile_size() - 2 * d->m_slack);
+  for(int c = 0; c < 2; ++c)
+    {
+      if(max_corner[c] < 0.0f || min_corner[c] >= static_cast<float>(d->m_dimensions[c])
+         || min_corner[c] > max_corner[c])
+        {
+          return false;
+        }
+
+      out_min_tile[c] = static_cast<int>(std::max(0.0f, min_corner[c]) / tile_interior_size);
+      out_max_tile[c] = static_cast<int>(max_corner[c] / tile_interior_size);
+      out_max_tile[c] = std::min(out_max_tile[c], d->m_num_color_tiles[c] - 1);
+    }
+  return true;
+}
+
+unsigned int
+fastuidraw::Image::
+make_resident(const_c_array<ivec2> tiles)
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->make_resident(tiles);
+}
+
+unsigned int
+fastuidraw::Image::
+make_resident(ivec2 min_tile, ivec2 max_tile)
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+
+  std::vector<ivec2> tiles;
+
+  min_tile.x() = std::max(0, min_tile.x());
+  min_tile.y() = std::max(0, min_tile.y());
+  max_tile.x() = std::min(d->m_num_color_tiles.x() - 1, max_tile.x());
+  max_tile.y() = std::min(d->m_num_color_tiles.y() - 1, max_tile.y());
+  for(int y = min_tile.y(); y <= max_tile.y(); ++y)
+    {
+      for(int x = min_tile.x(); x <= max_tile.x(); ++x)
+        {
+          tiles.push_back(ivec2(x, y));
+        }
+    }
+  return d->make_resident(make_c_array(tiles));
+}
+
+bool
+fastuidraw::Image::
+resident(ivec2 tile) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+
+  if(!d->m_virtual_source)
+    {
+      return true;
+    }
+
+  assert(tile.x() >= 0 && tile.x() < d->m_num_color_tiles.x());
+  assert(tile.y() >= 0 && tile.y() < d->m_num_color_tiles.y());
+  return d->m_tile_last_used[tile.x() + tile.y() * d->m_num_color_tiles.x()] != 0;
+}
+
+void
+fastuidraw::Image::
+evict_all(void)
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+
+  if(d->m_virtual_source)
+    {
+      for(unsigned int i = 0, endi = d->m_resident_tiles.size(); i < endi; ++i)
+        {
+          d->evict_tile(d->m_resident_tiles[i]);
+        }
+      d->m_resident_tiles.clear();
+      d->update_dirty_index_tiles();
+    }
+}
+
+unsigned int
+fastuidraw::Image::
+number_resident_tiles(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_virtual_source ?
+    d->m_resident_tiles.size() :
+    d->m_color_tiles.size();
+}
+
+unsigned int
+fastuidraw::Image::
+number_evicted_tiles(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_number_evicted;
+}
+
+void
+fastuidraw::Image::
+resident_tile_budget(unsigned int v)
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  d->m_resident_tile_budget = v;
+}
+
+unsigned int
+fastuidraw::Image::
+resident_tile_budget(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_resident_tile_budget;
+}
+
+void
+fastuidraw::Image::
+advance_frame(void)
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  ++d->m_current_frame;
+}
+
+unsigned int
+fastuidraw::Image::
+current_frame(void) const
+{
+  ImagePrivate *d;
+  d = reinterpret_cast<ImagePrivate*>(m_d);
+  return d->m_current_frame - 1;
+}
@@ -20,7 +20,10 @@
 
 #include <vector>
 #include <list>
+#include <map>
 #include <cstring>
+#include <boost/atomic.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
@@ -150,18 +153,174 @@ namespace
     fastuidraw::vecN<int, pool_size> m_free_slots;
   };
 
+  class EntryBase;
+
+  /* Base class for the pools of a PainterPackedValuePool
+     that is thread safe. Entries are returned to the pool
+     from any thread by pushing them onto m_returned; an
+     allocating thread takes the entire list in one atomic
+     exchange, so no ABA problem arises.
+   */
+  class ConcurrentPoolBase:public fastuidraw::reference_counted<ConcurrentPoolBase>::default_base
+  {
+  public:
+    ConcurrentPoolBase(void):
+      m_returned(NULL),
+      m_id(next_id())
+    {}
+
+    virtual
+    ~ConcurrentPoolBase()
+    {}
+
+    void
+    return_entry(EntryBase *e);
+
+  protected:
+    boost::atomic<EntryBase*> m_returned;
+
+    /* unique for the life of the process, unlike
+       the address of the pool.
+     */
+    const uint64_t m_id;
+
+  private:
+    static
+    uint64_t
+    next_id(void)
+    {
+      static boost::atomic<uint64_t> counter(0);
+      return counter.fetch_add(1, boost::memory_order_relaxed);
+    }
+  };
+
+  /* The free entries a thread keeps for one ConcurrentPool. A
+     Magazine is owned by both the pool and the thread, whichever
+     lets go of it last deletes it; after the pool is deleted, the
+     entries on m_head are garbage and must not be touched.
+   */
+  class Magazine:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    Magazine(uint64_t pool_id):
+      m_pool_id(pool_id),
+      m_head(NULL),
+      m_next(NULL),
+      m_pool_alive(true),
+      m_owners(2)
+    {}
+
+    void
+    release_owner(void)
+    {
+      if(m_owners.fetch_sub(1, boost::memory_order_acq_rel) == 1)
+        {
+          FASTUIDRAWdelete(this);
+        }
+    }
+
+    const uint64_t m_pool_id;
+    EntryBase *m_head;
+    Magazine *m_next;
+    boost::atomic<bool> m_pool_alive;
+
+  private:
+    boost::atomic<int> m_owners;
+  };
+
+  /* The Magazine objects of a thread, one for each ConcurrentPool
+     the thread allocated from. They are keyed by the id of the pool
+     and not its address, so that a pool made at the address of a
+     deleted pool does not find the Magazine of the deleted pool.
+     The Magazine objects of deleted pools are dropped whenever a
+     Magazine is added and when the thread exits.
+   */
+  class MagazineTable:fastuidraw::noncopyable
+  {
+  public:
+    ~MagazineTable()
+    {
+      for(std::vector<Magazine*>::iterator iter = m_magazines.begin(),
+            end = m_magazines.end(); iter != end; ++iter)
+        {
+          (*iter)->release_owner();
+        }
+    }
+
+    Magazine*
+    fetch(uint64_t pool_id)
+    {
+      for(std::vector<Magazine*>::iterator iter = m_magazines.begin(),
+            end = m_magazines.end(); iter != end; ++iter)
+        {
+          if((*iter)->m_pool_id == pool_id)
+            {
+              return *iter;
+            }
+        }
+      return NULL;
+    }
+
+    void
+    add(Magazine *m)
+    {
+      unsigned int dst(0);
+      for(unsigned int src = 0, end = m_magazines.size(); src < end; ++src)
+        {
+          if(m_magazines[src]->m_pool_alive.load(boost::memory_order_acquire))
+            {
+              m_magazines[dst++] = m_magazines[src];
+            }
+          else
+            {
+              m_magazines[src]->release_owner();
+            }
+        }
+      m_magazines.resize(dst);
+      m_magazines.push_back(m);
+    }
+
+    static
+    MagazineTable&
+    current(void)
+    {
+      static boost::thread_specific_ptr<MagazineTable> tables;
+      MagazineTable *p;
+
+      p = tables.get();
+      if(p == NULL)
+        {
+          p = FASTUIDRAWnew MagazineTable();
+          tables.reset(p);
+        }
+      return *p;
+    }
+
+  private:
+    std::vector<Magazine*> m_magazines;
+  };
+
   class EntryBase
   {
   public:
 
     EntryBase(void):
       m_raw_value(NULL),
-      m_pool_slot(-1)
+      m_pool_slot(-1),
+      m_next_free(NULL),
+      m_atomic_count(0)
     {}
 
     void
     aquire(void)
     {
+      if(m_concurrent_pool)
+        {
+          m_atomic_count.fetch_add(1, boost::memory_order_relaxed);
+          return;
+        }
+
       assert(m_pool);
       assert(m_pool_slot >= 0);
       m_count.add_reference();
@@ -170,6 +329,23 @@ namespace
     void
     release(void)
     {
+      if(m_concurrent_pool)
+        {
+          if(m_atomic_count.fetch_sub(1, boost::memory_order_release) == 1)
+            {
+              fastuidraw::reference_counted_ptr<ConcurrentPoolBase> pool;
+
+              /* once the entry is returned, another thread may take
+                 it, so m_concurrent_pool must be cleared first and
+                 the pool kept alive until return_entry() is done.
+               */
+              boost::atomic_thread_fence(boost::memory_order_acquire);
+              pool.swap(m_concurrent_pool);
+              pool->return_entry(this);
+            }
+          return;
+        }
+
       assert(m_pool);
       assert(m_pool_slot >= 0);
       if(m_count.remove_reference())
@@ -209,11 +385,23 @@ namespace
     fastuidraw::reference_counted_ptr<PoolBase> m_pool;
     int m_pool_slot;
 
+    /* pool of the entry if the entry comes from a
+       PainterPackedValuePool that is thread safe,
+       and the next free entry when the entry is free.
+     */
+    fastuidraw::reference_counted_ptr<ConcurrentPoolBase> m_concurrent_pool;
+
+  public:
+    EntryBase *m_next_free;
+
   private:
     /* Entry reference count is not thread safe because
-       the objects themselves are not.
+       the objects themselves are not; entries from a
+       thread safe PainterPackedValuePool use m_atomic_count
+       instead.
     */
     fastuidraw::reference_count_non_concurrent m_count;
+    boost::atomic<int> m_atomic_count;
   };
 
   template<typename T>
@@ -232,9 +420,25 @@ namespace
       assert(slot >= 0);
 
       m_pool = p;
-      m_state = st;
       m_pool_slot = slot;
+      set_value(st, alignment);
+    }
+
+    void
+    set(const T &st, int alignment, ConcurrentPoolBase *p)
+    {
+      assert(p);
+      m_concurrent_pool = p;
+      set_value(st, alignment);
+    }
+
+    T m_state;
 
+  private:
+    void
+    set_value(const T &st, int alignment)
+    {
+      m_state = st;
       this->m_begin_id = -1;
       this->m_draw_command_id = 0;
       this->m_offset = 0;
@@ -243,8 +447,6 @@ namespace
       this->m_data.resize(m_state.data_size(alignment));
       m_state.pack_data(alignment, fastuidraw::make_c_array(this->m_data));
     }
-
-    T m_state;
   };
 
   template<typename T>
@@ -302,375 +504,1372 @@ namespace
     std::vector<fastuidraw::reference_counted_ptr<Pool<T> > > m_pools;
   };
 
-  class PainterPackedValuePoolPrivate
-  {
-  public:
-    explicit
-    PainterPackedValuePoolPrivate(int d):
-      m_alignment(d)
-    {}
-
-    int m_alignment;
-
-    PoolSet<fastuidraw::PainterBrush> m_brush_pool;
-    PoolSet<fastuidraw::PainterClipEquations> m_clip_equations_pool;
-    PoolSet<fastuidraw::PainterItemMatrix> m_item_matrix_pool;
-    PoolSet<fastuidraw::PainterItemShaderData> m_item_shader_data_pool;
-    PoolSet<fastuidraw::PainterBlendShaderData> m_blend_shader_data_pool;
-  };
-
-  class painter_state_location
-  {
-  public:
-    uint32_t m_clipping_data_loc;
-    uint32_t m_item_matrix_data_loc;
-    uint32_t m_brush_shader_data_loc;
-    uint32_t m_item_shader_data_loc;
-    uint32_t m_blend_shader_data_loc;
-  };
-
-  class PainterPackerPrivate;
-
-  class per_draw_command
+  /* A ConcurrentPool gives each thread its own magazine of free
+     entries so that allocating does not touch memory shared with
+     other threads until the magazine is empty. When the magazine
+     is empty, the entries returned by all threads are taken in one
+     go, and if there are none a new block of entries is made. The
+     magazines and blocks are kept on lock-free lists that are only
+     walked in the dtor. The free entries of a thread's magazine are
+     not reclaimed when the thread exits.
+   */
+  template<typename T>
+  class ConcurrentPool:public ConcurrentPoolBase
   {
   public:
-    per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                     const fastuidraw::PainterBackend::ConfigurationBase &config);
+    enum
+      {
+        block_size = PoolBase::pool_size
+      };
 
-    unsigned int
-    attribute_room(void)
-    {
-      assert(m_attributes_written <= m_draw_command->m_attributes.size());
-      return m_draw_command->m_attributes.size() - m_attributes_written;
-    }
+    ConcurrentPool(void):
+      m_all_magazines(NULL),
+      m_blocks(NULL)
+    {}
 
-    unsigned int
-    index_room(void)
+    ~ConcurrentPool()
     {
-      assert(m_indices_written <= m_draw_command->m_indices.size());
-      return m_draw_command->m_indices.size() - m_indices_written;
-    }
+      for(Magazine *m = m_all_magazines.load(boost::memory_order_acquire), *next; m != NULL; m = next)
+        {
+          next = m->m_next;
+          m->m_pool_alive.store(false, boost::memory_order_release);
+          m->release_owner();
+        }
 
-    unsigned int
-    store_room(void)
-    {
-      unsigned int s;
-      s = store_written();
-      assert(s <= m_draw_command->m_store.size());
-      return m_draw_command->m_store.size() - s;
+      for(Block *b = m_blocks.load(boost::memory_order_acquire), *next; b != NULL; b = next)
+        {
+          next = b->m_next;
+          FASTUIDRAWdelete(b);
+        }
     }
 
-    unsigned int
-    store_written(void)
+    Entry<T>*
+    allocate(const T &st, int alignment)
     {
-      return current_block() * m_alignment;
-    }
+      Magazine *mag;
+      EntryBase *e;
 
-    void
-    unmap(void)
-    {
-      m_draw_command->unmap(m_attributes_written, m_indices_written, store_written());
-    }
+      MagazineTable &table(MagazineTable::current());
+      mag = table.fetch(m_id);
+      if(mag == NULL)
+        {
+          mag = FASTUIDRAWnew Magazine(m_id);
+          push(m_all_magazines, mag);
+          table.add(mag);
+        }
 
-    void
-    pack_painter_state(const fastuidraw::PainterPackerData &state,
-                       PainterPackerPrivate *p, painter_state_location &out_data);
+      e = mag->m_head;
+      if(e == NULL)
+        {
+          e = m_returned.exchange(NULL, boost::memory_order_acquire);
+          if(e == NULL)
+            {
+              Block *b;
 
-    unsigned int
-    pack_header(unsigned int header_size,
-                uint32_t brush_shader,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
-                uint64_t blend_mode,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
-                unsigned int z,
-                const painter_state_location &loc,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+              b = FASTUIDRAWnew Block();
+              push(m_blocks, b);
+              e = b->m_first;
+            }
+        }
+      mag->m_head = e->m_next_free;
+      e->m_next_free = NULL;
 
-    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
-    unsigned int m_attributes_written, m_indices_written;
+      Entry<T> *return_value;
+      return_value = static_cast<Entry<T>*>(e);
+      return_value->set(st, alignment, this);
+      return return_value;
+    }
 
   private:
-    fastuidraw::c_array<fastuidraw::generic_data>
-    allocate_store(unsigned int num_elements);
-
-    unsigned int
-    current_block(void)
+    class Block
     {
-      return m_store_blocks_written;
-    }
+    public:
+      Block(void):
+        m_next(NULL)
+      {
+        for(unsigned int i = 0; i + 1 < block_size; ++i)
+          {
+            m_entries[i].m_next_free = &m_entries[i + 1];
+          }
+        m_first = &m_entries[0];
+      }
 
-    void
-    pack_state_data(PainterPackerPrivate *p, EntryBase *st_d, uint32_t &location);
+      fastuidraw::vecN<Entry<T>, block_size> m_entries;
+      EntryBase *m_first;
+      Block *m_next;
+    };
 
-    template<typename T>
+    template<typename S>
+    static
     void
-    pack_state_data_from_value(const T &st, uint32_t &location)
+    push(boost::atomic<S*> &list, S *p)
     {
-      fastuidraw::c_array<fastuidraw::generic_data> dst;
-      unsigned int data_sz;
+      S *head;
 
-      location = current_block();
-      data_sz = st.data_size(m_alignment);
-      dst = allocate_store(data_sz);
-      st.pack_data(m_alignment, dst);
+      head = list.load(boost::memory_order_relaxed);
+      do
+        {
+          p->m_next = head;
+        }
+      while(!list.compare_exchange_weak(head, p, boost::memory_order_release, boost::memory_order_relaxed));
     }
 
-    template<typename T>
-    void
-    pack_state_data(PainterPackerPrivate *p,
-                    const fastuidraw::PainterData::value<T> &obj,
-                    uint32_t &location)
+    boost::atomic<Magazine*> m_all_magazines;
+    boost::atomic<Block*> m_blocks;
+  };
+
+  template<typename T>
+  class PoolSetCollection:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    PoolSetCollection(bool thread_safe):
+      m_pool(NULL)
     {
-      if(obj.m_packed_value)
+      if(thread_safe)
         {
-          EntryBase *e;
-          e = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
-          pack_state_data(p, e, location);
+          m_concurrent_pool = FASTUIDRAWnew ConcurrentPool<T>();
         }
-      else if(obj.m_value != NULL)
+      else
         {
-          pack_state_data_from_value(*obj.m_value, location);
+          m_pool = FASTUIDRAWnew PoolSet<T>();
         }
-      else
+    }
+
+    ~PoolSetCollection()
+    {
+      if(m_pool)
         {
-          static T v;
-          pack_state_data_from_value(v, location);
+          FASTUIDRAWdelete(m_pool);
         }
     }
 
-    unsigned int m_store_blocks_written;
-    unsigned int m_alignment;
-    fastuidraw::reference_counted_ptr<const fastuidraw::Image> m_last_image;
-    fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> m_last_color_stop;
-    std::list<fastuidraw::reference_counted_ptr<const fastuidraw::Image> > m_images_active;
-    std::list<fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> > m_color_stops_active;
+    Entry<T>*
+    allocate(const T &st, int alignment)
+    {
+      return (m_concurrent_pool) ?
+        m_concurrent_pool->allocate(st, alignment) :
+        m_pool->allocate(st, alignment);
+    }
 
-    uint32_t m_brush_shader_mask;
-    PainterShaderGroupPrivate m_prev_state;
-    fastuidraw::BlendMode m_prev_blend_mode;
+  private:
+    PoolSet<T> *m_pool;
+    fastuidraw::reference_counted_ptr<ConcurrentPool<T> > m_concurrent_pool;
   };
 
-  class PainterPackerPrivateWorkroom
+  class PainterPackedValuePoolPrivate
   {
   public:
-    std::vector<unsigned int> m_attribs_loaded;
+    explicit
+    PainterPackedValuePoolPrivate(int d, bool thread_safe):
+      m_alignment(d),
+      m_brush_pool(thread_safe),
+      m_clip_equations_pool(thread_safe),
+      m_item_matrix_pool(thread_safe),
+      m_item_shader_data_pool(thread_safe),
+      m_blend_shader_data_pool(thread_safe)
+    {}
+
+    int m_alignment;
+
+    PoolSetCollection<fastuidraw::PainterBrush> m_brush_pool;
+    PoolSetCollection<fastuidraw::PainterClipEquations> m_clip_equations_pool;
+    PoolSetCollection<fastuidraw::PainterItemMatrix> m_item_matrix_pool;
+    PoolSetCollection<fastuidraw::PainterItemShaderData> m_item_shader_data_pool;
+    PoolSetCollection<fastuidraw::PainterBlendShaderData> m_blend_shader_data_pool;
   };
 
-  class PainterPackerPrivate
+  class painter_state_location
   {
   public:
-    explicit
-    PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
-                         fastuidraw::PainterPacker *p);
+    uint32_t m_clipping_data_loc;
+    uint32_t m_item_matrix_data_loc;
+    uint32_t m_brush_shader_data_loc;
+    uint32_t m_item_shader_data_loc;
+    uint32_t m_blend_shader_data_loc;
+  };
 
-    void
-    start_new_command(void);
+  class PainterPackerPrivate;
+  class DisplayListPrivate;
 
-    void
-    upload_draw_state(const fastuidraw::PainterPackerData &draw_state);
+  typedef fastuidraw::vecN<unsigned int, fastuidraw::PainterPacker::number_stats> packer_stats;
 
-    unsigned int
-    compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state);
+  /* the kinds of state data packed for each draw
+   */
+  enum state_kind_t
+    {
+      clip_state,
+      item_matrix_state,
+      item_shader_data_state,
+      blend_shader_data_state,
+      brush_state,
 
-    template<typename T>
-    unsigned int
-    compute_room_needed_for_packing(const fastuidraw::PainterData::value<T> &obj)
+      number_state_kinds
+    };
+
+  bool
+  headers_equal(const fastuidraw::PainterHeader &a,
+                const fastuidraw::PainterHeader &b)
+  {
+    return a.m_clip_equations_location == b.m_clip_equations_location
+      && a.m_item_matrix_location == b.m_item_matrix_location
+      && a.m_brush_shader_data_location == b.m_brush_shader_data_location
+      && a.m_item_shader_data_location == b.m_item_shader_data_location
+      && a.m_blend_shader_data_location == b.m_blend_shader_data_location
+      && a.m_item_shader == b.m_item_shader
+      && a.m_brush_shader == b.m_brush_shader
+      && a.m_blend_shader == b.m_blend_shader
+      && a.m_z == b.m_z;
+  }
+
+  /* size of the arrays of the PainterDraw objects
+     returned by PainterBackend::map_draw()
+   */
+  class draw_capacity
+  {
+  public:
+    draw_capacity(void):
+      m_attributes(0),
+      m_indices(0),
+      m_store(0)
+    {}
+
+    unsigned int m_attributes, m_indices, m_store;
+  };
+
+  /* a header packed into a PainterDraw of a stream, recorded
+     so that its locations can be relocated when the stream
+     is spliced into the PainterDraw of a PainterPacker.
+   */
+  class recorded_header
+  {
+  public:
+    fastuidraw::PainterHeader m_header;
+    PainterShaderGroupPrivate m_group;
+    unsigned int m_location;
+    unsigned int m_attributes_written, m_indices_written;
+
+    /* true if what the draw of the header produces does
+       not depend on what is underneath it, see draw_is_opaque().
+     */
+    bool m_opaque;
+
+    /* values of the item matrix and clip equations
+       of the header, used by display lists.
+     */
+    fastuidraw::float3x3 m_item_matrix;
+    fastuidraw::PainterClipEquations m_clip;
+  };
+
+  /* how the headers of a display list are modified
+     when the display list is spliced into a PainterDraw.
+   */
+  class display_list_replay
+  {
+  public:
+    /* transformation to apply to the item matrix of each
+       header and its inverse transpose which is applied
+       to the clip equations.
+     */
+    fastuidraw::float3x3 m_transformation;
+    fastuidraw::float3x3 m_transformation_inverse_transpose;
+
+    /* headers whose clip equations are m_base_clip
+       take m_clip as their clip equations instead.
+     */
+    fastuidraw::PainterClipEquations m_base_clip, m_clip;
+
+    /* value added to the z of each header */
+    uint32_t m_z_offset;
+  };
+
+  /* the state of a header that triggers draw breaks
+   */
+  class draw_break_key
+  {
+  public:
+    draw_break_key(void):
+      m_item_group(0),
+      m_blend_group(0),
+      m_brush(0),
+      m_blend_mode(0)
+    {}
+
+    draw_break_key(const PainterShaderGroupPrivate &v, uint32_t brush_shader_mask):
+      m_item_group(v.m_item_group),
+      m_blend_group(v.m_blend_group),
+      m_brush(v.m_brush & brush_shader_mask),
+      m_blend_mode(v.m_blend_mode)
+    {}
+
+    bool
+    operator==(const draw_break_key &rhs) const
     {
-      if(obj.m_packed_value)
+      return m_item_group == rhs.m_item_group
+        && m_blend_group == rhs.m_blend_group
+        && m_brush == rhs.m_brush
+        && m_blend_mode == rhs.m_blend_mode;
+    }
+
+    bool
+    operator<(const draw_break_key &rhs) const
+    {
+      if(m_item_group != rhs.m_item_group)
         {
-          EntryBase *d;
-          d = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
-          if(d->m_painter == m_p && d->m_begin_id == m_number_begins
-             && d->m_draw_command_id == m_accumulated_draws.size())
-            {
-              return 0;
-            }
-          else
-            {
-              return d->m_data.size();
-            }
+          return m_item_group < rhs.m_item_group;
         }
-      else if(obj.m_value != NULL)
+      if(m_blend_group != rhs.m_blend_group)
         {
-          return obj.m_value->data_size(m_alignment);
+          return m_blend_group < rhs.m_blend_group;
         }
-      else
+      if(m_brush != rhs.m_brush)
         {
-          static T v;
-          return v.data_size(m_alignment);
+          return m_brush < rhs.m_brush;
         }
-    };
-
-    fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> m_backend;
-    fastuidraw::PainterShaderSet m_default_shaders;
-    unsigned int m_alignment;
-    unsigned int m_header_size;
+      return m_blend_mode < rhs.m_blend_mode;
+    }
 
-    fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend_shader;
-    uint64_t m_blend_mode;
-    painter_state_location m_painter_state_location;
-    int m_number_begins;
+    uint32_t m_item_group, m_blend_group, m_brush;
+    fastuidraw::BlendMode::packed_value m_blend_mode;
+  };
 
-    std::vector<per_draw_command> m_accumulated_draws;
-    fastuidraw::PainterPacker *m_p;
+  /* returns true if neither the blend shader nor the blend
+     mode read the framebuffer, i.e. a draw replaces what is
+     underneath it instead of blending with it.
+   */
+  bool
+  draw_is_opaque(const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                 uint64_t blend_mode)
+  {
+    fastuidraw::BlendMode mode(static_cast<fastuidraw::BlendMode::packed_value>(blend_mode));
 
-    PainterPackerPrivateWorkroom m_work_room;
-  };
-}
+    if(blend_shader && blend_shader->type() == fastuidraw::PainterBlendShader::framebuffer_fetch)
+      {
+        return false;
+      }
 
+    if(!mode.blending_on())
+      {
+        return true;
+      }
 
-//////////////////////////////////////////
-// per_draw_command methods
-per_draw_command::
-per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                 const fastuidraw::PainterBackend::ConfigurationBase &config):
-  m_draw_command(r),
-  m_attributes_written(0),
-  m_indices_written(0),
-  m_store_blocks_written(0),
-  m_alignment(config.alignment()),
-  m_brush_shader_mask(config.brush_shader_mask())
-{
-  m_prev_state.m_item_group = 0;
-  m_prev_state.m_brush = 0;
-  m_prev_state.m_blend_group = 0;
-}
+    if(mode.equation_rgb() == fastuidraw::BlendMode::MIN
+       || mode.equation_rgb() == fastuidraw::BlendMode::MAX
+       || mode.equation_alpha() == fastuidraw::BlendMode::MIN
+       || mode.equation_alpha() == fastuidraw::BlendMode::MAX
+       || mode.func_dst_rgb() != fastuidraw::BlendMode::ZERO
+       || mode.func_dst_alpha() != fastuidraw::BlendMode::ZERO)
+      {
+        return false;
+      }
 
+    for(unsigned int i = 0; i < 2; ++i)
+      {
+        enum fastuidraw::BlendMode::func_t f;
+
+        f = (i == 0) ? mode.func_src_rgb() : mode.func_src_alpha();
+        if(f == fastuidraw::BlendMode::DST_COLOR
+           || f == fastuidraw::BlendMode::ONE_MINUS_DST_COLOR
+           || f == fastuidraw::BlendMode::DST_ALPHA
+           || f == fastuidraw::BlendMode::ONE_MINUS_DST_ALPHA
+           || f == fastuidraw::BlendMode::SRC_ALPHA_SATURATE)
+          {
+            return false;
+          }
+      }
 
-fastuidraw::c_array<fastuidraw::generic_data>
-per_draw_command::
-allocate_store(unsigned int num_elements)
-{
-  fastuidraw::c_array<fastuidraw::generic_data> return_value;
-  assert(num_elements % m_alignment == 0);
-  return_value = m_draw_command->m_store.sub_array(store_written(), num_elements);
-  m_store_blocks_written += num_elements / m_alignment;
-  return return_value;
-}
+    return true;
+  }
 
-void
-per_draw_command::
-pack_state_data(PainterPackerPrivate *p,
-                EntryBase *d, uint32_t &location)
-{
-  if(d->m_painter == p->m_p && d->m_begin_id == p->m_number_begins
-     && d->m_draw_command_id == p->m_accumulated_draws.size())
-    {
-      location = d->m_offset;
-      return;
-    }
+  bool
+  clip_equations_equal(const fastuidraw::PainterClipEquations &a,
+                       const fastuidraw::PainterClipEquations &b)
+  {
+    for(unsigned int i = 0; i < 4; ++i)
+      {
+        if(a.m_clip_equations[i].x() != b.m_clip_equations[i].x()
+           || a.m_clip_equations[i].y() != b.m_clip_equations[i].y()
+           || a.m_clip_equations[i].z() != b.m_clip_equations[i].z())
+          {
+            return false;
+          }
+      }
+    return true;
+  }
 
-  /* data not in current data store add
-     it to the current store.
+  /* PainterDraw of a stream, memory is recycled by
+     the stream that created it.
    */
-  fastuidraw::const_c_array<fastuidraw::generic_data> src;
-  fastuidraw::c_array<fastuidraw::generic_data> dst;
+  class StreamBuffers
+  {
+  public:
+    explicit
+    StreamBuffers(const draw_capacity &cap):
+      m_attributes(cap.m_attributes),
+      m_header_attributes(cap.m_attributes),
+      m_indices(cap.m_indices),
+      m_store(cap.m_store)
+    {}
 
-  location = current_block();
-  src = fastuidraw::make_c_array(d->m_data);
-  dst = allocate_store(src.size());
-  std::copy(src.begin(), src.end(), dst.begin());
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+  };
 
-  d->m_painter = p->m_p;
-  d->m_begin_id = p->m_number_begins;
-  d->m_draw_command_id = p->m_accumulated_draws.size();
-  d->m_offset = location;
-}
+  class StreamChunk:public fastuidraw::PainterDraw
+  {
+  public:
+    StreamChunk(PainterPackerPrivate *stream, StreamBuffers *buffers);
 
-void
-per_draw_command::
-pack_painter_state(const fastuidraw::PainterPackerData &state,
-                   PainterPackerPrivate *p, painter_state_location &out_data)
-{
-  pack_state_data(p, state.m_clip, out_data.m_clipping_data_loc);
-  pack_state_data(p, state.m_matrix, out_data.m_item_matrix_data_loc);
-  pack_state_data(p, state.m_item_shader_data, out_data.m_item_shader_data_loc);
-  pack_state_data(p, state.m_blend_shader_data, out_data.m_blend_shader_data_loc);
-  pack_state_data(p, state.m_brush, out_data.m_brush_shader_data_loc);
+    ~StreamChunk();
 
-  /* We save a handle to the image and colorstop used by the brush,
-     to make sure the Image and ColorStopSequenceOnAtlas objects are
-     not deleted until the draw command built is sent down to the 3D
-     API.
-   */
-  const fastuidraw::PainterBrush &brush(fetch_value(state.m_brush));
-  if(brush.image() && m_last_image != brush.image())
+    /* release the memory past what was written,
+       must only be called after unmapping.
+     */
+    void
+    shrink(unsigned int attributes_written,
+           unsigned int indices_written,
+           unsigned int store_written);
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup&,
+               const fastuidraw::PainterShaderGroup&,
+               unsigned int, unsigned int) const
     {
-      m_last_image = brush.image();
-      m_images_active.push_back(m_last_image);
+      /* draw breaks are computed when the stream
+         is spliced, see per_draw_command::splice()
+       */
     }
 
-  if(brush.color_stops() && m_last_color_stop != brush.color_stops())
+    virtual
+    void
+    draw(void) const
     {
-      m_last_color_stop = brush.color_stops();
-      m_color_stops_active.push_back(m_last_color_stop);
+      assert(!"StreamChunk::draw() should never be called");
     }
-}
 
-unsigned int
-per_draw_command::
-pack_header(unsigned int header_size,
-            uint32_t brush_shader,
-            const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
-            uint64_t blend_mode,
-            const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
-            unsigned int z,
-            const painter_state_location &loc,
-            const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
-{
-  unsigned int return_value;
-  fastuidraw::c_array<fastuidraw::generic_data> dst;
-  fastuidraw::PainterHeader header;
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int, unsigned int, unsigned int) const
+    {}
 
-  return_value = current_block();
-  dst = allocate_store(header_size);
+  private:
+    PainterPackerPrivate *m_stream;
+    StreamBuffers *m_buffers;
+  };
 
-  if(call_back)
+  class per_draw_command
+  {
+  public:
+    per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
+                     const fastuidraw::PainterBackend::ConfigurationBase &config,
+                     bool record_headers, bool reorder,
+                     packer_stats *stats);
+
+    unsigned int
+    attribute_room(void)
     {
-      call_back->current_draw(m_draw_command);
+      assert(m_attributes_written <= m_draw_command->m_attributes.size());
+      return m_draw_command->m_attributes.size() - m_attributes_written;
     }
 
-  PainterShaderGroupPrivate current;
-  fastuidraw::PainterShader::Tag blend;
-
-  if(blend_shader)
+    unsigned int
+    index_room(void)
     {
-      blend = blend_shader->tag();
+      assert(m_indices_written <= m_draw_command->m_indices.size());
+      return m_draw_command->m_indices.size() - m_indices_written;
     }
-  current.m_item_group = item_shader->group();
-  current.m_brush = brush_shader;
-  current.m_blend_group = blend.m_group;
-  current.m_blend_mode = blend_mode;
 
-  header.m_clip_equations_location = loc.m_clipping_data_loc;
-  header.m_item_matrix_location = loc.m_item_matrix_data_loc;
-  header.m_brush_shader_data_location = loc.m_brush_shader_data_loc;
-  header.m_item_shader_data_location = loc.m_item_shader_data_loc;
-  header.m_blend_shader_data_location = loc.m_blend_shader_data_loc;
-  header.m_item_shader = item_shader->ID();
-  header.m_brush_shader = current.m_brush;
-  header.m_blend_shader = blend.m_ID;
-  header.m_z = z;
-  header.pack_data(m_alignment, dst);
+    unsigned int
+    store_room(void)
+    {
+      unsigned int s;
+      s = store_written();
+      assert(s <= m_draw_command->m_store.size());
+      return m_draw_command->m_store.size() - s;
+    }
 
-  if(current.m_item_group != m_prev_state.m_item_group
-     || current.m_blend_group != m_prev_state.m_blend_group
-     || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u
-     || current.m_blend_mode != m_prev_state.m_blend_mode)
+    unsigned int
+    store_written(void) const
     {
-      m_draw_command->draw_break(m_prev_state, current,
-                                 m_attributes_written,
-                                 m_indices_written);
+      return current_block() * m_alignment;
     }
 
-  m_prev_state = current;
+    void
+    unmap(void)
+    {
+      if(m_reorder)
+        {
+          reorder_and_break();
+        }
+      increment_stat(fastuidraw::PainterPacker::num_attributes, m_attributes_written);
+      increment_stat(fastuidraw::PainterPacker::num_indices, m_indices_written);
+      increment_stat(fastuidraw::PainterPacker::num_store_blocks, m_store_blocks_written);
+      m_draw_command->unmap(m_attributes_written, m_indices_written, store_written());
+    }
 
-  if(call_back)
+    bool
+    fits(const per_draw_command &src)
     {
-      call_back->header_added(header, dst);
+      return attribute_room() >= src.m_attributes_written
+        && index_room() >= src.m_indices_written
+        && store_room() >= src.m_store_blocks_written * src.m_alignment;
     }
 
-  return return_value;
+    void
+    splice(const per_draw_command &src, const display_list_replay *replay);
+
+    const std::vector<recorded_header>&
+    recorded_headers(void) const
+    {
+      return m_recorded_headers;
+    }
+
+    void
+    pack_painter_state(const fastuidraw::PainterPackerData &state,
+                       PainterPackerPrivate *p, painter_state_location &out_data);
+
+    unsigned int
+    pack_header(unsigned int header_size,
+                uint32_t brush_shader,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                uint64_t blend_mode,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
+                unsigned int z,
+                const painter_state_location &loc,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
+    unsigned int m_attributes_written, m_indices_written;
+
+  private:
+    fastuidraw::c_array<fastuidraw::generic_data>
+    allocate_store(unsigned int num_elements);
+
+    void
+    update_state(const PainterShaderGroupPrivate &current);
+
+    void
+    reorder_and_break(void);
+
+    void
+    increment_stat(enum fastuidraw::PainterPacker::stats_t st, unsigned int amount = 1)
+    {
+      if(m_stats)
+        {
+          (*m_stats)[st] += amount;
+        }
+    }
+
+    unsigned int
+    current_block(void) const
+    {
+      return m_store_blocks_written;
+    }
+
+    void
+    pack_state_data(PainterPackerPrivate *p, EntryBase *st_d,
+                    enum state_kind_t kind, uint32_t &location);
+
+    template<typename T>
+    void
+    pack_state_data_from_value(const T &st, enum state_kind_t kind, uint32_t &location)
+    {
+      fastuidraw::c_array<fastuidraw::generic_data> dst;
+      unsigned int data_sz;
+
+      location = current_block();
+      data_sz = st.data_size(m_alignment);
+      dst = allocate_store(data_sz);
+      st.pack_data(m_alignment, dst);
+      dedupe_state(kind, location);
+    }
+
+    template<typename T>
+    void
+    pack_state_data(PainterPackerPrivate *p,
+                    const fastuidraw::PainterData::value<T> &obj,
+                    enum state_kind_t kind,
+                    uint32_t &location)
+    {
+      if(obj.m_packed_value)
+        {
+          EntryBase *e;
+          e = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
+          pack_state_data(p, e, kind, location);
+        }
+      else if(obj.m_value != NULL)
+        {
+          pack_state_data_from_value(*obj.m_value, kind, location);
+        }
+      else
+        {
+          static T v;
+          pack_state_data_from_value(v, kind, location);
+        }
+    }
+
+    void
+    dedupe_state(enum state_kind_t kind, uint32_t &location);
+
+    unsigned int m_store_blocks_written;
+    unsigned int m_alignment;
+    fastuidraw::reference_counted_ptr<const fastuidraw::Image> m_last_image;
+    fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> m_last_color_stop;
+    std::list<fastuidraw::reference_counted_ptr<const fastuidraw::Image> > m_images_active;
+    std::list<fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> > m_color_stops_active;
+
+    uint32_t m_brush_shader_mask;
+    PainterShaderGroupPrivate m_prev_state;
+    fastuidraw::BlendMode m_prev_blend_mode;
+
+    /* if m_record_headers is true, then headers are recorded
+       to m_recorded_headers and draw breaks are not issued as
+       headers are added. If m_reorder is true, the draws are
+       reordered by state and the draw breaks issued just before
+       unmapping.
+     */
+    bool m_record_headers, m_reorder;
+    std::vector<recorded_header> m_recorded_headers;
+
+    /* NULL for the PainterDraw objects of streams
+       and display lists.
+     */
+    packer_stats *m_stats;
+
+    /* location and size in blocks of the state data last packed
+       for each kind of state, and the last header packed; used to
+       reuse the data of the previous draw when it is the same.
+     */
+    fastuidraw::vecN<unsigned int, number_state_kinds> m_last_state_location;
+    fastuidraw::vecN<unsigned int, number_state_kinds> m_last_state_blocks;
+    bool m_last_header_reusable;
+    fastuidraw::PainterHeader m_last_header;
+    PainterShaderGroupPrivate m_last_header_group;
+    unsigned int m_last_header_location;
+    fastuidraw::float3x3 m_recorded_item_matrix;
+    fastuidraw::PainterClipEquations m_recorded_clip;
+  };
+
+  class PainterPackerPrivateWorkroom
+  {
+  public:
+    std::vector<unsigned int> m_attribs_loaded;
+  };
+
+  class PainterPackerPrivate
+  {
+  public:
+    explicit
+    PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
+                         fastuidraw::PainterPacker *p);
+
+    /* ctor for the private data of a PainterPacker::Stream
+     */
+    explicit
+    PainterPackerPrivate(const PainterPackerPrivate &parent);
+
+    ~PainterPackerPrivate();
+
+    void
+    start_new_command(void);
+
+    void
+    upload_draw_state(const fastuidraw::PainterPackerData &draw_state);
+
+    unsigned int
+    compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state);
+
+    template<typename T>
+    unsigned int
+    compute_room_needed_for_packing(const fastuidraw::PainterData::value<T> &obj)
+    {
+      if(obj.m_packed_value)
+        {
+          EntryBase *d;
+          d = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
+          if(m_p != NULL && d->m_painter == m_p && d->m_begin_id == m_number_begins
+             && d->m_draw_command_id == m_accumulated_draws.size())
+            {
+              return 0;
+            }
+          else
+            {
+              return d->m_data.size();
+            }
+        }
+      else if(obj.m_value != NULL)
+        {
+          return obj.m_value->data_size(m_alignment);
+        }
+      else
+        {
+          static T v;
+          return v.data_size(m_alignment);
+        }
+    };
+
+    void
+    draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                 const fastuidraw::PainterPackerData &draw,
+                 fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                 fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                 fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                 unsigned int z,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    void
+    splice_stream(const PainterPackerPrivate *stream, const display_list_replay *replay);
+
+    void
+    clear_stream(void);
+
+    void
+    shrink_stream(void);
+
+    StreamBuffers*
+    acquire_stream_buffers(void);
+
+    void
+    release_stream_buffers(StreamBuffers *b);
+
+    /* m_backend is NULL exactly when this object
+       is the private data of a PainterPacker::Stream.
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> m_backend;
+    fastuidraw::PainterBackend::ConfigurationBase m_config;
+    fastuidraw::PainterShaderSet m_default_shaders;
+    unsigned int m_alignment;
+    unsigned int m_header_size;
+
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend_shader;
+    uint64_t m_blend_mode;
+    painter_state_location m_painter_state_location;
+    int m_number_begins;
+
+    std::vector<per_draw_command> m_accumulated_draws;
+    fastuidraw::PainterPacker *m_p;
+
+    draw_capacity m_capacity;
+    std::vector<StreamBuffers*> m_free_stream_buffers;
+    DisplayListPrivate *m_recording;
+    bool m_reorder_draws;
+
+    /* stats of the current begin()/end() pair
+       and of the last begin()/end() pair.
+     */
+    packer_stats m_stats, m_last_stats;
+
+    PainterPackerPrivateWorkroom m_work_room;
+  };
+
+  class DisplayListPrivate
+  {
+  public:
+    explicit
+    DisplayListPrivate(const PainterPackerPrivate &parent):
+      m_draws(parent),
+      m_base_z(0),
+      m_z_span(0),
+      m_bytes(0),
+      m_number_headers(0)
+    {}
+
+    void
+    finalize(void);
+
+    PainterPackerPrivate m_draws;
+    fastuidraw::float3x3 m_base_transformation;
+    fastuidraw::PainterClipEquations m_base_clip;
+    unsigned int m_base_z, m_z_span;
+    unsigned int m_bytes, m_number_headers;
+  };
+}
+
+
+//////////////////////////////////////////
+// ConcurrentPoolBase methods
+void
+ConcurrentPoolBase::
+return_entry(EntryBase *e)
+{
+  EntryBase *head;
+
+  head = m_returned.load(boost::memory_order_relaxed);
+  do
+    {
+      e->m_next_free = head;
+    }
+  while(!m_returned.compare_exchange_weak(head, e, boost::memory_order_release, boost::memory_order_relaxed));
+}
+
+//////////////////////////////////////////
+// StreamChunk methods
+StreamChunk::
+StreamChunk(PainterPackerPrivate *stream, StreamBuffers *buffers):
+  m_stream(stream),
+  m_buffers(buffers)
+{
+  m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+  m_store = fastuidraw::make_c_array(m_buffers->m_store);
+}
+
+StreamChunk::
+~StreamChunk()
+{
+  m_stream->release_stream_buffers(m_buffers);
+}
+
+void
+StreamChunk::
+shrink(unsigned int attributes_written,
+       unsigned int indices_written,
+       unsigned int store_written)
+{
+  assert(unmapped());
+
+  std::vector<fastuidraw::PainterAttribute>(m_buffers->m_attributes.begin(),
+                                            m_buffers->m_attributes.begin() + attributes_written).swap(m_buffers->m_attributes);
+  std::vector<uint32_t>(m_buffers->m_header_attributes.begin(),
+                        m_buffers->m_header_attributes.begin() + attributes_written).swap(m_buffers->m_header_attributes);
+  std::vector<fastuidraw::PainterIndex>(m_buffers->m_indices.begin(),
+                                        m_buffers->m_indices.begin() + indices_written).swap(m_buffers->m_indices);
+  std::vector<fastuidraw::generic_data>(m_buffers->m_store.begin(),
+                                        m_buffers->m_store.begin() + store_written).swap(m_buffers->m_store);
+
+  m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+  m_store = fastuidraw::make_c_array(m_buffers->m_store);
+}
+
+//////////////////////////////////////////
+// per_draw_command methods
+per_draw_command::
+per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
+                 const fastuidraw::PainterBackend::ConfigurationBase &config,
+                 bool record_headers, bool reorder,
+                 packer_stats *stats):
+  m_draw_command(r),
+  m_attributes_written(0),
+  m_indices_written(0),
+  m_store_blocks_written(0),
+  m_alignment(config.alignment()),
+  m_brush_shader_mask(config.brush_shader_mask()),
+  m_record_headers(record_headers || reorder),
+  m_reorder(reorder),
+  m_stats(stats),
+  m_last_state_location(0),
+  m_last_state_blocks(0),
+  m_last_header_reusable(false),
+  m_last_header_location(0)
+{
+  m_prev_state.m_item_group = 0;
+  m_prev_state.m_brush = 0;
+  m_prev_state.m_blend_group = 0;
+}
+
+
+fastuidraw::c_array<fastuidraw::generic_data>
+per_draw_command::
+allocate_store(unsigned int num_elements)
+{
+  fastuidraw::c_array<fastuidraw::generic_data> return_value;
+  assert(num_elements % m_alignment == 0);
+  return_value = m_draw_command->m_store.sub_array(store_written(), num_elements);
+  m_store_blocks_written += num_elements / m_alignment;
+  return return_value;
+}
+
+void
+per_draw_command::
+pack_state_data(PainterPackerPrivate *p,
+                EntryBase *d, enum state_kind_t kind,
+                uint32_t &location)
+{
+  /* the packed value cache is not used by streams because
+     streams are filled from threads other than the thread
+     of the PainterPacker.
+   */
+  bool use_cache(p->m_p != NULL);
+
+  if(use_cache && d->m_painter == p->m_p && d->m_begin_id == p->m_number_begins
+     && d->m_draw_command_id == p->m_accumulated_draws.size())
+    {
+      location = d->m_offset;
+      m_last_state_location[kind] = location;
+      m_last_state_blocks[kind] = d->m_data.size() / m_alignment;
+      increment_stat(fastuidraw::PainterPacker::num_packed_value_reuses);
+      return;
+    }
+
+  /* data not in current data store add
+     it to the current store.
+   */
+  fastuidraw::const_c_array<fastuidraw::generic_data> src;
+  fastuidraw::c_array<fastuidraw::generic_data> dst;
+
+  location = current_block();
+  src = fastuidraw::make_c_array(d->m_data);
+  dst = allocate_store(src.size());
+  std::copy(src.begin(), src.end(), dst.begin());
+  dedupe_state(kind, location);
+
+  if(use_cache)
+    {
+      d->m_painter = p->m_p;
+      d->m_begin_id = p->m_number_begins;
+      d->m_draw_command_id = p->m_accumulated_draws.size();
+      d->m_offset = location;
+    }
+}
+
+void
+per_draw_command::
+dedupe_state(enum state_kind_t kind, uint32_t &location)
+{
+  /* the data at location was just packed and is the
+     end of the store; if it is the same as the data
+     last packed for kind, take it back and use the
+     data last packed instead.
+   */
+  unsigned int blocks, last_location;
+  bool same;
+
+  blocks = m_store_blocks_written - location;
+  last_location = m_last_state_location[kind];
+  same = (blocks == m_last_state_blocks[kind] && blocks > 0 && last_location != location);
+  for(unsigned int i = 0, endi = blocks * m_alignment; same && i < endi; ++i)
+    {
+      same = (m_draw_command->m_store[location * m_alignment + i].u
+              == m_draw_command->m_store[last_location * m_alignment + i].u);
+    }
+
+  if(same)
+    {
+      m_store_blocks_written = location;
+      location = last_location;
+      increment_stat(fastuidraw::PainterPacker::num_state_reuses);
+    }
+  else
+    {
+      m_last_state_location[kind] = location;
+      m_last_state_blocks[kind] = blocks;
+      increment_stat(fastuidraw::PainterPacker::num_state_packs);
+    }
+}
+
+void
+per_draw_command::
+pack_painter_state(const fastuidraw::PainterPackerData &state,
+                   PainterPackerPrivate *p, painter_state_location &out_data)
+{
+  pack_state_data(p, state.m_clip, clip_state, out_data.m_clipping_data_loc);
+  pack_state_data(p, state.m_matrix, item_matrix_state, out_data.m_item_matrix_data_loc);
+  pack_state_data(p, state.m_item_shader_data, item_shader_data_state, out_data.m_item_shader_data_loc);
+  pack_state_data(p, state.m_blend_shader_data, blend_shader_data_state, out_data.m_blend_shader_data_loc);
+  pack_state_data(p, state.m_brush, brush_state, out_data.m_brush_shader_data_loc);
+
+  if(m_record_headers)
+    {
+      m_recorded_item_matrix = fetch_value(state.m_matrix).m_item_matrix;
+      m_recorded_clip = fetch_value(state.m_clip);
+    }
+
+  /* We save a handle to the image and colorstop used by the brush,
+     to make sure the Image and ColorStopSequenceOnAtlas objects are
+     not deleted until the draw command built is sent down to the 3D
+     API.
+   */
+  const fastuidraw::PainterBrush &brush(fetch_value(state.m_brush));
+  if(brush.image() && m_last_image != brush.image())
+    {
+      m_last_image = brush.image();
+      m_images_active.push_back(m_last_image);
+    }
+
+  if(brush.color_stops() && m_last_color_stop != brush.color_stops())
+    {
+      m_last_color_stop = brush.color_stops();
+      m_color_stops_active.push_back(m_last_color_stop);
+    }
+}
+
+unsigned int
+per_draw_command::
+pack_header(unsigned int header_size,
+            uint32_t brush_shader,
+            const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+            uint64_t blend_mode,
+            const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
+            unsigned int z,
+            const painter_state_location &loc,
+            const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  unsigned int return_value;
+  fastuidraw::c_array<fastuidraw::generic_data> dst;
+  fastuidraw::PainterHeader header;
+
+  if(call_back)
+    {
+      call_back->current_draw(m_draw_command);
+    }
+
+  PainterShaderGroupPrivate current;
+  fastuidraw::PainterShader::Tag blend;
+
+  if(blend_shader)
+    {
+      blend = blend_shader->tag();
+    }
+  current.m_item_group = item_shader->group();
+  current.m_brush = brush_shader;
+  current.m_blend_group = blend.m_group;
+  current.m_blend_mode = blend_mode;
+
+  header.m_clip_equations_location = loc.m_clipping_data_loc;
+  header.m_item_matrix_location = loc.m_item_matrix_data_loc;
+  header.m_brush_shader_data_location = loc.m_brush_shader_data_loc;
+  header.m_item_shader_data_location = loc.m_item_shader_data_loc;
+  header.m_blend_shader_data_location = loc.m_blend_shader_data_loc;
+  header.m_item_shader = item_shader->ID();
+  header.m_brush_shader = current.m_brush;
+  header.m_blend_shader = blend.m_ID;
+  header.m_z = z;
+
+  /* If the header is the same as the previous header, the
+     attributes can point to the previous header. A header
+     given to a DataCallBack may be modified later, so such
+     headers are never shared.
+   */
+  if(!call_back && m_last_header_reusable
+     && headers_equal(header, m_last_header)
+     && draw_break_key(current, ~0u) == draw_break_key(m_last_header_group, ~0u))
+    {
+      increment_stat(fastuidraw::PainterPacker::num_header_reuses);
+      return m_last_header_location;
+    }
+
+  return_value = current_block();
+  dst = allocate_store(header_size);
+  header.pack_data(m_alignment, dst);
+  increment_stat(fastuidraw::PainterPacker::num_headers);
+
+  m_last_header_reusable = !call_back;
+  m_last_header = header;
+  m_last_header_group = current;
+  m_last_header_location = return_value;
+
+  if(m_record_headers)
+    {
+      recorded_header R;
+
+      R.m_header = header;
+      R.m_group = current;
+      R.m_location = return_value;
+      R.m_attributes_written = m_attributes_written;
+      R.m_indices_written = m_indices_written;
+      R.m_opaque = draw_is_opaque(blend_shader, blend_mode);
+      R.m_item_matrix = m_recorded_item_matrix;
+      R.m_clip = m_recorded_clip;
+      m_recorded_headers.push_back(R);
+    }
+  else
+    {
+      update_state(current);
+    }
+
+  if(call_back)
+    {
+      call_back->header_added(header, dst);
+    }
+
+  return return_value;
+}
+
+void
+per_draw_command::
+update_state(const PainterShaderGroupPrivate &current)
+{
+  if(current.m_item_group != m_prev_state.m_item_group
+     || current.m_blend_group != m_prev_state.m_blend_group
+     || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u
+     || current.m_blend_mode != m_prev_state.m_blend_mode)
+    {
+      m_draw_command->draw_break(m_prev_state, current,
+                                 m_attributes_written,
+                                 m_indices_written);
+
+      increment_stat(fastuidraw::PainterPacker::num_draw_breaks);
+      if(current.m_item_group != m_prev_state.m_item_group)
+        {
+          increment_stat(fastuidraw::PainterPacker::num_item_shader_breaks);
+        }
+      if(current.m_blend_group != m_prev_state.m_blend_group)
+        {
+          increment_stat(fastuidraw::PainterPacker::num_blend_shader_breaks);
+        }
+      if((m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u)
+        {
+          increment_stat(fastuidraw::PainterPacker::num_brush_shader_breaks);
+        }
+      if(current.m_blend_mode != m_prev_state.m_blend_mode)
+        {
+          increment_stat(fastuidraw::PainterPacker::num_blend_mode_breaks);
+        }
+    }
+
+  m_prev_state = current;
+}
+
+void
+per_draw_command::
+reorder_and_break(void)
+{
+  unsigned int num_headers(m_recorded_headers.size());
+  unsigned int total_indices(m_indices_written);
+
+  if(num_headers == 0)
+    {
+      return;
+    }
+
+  /* The indices following a header up to the next header are
+     the indices of that header. Headers are grouped by the state
+     that causes a draw break, the groups taken in the order of their
+     first header. The depth test only resolves the order of draws
+     that replace what is underneath them, so a header is moved
+     ahead of earlier headers only within a run of consecutive
+     headers that are opaque (see draw_is_opaque()) and share
+     the blend mode; draws that blend (text, anti-aliasing passes,
+     translucent brushes, blend modes that read the framebuffer)
+     and changes of blend mode are never reordered across. Within
+     a run, a header is moved ahead of an earlier header only if
+     their z-values differ; headers sharing a z-value keep their
+     order.
+   */
+  std::vector<unsigned int> run_start(num_headers);
+  std::vector<int> prev_same_z(num_headers, -1);
+  std::vector<bool> emitted(num_headers, false);
+  std::map<draw_break_key, std::vector<unsigned int> > groups;
+  std::map<draw_break_key, unsigned int> group_heads;
+  std::vector<draw_break_key> keys(num_headers);
+  {
+    std::map<uint32_t, int> last_with_z;
+    for(unsigned int i = 0; i < num_headers; ++i)
+      {
+        std::map<uint32_t, int>::iterator iter;
+        uint32_t z(m_recorded_headers[i].m_header.m_z);
+
+        iter = last_with_z.find(z);
+        if(iter != last_with_z.end())
+          {
+            prev_same_z[i] = iter->second;
+            iter->second = i;
+          }
+        else
+          {
+            last_with_z[z] = i;
+          }
+        keys[i] = draw_break_key(m_recorded_headers[i].m_group, m_brush_shader_mask);
+        groups[keys[i]].push_back(i);
+
+        if(i > 0
+           && m_recorded_headers[i].m_opaque
+           && m_recorded_headers[i - 1].m_opaque
+           && m_recorded_headers[i].m_group.m_blend_mode == m_recorded_headers[i - 1].m_group.m_blend_mode)
+          {
+            run_start[i] = run_start[i - 1];
+          }
+        else
+          {
+            run_start[i] = i;
+          }
+      }
+  }
+
+  std::vector<fastuidraw::PainterIndex> src_indices(m_draw_command->m_indices.begin(),
+                                                    m_draw_command->m_indices.begin() + total_indices);
+  unsigned int first_pending(0), dst_index(0);
+
+  while(first_pending < num_headers)
+    {
+      /* the first header not yet emitted is always ready,
+         emit all ready headers with its state.
+       */
+      const draw_break_key &key(keys[first_pending]);
+      const std::vector<unsigned int> &group(groups[key]);
+      unsigned int &head(group_heads[key]);
+
+      while(head < group.size()
+            && run_start[group[head]] <= first_pending
+            && (prev_same_z[group[head]] == -1 || emitted[prev_same_z[group[head]]]))
+        {
+          unsigned int h(group[head]), begin, end;
+
+          begin = m_recorded_headers[h].m_indices_written;
+          end = (h + 1 < num_headers) ? m_recorded_headers[h + 1].m_indices_written : total_indices;
+
+          m_indices_written = dst_index;
+          update_state(m_recorded_headers[h].m_group);
+          std::copy(src_indices.begin() + begin, src_indices.begin() + end,
+                    m_draw_command->m_indices.begin() + dst_index);
+          dst_index += end - begin;
+
+          emitted[h] = true;
+          ++head;
+        }
+
+      while(first_pending < num_headers && emitted[first_pending])
+        {
+          ++first_pending;
+        }
+    }
+
+  assert(dst_index == total_indices);
+  m_indices_written = total_indices;
+  m_recorded_headers.clear();
+}
+
+void
+per_draw_command::
+splice(const per_draw_command &src, const display_list_replay *replay)
+{
+  unsigned int attrib_offset, index_offset, block_offset, header_size;
+  fastuidraw::const_c_array<fastuidraw::generic_data> src_store;
+  fastuidraw::c_array<fastuidraw::generic_data> dst_store;
+
+  assert(src.m_alignment == m_alignment);
+  assert(fits(src));
+
+  attrib_offset = m_attributes_written;
+  index_offset = m_indices_written;
+  block_offset = current_block();
+  header_size = fastuidraw::PainterHeader::data_size(m_alignment);
+
+  /* the last header is not the header of the last
+     indices anymore, so it cannot be reused.
+   */
+  m_last_header_reusable = false;
+
+  /* copy the data store verbatim, then overwrite the
+     headers with their locations relocated.
+   */
+  src_store = src.m_draw_command->m_store.sub_array(0, src.store_written());
+  dst_store = allocate_store(src_store.size());
+  std::copy(src_store.begin(), src_store.end(), dst_store.begin());
+
+  for(std::vector<recorded_header>::const_iterator iter = src.m_recorded_headers.begin(),
+        end = src.m_recorded_headers.end(); iter != end; ++iter)
+    {
+      fastuidraw::PainterHeader header(iter->m_header);
+      fastuidraw::c_array<fastuidraw::generic_data> dst_header;
+
+      dst_header = dst_store.sub_array(iter->m_location * m_alignment, header_size);
+
+      header.m_clip_equations_location += block_offset;
+      header.m_item_matrix_location += block_offset;
+      header.m_brush_shader_data_location += block_offset;
+      header.m_item_shader_data_location += block_offset;
+      header.m_blend_shader_data_location += block_offset;
+
+      /* the z-value may have been changed after the header was
+         packed (for example by a PainterDraw::DelayedAction),
+         so take the value from the store.
+       */
+      header.m_z = dst_header[fastuidraw::PainterHeader::z_offset].u;
+
+      if(replay)
+        {
+          fastuidraw::PainterItemMatrix matrix(replay->m_transformation * iter->m_item_matrix);
+          fastuidraw::PainterClipEquations clip;
+
+          if(clip_equations_equal(iter->m_clip, replay->m_base_clip))
+            {
+              clip = replay->m_clip;
+            }
+          else
+            {
+              for(unsigned int i = 0; i < 4; ++i)
+                {
+                  clip.m_clip_equations[i] = replay->m_transformation_inverse_transpose * iter->m_clip.m_clip_equations[i];
+                }
+            }
+
+          /* the packed value cache is not used by streams and display
+             lists, so the item matrix and clip equations of a header are
+             only shared with headers whose item matrix and clip equations
+             have the same values; thus they can be overwritten in place.
+           */
+          matrix.pack_data(m_alignment, dst_store.sub_array((header.m_item_matrix_location - block_offset) * m_alignment,
+                                                            matrix.data_size(m_alignment)));
+          clip.pack_data(m_alignment, dst_store.sub_array((header.m_clip_equations_location - block_offset) * m_alignment,
+                                                          clip.data_size(m_alignment)));
+          header.m_z += replay->m_z_offset;
+        }
+
+      header.pack_data(m_alignment, dst_header);
+      increment_stat(fastuidraw::PainterPacker::num_headers);
+
+      /* draw breaks are issued with the attribute and
+         index counts as they were when the header was
+         packed into the stream.
+       */
+      m_attributes_written = attrib_offset + iter->m_attributes_written;
+      m_indices_written = index_offset + iter->m_indices_written;
+      if(m_record_headers)
+        {
+          recorded_header R(*iter);
+
+          R.m_header = header;
+          R.m_location = iter->m_location + block_offset;
+          R.m_attributes_written = m_attributes_written;
+          R.m_indices_written = m_indices_written;
+          m_recorded_headers.push_back(R);
+        }
+      else
+        {
+          update_state(iter->m_group);
+        }
+    }
+
+  fastuidraw::const_c_array<fastuidraw::PainterAttribute> src_attribs;
+  fastuidraw::const_c_array<uint32_t> src_headers;
+  fastuidraw::const_c_array<fastuidraw::PainterIndex> src_indices;
+  fastuidraw::c_array<fastuidraw::PainterAttribute> dst_attribs;
+  fastuidraw::c_array<uint32_t> dst_headers;
+  fastuidraw::c_array<fastuidraw::PainterIndex> dst_indices;
+
+  src_attribs = src.m_draw_command->m_attributes.sub_array(0, src.m_attributes_written);
+  src_headers = src.m_draw_command->m_header_attributes.sub_array(0, src.m_attributes_written);
+  src_indices = src.m_draw_command->m_indices.sub_array(0, src.m_indices_written);
+
+  dst_attribs = m_draw_command->m_attributes.sub_array(attrib_offset, src_attribs.size());
+  dst_headers = m_draw_command->m_header_attributes.sub_array(attrib_offset, src_headers.size());
+  dst_indices = m_draw_command->m_indices.sub_array(index_offset, src_indices.size());
+
+  std::copy(src_attribs.begin(), src_attribs.end(), dst_attribs.begin());
+
+  for(unsigned int i = 0; i < src_headers.size(); ++i)
+    {
+      dst_headers[i] = src_headers[i] + block_offset;
+    }
+
+  for(unsigned int i = 0; i < src_indices.size(); ++i)
+    {
+      dst_indices[i] = src_indices[i] + attrib_offset;
+    }
+
+  m_attributes_written = attrib_offset + src.m_attributes_written;
+  m_indices_written = index_offset + src.m_indices_written;
+
+  m_images_active.insert(m_images_active.end(), src.m_images_active.begin(), src.m_images_active.end());
+  m_color_stops_active.insert(m_color_stops_active.end(), src.m_color_stops_active.begin(), src.m_color_stops_active.end());
 }
 
 ///////////////////////////////////////////
@@ -679,9 +1878,14 @@ PainterPackerPrivate::
 PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
                      fastuidraw::PainterPacker *p):
   m_backend(backend),
-  m_p(p)
+  m_config(backend->configuration_base()),
+  m_p(p),
+  m_recording(NULL),
+  m_reorder_draws(false),
+  m_stats(0),
+  m_last_stats(0)
 {
-  m_alignment = m_backend->configuration_base().alignment();
+  m_alignment = m_config.alignment();
   m_header_size = fastuidraw::PainterHeader::data_size(m_alignment);
   // By calling PainterBackend::default_shaders(), we make the shaders
   // registered. By setting m_default_shaders to its return value,
@@ -692,6 +1896,39 @@ PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBacken
   m_number_begins = 0;
 }
 
+PainterPackerPrivate::
+PainterPackerPrivate(const PainterPackerPrivate &parent):
+  m_config(parent.m_config),
+  m_default_shaders(parent.m_default_shaders),
+  m_alignment(parent.m_alignment),
+  m_header_size(parent.m_header_size),
+  m_blend_shader(parent.m_blend_shader),
+  m_blend_mode(parent.m_blend_mode),
+  m_number_begins(0),
+  m_p(NULL),
+  m_capacity(parent.m_capacity),
+  m_recording(NULL),
+  m_reorder_draws(false),
+  m_stats(0),
+  m_last_stats(0)
+{
+}
+
+PainterPackerPrivate::
+~PainterPackerPrivate()
+{
+  /* the StreamChunk objects return their buffers
+     on their dtor, so clear them first.
+   */
+  FASTUIDRAWdelete(m_recording);
+  m_accumulated_draws.clear();
+  for(std::vector<StreamBuffers*>::iterator iter = m_free_stream_buffers.begin(),
+        end = m_free_stream_buffers.end(); iter != end; ++iter)
+    {
+      FASTUIDRAWdelete(*iter);
+    }
+}
+
 void
 PainterPackerPrivate::
 start_new_command(void)
@@ -701,37 +1938,325 @@ start_new_command(void)
       m_accumulated_draws.back().unmap();
     }
 
-  fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
-  r = m_backend->map_draw();
-  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base()));
-}
+  fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
+  if(m_backend)
+    {
+      r = m_backend->map_draw();
+      ++m_stats[fastuidraw::PainterPacker::num_draws];
+
+      /* all PainterDraw objects of a backend are expected to be the same
+         size, streams use the sizes to make sure a chunk of a stream fits
+         within a single PainterDraw.
+       */
+      m_capacity.m_attributes = r->m_attributes.size();
+      m_capacity.m_indices = r->m_indices.size();
+      m_capacity.m_store = r->m_store.size();
+    }
+  else
+    {
+      r = FASTUIDRAWnew StreamChunk(this, acquire_stream_buffers());
+    }
+  m_accumulated_draws.push_back(per_draw_command(r, m_config, !m_backend,
+                                                 m_backend && m_reorder_draws,
+                                                 m_backend ? &m_stats : NULL));
+}
+
+StreamBuffers*
+PainterPackerPrivate::
+acquire_stream_buffers(void)
+{
+  StreamBuffers *return_value;
+  if(m_free_stream_buffers.empty())
+    {
+      return_value = FASTUIDRAWnew StreamBuffers(m_capacity);
+    }
+  else
+    {
+      return_value = m_free_stream_buffers.back();
+      m_free_stream_buffers.pop_back();
+    }
+  return return_value;
+}
+
+void
+PainterPackerPrivate::
+release_stream_buffers(StreamBuffers *b)
+{
+  m_free_stream_buffers.push_back(b);
+}
+
+void
+PainterPackerPrivate::
+clear_stream(void)
+{
+  assert(!m_backend);
+  m_accumulated_draws.clear();
+}
+
+void
+PainterPackerPrivate::
+shrink_stream(void)
+{
+  assert(!m_backend);
+  if(!m_accumulated_draws.empty())
+    {
+      m_accumulated_draws.back().unmap();
+    }
+
+  /* The StreamChunk objects are only referenced by the
+     per_draw_command objects of this, so casting away
+     the const is safe.
+   */
+  for(std::vector<per_draw_command>::iterator iter = m_accumulated_draws.begin(),
+        end = m_accumulated_draws.end(); iter != end; ++iter)
+    {
+      const StreamChunk *chunk;
+
+      chunk = static_cast<const StreamChunk*>(iter->m_draw_command.get());
+      const_cast<StreamChunk*>(chunk)->shrink(iter->m_attributes_written,
+                                              iter->m_indices_written,
+                                              iter->store_written());
+    }
+}
+
+void
+PainterPackerPrivate::
+splice_stream(const PainterPackerPrivate *stream, const display_list_replay *replay)
+{
+  assert(m_backend);
+  assert(!stream->m_backend);
+  assert(!m_accumulated_draws.empty());
+
+  for(std::vector<per_draw_command>::const_iterator iter = stream->m_accumulated_draws.begin(),
+        end = stream->m_accumulated_draws.end(); iter != end; ++iter)
+    {
+      if(iter->m_indices_written == 0)
+        {
+          continue;
+        }
+
+      if(!m_accumulated_draws.back().fits(*iter))
+        {
+          start_new_command();
+          assert(m_accumulated_draws.back().fits(*iter));
+        }
+      m_accumulated_draws.back().splice(*iter, replay);
+    }
+}
+
+unsigned int
+PainterPackerPrivate::
+compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
+{
+  unsigned int R(0);
+  R += compute_room_needed_for_packing(draw_state.m_clip);
+  R += compute_room_needed_for_packing(draw_state.m_matrix);
+  R += compute_room_needed_for_packing(draw_state.m_brush);
+  R += compute_room_needed_for_packing(draw_state.m_item_shader_data);
+  R += compute_room_needed_for_packing(draw_state.m_blend_shader_data);
+  return R;
+}
+
+void
+PainterPackerPrivate::
+upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
+{
+  unsigned int needed_room;
+
+  assert(!m_accumulated_draws.empty());
+  needed_room = compute_room_needed_for_packing(draw_state);
+  if(needed_room > m_accumulated_draws.back().store_room())
+    {
+      start_new_command();
+    }
+  m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
+}
+
+void
+PainterPackerPrivate::
+draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+             const fastuidraw::PainterPackerData &draw,
+             fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+             fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+             fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+             unsigned int z,
+             const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  bool allocate_header;
+  unsigned int header_loc;
+  const unsigned int NOT_LOADED = ~0u;
+
+  assert((attrib_chunk_selector.empty() && attrib_chunks.size() == index_chunks.size())
+         || (attrib_chunk_selector.size() == index_chunks.size()) );
+
+  if(attrib_chunks.empty() || !shader)
+    {
+      /* should we emit a warning message that the PainterItemShader
+         was missing the item shader value?
+       */
+      return;
+    }
+
+  m_work_room.m_attribs_loaded.clear();
+  m_work_room.m_attribs_loaded.resize(attrib_chunk_selector.size(), NOT_LOADED);
+
+  assert(shader);
+
+  upload_draw_state(draw);
+  allocate_header = true;
+
+  for(unsigned chunk = 0, num_chunks = index_chunks.size(); chunk < num_chunks; ++chunk)
+    {
+      unsigned int attrib_room, index_room, data_room;
+      unsigned int attrib_src, needed_attrib_room;
+
+      attrib_room = m_accumulated_draws.back().attribute_room();
+      index_room = m_accumulated_draws.back().index_room();
+      data_room = m_accumulated_draws.back().store_room();
+
+      if(attrib_chunk_selector.empty())
+        {
+          attrib_src = chunk;
+          needed_attrib_room = attrib_chunks[attrib_src].size();
+        }
+      else
+        {
+          attrib_src = attrib_chunk_selector[chunk];
+          needed_attrib_room = (m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED) ?
+            attrib_chunks[attrib_src].size() :
+            0;
+        }
+
+      if(index_chunks[chunk].empty() || attrib_chunks[attrib_src].empty())
+        {
+          continue;
+        }
+
+      if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size()
+         || (allocate_header && data_room < m_header_size))
+        {
+          start_new_command();
+          upload_draw_state(draw);
+
+          /* reset attribs_loaded[] and recompute needed_attrib_room
+           */
+          if(!attrib_chunk_selector.empty())
+            {
+              std::fill(m_work_room.m_attribs_loaded.begin(), m_work_room.m_attribs_loaded.end(), NOT_LOADED);
+              needed_attrib_room = attrib_chunks[attrib_src].size();
+            }
+
+          attrib_room = m_accumulated_draws.back().attribute_room();
+          index_room = m_accumulated_draws.back().index_room();
+          data_room = m_accumulated_draws.back().store_room();
+          allocate_header = true;
+
+          if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size())
+            {
+              assert(!"Unable to fit chunk into freshly allocated draw command, not good!");
+              continue;
+            }
+
+          assert(data_room >= m_header_size);
+        }
+
+      per_draw_command &cmd(m_accumulated_draws.back());
+      if(allocate_header)
+        {
+          allocate_header = false;
+          header_loc = cmd.pack_header(m_header_size,
+                                       fetch_value(draw.m_brush).shader(),
+                                       m_blend_shader,
+                                       m_blend_mode,
+                                       shader,
+                                       z, m_painter_state_location,
+                                       call_back);
+        }
+
+      /* copy attribute data and get offset into attribute buffer
+         where attributes are copied
+       */
+      unsigned int attrib_offset;
+
+      if(needed_attrib_room > 0)
+        {
+          fastuidraw::c_array<fastuidraw::PainterAttribute> attrib_dst_ptr;
+          fastuidraw::const_c_array<fastuidraw::PainterAttribute> attrib_src_ptr;
+          fastuidraw::c_array<uint32_t> header_dst_ptr;
+
+          attrib_src_ptr = attrib_chunks[attrib_src];
+          attrib_dst_ptr = cmd.m_draw_command->m_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
+          header_dst_ptr = cmd.m_draw_command->m_header_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
+
+          std::copy(attrib_src_ptr.begin(), attrib_src_ptr.end(), attrib_dst_ptr.begin());
+          std::fill(header_dst_ptr.begin(), header_dst_ptr.end(), header_loc);
+
+          if(!attrib_chunk_selector.empty())
+            {
+              assert(m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED);
+              m_work_room.m_attribs_loaded[attrib_src] = cmd.m_attributes_written;
+            }
+          attrib_offset = cmd.m_attributes_written;
+          cmd.m_attributes_written += attrib_dst_ptr.size();
+        }
+      else
+        {
+          assert(!attrib_chunk_selector.empty());
+          assert(m_work_room.m_attribs_loaded[attrib_src] != NOT_LOADED);
+          attrib_offset = m_work_room.m_attribs_loaded[attrib_src];
+        }
+
+      /* copy and adjust the index value by incrementing them by attrib_offset
+       */
+      fastuidraw::c_array<fastuidraw::PainterIndex> index_dst_ptr;
+      fastuidraw::const_c_array<fastuidraw::PainterIndex> index_src_ptr;
 
-unsigned int
-PainterPackerPrivate::
-compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
-{
-  unsigned int R(0);
-  R += compute_room_needed_for_packing(draw_state.m_clip);
-  R += compute_room_needed_for_packing(draw_state.m_matrix);
-  R += compute_room_needed_for_packing(draw_state.m_brush);
-  R += compute_room_needed_for_packing(draw_state.m_item_shader_data);
-  R += compute_room_needed_for_packing(draw_state.m_blend_shader_data);
-  return R;
+      index_src_ptr = index_chunks[chunk];
+      index_dst_ptr = cmd.m_draw_command->m_indices.sub_array(cmd.m_indices_written, index_src_ptr.size());
+      for(unsigned int i = 0; i < index_dst_ptr.size(); ++i)
+        {
+          index_dst_ptr[i] = index_src_ptr[i] + attrib_offset;
+        }
+      cmd.m_indices_written += index_dst_ptr.size();
+    }
 }
 
+
+///////////////////////////////////////////
+// DisplayListPrivate methods
 void
-PainterPackerPrivate::
-upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
+DisplayListPrivate::
+finalize(void)
 {
-  unsigned int needed_room;
+  m_draws.shrink_stream();
 
-  assert(!m_accumulated_draws.empty());
-  needed_room = compute_room_needed_for_packing(draw_state);
-  if(needed_room > m_accumulated_draws.back().store_room())
+  m_z_span = 0;
+  m_bytes = 0;
+  m_number_headers = 0;
+  for(std::vector<per_draw_command>::const_iterator iter = m_draws.m_accumulated_draws.begin(),
+        end = m_draws.m_accumulated_draws.end(); iter != end; ++iter)
     {
-      start_new_command();
+      const fastuidraw::PainterDraw &draw(*iter->m_draw_command);
+
+      /* the PainterDraw must be unmapped which means that all
+         of its PainterDraw::DelayedAction objects have been
+         performed, so the z-values in the store are final.
+       */
+      assert(draw.unmapped());
+      m_bytes += draw.m_attributes.size() * (sizeof(fastuidraw::PainterAttribute) + sizeof(uint32_t))
+        + draw.m_indices.size() * sizeof(fastuidraw::PainterIndex)
+        + draw.m_store.size() * sizeof(fastuidraw::generic_data);
+
+      for(std::vector<recorded_header>::const_iterator h = iter->recorded_headers().begin(),
+            hend = iter->recorded_headers().end(); h != hend; ++h)
+        {
+          uint32_t z;
+
+          z = draw.m_store[h->m_location * m_draws.m_alignment + fastuidraw::PainterHeader::z_offset].u;
+          m_z_span = fastuidraw::t_max(m_z_span, z - m_base_z + 1u);
+          ++m_number_headers;
+        }
     }
-  m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
 }
 
 /////////////////////////////////////////
@@ -772,6 +2297,118 @@ packed_blend_mode(void) const
   return d->m_blend_mode;
 }
 
+////////////////////////////////////////////
+// fastuidraw::PainterPacker::Stream methods
+fastuidraw::PainterPacker::Stream::
+Stream(void *d):
+  m_d(d)
+{}
+
+fastuidraw::PainterPacker::Stream::
+~Stream()
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+void
+fastuidraw::PainterPacker::Stream::
+blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
+             BlendMode::packed_value pblend_mode)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  assert(h);
+  d->m_blend_shader = h;
+  d->m_blend_mode = pblend_mode;
+}
+
+void
+fastuidraw::PainterPacker::Stream::
+draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+             const PainterPackerData &draw,
+             const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+             const_c_array<const_c_array<PainterIndex> > index_chunks,
+             unsigned int z)
+{
+  draw_generic(shader, draw, attrib_chunks, index_chunks,
+               const_c_array<unsigned int>(), z);
+}
+
+void
+fastuidraw::PainterPacker::Stream::
+draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+             const PainterPackerData &draw,
+             const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+             const_c_array<const_c_array<PainterIndex> > index_chunks,
+             const_c_array<unsigned int> attrib_chunk_selector,
+             unsigned int z)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  if(d->m_accumulated_draws.empty())
+    {
+      d->start_new_command();
+    }
+  d->draw_generic(shader, draw, attrib_chunks, index_chunks,
+                  attrib_chunk_selector, z,
+                  reference_counted_ptr<DataCallBack>());
+}
+
+void
+fastuidraw::PainterPacker::Stream::
+clear(void)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->clear_stream();
+}
+
+////////////////////////////////////////////
+// fastuidraw::PainterPacker::DisplayList methods
+fastuidraw::PainterPacker::DisplayList::
+DisplayList(void *d):
+  m_d(d)
+{}
+
+fastuidraw::PainterPacker::DisplayList::
+~DisplayList()
+{
+  DisplayListPrivate *d;
+  d = reinterpret_cast<DisplayListPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PainterPacker::DisplayList::
+bytes(void) const
+{
+  DisplayListPrivate *d;
+  d = reinterpret_cast<DisplayListPrivate*>(m_d);
+  return d->m_bytes;
+}
+
+unsigned int
+fastuidraw::PainterPacker::DisplayList::
+number_headers(void) const
+{
+  DisplayListPrivate *d;
+  d = reinterpret_cast<DisplayListPrivate*>(m_d);
+  return d->m_number_headers;
+}
+
+unsigned int
+fastuidraw::PainterPacker::DisplayList::
+z_span(void) const
+{
+  DisplayListPrivate *d;
+  d = reinterpret_cast<DisplayListPrivate*>(m_d);
+  return d->m_z_span;
+}
+
 ////////////////////////////////////////////
 // fastuidraw::PainterPacker methods
 fastuidraw::PainterPacker::
@@ -798,6 +2435,7 @@ begin(void)
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
   assert(d->m_accumulated_draws.empty());
+  std::fill(d->m_stats.begin(), d->m_stats.end(), 0u);
   d->start_new_command();
   ++d->m_number_begins;
 }
@@ -829,7 +2467,20 @@ void
 fastuidraw::PainterPacker::
 end(void)
 {
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+
   flush();
+  d->m_last_stats = d->m_stats;
+}
+
+unsigned int
+fastuidraw::PainterPacker::
+query_stat(enum stats_t st) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_last_stats[st];
 }
 
 void
@@ -858,144 +2509,117 @@ draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
 {
   PainterPackerPrivate *d;
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
-
-  bool allocate_header;
-  unsigned int header_loc;
-  const unsigned int NOT_LOADED = ~0u;
-
-  assert((attrib_chunk_selector.empty() && attrib_chunks.size() == index_chunks.size())
-         || (attrib_chunk_selector.size() == index_chunks.size()) );
-
-  if(attrib_chunks.empty() || !shader)
-    {
-      /* should we emit a warning message that the PainterItemShader
-         was missing the item shader value?
-       */
-      return;
-    }
-
-  d->m_work_room.m_attribs_loaded.clear();
-  d->m_work_room.m_attribs_loaded.resize(attrib_chunk_selector.size(), NOT_LOADED);
-
-  assert(shader);
-
-  d->upload_draw_state(draw);
-  allocate_header = true;
-
-  for(unsigned chunk = 0, num_chunks = index_chunks.size(); chunk < num_chunks; ++chunk)
+  if(d->m_recording)
     {
-      unsigned int attrib_room, index_room, data_room;
-      unsigned int attrib_src, needed_attrib_room;
-
-      attrib_room = d->m_accumulated_draws.back().attribute_room();
-      index_room = d->m_accumulated_draws.back().index_room();
-      data_room = d->m_accumulated_draws.back().store_room();
-
-      if(attrib_chunk_selector.empty())
-        {
-          attrib_src = chunk;
-          needed_attrib_room = attrib_chunks[attrib_src].size();
-        }
-      else
-        {
-          attrib_src = attrib_chunk_selector[chunk];
-          needed_attrib_room = (d->m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED) ?
-            attrib_chunks[attrib_src].size() :
-            0;
-        }
-
-      if(index_chunks[chunk].empty() || attrib_chunks[attrib_src].empty())
-        {
-          continue;
-        }
-
-      if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size()
-         || (allocate_header && data_room < d->m_header_size))
+      d = &d->m_recording->m_draws;
+      if(d->m_accumulated_draws.empty())
         {
           d->start_new_command();
-          d->upload_draw_state(draw);
+        }
+    }
+  d->draw_generic(shader, draw, attrib_chunks, index_chunks,
+                  attrib_chunk_selector, z, call_back);
+}
 
-          /* reset attribs_loaded[] and recompute needed_attrib_room
-           */
-          if(!attrib_chunk_selector.empty())
-            {
-              std::fill(d->m_work_room.m_attribs_loaded.begin(), d->m_work_room.m_attribs_loaded.end(), NOT_LOADED);
-              needed_attrib_room = attrib_chunks[attrib_src].size();
-            }
+void
+fastuidraw::PainterPacker::
+begin_display_list(const float3x3 &base_transformation,
+                   const PainterClipEquations &base_clip,
+                   unsigned int base_z)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
-          attrib_room = d->m_accumulated_draws.back().attribute_room();
-          index_room = d->m_accumulated_draws.back().index_room();
-          data_room = d->m_accumulated_draws.back().store_room();
-          allocate_header = true;
+  assert(d->m_recording == NULL);
+  assert(d->m_capacity.m_attributes > 0);
+  d->m_recording = FASTUIDRAWnew DisplayListPrivate(*d);
+  d->m_recording->m_base_transformation = base_transformation;
+  d->m_recording->m_base_clip = base_clip;
+  d->m_recording->m_base_z = base_z;
+}
 
-          if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size())
-            {
-              assert(!"Unable to fit chunk into freshly allocated draw command, not good!");
-              continue;
-            }
+fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DisplayList>
+fastuidraw::PainterPacker::
+end_display_list(void)
+{
+  PainterPackerPrivate *d;
+  DisplayListPrivate *list;
 
-          assert(data_room >= d->m_header_size);
-        }
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  assert(d->m_recording != NULL);
 
-      per_draw_command &cmd(d->m_accumulated_draws.back());
-      if(allocate_header)
-        {
-          allocate_header = false;
-          header_loc = cmd.pack_header(d->m_header_size,
-                                       fetch_value(draw.m_brush).shader(),
-                                       d->m_blend_shader,
-                                       d->m_blend_mode,
-                                       shader,
-                                       z, d->m_painter_state_location,
-                                       call_back);
-        }
+  list = d->m_recording;
+  d->m_recording = NULL;
+  list->finalize();
+  return FASTUIDRAWnew DisplayList(list);
+}
 
-      /* copy attribute data and get offset into attribute buffer
-         where attributes are copied
-       */
-      unsigned int attrib_offset;
+unsigned int
+fastuidraw::PainterPacker::
+draw_display_list(const reference_counted_ptr<const DisplayList> &list,
+                  const float3x3 &transformation,
+                  const PainterClipEquations &clip,
+                  unsigned int z)
+{
+  PainterPackerPrivate *d;
+  DisplayListPrivate *list_d;
+  display_list_replay replay;
+  float3x3 base_inverse;
 
-      if(needed_attrib_room > 0)
-        {
-          c_array<PainterAttribute> attrib_dst_ptr;
-          const_c_array<PainterAttribute> attrib_src_ptr;
-          c_array<uint32_t> header_dst_ptr;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  assert(list);
+  assert(d->m_recording == NULL);
+
+  list_d = reinterpret_cast<DisplayListPrivate*>(list->m_d);
+  list_d->m_base_transformation.inverse(base_inverse);
+  replay.m_transformation = transformation * base_inverse;
+  replay.m_transformation.inverse_transpose(replay.m_transformation_inverse_transpose);
+  replay.m_base_clip = list_d->m_base_clip;
+  replay.m_clip = clip;
+  replay.m_z_offset = z - list_d->m_base_z;
+
+  d->splice_stream(&list_d->m_draws, &replay);
+  return list_d->m_bytes;
+}
 
-          attrib_src_ptr = attrib_chunks[attrib_src];
-          attrib_dst_ptr = cmd.m_draw_command->m_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
-          header_dst_ptr = cmd.m_draw_command->m_header_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
+fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::Stream>
+fastuidraw::PainterPacker::
+create_stream(void)
+{
+  PainterPackerPrivate *d, *stream_d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
-          std::memcpy(attrib_dst_ptr.c_ptr(), attrib_src_ptr.c_ptr(), sizeof(PainterAttribute) * attrib_dst_ptr.size());
-          std::fill(header_dst_ptr.begin(), header_dst_ptr.end(), header_loc);
+  /* the sizes of the PainterDraw objects of the backend are
+     only known once a PainterDraw has been mapped, i.e. after
+     the first begin(); without them the chunks of a Stream
+     would have no room.
+   */
+  if(d->m_capacity.m_attributes == 0
+     || d->m_capacity.m_indices == 0
+     || d->m_capacity.m_store == 0)
+    {
+      return reference_counted_ptr<Stream>();
+    }
 
-          if(!attrib_chunk_selector.empty())
-            {
-              assert(d->m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED);
-              d->m_work_room.m_attribs_loaded[attrib_src] = cmd.m_attributes_written;
-            }
-          attrib_offset = cmd.m_attributes_written;
-          cmd.m_attributes_written += attrib_dst_ptr.size();
-        }
-      else
-        {
-          assert(!attrib_chunk_selector.empty());
-          assert(d->m_work_room.m_attribs_loaded[attrib_src] != NOT_LOADED);
-          attrib_offset = d->m_work_room.m_attribs_loaded[attrib_src];
-        }
+  stream_d = FASTUIDRAWnew PainterPackerPrivate(*d);
+  return FASTUIDRAWnew Stream(stream_d);
+}
 
-      /* copy and adjust the index value by incrementing them by attrib_offset
-       */
-      c_array<PainterIndex> index_dst_ptr;
-      const_c_array<PainterIndex> index_src_ptr;
+void
+fastuidraw::PainterPacker::
+submit_stream(const reference_counted_ptr<Stream> &stream)
+{
+  PainterPackerPrivate *d, *stream_d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
-      index_src_ptr = index_chunks[chunk];
-      index_dst_ptr = cmd.m_draw_command->m_indices.sub_array(cmd.m_indices_written, index_src_ptr.size());
-      for(unsigned int i = 0; i < index_dst_ptr.size(); ++i)
-        {
-          index_dst_ptr[i] = index_src_ptr[i] + attrib_offset;
-        }
-      cmd.m_indices_written += index_dst_ptr.size();
+  assert(stream);
+  stream_d = reinterpret_cast<PainterPackerPrivate*>(stream->m_d);
+  if(!stream_d->m_accumulated_draws.empty())
+    {
+      stream_d->m_accumulated_draws.back().unmap();
     }
+  d->splice_stream(stream_d, NULL);
+  stream_d->clear_stream();
 }
 
 const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&
@@ -1053,6 +2677,29 @@ blend_shader(const fastuidraw::reference_counted_ptr<PainterBlendShader> &h,
   assert(h);
   d->m_blend_shader = h;
   d->m_blend_mode = pblend_mode;
+  if(d->m_recording)
+    {
+      d->m_recording->m_draws.m_blend_shader = h;
+      d->m_recording->m_draws.m_blend_mode = pblend_mode;
+    }
+}
+
+bool
+fastuidraw::PainterPacker::
+reorder_draws(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_reorder_draws;
+}
+
+void
+fastuidraw::PainterPacker::
+reorder_draws(bool v)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->m_reorder_draws = v;
 }
 
 const fastuidraw::PainterShaderSet&
@@ -1237,9 +2884,9 @@ raw_value(void) const
 /////////////////////////////////////////////////////
 // PainterPackedValuePool methods
 fastuidraw::PainterPackedValuePool::
-PainterPackedValuePool(int alignment)
+PainterPackedValuePool(int alignment, bool thread_safe)
 {
-  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment);
+  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment, thread_safe);
 }
 
 fastuidraw::PainterPackedValuePool::
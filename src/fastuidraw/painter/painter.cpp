@@ -448,11 +448,16 @@ namespace
                        bool with_anti_aliasing,
                        const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
+    const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+    select_tessellation(const fastuidraw::Path &path);
+
     fastuidraw::vec2 m_resolution;
     fastuidraw::vec2 m_one_pixel_width;
+    float m_curve_flatness;
     unsigned int m_current_z;
     clip_rect_state m_clip_rect_state;
     std::vector<occluder_stack_entry> m_occluder_stack;
+    unsigned int m_display_list_occluder_depth;
     std::vector<state_stack_entry> m_state_stack;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker> m_core;
     fastuidraw::PainterPackedValuePool m_pool;
@@ -634,6 +639,7 @@ PainterPrivate::
 PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend):
   m_resolution(1.0f, 1.0f),
   m_one_pixel_width(1.0f, 1.0f),
+  m_curve_flatness(-1.0f),
   m_pool(backend->configuration_base().alignment())
 {
   m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
@@ -642,6 +648,27 @@ PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> bac
                                              .pen(0.0f, 0.0f, 0.0f, 0.0f));
   m_identiy_matrix = m_pool.create_packed_value(fastuidraw::PainterItemMatrix());
   m_current_z = 1;
+  m_display_list_occluder_depth = 0;
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+PainterPrivate::
+select_tessellation(const fastuidraw::Path &path)
+{
+  if(m_curve_flatness <= 0.0f)
+    {
+      return path.tessellation();
+    }
+
+  /* map from clip coordinates to pixel coordinates
+   */
+  fastuidraw::float3x3 to_pixels;
+
+  to_pixels(0, 0) = 0.5f * m_resolution.x();
+  to_pixels(0, 2) = 0.5f * m_resolution.x();
+  to_pixels(1, 1) = 0.5f * m_resolution.y();
+  to_pixels(1, 2) = 0.5f * m_resolution.y();
+  return path.tessellation(to_pixels * m_current_item_matrix.m_item_matrix, m_curve_flatness);
 }
 
 void
@@ -1053,6 +1080,56 @@ end(void)
   d->m_core->end();
 }
 
+void
+fastuidraw::Painter::
+begin_display_list(void)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  d->m_display_list_occluder_depth = d->m_occluder_stack.size();
+  d->m_core->begin_display_list(d->m_current_item_matrix.m_item_matrix,
+                                d->m_current_clip, d->m_current_z);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DisplayList>
+fastuidraw::Painter::
+end_display_list(void)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  /* the occluders pushed while recording must be popped
+     so that their z-values are written before the
+     recording ends.
+   */
+  while(d->m_occluder_stack.size() > d->m_display_list_occluder_depth)
+    {
+      d->m_occluder_stack.back().on_pop(this);
+      d->m_occluder_stack.pop_back();
+    }
+  return d->m_core->end_display_list();
+}
+
+unsigned int
+fastuidraw::Painter::
+draw_display_list(const reference_counted_ptr<const PainterPacker::DisplayList> &list)
+{
+  PainterPrivate *d;
+  unsigned int return_value;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      return 0;
+    }
+
+  return_value = d->m_core->draw_display_list(list, d->m_current_item_matrix.m_item_matrix,
+                                              d->m_current_clip, d->m_current_z);
+  d->m_current_z += list->z_span();
+  return return_value;
+}
+
 void
 fastuidraw::Painter::
 draw_generic(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
@@ -1234,8 +1311,11 @@ stroke_path(const PainterData &draw, const Path &path,
             bool with_anti_aliasing,
             const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
   stroke_path(default_shaders().stroke_shader(), draw,
-              path.tessellation()->stroked()->painter_data(),
+              d->select_tessellation(path)->stroked()->painter_data(),
               close_contours, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1246,8 +1326,11 @@ stroke_path_pixel_width(const PainterData &draw, const Path &path,
                         bool with_anti_aliasing,
                         const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
   stroke_path(default_shaders().pixel_width_stroke_shader(), draw,
-              path.tessellation()->stroked()->painter_data(),
+              d->select_tessellation(path)->stroked()->painter_data(),
               close_contours, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1405,8 +1488,11 @@ stroke_dashed_path(const PainterData &draw, const Path &path,
                    bool with_anti_aliasing,
                    const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
   stroke_dashed_path(default_shaders().dashed_stroke_shader(), draw,
-                     path.tessellation()->stroked()->painter_data(),
+                     d->select_tessellation(path)->stroked()->painter_data(),
                      close_contour, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1417,8 +1503,11 @@ stroke_dashed_path_pixel_width(const PainterData &draw, const Path &path,
                                bool with_anti_aliasing,
                                const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
    stroke_dashed_path(default_shaders().pixel_width_dashed_stroke_shader(), draw,
-                      path.tessellation()->stroked()->painter_data(),
+                      d->select_tessellation(path)->stroked()->painter_data(),
                       close_contour, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1444,7 +1533,10 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
           const Path &path, enum PainterEnums::fill_rule_t fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  fill_path(shader, draw, d->select_tessellation(path)->filled()->painter_data(), fill_rule, call_back);
 }
 
 void
@@ -1532,7 +1624,10 @@ fill_path(const PainterFillShader &shader,
           const PainterData &draw, const Path &path, const CustomFillRuleBase &fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  fill_path(shader, draw, d->select_tessellation(path)->filled()->painter_data(), fill_rule, call_back);
 }
 
 void
@@ -1874,8 +1969,8 @@ clipInPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
     }
 
   vec2 pmin, pmax;
-  pmin = path.tessellation()->bounding_box_min();
-  pmax = path.tessellation()->bounding_box_max();
+  pmin = d->select_tessellation(path)->bounding_box_min();
+  pmax = d->select_tessellation(path)->bounding_box_max();
   clipInRect(pmin, pmax - pmin);
   clipOutPath(path, PainterEnums::complement_fill_rule(fill_rule));
 }
@@ -1895,8 +1990,8 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
     }
 
   vec2 pmin, pmax;
-  pmin = path.tessellation()->bounding_box_min();
-  pmax = path.tessellation()->bounding_box_max();
+  pmin = d->select_tessellation(path)->bounding_box_min();
+  pmax = d->select_tessellation(path)->bounding_box_max();
   clipInRect(pmin, pmax - pmin);
   clipOutPath(path, ComplementFillRule(&fill_rule));
 }
@@ -2105,6 +2200,51 @@ default_shaders(void) const
   return d->m_core->default_shaders();
 }
 
+unsigned int
+fastuidraw::Painter::
+query_stat(enum PainterPacker::stats_t st) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_core->query_stat(st);
+}
+
+float
+fastuidraw::Painter::
+curve_flatness(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_curve_flatness;
+}
+
+void
+fastuidraw::Painter::
+curve_flatness(float v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_curve_flatness = v;
+}
+
+bool
+fastuidraw::Painter::
+reorder_draws(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_core->reorder_draws();
+}
+
+void
+fastuidraw::Painter::
+reorder_draws(bool v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_core->reorder_draws(v);
+}
+
 unsigned int
 fastuidraw::Painter::
 current_z(void) const
@@ -251,6 +251,15 @@ fastuidraw::PainterAttributeDataFillerGlyphs::
   m_d = NULL;
 }
 
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_glyphs(void) const
+{
+  FillGlyphsPrivate *d;
+  d = reinterpret_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_number_glyphs;
+}
+
 void
 fastuidraw::PainterAttributeDataFillerGlyphs::
 compute_sizes(unsigned int &number_attributes,
@@ -104,6 +104,11 @@ pack_data(unsigned int alignment, c_array<generic_data> dst) const
       sub_dest[image_start_xy_offset].u =
         pack_bits(image_size_x_bit0, image_size_x_num_bits, m_data.m_image_start.x())
         | pack_bits(image_size_y_bit0, image_size_y_num_bits, m_data.m_image_start.y());
+
+      uvec2 level0_size(m_data.m_image->dimensions());
+      sub_dest[image_level0_size_xy_offset].u =
+        pack_bits(image_size_x_bit0, image_size_x_num_bits, level0_size.x())
+        | pack_bits(image_size_y_bit0, image_size_y_num_bits, level0_size.y());
     }
 
   if(pshader & gradient_mask)
@@ -188,7 +193,7 @@ fastuidraw::PainterBrush::
 sub_image(const reference_counted_ptr<const Image> &im,
           uvec2 xy, uvec2 wh, enum image_filter f)
 {
-  uint32_t slack, lookups;
+  uint32_t slack, lookups, mipmap_levels;
   uint32_t filter_bits;
 
   filter_bits = im ? f : 0;
@@ -210,6 +215,11 @@ sub_image(const reference_counted_ptr<const Image> &im,
   m_data.m_shader_raw &= ~(image_number_index_lookups_max << image_number_index_lookups_bit0);
   m_data.m_shader_raw |= (lookups << image_number_index_lookups_bit0);
 
+  mipmap_levels = im ? im->number_mipmap_levels() - 1 : 0;
+  assert(mipmap_levels <= image_number_mipmap_levels_max);
+  m_data.m_shader_raw &= ~(image_number_mipmap_levels_max << image_number_mipmap_levels_bit0);
+  m_data.m_shader_raw |= (mipmap_levels << image_number_mipmap_levels_bit0);
+
   return *this;
 }
 
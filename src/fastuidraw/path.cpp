@@ -20,11 +20,18 @@
 #include <algorithm>
 #include <cmath>
 #include <vector>
+#include <map>
 #include <fastuidraw/path.hpp>
 #include "private/util_private.hpp"
 
 namespace
 {
+  /* safety limits on the tessellation of a single curve when
+     TessellationParams::m_max_distance is positive.
+   */
+  const unsigned int max_error_bounded_recursion = 16;
+  const unsigned int max_error_bounded_segments = 1u << max_error_bounded_recursion;
+
   class poly
   {
   public:
@@ -86,9 +93,15 @@ namespace
 
 
   private:
-    unsigned int m_max_recursion, m_max_size;
+    static
+    unsigned int
+    compute_max_recursion(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
+                          const fastuidraw::PathContour::interpolator_generic *h);
+
+    unsigned int m_max_recursion;
     const fastuidraw::PathContour::interpolator_generic *m_h;
     float m_thresh_times_six;
+    float m_max_distance;
     std::vector<analytic_point_data> m_data;
 
     void
@@ -117,9 +130,19 @@ namespace
     void
     init(void);
 
+    /* the points of the curve, i.e. start point,
+       control points and end point; m_poly holds
+       the curve as a polynomial.
+     */
+    std::vector<fastuidraw::vec2> m_pts;
     std::vector<fastuidraw::vec2> m_poly;
     std::vector<fastuidraw::vec2> m_poly_prime;
     std::vector<fastuidraw::vec2> m_poly_prime_prime;
+
+    /* upper bound of the magnitude of the second
+       derivative, see bezier::second_derivative_bound().
+     */
+    float m_second_derivative_bound;
   };
 
   class ArcPrivate
@@ -152,20 +175,62 @@ namespace
     current_contour(void)
     {
       assert(!m_contours.empty());
-      m_tessellation.clear();
+      clear_tessellation();
       return m_contours.back();
     }
 
     void
     move_common(const fastuidraw::vec2 &pt)
     {
-      m_tessellation.clear();
+      clear_tessellation();
       m_contours.push_back(FASTUIDRAWnew fastuidraw::PathContour());
       m_contours.back()->start(pt);
     }
 
+    /* called when the geometry changes; the old tessellations
+       are kept so that the new tessellations can copy the
+       points of the edges that did not change.
+     */
+    void
+    clear_tessellation(void)
+    {
+      if(m_tessellation)
+        {
+          m_reuse_tessellation = m_tessellation;
+          m_tessellation.clear();
+        }
+
+      for(std::map<int, fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> >::iterator
+            iter = m_tessellation_lod.begin(), end = m_tessellation_lod.end(); iter != end; ++iter)
+        {
+          m_reuse_tessellation_lod[iter->first] = iter->second;
+        }
+      m_tessellation_lod.clear();
+    }
+
+    /* called when the tessellations made so far are useless
+     */
+    void
+    drop_tessellation(void)
+    {
+      m_tessellation.clear();
+      m_tessellation_lod.clear();
+      m_reuse_tessellation.clear();
+      m_reuse_tessellation_lod.clear();
+    }
+
     fastuidraw::TessellatedPath::TessellationParams m_tessellation_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_tessellation;
+
+    /* tessellations with TessellationParams::m_max_distance
+       set to 2^k keyed by k.
+     */
+    std::map<int, fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> > m_tessellation_lod;
+
+    /* tessellations from before the last change of geometry
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_reuse_tessellation;
+    std::map<int, fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> > m_reuse_tessellation_lod;
     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > m_contours;
   };
 }
@@ -345,10 +410,10 @@ analytic_point_data(float time, const fastuidraw::PathContour::interpolator_gene
 Tessellator::
 Tessellator(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
             const fastuidraw::PathContour::interpolator_generic *h):
-  m_max_recursion(fastuidraw::uint32_log2(tess_params.m_max_segments)),
-  m_max_size(tess_params.m_max_segments + 1),
+  m_max_recursion(compute_max_recursion(tess_params, h)),
   m_h(h),
-  m_thresh_times_six(tess_params.m_curve_tessellation * 6.0f)
+  m_thresh_times_six(tess_params.m_curve_tessellation * 6.0f),
+  m_max_distance(tess_params.m_max_distance)
 {
   assert(m_h);
 
@@ -384,6 +449,33 @@ requires_recursion(float delta_t,
                    unsigned int idx_q)
 
 {
+  if(m_max_distance > 0.0f)
+    {
+      /* use the distance from the point of the curve at the middle
+         time to the line segment connecting the end points as the
+         error of the line segment. A single curve can have its
+         middle on the segment connecting its end points (for example
+         an S-shaped cubic), so the first split is always done.
+       */
+      fastuidraw::vec2 p, q, v, m;
+      float mag_sq, error_sq, s;
+
+      if(idx_p == 0 && idx_q == 1)
+        {
+          return true;
+        }
+
+      p = m_data[idx_p].m_p;
+      q = m_data[idx_q].m_p;
+      m = m_data[idx_mid].m_p - p;
+      v = q - p;
+      mag_sq = dot(v, v);
+      s = (mag_sq > 0.0f) ? std::max(0.0f, std::min(1.0f, dot(m, v) / mag_sq)) : 0.0f;
+      m -= s * v;
+      error_sq = dot(m, m);
+      return error_sq > m_max_distance * m_max_distance;
+    }
+
   /* Use simpson's Rule on the integral:
        integral_[t, t + delta_t] K_times_speed(t) dt
   */
@@ -431,12 +523,51 @@ tessellation_worker(unsigned int idx_start, unsigned int idx_end,
 }
 
 
+unsigned int
+Tessellator::
+compute_max_recursion(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
+                      const fastuidraw::PathContour::interpolator_generic *h)
+{
+  if(tess_params.m_max_distance <= 0.0f)
+    {
+      return fastuidraw::uint32_log2(tess_params.m_max_segments);
+    }
+
+  /* The distance between a curve over a time interval of length
+     dt and the segment connecting its end points is at most
+     M * dt * dt / 8 where M bounds the magnitude of the second
+     derivative of the curve, so a recursion depth L with
+     M / (8 * 4^L) <= m_max_distance meets the error bound
+     everywhere.
+   */
+  float M;
+
+  M = h->second_derivative_bound();
+  if(M < 0.0f)
+    {
+      return max_error_bounded_recursion;
+    }
+
+  float ratio;
+  ratio = M / (8.0f * tess_params.m_max_distance);
+  if(ratio <= 1.0f)
+    {
+      return 0;
+    }
+
+  float L;
+  L = std::ceil(0.5f * std::log(ratio) / std::log(2.0f));
+  return std::min(static_cast<unsigned int>(L), max_error_bounded_recursion);
+}
+
 unsigned int
 Tessellator::
 dump(fastuidraw::c_array<fastuidraw::TessellatedPath::point> out_data) const
 {
-  assert(out_data.size() >= m_data.size());
-  std::copy(m_data.begin(), m_data.end(), out_data.begin());
+  if(out_data.size() >= m_data.size())
+    {
+      std::copy(m_data.begin(), m_data.end(), out_data.begin());
+    }
   return m_data.size();
 }
 
@@ -454,9 +585,21 @@ init(void)
   unsigned int degree = m_poly.size() - 1;
   binomial_coeff BC(degree);
 
+  m_pts = m_poly;
+
   poly::compute_bernstein_derivative(m_poly, m_poly_prime);
   poly::compute_bernstein_derivative(m_poly_prime, m_poly_prime_prime);
 
+  /* m_poly_prime_prime holds the control points of the second
+     derivative, the curve of which stays within their convex hull.
+   */
+  m_second_derivative_bound = 0.0f;
+  for(unsigned int i = 0, endi = m_poly_prime_prime.size(); i < endi; ++i)
+    {
+      m_second_derivative_bound = std::max(m_second_derivative_bound,
+                                           m_poly_prime_prime[i].magnitude());
+    }
+
   BC.prepare_bernstein(m_poly);
   BC.prepare_bernstein(m_poly_prime);
   BC.prepare_bernstein(m_poly_prime_prime);
@@ -588,6 +731,14 @@ fastuidraw::PathContour::bezier::
   m_d = NULL;
 }
 
+fastuidraw::const_c_array<fastuidraw::vec2>
+fastuidraw::PathContour::bezier::
+control_pts(void) const
+{
+  BezierPrivate *d;
+  d = reinterpret_cast<BezierPrivate*>(m_d);
+  return make_c_array(d->m_pts).sub_array(1, d->m_pts.size() - 2);
+}
 
 void
 fastuidraw::PathContour::bezier::
@@ -600,6 +751,15 @@ compute(float t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const
   outp_tt = poly::compute_poly(t, make_c_array(d->m_poly_prime_prime));
 }
 
+float
+fastuidraw::PathContour::bezier::
+second_derivative_bound(void) const
+{
+  BezierPrivate *d;
+  d = reinterpret_cast<BezierPrivate*>(m_d);
+  return d->m_second_derivative_bound;
+}
+
 fastuidraw::PathContour::interpolator_base*
 fastuidraw::PathContour::bezier::
 deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
@@ -617,6 +777,11 @@ produce_tessellation(const TessellatedPath::TessellationParams&,
   vec2 delta(end_pt() - start_pt());
   float mag(delta.magnitude());
 
+  if(out_data.size() < 2)
+    {
+      return 2;
+    }
+
   out_data[0].m_p = start_pt();
   out_data[0].m_p_t = delta;
   out_data[0].m_distance_from_edge_start = 0.0f;
@@ -710,9 +875,30 @@ produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
   unsigned int needed_size;
   float needed_sizef, delta_angle, sgn, sgn_radius;
 
-  needed_sizef = std::abs(d->m_angle_speed) / tess_params.m_curve_tessellation;
-  needed_size = static_cast<unsigned int>(needed_sizef);
-  needed_size = std::min(needed_size, tess_params.m_max_segments);
+  if(tess_params.m_max_distance > 0.0f)
+    {
+      /* a chord of an arc of angle A has distance
+         radius * (1 - cos(A / 2)) to the arc.
+       */
+      float max_angle;
+
+      max_angle = 2.0f * std::acos(std::max(-1.0f, 1.0f - tess_params.m_max_distance / d->m_radius));
+      needed_sizef = std::ceil(std::abs(d->m_angle_speed) / max_angle);
+      needed_sizef = std::min(needed_sizef, static_cast<float>(max_error_bounded_segments));
+      needed_size = std::max(1u, static_cast<unsigned int>(needed_sizef));
+    }
+  else
+    {
+      needed_sizef = std::abs(d->m_angle_speed) / tess_params.m_curve_tessellation;
+      needed_size = static_cast<unsigned int>(needed_sizef);
+      needed_size = std::min(needed_size, tess_params.m_max_segments);
+    }
+
+  if(out_data.size() < needed_size + 1)
+    {
+      return needed_size + 1;
+    }
+
   delta_angle = d->m_angle_speed / static_cast<float>(needed_size);
   sgn = d->m_angle_speed > 0.0 ? 1.0 : -1.0;
   sgn_radius = sgn * d->m_radius;
@@ -1017,12 +1203,13 @@ PathPrivate::
 PathPrivate(const PathPrivate &obj):
   m_tessellation_params(obj.m_tessellation_params),
   m_tessellation(obj.m_tessellation),
+  m_tessellation_lod(obj.m_tessellation_lod),
   m_contours(obj.m_contours)
 {
   /* if the last contour is not ended, we need to do a
      deep copy on it.
    */
-  if(!m_contours.back()->ended())
+  if(!m_contours.empty() && !m_contours.back()->ended())
     {
       m_contours.back() = m_contours.back()->deep_copy();
     }
@@ -1084,7 +1271,7 @@ clear(void)
 {
   PathPrivate *d;
   d = reinterpret_cast<PathPrivate*>(m_d);
-  d->m_tessellation.clear();
+  d->drop_tessellation();
   d->m_contours.clear();
 }
 
@@ -1103,7 +1290,7 @@ add_contour(const reference_counted_ptr<const PathContour> &pcontour)
   reference_counted_ptr<PathContour> contour;
   contour = pcontour.const_cast_ptr<PathContour>();
 
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   if(d->m_contours.empty() || d->m_contours.back()->ended())
     {
       d->m_contours.push_back(contour);
@@ -1129,7 +1316,7 @@ add_contours(const Path &path)
 
   if(d != pd && !pd->m_contours.empty())
     {
-      d->m_tessellation.clear();
+      d->clear_tessellation();
       d->m_contours.reserve(d->m_contours.size() + pd->m_contours.size());
 
       reference_counted_ptr<PathContour> r;
@@ -1210,7 +1397,7 @@ tessellation_params(const fastuidraw::TessellatedPath::TessellationParams &p)
    */
   if(p != d->m_tessellation_params)
     {
-      d->m_tessellation = reference_counted_ptr<const TessellatedPath>();
+      d->drop_tessellation();
     }
   d->m_tessellation_params = p;
 }
@@ -1224,11 +1411,124 @@ tessellation(void) const
   if(!d->m_tessellation)
     {
       d->m_tessellation = FASTUIDRAWnew TessellatedPath(*this,
-                                                        d->m_tessellation_params);
+                                                        d->m_tessellation_params,
+                                                        d->m_reuse_tessellation);
+      d->m_reuse_tessellation.clear();
     }
   return d->m_tessellation;
 }
 
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::Path::
+tessellation(float max_distance) const
+{
+  PathPrivate *d;
+  d = reinterpret_cast<PathPrivate*>(m_d);
+
+  if(!(max_distance > 0.0f))
+    {
+      return tessellation();
+    }
+
+  /* round max_distance down to a power of 2, so that a
+     path drawn with continuously changing zoom only
+     creates a handful of tessellations.
+   */
+  int k;
+  std::map<int, reference_counted_ptr<const TessellatedPath> >::iterator iter;
+
+  std::frexp(max_distance, &k);
+  --k;
+
+  iter = d->m_tessellation_lod.find(k);
+  if(iter == d->m_tessellation_lod.end())
+    {
+      TessellatedPath::TessellationParams P(d->m_tessellation_params);
+
+      std::map<int, reference_counted_ptr<const TessellatedPath> >::iterator reuse;
+
+      P.m_max_distance = std::ldexp(1.0f, k);
+      iter = d->m_tessellation_lod.insert(std::make_pair(k, reference_counted_ptr<const TessellatedPath>())).first;
+      reuse = d->m_reuse_tessellation_lod.find(k);
+      if(reuse != d->m_reuse_tessellation_lod.end())
+        {
+          iter->second = FASTUIDRAWnew TessellatedPath(*this, P, reuse->second);
+          d->m_reuse_tessellation_lod.erase(reuse);
+        }
+      else
+        {
+          iter->second = FASTUIDRAWnew TessellatedPath(*this, P);
+        }
+    }
+  return iter->second;
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::Path::
+tessellation(const float3x3 &transformation, float max_pixel_distance) const
+{
+  if(!(max_pixel_distance > 0.0f) || number_contours() == 0)
+    {
+      return tessellation();
+    }
+
+  /* compute by how much the transformation stretches
+     distances within the bounding box of the path, that
+     is the largest singular value of the derivative of
+     the transformation at the corners of the box. The
+     transformation is projective and so its derivative
+     is not constant; for the transformations of 2D UI
+     taking the maximum at the corners is good enough.
+   */
+  const reference_counted_ptr<const TessellatedPath> &coarse(tessellation());
+  vecN<vec2, 4> pts;
+  float stretch(0.0f);
+
+  pts[0] = coarse->bounding_box_min();
+  pts[2] = coarse->bounding_box_max();
+  pts[1] = vec2(pts[0].x(), pts[2].y());
+  pts[3] = vec2(pts[2].x(), pts[0].y());
+
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      vec3 q;
+      float u, v, a, b, c, e, tr, det, disc;
+
+      q = transformation * vec3(pts[i].x(), pts[i].y(), 1.0f);
+      if(q.z() <= 0.0f)
+        {
+          /* part of the path is behind the viewer, the
+             magnification is unbounded
+           */
+          return tessellation();
+        }
+      u = q.x() / q.z();
+      v = q.y() / q.z();
+
+      /* J = [ a b ]
+             [ c e ], the derivative of the transformation
+       */
+      a = (transformation(0, 0) - u * transformation(2, 0)) / q.z();
+      b = (transformation(0, 1) - u * transformation(2, 1)) / q.z();
+      c = (transformation(1, 0) - v * transformation(2, 0)) / q.z();
+      e = (transformation(1, 1) - v * transformation(2, 1)) / q.z();
+
+      /* largest eigenvalue of transpose(J) * J
+       */
+      tr = a * a + b * b + c * c + e * e;
+      det = a * e - b * c;
+      disc = std::sqrt(std::max(0.0f, tr * tr - 4.0f * det * det));
+      stretch = std::max(stretch, std::sqrt(0.5f * (tr + disc)));
+    }
+
+  if(!(stretch > 0.0f))
+    {
+      return tessellation();
+    }
+
+  return tessellation(max_pixel_distance / stretch);
+}
+
 fastuidraw::Path&
 fastuidraw::Path::
 operator<<(const control_point &pt)
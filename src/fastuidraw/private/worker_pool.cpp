@@ -0,0 +1,172 @@
+/*!
+ * \file worker_pool.cpp
+ * \brief file worker_pool.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <assert.h>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include "worker_pool.hpp"
+
+namespace
+{
+  fastuidraw::worker_pool *shared_pool = NULL;
+  boost::once_flag shared_pool_once = BOOST_ONCE_INIT;
+
+  void
+  make_shared_pool(void)
+  {
+    /* the worker_pool is destroyed (and its threads joined)
+       at exit.
+     */
+    static fastuidraw::worker_pool pool(std::max(2u, boost::thread::hardware_concurrency()) - 1u);
+    shared_pool = &pool;
+  }
+}
+
+fastuidraw::worker_pool::
+worker_pool(unsigned int number_threads):
+  m_number_threads(number_threads),
+  m_done(false)
+{
+  for(unsigned int i = 0; i < m_number_threads; ++i)
+    {
+      m_threads.create_thread(boost::bind(&worker_pool::worker, this));
+    }
+}
+
+fastuidraw::worker_pool::
+~worker_pool()
+{
+  /* the tasks of run() are all done, those of post()
+     still queued are run before the threads exit.
+   */
+  m_mutex.lock();
+  m_done = true;
+  m_mutex.unlock();
+  m_task_added.notify_all();
+  m_threads.join_all();
+}
+
+void
+fastuidraw::worker_pool::
+run(job *J, unsigned int number_helpers)
+{
+  unsigned int running(0);
+
+  number_helpers = std::min(number_helpers, m_number_threads);
+  if(number_helpers > 0)
+    {
+      task T;
+
+      T.m_job = J;
+      T.m_running = &running;
+      m_mutex.lock();
+      m_tasks.insert(m_tasks.end(), number_helpers, T);
+      m_mutex.unlock();
+      m_task_added.notify_all();
+    }
+
+  J->run();
+
+  if(number_helpers > 0)
+    {
+      boost::unique_lock<boost::mutex> lock(m_mutex);
+
+      /* the tasks not yet taken by a worker are dropped;
+         the job has no work left for them.
+       */
+      for(std::deque<task>::iterator iter = m_tasks.begin(); iter != m_tasks.end();)
+        {
+          if(iter->m_running == &running)
+            {
+              iter = m_tasks.erase(iter);
+            }
+          else
+            {
+              ++iter;
+            }
+        }
+
+      while(running > 0)
+        {
+          m_task_done.wait(lock);
+        }
+    }
+}
+
+void
+fastuidraw::worker_pool::
+post(job *J)
+{
+  task T;
+
+  assert(m_number_threads > 0);
+  T.m_job = J;
+  T.m_running = NULL;
+  m_mutex.lock();
+  m_tasks.push_back(T);
+  m_mutex.unlock();
+  m_task_added.notify_one();
+}
+
+void
+fastuidraw::worker_pool::
+worker(void)
+{
+  for(;;)
+    {
+      task T;
+
+      {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        while(m_tasks.empty() && !m_done)
+          {
+            m_task_added.wait(lock);
+          }
+
+        if(m_tasks.empty())
+          {
+            return;
+          }
+        T = m_tasks.front();
+        m_tasks.pop_front();
+        if(T.m_running)
+          {
+            ++*T.m_running;
+          }
+      }
+
+      T.m_job->run();
+
+      if(T.m_running)
+        {
+          m_mutex.lock();
+          --*T.m_running;
+          m_mutex.unlock();
+          m_task_done.notify_all();
+        }
+    }
+}
+
+fastuidraw::worker_pool&
+fastuidraw::worker_pool::
+shared(void)
+{
+  boost::call_once(shared_pool_once, &make_shared_pool);
+  return *shared_pool;
+}
@@ -0,0 +1,132 @@
+/*!
+ * \file worker_pool.hpp
+ * \brief file worker_pool.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <boost/thread.hpp>
+#include <fastuidraw/util/util.hpp>
+
+namespace fastuidraw
+{
+  /*!\class worker_pool
+    A worker_pool is a set of threads that are made once
+    and then help the threads that ask for them to run a
+    \ref job. A job given to run() is run on the asking
+    thread as well, so such a job never waits on the
+    worker_pool being free. A job given to post() is run
+    by the worker_pool alone, without the asking thread
+    waiting on it.
+   */
+  class worker_pool:fastuidraw::noncopyable
+  {
+  public:
+    /*!\class job
+      A job is run by several threads at once; each
+      call of run() is to take work from the job
+      until the job has no work left.
+     */
+    class job
+    {
+    public:
+      virtual
+      ~job()
+      {}
+
+      /*!\fn
+        To be implemented by a derived class to do
+        the work of the job until none is left.
+       */
+      virtual
+      void
+      run(void) = 0;
+    };
+
+    /*!\fn
+      Ctor.
+      \param number_threads number of threads of the worker_pool
+     */
+    explicit
+    worker_pool(unsigned int number_threads);
+
+    ~worker_pool();
+
+    /*!\fn
+      Returns the number of threads of the worker_pool.
+     */
+    unsigned int
+    number_threads(void) const
+    {
+      return m_number_threads;
+    }
+
+    /*!\fn
+      Run a job on the calling thread and on up to number_helpers
+      threads of the worker_pool, returning when each of those
+      calls of job::run() has returned. A thread of the worker_pool
+      that has not started on the job when the calling thread
+      returns from job::run() does not run the job.
+      \param J job to run
+      \param number_helpers maximum number of threads of the
+                            worker_pool to run the job
+     */
+    void
+    run(job *J, unsigned int number_helpers);
+
+    /*!\fn
+      Queue a job to be run once by a thread of the worker_pool
+      and return without waiting on it. The job must stay alive
+      until its job::run() returns. The worker_pool must have
+      at least one thread.
+      \param J job to run
+     */
+    void
+    post(job *J);
+
+    /*!\fn
+      Returns the worker_pool shared by the library. It is made
+      on the first call with one thread less than the number of
+      hardware threads, since the calling thread of run() also
+      runs jobs, but with at least one thread so that the jobs
+      given to post() are run.
+     */
+    static
+    worker_pool&
+    shared(void);
+
+  private:
+    /* m_running is NULL for a task added by post() */
+    class task
+    {
+    public:
+      job *m_job;
+      unsigned int *m_running;
+    };
+
+    void
+    worker(void);
+
+    unsigned int m_number_threads;
+    boost::mutex m_mutex;
+    boost::condition_variable m_task_added, m_task_done;
+    std::deque<task> m_tasks;
+    bool m_done;
+    boost::thread_group m_threads;
+  };
+}
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <complex>
+#include <boost/atomic.hpp>
 
 #include <fastuidraw/stroked_path.hpp>
 #include <fastuidraw/tessellated_path.hpp>
@@ -26,6 +27,7 @@
 #include <fastuidraw/painter/painter_attribute_data.hpp>
 #include <fastuidraw/painter/painter_attribute_data_filler_path_stroked.hpp>
 #include "private/util_private.hpp"
+#include "private/worker_pool.hpp"
 
 namespace
 {
@@ -80,6 +82,76 @@ namespace
     fastuidraw::range_type<unsigned int> m_attribs, m_indices;
   };
 
+  /* Where the data of a contour is within one partition of
+     the data of a point set. The data of each contour is
+     contiguous within each partition, so the data of a contour
+     that is unchanged can be copied from a StrokedPath made
+     earlier by shifting its indices and depth values. m_depth
+     holds the depth values before they are reversed (so that
+     the data drawn first has the largest depth value).
+   */
+  class ContourChunk
+  {
+  public:
+    ContourChunk(void):
+      m_attribs(0, 0),
+      m_indices(0, 0),
+      m_depth(0, 0)
+    {}
+
+    void
+    set_begin(unsigned int vertex, unsigned int index, unsigned int depth)
+    {
+      m_attribs.m_begin = vertex;
+      m_indices.m_begin = index;
+      m_depth.m_begin = depth;
+    }
+
+    void
+    set_end(unsigned int vertex, unsigned int index, unsigned int depth)
+    {
+      m_attribs.m_end = vertex;
+      m_indices.m_end = index;
+      m_depth.m_end = depth;
+    }
+
+    fastuidraw::range_type<unsigned int> m_attribs, m_indices, m_depth;
+  };
+
+  /* [0] --> data not of the closing edge, and the data of caps
+     [1] --> data of the closing edge
+   */
+  typedef fastuidraw::vecN<ContourChunk, 2> ContourChunkPair;
+
+  /* move a Location within the chunk src to where
+     the data of src is copied to by the chunk dst
+   */
+  void
+  shift_location(Location &loc, const ContourChunk &src, const ContourChunk &dst)
+  {
+    loc.m_attribs.m_begin = loc.m_attribs.m_begin - src.m_attribs.m_begin + dst.m_attribs.m_begin;
+    loc.m_attribs.m_end = loc.m_attribs.m_end - src.m_attribs.m_begin + dst.m_attribs.m_begin;
+    loc.m_indices.m_begin = loc.m_indices.m_begin - src.m_indices.m_begin + dst.m_indices.m_begin;
+    loc.m_indices.m_end = loc.m_indices.m_end - src.m_indices.m_begin + dst.m_indices.m_begin;
+  }
+
+  /* The arrays of a point set and where its (one or two)
+     partitions are within them.
+   */
+  class PointSetArrays
+  {
+  public:
+    fastuidraw::const_c_array<fastuidraw::StrokedPath::point> m_points;
+    fastuidraw::const_c_array<unsigned int> m_indices;
+    unsigned int m_number_partitions;
+    fastuidraw::uvec2 m_vertex_start, m_index_start;
+
+    /* the depth values of partition p, after being reversed,
+       are in [m_depth_start[p], m_depth_start[p] + m_depth_count[p])
+     */
+    fastuidraw::uvec2 m_depth_start, m_depth_count;
+  };
+
   class LocationsOfJoins
   {
   public:
@@ -181,13 +253,31 @@ namespace
   public:
     static const float sm_mag_tol;
 
-    EdgeDataCreator(const fastuidraw::TessellatedPath &P):
+    EdgeDataCreator(const fastuidraw::TessellatedPath &P,
+                    const std::vector<int> &contour_reuse):
       m_P(P),
+      m_contour_reuse(contour_reuse),
+      m_number_built_contours(0),
       m_per_contour_data(m_P.number_contours())
     {
       compute_size();
     }
 
+    /* the data of a contour is only made if it is
+       not copied from a StrokedPath made earlier.
+     */
+    bool
+    build_contour(unsigned int contour) const
+    {
+      return m_contour_reuse[contour] < 0;
+    }
+
+    unsigned int
+    number_built_contours(void) const
+    {
+      return m_number_built_contours;
+    }
+
     fastuidraw::uvec4
     sizes(void) const
     {
@@ -197,7 +287,8 @@ namespace
     void
     fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
               fastuidraw::c_array<unsigned int> indices,
-              unsigned int &pre_close_depth, unsigned int &close_depth);
+              unsigned int &pre_close_depth, unsigned int &close_depth,
+              std::vector<ContourChunkPair> &chunks);
 
     const PerContourData&
     per_contour_data(unsigned int contour) const
@@ -222,6 +313,8 @@ namespace
 
     PointIndexSize m_size;
     const fastuidraw::TessellatedPath &m_P;
+    const std::vector<int> &m_contour_reuse;
+    unsigned int m_number_built_contours;
     fastuidraw::vec2 m_prev_normal;
     std::vector<PerContourData> m_per_contour_data;
   };
@@ -288,7 +381,8 @@ namespace
               fastuidraw::c_array<unsigned int> indices,
               unsigned int &pre_close_depth, unsigned int &close_depth,
               std::vector<LocationsOfCapsAndJoins> &locations,
-              enum joint_type_t Jtype);
+              enum joint_type_t Jtype,
+              std::vector<ContourChunkPair> &chunks);
 
   private:
 
@@ -515,7 +609,8 @@ namespace
               fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
               fastuidraw::c_array<unsigned int> indices,
               std::vector<LocationsOfCapsAndJoins> &locations,
-              enum cap_type_t cp) const;
+              enum cap_type_t cp,
+              std::vector<ContourChunkPair> &chunks) const;
 
   private:
 
@@ -547,15 +642,16 @@ namespace
   class RoundedCapCreator:public CapCreatorBase
   {
   public:
-    RoundedCapCreator(const fastuidraw::TessellatedPath &P):
-      CapCreatorBase(P, compute_size(P))
+    RoundedCapCreator(const fastuidraw::TessellatedPath &P,
+                      const EdgeDataCreator &e):
+      CapCreatorBase(P, compute_size(P, 2 * e.number_built_contours()))
     {
     }
 
   private:
 
     PointIndexCapSize
-    compute_size(const fastuidraw::TessellatedPath &P);
+    compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps);
 
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -573,15 +669,16 @@ namespace
   class SquareCapCreator:public CapCreatorBase
   {
   public:
-    SquareCapCreator(const fastuidraw::TessellatedPath &P):
-      CapCreatorBase(P, compute_size(P))
+    SquareCapCreator(const fastuidraw::TessellatedPath &P,
+                     const EdgeDataCreator &e):
+      CapCreatorBase(P, compute_size(P, 2 * e.number_built_contours()))
     {
     }
 
   private:
 
     PointIndexCapSize
-    compute_size(const fastuidraw::TessellatedPath &P);
+    compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps);
 
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -596,15 +693,16 @@ namespace
   class AdjustableCapCreator:public CapCreatorBase
   {
   public:
-    AdjustableCapCreator(const fastuidraw::TessellatedPath &P):
-      CapCreatorBase(P, compute_size(P))
+    AdjustableCapCreator(const fastuidraw::TessellatedPath &P,
+                         const EdgeDataCreator &e):
+      CapCreatorBase(P, compute_size(P, 2 * e.number_built_contours()))
     {
     }
 
   private:
 
     PointIndexCapSize
-    compute_size(const fastuidraw::TessellatedPath &P);
+    compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps);
 
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -684,6 +782,14 @@ namespace
         m_without_closing_edge;
     }
 
+    void
+    swap(PartitionedArray &obj)
+    {
+      m_data.swap(obj.m_data);
+      std::swap(m_with_closing_edge, obj.m_with_closing_edge);
+      std::swap(m_without_closing_edge, obj.m_without_closing_edge);
+    }
+
   private:
     std::vector<T> m_data;
     fastuidraw::c_array<T> m_with_closing_edge;
@@ -723,6 +829,59 @@ namespace
       m_indices.resize(szs[2], szs[3], false);
     }
 
+    fastuidraw::c_array<T>
+    all_points(void)
+    {
+      return m_points.data(true);
+    }
+
+    fastuidraw::c_array<unsigned int>
+    all_indices(void)
+    {
+      return m_indices.data(true);
+    }
+
+    /* the vertices of partition 0 (not closing edge)
+       come first and the indices of partition 1 (closing
+       edge) come first
+     */
+    void
+    resize_partitions(fastuidraw::uvec2 verts, fastuidraw::uvec2 indices,
+                      fastuidraw::uvec2 depths)
+    {
+      resize(fastuidraw::uvec4(verts[0], verts[1], indices[0], indices[1]));
+      m_number_depth[false] = depths[0];
+      m_number_depth[true] = depths[0] + depths[1];
+    }
+
+    PointSetArrays
+    arrays(void) const
+    {
+      PointSetArrays R;
+
+      R.m_points = m_points.data(true);
+      R.m_indices = m_indices.data(true);
+      R.m_number_partitions = 2;
+      R.m_vertex_start = fastuidraw::uvec2(0, m_points.data(false).size());
+      R.m_index_start = fastuidraw::uvec2(m_indices.data(true).size() - m_indices.data(false).size(), 0);
+      R.m_depth_start = fastuidraw::uvec2(0, m_number_depth[false]);
+      R.m_depth_count = fastuidraw::uvec2(m_number_depth[false], m_number_depth[true] - m_number_depth[false]);
+      return R;
+    }
+
+    /* Data is never copied because the c_array values of
+       m_points and m_indices point into their std::vector.
+       Swapping the std::vector values keeps their backing
+       stores and thus keeps the c_array values valid.
+     */
+    void
+    swap(Data &obj)
+    {
+      m_points.swap(obj.m_points);
+      m_indices.swap(obj.m_indices);
+      std::swap(m_number_depth, obj.m_number_depth);
+    }
+
     void
     compute_conveniance(DataAsCArraysPair &out_value)
     {
@@ -751,6 +910,49 @@ namespace
       m_indices.resize(szs[1]);
     }
 
+    fastuidraw::c_array<fastuidraw::StrokedPath::point>
+    all_points(void)
+    {
+      return fastuidraw::make_c_array(m_points);
+    }
+
+    fastuidraw::c_array<unsigned int>
+    all_indices(void)
+    {
+      return fastuidraw::make_c_array(m_indices);
+    }
+
+    void
+    resize_partitions(fastuidraw::uvec2 verts, fastuidraw::uvec2 indices,
+                      fastuidraw::uvec2 depths)
+    {
+      resize(fastuidraw::uvec2(verts[0], indices[0]));
+      m_number_depth = depths[0];
+    }
+
+    PointSetArrays
+    arrays(void) const
+    {
+      PointSetArrays R;
+
+      R.m_points = fastuidraw::make_c_array(m_points);
+      R.m_indices = fastuidraw::make_c_array(m_indices);
+      R.m_number_partitions = 1;
+      R.m_vertex_start = fastuidraw::uvec2(0, 0);
+      R.m_index_start = fastuidraw::uvec2(0, 0);
+      R.m_depth_start = fastuidraw::uvec2(0, 0);
+      R.m_depth_count = fastuidraw::uvec2(m_number_depth, 0);
+      return R;
+    }
+
+    void
+    swap(CapData &obj)
+    {
+      m_points.swap(obj.m_points);
+      m_indices.swap(obj.m_indices);
+      std::swap(m_number_depth, obj.m_number_depth);
+    }
+
     void
     compute_conveniance(DataAsCArraysPair &out_value)
     {
@@ -764,10 +966,68 @@ namespace
   class StrokedPathPrivate
   {
   public:
-    explicit
-    StrokedPathPrivate(const fastuidraw::TessellatedPath &P);
+    /* contour_reuse[o] is the contour of prev whose data
+       to use for contour o, or -1 if the data of contour o
+       is to be made.
+     */
+    StrokedPathPrivate(const fastuidraw::TessellatedPath &P,
+                       const StrokedPathPrivate *prev,
+                       const std::vector<int> &contour_reuse,
+                       fastuidraw::worker_pool *pool,
+                       unsigned int max_threads);
     ~StrokedPathPrivate();
 
+    /* the join and cap data are each produced from the
+       TessellatedPath and the EdgeDataCreator only and
+       write to different elements of m_locations, so
+       they can be produced concurrently.
+     */
+    enum producer_t
+      {
+        rounded_joins_producer,
+        bevel_joins_producer,
+        miter_joins_producer,
+        cap_joins_producer,
+        rounded_cap_producer,
+        square_cap_producer,
+        adjustable_cap_producer,
+
+        number_producers
+      };
+
+    template<typename T>
+    void
+    create_joins(const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e,
+                 Data<fastuidraw::StrokedPath::point> &dst, enum joint_type_t tp,
+                 std::vector<ContourChunkPair> &chunks);
+
+    template<typename T>
+    void
+    create_caps(const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e,
+                CapData &dst, enum cap_type_t tp,
+                std::vector<ContourChunkPair> &chunks);
+
+    void
+    run_producer(enum producer_t producer,
+                 const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e);
+
+    PointSetArrays
+    arrays(enum fastuidraw::StrokedPath::point_set_t tp) const;
+
+    void
+    merge_contours(const StrokedPathPrivate &prev,
+                   const std::vector<int> &contour_reuse);
+
+    template<typename T>
+    void
+    merge_contours(enum fastuidraw::StrokedPath::point_set_t tp, T &dst,
+                   const StrokedPathPrivate &prev,
+                   const std::vector<int> &contour_reuse);
+
+    void
+    shift_locations(enum fastuidraw::StrokedPath::point_set_t tp, unsigned int contour,
+                    const ContourChunkPair &src, const ContourChunkPair &dst);
+
     Data<fastuidraw::StrokedPath::point> m_edges;
     Data<fastuidraw::StrokedPath::point> m_rounded_joins;
     Data<fastuidraw::StrokedPath::point> m_bevel_joins;
@@ -779,10 +1039,40 @@ namespace
     CapData m_adjustable_cap;
     std::vector<LocationsOfCapsAndJoins> m_locations;
 
+    /* for each point set, where the data of each
+       contour is within each partition
+     */
+    fastuidraw::vecN<std::vector<ContourChunkPair>, fastuidraw::StrokedPath::number_point_set_types> m_chunks;
+
     fastuidraw::vecN<DataAsCArraysPair, fastuidraw::StrokedPath::number_point_set_types> m_return_values;
     fastuidraw::PainterAttributeData *m_attribute_data;
   };
 
+  /* runs the producers of a StrokedPathPrivate
+     until none are left to run
+   */
+  class ProducerJob:public fastuidraw::worker_pool::job
+  {
+  public:
+    ProducerJob(StrokedPathPrivate *d,
+                const fastuidraw::TessellatedPath &P,
+                const EdgeDataCreator &e):
+      m_d(d),
+      m_P(P),
+      m_e(e),
+      m_next_producer(0)
+    {}
+
+    virtual
+    void
+    run(void);
+
+  private:
+    StrokedPathPrivate *m_d;
+    const fastuidraw::TessellatedPath &m_P;
+    const EdgeDataCreator &m_e;
+    boost::atomic<unsigned int> m_next_producer;
+  };
 }
 
 //////////////////////////////////
@@ -823,6 +1113,9 @@ get_cap_type_t(enum fastuidraw::StrokedPath::point_set_t tp)
     case fastuidraw::StrokedPath::rounded_cap_point_set:
       return rounded_cap;
 
+    case fastuidraw::StrokedPath::adjustable_cap_point_set:
+      return adjustable_cap;
+
     default:
       assert(!"Passed a non-cap type to get_cap_type_t");
       return cap_type_count;
@@ -1008,6 +1301,12 @@ compute_size(void)
 {
   for(unsigned int o = 0; o < m_P.number_contours(); ++o)
     {
+      if(!build_contour(o))
+        {
+          continue;
+        }
+
+      ++m_number_built_contours;
       m_per_contour_data[o].m_edge_begin_normal.resize(m_P.number_edges(o), fastuidraw::vec2(999,999));
       m_per_contour_data[o].m_edge_end_normal.resize(m_P.number_edges(o), fastuidraw::vec2(111,111));
       for(unsigned int e = 0; e < m_P.number_edges(o); ++e)
@@ -1198,7 +1497,8 @@ void
 EdgeDataCreator::
 fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
           fastuidraw::c_array<unsigned int> indices,
-          unsigned int &pre_close_depth, unsigned int &close_depth)
+          unsigned int &pre_close_depth, unsigned int &close_depth,
+          std::vector<ContourChunkPair> &chunks)
 {
   unsigned int pre_close_vertex(0), pre_close_index(m_size.close_indices());
   unsigned int close_vertex(m_size.pre_close_verts()), close_index(0);
@@ -1209,6 +1509,13 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
 
   for(unsigned int o = 0; o < m_P.number_contours(); ++o)
     {
+      if(!build_contour(o))
+        {
+          continue;
+        }
+
+      chunks[o][0].set_begin(pre_close_vertex, pre_close_index, pre_close_depth);
+      chunks[o][1].set_begin(close_vertex, close_index, close_depth);
       for(unsigned int e = 0; e < m_P.number_edges(o); ++e)
         {
           if(e + 1 == m_P.number_edges(o))
@@ -1222,6 +1529,8 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                        pre_close_vertex, pre_close_index);
             }
         }
+      chunks[o][0].set_end(pre_close_vertex, pre_close_index, pre_close_depth);
+      chunks[o][1].set_end(close_vertex, close_index, close_depth);
     }
 
   assert(pre_close_vertex == m_size.pre_close_verts());
@@ -1258,6 +1567,11 @@ compute_size(void)
       m_size_ready = true;
       for(unsigned int o = 0, join_id = 0; o < m_P.number_contours(); ++o)
         {
+          if(!m_e.build_contour(o))
+            {
+              continue;
+            }
+
           for(unsigned int e = 1; e + 1 < m_P.number_edges(o); ++e, ++join_id)
             {
               add_join(join_id, m_P,
@@ -1326,7 +1640,8 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
           fastuidraw::c_array<unsigned int> indices,
           unsigned int &pre_close_depth, unsigned int &close_depth,
           std::vector<LocationsOfCapsAndJoins> &locations,
-          enum joint_type_t Jtype)
+          enum joint_type_t Jtype,
+          std::vector<ContourChunkPair> &chunks)
 {
   unsigned int pre_close_vertex(0), pre_close_index(m_size.close_indices());
   unsigned int close_vertex(m_size.pre_close_verts()), close_index(0);
@@ -1337,6 +1652,13 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
 
   for(unsigned int o = 0, join_id = 0; o < m_P.number_contours(); ++o)
     {
+      if(!m_e.build_contour(o))
+        {
+          continue;
+        }
+
+      chunks[o][0].set_begin(pre_close_vertex, pre_close_index, pre_close_depth);
+      chunks[o][1].set_begin(close_vertex, close_index, close_depth);
       for(unsigned int e = 1; e + 1 < m_P.number_edges(o); ++e, ++join_id)
         {
           fill_join(join_id, o, e, pts, pre_close_depth, indices,
@@ -1356,6 +1678,8 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
 
           join_id += 2;
         }
+      chunks[o][0].set_end(pre_close_vertex, pre_close_index, pre_close_depth);
+      chunks[o][1].set_end(close_vertex, close_index, close_depth);
     }
 
   total = close_depth + pre_close_depth;
@@ -1892,12 +2216,19 @@ fill_data(const EdgeDataCreator &edge_creator,
           fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
           fastuidraw::c_array<unsigned int> indices,
           std::vector<LocationsOfCapsAndJoins> &locations,
-          enum cap_type_t cp) const
+          enum cap_type_t cp,
+          std::vector<ContourChunkPair> &chunks) const
 {
   unsigned int vertex_offset(0), index_offset(0), v(0), depth(0);
 
   for(unsigned int o = 0; o < m_P.number_contours(); ++o)
     {
+      if(!edge_creator.build_contour(o))
+        {
+          continue;
+        }
+
+      chunks[o][0].set_begin(vertex_offset, index_offset, depth);
       add_cap_and_set_location(edge_creator.per_contour_data(o).m_begin_cap_normal,
                                true, m_P.unclosed_contour_point_data(o).front(),
                                pts, indices,
@@ -1922,6 +2253,7 @@ fill_data(const EdgeDataCreator &edge_creator,
           assign_depth(pts[v], depth);
           ++depth;
         }
+      chunks[o][0].set_end(vertex_offset, index_offset, depth);
     }
 
   assert(vertex_offset == m_size.verts());
@@ -1940,10 +2272,9 @@ fill_data(const EdgeDataCreator &edge_creator,
 // RoundedCapCreator methods
 PointIndexCapSize
 RoundedCapCreator::
-compute_size(const fastuidraw::TessellatedPath &P)
+compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps)
 {
   float tc(P.tessellation_parameters().m_curve_tessellation);
-  unsigned int num_caps;
   PointIndexCapSize return_value;
 
   m_num_arc_points_per_cap = static_cast<unsigned int>(static_cast<float>(M_PI) / tc);
@@ -1953,7 +2284,6 @@ compute_size(const fastuidraw::TessellatedPath &P)
 
   /* each cap is a triangle fan centered at the cap point.
    */
-  num_caps = 2 * P.number_contours();
   return_value.verts() = (1 + m_num_arc_points_per_cap) * num_caps;
   return_value.indices() = 3 * (m_num_arc_points_per_cap - 1) * num_caps;
 
@@ -2039,15 +2369,15 @@ add_cap(const fastuidraw::vec2 &normal_from_stroking,
 // SquareCapCreator methods
 PointIndexCapSize
 SquareCapCreator::
-compute_size(const fastuidraw::TessellatedPath &P)
+compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps)
 {
   PointIndexCapSize return_value;
-  unsigned int num_caps;
+
+  FASTUIDRAWunused(P);
 
   /* each square cap generates 5 new points
      and 3 triangles (= 9 indices)
    */
-  num_caps = 2 * P.number_contours();
   return_value.verts() = 5 * num_caps;
   return_value.indices() = 9 * num_caps;
 
@@ -2136,12 +2466,11 @@ add_cap(const fastuidraw::vec2 &normal_from_stroking,
 // AdjustableCapCreator methods
 PointIndexCapSize
 AdjustableCapCreator::
-compute_size(const fastuidraw::TessellatedPath &P)
+compute_size(const fastuidraw::TessellatedPath &P, unsigned int num_caps)
 {
   PointIndexCapSize return_value;
-  unsigned int num_caps;
 
-  num_caps = 2 * P.number_contours();
+  FASTUIDRAWunused(P);
   return_value.verts() = CapJoinCreator::number_points_per_fan * num_caps;
   return_value.indices() = CapJoinCreator::number_indices_per_fan * num_caps;
 
@@ -2334,7 +2663,11 @@ fill_join_implement(unsigned int join_id,
 /////////////////////////////////////////////
 // StrokedPathPrivate methods
 StrokedPathPrivate::
-StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
+StrokedPathPrivate(const fastuidraw::TessellatedPath &P,
+                   const StrokedPathPrivate *prev,
+                   const std::vector<int> &contour_reuse,
+                   fastuidraw::worker_pool *pool,
+                   unsigned int max_threads):
   m_attribute_data(NULL)
 {
   if(P.number_contours() == 0)
@@ -2348,65 +2681,39 @@ StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
       m_locations[C].m_joins.resize(P.number_edges(C));
     }
 
-  EdgeDataCreator e(P);
+  for(unsigned int i = 0; i < fastuidraw::StrokedPath::number_point_set_types; ++i)
+    {
+      m_chunks[i].resize(P.number_contours());
+    }
+
+  /* the joins and caps need the normals computed
+     when the edge data is filled.
+   */
+  EdgeDataCreator e(P, contour_reuse);
   m_edges.resize(e.sizes());
   e.fill_data(m_edges.m_points.data(true),
               m_edges.m_indices.data(true),
               m_edges.m_number_depth[false],
-              m_edges.m_number_depth[true]);
-
-  RoundedJoinCreator r(P, e);
-  m_rounded_joins.resize(r.sizes());
-  r.fill_data(m_rounded_joins.m_points.data(true),
-              m_rounded_joins.m_indices.data(true),
-              m_rounded_joins.m_number_depth[false],
-              m_rounded_joins.m_number_depth[true],
-              m_locations, rounded_join);
-
-  BevelJoinCreator b(P, e);
-  m_bevel_joins.resize(b.sizes());
-  b.fill_data(m_bevel_joins.m_points.data(true),
-              m_bevel_joins.m_indices.data(true),
-              m_bevel_joins.m_number_depth[false],
-              m_bevel_joins.m_number_depth[true],
-              m_locations, bevel_join);
-
-  MiterJoinCreator m(P, e);
-  m_miter_joins.resize(m.sizes());
-  m.fill_data(m_miter_joins.m_points.data(true),
-              m_miter_joins.m_indices.data(true),
-              m_miter_joins.m_number_depth[false],
-              m_miter_joins.m_number_depth[true],
-              m_locations, miter_join);
-
-  CapJoinCreator cj(P, e);
-  m_cap_joins.resize(cj.sizes());
-  cj.fill_data(m_cap_joins.m_points.data(true),
-               m_cap_joins.m_indices.data(true),
-               m_cap_joins.m_number_depth[false],
-               m_cap_joins.m_number_depth[true],
-               m_locations, cap_join);
-
-  RoundedCapCreator rc(P);
-  m_rounded_cap.resize(rc.sizes());
-  m_rounded_cap.m_number_depth = rc.fill_data(e,
-                                              fastuidraw::make_c_array(m_rounded_cap.m_points),
-                                              fastuidraw::make_c_array(m_rounded_cap.m_indices),
-                                              m_locations, rounded_cap);
-
-  SquareCapCreator sc(P);
-  m_square_cap.resize(sc.sizes());
-  m_square_cap.m_number_depth = sc.fill_data(e,
-                                             fastuidraw::make_c_array(m_square_cap.m_points),
-                                             fastuidraw::make_c_array(m_square_cap.m_indices),
-                                             m_locations, square_cap);
-
-  AdjustableCapCreator ac(P);
-  m_adjustable_cap.resize(ac.sizes());
-  m_adjustable_cap.m_number_depth = ac.fill_data(e,
-                                                 fastuidraw::make_c_array(m_adjustable_cap.m_points),
-                                                 fastuidraw::make_c_array(m_adjustable_cap.m_indices),
-                                                 m_locations, adjustable_cap);
+              m_edges.m_number_depth[true],
+              m_chunks[fastuidraw::StrokedPath::edge_point_set]);
+
+  ProducerJob job(this, P, e);
+  if(pool != NULL && max_threads > 1)
+    {
+      /* the calling thread also runs producers
+       */
+      pool->run(&job, std::min(max_threads, static_cast<unsigned int>(number_producers)) - 1);
+    }
+  else
+    {
+      job.run();
+    }
+
+  if(e.number_built_contours() < P.number_contours())
+    {
+      assert(prev != NULL);
+      merge_contours(*prev, contour_reuse);
+    }
 
   m_bevel_joins.compute_conveniance(m_return_values[fastuidraw::StrokedPath::bevel_join_point_set]);
   m_rounded_joins.compute_conveniance(m_return_values[fastuidraw::StrokedPath::rounded_join_point_set]);
@@ -2420,6 +2727,282 @@ StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
   m_edges.compute_conveniance(m_return_values[fastuidraw::StrokedPath::edge_point_set]);
 }
 
+template<typename T>
+void
+StrokedPathPrivate::
+create_joins(const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e,
+             Data<fastuidraw::StrokedPath::point> &dst, enum joint_type_t tp,
+             std::vector<ContourChunkPair> &chunks)
+{
+  T creator(P, e);
+  dst.resize(creator.sizes());
+  creator.fill_data(dst.m_points.data(true),
+                    dst.m_indices.data(true),
+                    dst.m_number_depth[false],
+                    dst.m_number_depth[true],
+                    m_locations, tp, chunks);
+}
+
+template<typename T>
+void
+StrokedPathPrivate::
+create_caps(const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e,
+            CapData &dst, enum cap_type_t tp,
+            std::vector<ContourChunkPair> &chunks)
+{
+  T creator(P, e);
+  dst.resize(creator.sizes());
+  dst.m_number_depth = creator.fill_data(e,
+                                         fastuidraw::make_c_array(dst.m_points),
+                                         fastuidraw::make_c_array(dst.m_indices),
+                                         m_locations, tp, chunks);
+}
+
+void
+StrokedPathPrivate::
+run_producer(enum producer_t producer,
+             const fastuidraw::TessellatedPath &P, const EdgeDataCreator &e)
+{
+  switch(producer)
+    {
+    case rounded_joins_producer:
+      create_joins<RoundedJoinCreator>(P, e, m_rounded_joins, rounded_join,
+                                       m_chunks[fastuidraw::StrokedPath::rounded_join_point_set]);
+      break;
+
+    case bevel_joins_producer:
+      create_joins<BevelJoinCreator>(P, e, m_bevel_joins, bevel_join,
+                                       m_chunks[fastuidraw::StrokedPath::bevel_join_point_set]);
+      break;
+
+    case miter_joins_producer:
+      create_joins<MiterJoinCreator>(P, e, m_miter_joins, miter_join,
+                                       m_chunks[fastuidraw::StrokedPath::miter_join_point_set]);
+      break;
+
+    case cap_joins_producer:
+      create_joins<CapJoinCreator>(P, e, m_cap_joins, cap_join,
+                                       m_chunks[fastuidraw::StrokedPath::cap_join_point_set]);
+      break;
+
+    case rounded_cap_producer:
+      create_caps<RoundedCapCreator>(P, e, m_rounded_cap, rounded_cap,
+                                      m_chunks[fastuidraw::StrokedPath::rounded_cap_point_set]);
+      break;
+
+    case square_cap_producer:
+      create_caps<SquareCapCreator>(P, e, m_square_cap, square_cap,
+                                      m_chunks[fastuidraw::StrokedPath::square_cap_point_set]);
+      break;
+
+    case adjustable_cap_producer:
+      create_caps<AdjustableCapCreator>(P, e, m_adjustable_cap, adjustable_cap,
+                                      m_chunks[fastuidraw::StrokedPath::adjustable_cap_point_set]);
+      break;
+
+    default:
+      assert(!"Bad producer_t passed to run_producer");
+    }
+}
+
+//////////////////////////////////////
+// ProducerJob methods
+void
+ProducerJob::
+run(void)
+{
+  unsigned int producer;
+
+  while((producer = m_next_producer.fetch_add(1)) < StrokedPathPrivate::number_producers)
+    {
+      m_d->run_producer(static_cast<enum StrokedPathPrivate::producer_t>(producer), m_P, m_e);
+    }
+}
+
+PointSetArrays
+StrokedPathPrivate::
+arrays(enum fastuidraw::StrokedPath::point_set_t tp) const
+{
+  switch(tp)
+    {
+    case fastuidraw::StrokedPath::edge_point_set:
+      return m_edges.arrays();
+
+    case fastuidraw::StrokedPath::bevel_join_point_set:
+      return m_bevel_joins.arrays();
+
+    case fastuidraw::StrokedPath::rounded_join_point_set:
+      return m_rounded_joins.arrays();
+
+    case fastuidraw::StrokedPath::miter_join_point_set:
+      return m_miter_joins.arrays();
+
+    case fastuidraw::StrokedPath::cap_join_point_set:
+      return m_cap_joins.arrays();
+
+    case fastuidraw::StrokedPath::square_cap_point_set:
+      return m_square_cap.arrays();
+
+    case fastuidraw::StrokedPath::rounded_cap_point_set:
+      return m_rounded_cap.arrays();
+
+    case fastuidraw::StrokedPath::adjustable_cap_point_set:
+      return m_adjustable_cap.arrays();
+
+    default:
+      assert(!"Bad point_set_t passed to arrays");
+      return PointSetArrays();
+    }
+}
+
+void
+StrokedPathPrivate::
+merge_contours(const StrokedPathPrivate &prev,
+               const std::vector<int> &contour_reuse)
+{
+  /* a reused contour takes the locations of its joins
+     and caps from prev; merge_contours() then moves them,
+     and those of the contours that were made, to where
+     their data lands in the merged arrays.
+   */
+  for(unsigned int o = 0, endo = m_locations.size(); o < endo; ++o)
+    {
+      if(contour_reuse[o] >= 0)
+        {
+          assert(static_cast<unsigned int>(contour_reuse[o]) < prev.m_locations.size());
+          assert(prev.m_locations[contour_reuse[o]].m_joins.size() == m_locations[o].m_joins.size());
+          m_locations[o] = prev.m_locations[contour_reuse[o]];
+        }
+    }
+
+  merge_contours(fastuidraw::StrokedPath::edge_point_set, m_edges, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::bevel_join_point_set, m_bevel_joins, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::rounded_join_point_set, m_rounded_joins, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::miter_join_point_set, m_miter_joins, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::cap_join_point_set, m_cap_joins, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::square_cap_point_set, m_square_cap, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::rounded_cap_point_set, m_rounded_cap, prev, contour_reuse);
+  merge_contours(fastuidraw::StrokedPath::adjustable_cap_point_set, m_adjustable_cap, prev, contour_reuse);
+}
+
+template<typename T>
+void
+StrokedPathPrivate::
+merge_contours(enum fastuidraw::StrokedPath::point_set_t tp, T &dst,
+               const StrokedPathPrivate &prev,
+               const std::vector<int> &contour_reuse)
+{
+  PointSetArrays made(dst.arrays()), reused(prev.arrays(tp)), merged_arrays;
+  std::vector<ContourChunkPair> &chunks(m_chunks[tp]);
+  const std::vector<ContourChunkPair> &prev_chunks(prev.m_chunks[tp]);
+  fastuidraw::uvec2 verts(0, 0), indices(0, 0), depths(0, 0);
+  fastuidraw::c_array<fastuidraw::StrokedPath::point> dst_pts;
+  fastuidraw::c_array<unsigned int> dst_indices;
+  T merged;
+
+  for(unsigned int o = 0, endo = chunks.size(); o < endo; ++o)
+    {
+      const ContourChunkPair &src((contour_reuse[o] < 0) ? chunks[o] : prev_chunks[contour_reuse[o]]);
+      for(unsigned int p = 0; p < made.m_number_partitions; ++p)
+        {
+          verts[p] += src[p].m_attribs.difference();
+          indices[p] += src[p].m_indices.difference();
+          depths[p] += src[p].m_depth.difference();
+        }
+    }
+
+  merged.resize_partitions(verts, indices, depths);
+  merged_arrays = merged.arrays();
+  dst_pts = merged.all_points();
+  dst_indices = merged.all_indices();
+
+  fastuidraw::uvec2 vertex(merged_arrays.m_vertex_start), index(merged_arrays.m_index_start);
+  fastuidraw::uvec2 depth(0, 0);
+
+  for(unsigned int o = 0, endo = chunks.size(); o < endo; ++o)
+    {
+      bool is_reused(contour_reuse[o] >= 0);
+      const PointSetArrays &src_arrays(is_reused ? reused : made);
+      ContourChunkPair src(is_reused ? prev_chunks[contour_reuse[o]] : chunks[o]);
+
+      for(unsigned int p = 0; p < made.m_number_partitions; ++p)
+        {
+          const ContourChunk &S(src[p]);
+          ContourChunk &D(chunks[o][p]);
+          unsigned int src_last_depth, dst_last_depth;
+
+          /* the depth values of a partition are reversed from the
+             order in which they are made, see fill_data() of
+             EdgeDataCreator, JoinCreatorBase and CapCreatorBase.
+           */
+          src_last_depth = src_arrays.m_depth_start[p] + src_arrays.m_depth_count[p] - 1;
+          dst_last_depth = merged_arrays.m_depth_start[p] + merged_arrays.m_depth_count[p] - 1;
+
+          D.set_begin(vertex[p], index[p], depth[p]);
+          for(unsigned int v = S.m_attribs.m_begin; v < S.m_attribs.m_end; ++v, ++vertex[p])
+            {
+              fastuidraw::StrokedPath::point pt(src_arrays.m_points[v]);
+              unsigned int made_depth;
+
+              made_depth = src_last_depth - pt.depth() - S.m_depth.m_begin + depth[p];
+              assign_depth(pt, dst_last_depth - made_depth);
+              dst_pts[vertex[p]] = pt;
+            }
+
+          for(unsigned int i = S.m_indices.m_begin; i < S.m_indices.m_end; ++i, ++index[p])
+            {
+              dst_indices[index[p]] = src_arrays.m_indices[i] - S.m_attribs.m_begin + D.m_attribs.m_begin;
+            }
+          depth[p] += S.m_depth.difference();
+          D.set_end(vertex[p], index[p], depth[p]);
+        }
+      shift_locations(tp, o, src, chunks[o]);
+    }
+
+  dst.swap(merged);
+}
+
+void
+StrokedPathPrivate::
+shift_locations(enum fastuidraw::StrokedPath::point_set_t tp, unsigned int contour,
+                const ContourChunkPair &src, const ContourChunkPair &dst)
+{
+  LocationsOfCapsAndJoins &L(m_locations[contour]);
+
+  switch(tp)
+    {
+    case fastuidraw::StrokedPath::edge_point_set:
+      break;
+
+    case fastuidraw::StrokedPath::square_cap_point_set:
+    case fastuidraw::StrokedPath::rounded_cap_point_set:
+    case fastuidraw::StrokedPath::adjustable_cap_point_set:
+      {
+        enum cap_type_t C;
+        C = LocationsOfCapsAndJoins::get_cap_type_t(tp);
+        shift_location(L.m_caps[C].m_values[0], src[0], dst[0]);
+        shift_location(L.m_caps[C].m_values[1], src[0], dst[0]);
+      }
+      break;
+
+    default:
+      {
+        /* the last two joins of a contour are those
+           of the closing edge, see JoinCreatorBase::fill_data()
+         */
+        enum joint_type_t J;
+        unsigned int n(L.m_joins.size());
+
+        J = LocationsOfCapsAndJoins::get_join_type_t(tp);
+        for(unsigned int k = 0; k < n && n >= 2; ++k)
+          {
+            unsigned int p((k + 2 >= n) ? 1u : 0u);
+            shift_location(L.m_joins[k].m_values[J], src[p], dst[p]);
+          }
+      }
+    }
+}
+
 StrokedPathPrivate::
 ~StrokedPathPrivate()
 {
@@ -2511,10 +3094,43 @@ miter_distance(void) const
 //////////////////////////////////////////////////////////////
 // fastuidraw::StrokedPath methods
 fastuidraw::StrokedPath::
-StrokedPath(const fastuidraw::TessellatedPath &P)
+StrokedPath(const fastuidraw::TessellatedPath &P, unsigned int max_threads)
 {
+  std::vector<int> contour_reuse(P.number_contours(), -1);
+
   assert(number_offset_types < FASTUIDRAW_MAX_VALUE_FROM_NUM_BITS(offset_type_num_bits));
-  m_d = FASTUIDRAWnew StrokedPathPrivate(P);
+  m_d = FASTUIDRAWnew StrokedPathPrivate(P, NULL, contour_reuse,
+                                         (max_threads > 1) ? &worker_pool::shared() : NULL,
+                                         max_threads);
+}
+
+fastuidraw::StrokedPath::
+StrokedPath(const fastuidraw::TessellatedPath &P,
+            const reference_counted_ptr<const StrokedPath> &reuse,
+            const_c_array<int> reuse_contours,
+            unsigned int max_threads)
+{
+  std::vector<int> contour_reuse(P.number_contours(), -1);
+  const StrokedPathPrivate *prev(NULL);
+
+  assert(number_offset_types < FASTUIDRAW_MAX_VALUE_FROM_NUM_BITS(offset_type_num_bits));
+  if(reuse && reuse_contours.size() == P.number_contours())
+    {
+      prev = reinterpret_cast<const StrokedPathPrivate*>(reuse->m_d);
+      for(unsigned int o = 0, endo = P.number_contours(); o < endo; ++o)
+        {
+          int c(reuse_contours[o]);
+          if(c >= 0
+             && static_cast<unsigned int>(c) < prev->m_locations.size()
+             && prev->m_locations[c].m_joins.size() == P.number_edges(o))
+            {
+              contour_reuse[o] = c;
+            }
+        }
+    }
+  m_d = FASTUIDRAWnew StrokedPathPrivate(P, prev, contour_reuse,
+                                         (max_threads > 1) ? &worker_pool::shared() : NULL,
+                                         max_threads);
 }
 
 fastuidraw::StrokedPath::
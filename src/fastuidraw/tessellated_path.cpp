@@ -17,8 +17,8 @@
  */
 
 
-#include <list>
 #include <vector>
+#include <map>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
 #include "private/util_private.hpp"
@@ -29,7 +29,12 @@ namespace
   {
   public:
     TessellatedPathPrivate(const fastuidraw::Path &input,
-                           fastuidraw::TessellatedPath::TessellationParams TP);
+                           fastuidraw::TessellatedPath::TessellationParams TP,
+                           const TessellatedPathPrivate *reuse);
+
+    int
+    find_reuse_contour(const TessellatedPathPrivate *reuse, unsigned int o,
+                       const fastuidraw::PathContour *contour);
 
     std::vector<std::vector<fastuidraw::range_type<unsigned int> > > m_edge_ranges;
     std::vector<fastuidraw::TessellatedPath::point> m_point_data;
@@ -37,6 +42,28 @@ namespace
     fastuidraw::TessellatedPath::TessellationParams m_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked;
     fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled;
+
+    /* the contours and edges from which the tessellation was made;
+       the points of an edge are only a function of the interpolator
+       and m_params, so a later tessellation with the same m_params
+       can copy the points of those edges whose interpolator it
+       shares with this tessellation.
+     */
+    std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> > m_contour_sources;
+    std::vector<std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::PathContour::interpolator_base> > > m_edge_sources;
+
+    /* built on first need from the m_contour_sources of the
+       TessellatedPathPrivate being reused.
+     */
+    std::map<const fastuidraw::PathContour*, unsigned int> m_reuse_contour_map;
+
+    /* m_reused_contours[o] is the contour of the TessellatedPath
+       being reused all of whose edges are those of contour o, or
+       -1 if there is no such contour; the stroking of that contour
+       is then copied from m_reuse_stroked when this is stroked.
+     */
+    std::vector<int> m_reused_contours;
+    fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_reuse_stroked;
   };
 }
 
@@ -44,113 +71,168 @@ namespace
 // TessellatedPathPrivate methods
 TessellatedPathPrivate::
 TessellatedPathPrivate(const fastuidraw::Path &input,
-                       fastuidraw::TessellatedPath::TessellationParams TP):
+                       fastuidraw::TessellatedPath::TessellationParams TP,
+                       const TessellatedPathPrivate *reuse):
   m_edge_ranges(input.number_contours()),
   m_box_min(0.0f, 0.0f),
   m_box_max(0.0f, 0.0f),
-  m_params(TP)
+  m_params(TP),
+  m_contour_sources(input.number_contours()),
+  m_edge_sources(input.number_contours()),
+  m_reused_contours(input.number_contours(), -1)
 {
-  if(input.number_contours() > 0)
+  std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
+  bool first_point(true);
+
+  if(reuse != NULL && reuse->m_params != m_params)
+    {
+      reuse = NULL;
+    }
+
+  if(reuse != NULL)
     {
-      std::list<std::vector<fastuidraw::TessellatedPath::point> > temp;
-      std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
-      std::list<std::vector<fastuidraw::TessellatedPath::point> >::const_iterator iter, end_iter;
+      m_point_data.reserve(reuse->m_point_data.size());
+      m_reuse_stroked = reuse->m_stroked;
+    }
 
-      for(unsigned int loc = 0, o = 0, endo = input.number_contours(); o < endo; ++o)
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    {
+      fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
+      float contour_length(0.0f), open_contour_length(0.0f), closed_contour_length(0.0f);
+      unsigned int contour_start(m_point_data.size());
+      int reuse_contour;
+
+      reuse_contour = (reuse != NULL) ?
+        find_reuse_contour(reuse, o, contour.get()) :
+        -1;
+
+      bool all_edges_reused(reuse_contour != -1
+                            && reuse->m_edge_sources[reuse_contour].size() == contour->number_points());
+
+      m_contour_sources[o] = contour;
+      m_edge_ranges[o].resize(contour->number_points());
+      m_edge_sources[o].resize(contour->number_points());
+      for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
         {
-          fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
-          float contour_length(0.0f), open_contour_length(0.0f), closed_contour_length(0.0f);
-          std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator start_contour;
+          const fastuidraw::reference_counted_ptr<const fastuidraw::PathContour::interpolator_base> &h(contour->interpolator(e));
+          fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src;
+          unsigned int loc(m_point_data.size());
 
-          m_edge_ranges[o].resize(contour->number_points());
-          for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
+          if(reuse_contour != -1
+             && e < reuse->m_edge_sources[reuse_contour].size()
+             && reuse->m_edge_sources[reuse_contour][e] == h)
+            {
+              src = fastuidraw::make_c_array(reuse->m_point_data).sub_array(reuse->m_edge_ranges[reuse_contour][e]);
+            }
+          else
             {
               unsigned int needed;
 
-              temp.push_back(std::vector<fastuidraw::TessellatedPath::point>());
-              needed = contour->interpolator(e)->produce_tessellation(m_params, fastuidraw::make_c_array(work_room));
-              m_edge_ranges[o][e] = fastuidraw::range_type<unsigned int>(loc, loc + needed);
-              loc += needed;
-
-              for(unsigned int n = 0; n < needed; ++n)
-                {
-                  const fastuidraw::vec2 &pt(work_room[n].m_p);
-
-                  work_room[n].m_distance_from_contour_start = contour_length + work_room[n].m_distance_from_edge_start;
-
-                  if(o == 0 and e == 0 and n == 0)
-                    {
-                      m_box_min = pt;
-                      m_box_max = pt;
-                    }
-                  else
-                    {
-                      m_box_min.x() = std::min(m_box_min.x(), pt.x());
-                      m_box_min.y() = std::min(m_box_min.y(), pt.y());
-                      m_box_max.x() = std::max(m_box_max.x(), pt.x());
-                      m_box_max.y() = std::max(m_box_max.y(), pt.y());
-                    }
-                }
-              std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator t;
-              t = temp.insert(temp.end(),
-                              std::vector<fastuidraw::TessellatedPath::point>(work_room.begin(), work_room.begin() + needed));
-              if(e == 0)
+              all_edges_reused = false;
+              needed = h->produce_tessellation(m_params, fastuidraw::make_c_array(work_room));
+              if(needed > work_room.size())
                 {
-                  start_contour = t;
+                  work_room.resize(needed);
+                  needed = h->produce_tessellation(m_params, fastuidraw::make_c_array(work_room));
+                  assert(needed <= work_room.size());
                 }
+              src = fastuidraw::make_c_array(work_room).sub_array(0, needed);
+            }
 
-              contour_length = temp.back().back().m_distance_from_contour_start;
+          m_edge_sources[o][e] = h;
+          m_edge_ranges[o][e] = fastuidraw::range_type<unsigned int>(loc, loc + src.size());
+          m_point_data.insert(m_point_data.end(), src.begin(), src.end());
 
-              if(e + 2 == ende)
-                {
-                  open_contour_length = contour_length;
-                }
-              else if(e + 1 == ende)
+          float edge_length(src.back().m_distance_from_edge_start);
+          for(unsigned int n = loc, endn = m_point_data.size(); n < endn; ++n)
+            {
+              const fastuidraw::vec2 &pt(m_point_data[n].m_p);
+
+              m_point_data[n].m_distance_from_contour_start = contour_length + m_point_data[n].m_distance_from_edge_start;
+              m_point_data[n].m_edge_length = edge_length;
+
+              if(first_point)
                 {
-                  closed_contour_length = contour_length;
+                  m_box_min = pt;
+                  m_box_max = pt;
+                  first_point = false;
                 }
-
-              for(unsigned int n = 0; n < needed; ++n)
+              else
                 {
-                  (*t)[n].m_edge_length = (*t)[needed - 1].m_distance_from_edge_start;
+                  m_box_min.x() = std::min(m_box_min.x(), pt.x());
+                  m_box_min.y() = std::min(m_box_min.y(), pt.y());
+                  m_box_max.x() = std::max(m_box_max.x(), pt.x());
+                  m_box_max.y() = std::max(m_box_max.y(), pt.y());
                 }
             }
 
-          for(std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator
-                t = start_contour, endt = temp.end(); t != endt; ++t)
+          contour_length = m_point_data.back().m_distance_from_contour_start;
+
+          if(e + 2 == ende)
             {
-              for(unsigned int e = 0, ende = t->size(); e < ende; ++e)
-                {
-                  (*t)[e].m_open_contour_length = open_contour_length;
-                  (*t)[e].m_closed_contour_length = closed_contour_length;
-                }
+              open_contour_length = contour_length;
+            }
+          else if(e + 1 == ende)
+            {
+              closed_contour_length = contour_length;
             }
         }
 
-      unsigned int total_needed;
+      for(unsigned int n = contour_start, endn = m_point_data.size(); n < endn; ++n)
+        {
+          m_point_data[n].m_open_contour_length = open_contour_length;
+          m_point_data[n].m_closed_contour_length = closed_contour_length;
+        }
 
-      total_needed = m_edge_ranges.back().back().m_end;
-      m_point_data.reserve(total_needed);
-      for(iter = temp.begin(), end_iter = temp.end(); iter != end_iter; ++iter)
+      if(all_edges_reused)
         {
-          std::copy(iter->begin(), iter->end(),
-                    std::back_insert_iterator<std::vector<fastuidraw::TessellatedPath::point> >(m_point_data));
+          m_reused_contours[o] = reuse_contour;
         }
-      assert(total_needed == m_point_data.size());
     }
-  else
+}
+
+int
+TessellatedPathPrivate::
+find_reuse_contour(const TessellatedPathPrivate *reuse, unsigned int o,
+                   const fastuidraw::PathContour *contour)
+{
+  /* the common case is that contours are only added
+     or changed, in which case a contour has the same
+     index as in the tessellation being reused.
+   */
+  if(o < reuse->m_contour_sources.size() && reuse->m_contour_sources[o].get() == contour)
+    {
+      return o;
+    }
+
+  if(m_reuse_contour_map.empty())
     {
-      m_box_min = m_box_max = fastuidraw::vec2(0.0f, 0.0f);
+      for(unsigned int c = 0, endc = reuse->m_contour_sources.size(); c < endc; ++c)
+        {
+          m_reuse_contour_map[reuse->m_contour_sources[c].get()] = c;
+        }
     }
+
+  std::map<const fastuidraw::PathContour*, unsigned int>::const_iterator iter;
+  iter = m_reuse_contour_map.find(contour);
+  return (iter != m_reuse_contour_map.end()) ?
+    static_cast<int>(iter->second) :
+    -1;
 }
 
 //////////////////////////////////////
 // fastuidraw::TessellatedPath methods
 fastuidraw::TessellatedPath::
 TessellatedPath(const Path &input,
-                fastuidraw::TessellatedPath::TessellationParams TP)
+                fastuidraw::TessellatedPath::TessellationParams TP,
+                const reference_counted_ptr<const TessellatedPath> &reuse)
 {
-  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP);
+  const TessellatedPathPrivate *reuse_d;
+
+  reuse_d = (reuse) ?
+    reinterpret_cast<const TessellatedPathPrivate*>(reuse->m_d) :
+    NULL;
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, reuse_d);
 }
 
 fastuidraw::TessellatedPath::
@@ -165,12 +247,29 @@ fastuidraw::TessellatedPath::
 const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>&
 fastuidraw::TessellatedPath::
 stroked(void) const
+{
+  return stroked(1);
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>&
+fastuidraw::TessellatedPath::
+stroked(unsigned int max_threads) const
 {
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
   if(!d->m_stroked)
     {
-      d->m_stroked = FASTUIDRAWnew StrokedPath(*this);
+      if(d->m_reuse_stroked)
+        {
+          d->m_stroked = FASTUIDRAWnew StrokedPath(*this, d->m_reuse_stroked,
+                                                   fastuidraw::make_c_array(d->m_reused_contours),
+                                                   max_threads);
+          d->m_reuse_stroked = reference_counted_ptr<const StrokedPath>();
+        }
+      else
+        {
+          d->m_stroked = FASTUIDRAWnew StrokedPath(*this, max_threads);
+        }
     }
   return d->m_stroked;
 }
@@ -12,7 +12,9 @@ LIBRARY_SOURCES += $(call filelist, glyph_atlas.cpp \
 	glyph_render_data_curve_pair.cpp \
 	glyph_render_data_distance_field.cpp \
 	glyph_render_data_coverage.cpp \
-	glyph_cache.cpp glyph_selector.cpp \
+	glyph_cache.cpp glyph_disk_cache.cpp baked_glyph_atlas.cpp glyph_selector.cpp \
+	glyph_usage_profile.cpp \
+	text_layout.cpp \
 	freetype_font.cpp freetype_lib.cpp \
 	font_properties.cpp)
 
@@ -0,0 +1,880 @@
+/*!
+ * \file baked_glyph_atlas.cpp
+ * \brief file baked_glyph_atlas.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#include <fastuidraw/text/baked_glyph_atlas.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+#include "../private/util_private.hpp"
+#include "private/glyph_serialize.hpp"
+
+/* File format, all values are in the byte order of the machine:
+    - FileHeader
+    - FileHeader::m_number_glyphs glyphs in the order they
+      were baked, each glyph is:
+       - the font key, glyph code, glyph type and pixel size
+       - the number of regions of the glyph followed by the
+         regions, each region is the size and padding passed
+         to GlyphAtlas::allocate() and the location and layer
+         GlyphAtlas::allocate() gave
+       - the geometry offset and length
+       - the number of bytes of the GlyphLayoutData and Path
+         followed by the bytes as written by detail::write_layout()
+         and detail::write_path()
+    - the texels of the FileHeader::m_number_layers layers
+    - the values of the FileHeader::m_number_geometry_blocks
+      blocks of the geometry store.
+ */
+
+namespace
+{
+  enum
+    {
+      file_version = 2,
+      initial_geometry_store_size = 1024
+    };
+
+  const char file_magic[8] = { 'F', 'U', 'I', 'B', 'A', 'K', 'E', 'D' };
+  const uint32_t file_byte_order_mark = 0x01020304u;
+
+  class FileHeader
+  {
+  public:
+    char m_magic[8];
+    uint32_t m_byte_order_mark;
+    uint32_t m_version;
+    int32_t m_texel_width, m_texel_height;
+    uint32_t m_number_layers;
+    uint32_t m_geometry_alignment;
+    uint32_t m_packer;
+    uint32_t m_number_geometry_blocks;
+    uint32_t m_number_glyphs;
+  };
+
+  /* A region of a glyph in the atlas: the size and padding passed
+     to GlyphAtlas::allocate() and the location and layer of the
+     GlyphLocation returned.
+   */
+  class BakedRegion
+  {
+  public:
+    fastuidraw::ivec2 m_size;
+    fastuidraw::GlyphAtlas::Padding m_padding;
+    fastuidraw::ivec2 m_location;
+    int m_layer;
+  };
+
+  class BakedGlyph
+  {
+  public:
+    BakedGlyph(void):
+      m_font_key(0),
+      m_glyph_code(0),
+      m_geometry_offset(-1),
+      m_geometry_length(0)
+    {}
+
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    fastuidraw::GlyphRender m_render;
+    std::vector<BakedRegion> m_regions;
+    int m_geometry_offset, m_geometry_length;
+
+    /* GlyphLayoutData and Path as written by detail::write_layout()
+       and detail::write_path()
+     */
+    std::vector<uint8_t> m_layout_and_path;
+  };
+
+  class BakedGlyphKey
+  {
+  public:
+    BakedGlyphKey(uint64_t font_key, uint32_t glyph_code,
+                  fastuidraw::GlyphRender render):
+      m_font_key(font_key),
+      m_glyph_code(glyph_code),
+      m_render(render)
+    {}
+
+    bool
+    operator<(const BakedGlyphKey &rhs) const
+    {
+      if(m_font_key != rhs.m_font_key)
+        {
+          return m_font_key < rhs.m_font_key;
+        }
+      if(m_glyph_code != rhs.m_glyph_code)
+        {
+          return m_glyph_code < rhs.m_glyph_code;
+        }
+      return m_render < rhs.m_render;
+    }
+
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    fastuidraw::GlyphRender m_render;
+  };
+
+  /* texel store backed by CPU memory that also records the
+     regions passed to set_data(), so that the padding of
+     the regions allocated by GlyphAtlas::allocate() is known.
+   */
+  class BakeTexelStore:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    class SetDataCall
+    {
+    public:
+      fastuidraw::ivec2 m_xy, m_wh;
+      int m_layer;
+    };
+
+    explicit
+    BakeTexelStore(fastuidraw::ivec2 dims):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(dims.x(), dims.y(), 1, true),
+      m_texels(dims.x() * dims.y(), 0)
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<uint8_t> data)
+    {
+      int width(dimensions().x()), height(dimensions().y());
+      SetDataCall call;
+
+      assert(data.size() == static_cast<unsigned int>(w * h));
+      for(int r = 0; r < h; ++r)
+        {
+          std::copy(data.c_ptr() + r * w, data.c_ptr() + (r + 1) * w,
+                    m_texels.begin() + (l * height + y + r) * width + x);
+        }
+
+      call.m_xy = fastuidraw::ivec2(x, y);
+      call.m_wh = fastuidraw::ivec2(w, h);
+      call.m_layer = l;
+      m_calls.push_back(call);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    fastuidraw::c_array<uint8_t>
+    layer(int l)
+    {
+      unsigned int sz(dimensions().x() * dimensions().y());
+      return fastuidraw::c_array<uint8_t>(&m_texels[l * sz], sz);
+    }
+
+    std::vector<uint8_t> m_texels;
+    std::vector<SetDataCall> m_calls;
+
+  protected:
+
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_texels.resize(new_num_layers * dimensions().x() * dimensions().y(), 0);
+    }
+  };
+
+  class BakeGeometryStore:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    explicit
+    BakeGeometryStore(unsigned int alignment):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(alignment, initial_geometry_store_size, true),
+      m_values(alignment * initial_geometry_store_size)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int location, fastuidraw::const_c_array<fastuidraw::generic_data> pdata)
+    {
+      std::copy(pdata.begin(), pdata.end(), m_values.begin() + location * alignment());
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    std::vector<fastuidraw::generic_data> m_values;
+
+  protected:
+
+    virtual
+    void
+    resize_implement(unsigned int new_size)
+    {
+      m_values.resize(new_size * alignment());
+    }
+  };
+
+  class BakedGlyphAtlasPrivate
+  {
+  public:
+    BakedGlyphAtlasPrivate(fastuidraw::ivec2 texel_dimensions,
+                           unsigned int geometry_alignment,
+                           enum fastuidraw::GlyphAtlas::packer_t packer);
+
+    /* allocate the regions and geometry data of the glyphs
+       from an atlas in the order they were baked, checking
+       that the locations are those that were baked. On
+       failure, releases what was allocated.
+     */
+    enum fastuidraw::return_code
+    replay_allocations(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> &atlas,
+                       std::vector<fastuidraw::vecN<fastuidraw::GlyphLocation, 2> > &locations) const;
+
+    static
+    void
+    release_allocations(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> &atlas,
+                        const BakedGlyph &glyph,
+                        const fastuidraw::vecN<fastuidraw::GlyphLocation, 2> &locations);
+
+    void
+    write_file(std::vector<uint8_t> &bytes) const;
+
+    bool
+    read_file(const FileHeader &header, fastuidraw::detail::Reader &src);
+
+    bool
+    read_glyph(fastuidraw::detail::Reader &src, BakedGlyph &glyph);
+
+    fastuidraw::ivec2 m_texel_dimensions;
+    unsigned int m_geometry_alignment;
+    enum fastuidraw::GlyphAtlas::packer_t m_packer;
+    fastuidraw::reference_counted_ptr<BakeTexelStore> m_texel_store;
+    fastuidraw::reference_counted_ptr<BakeGeometryStore> m_geometry_store;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_atlas;
+    std::vector<BakedGlyph> m_glyphs;
+    std::set<BakedGlyphKey> m_keys;
+    unsigned int m_number_geometry_blocks;
+  };
+}
+
+////////////////////////////////////////
+// BakedGlyphAtlasPrivate methods
+BakedGlyphAtlasPrivate::
+BakedGlyphAtlasPrivate(fastuidraw::ivec2 texel_dimensions,
+                       unsigned int geometry_alignment,
+                       enum fastuidraw::GlyphAtlas::packer_t packer):
+  m_texel_dimensions(texel_dimensions),
+  m_geometry_alignment(geometry_alignment),
+  m_packer(packer),
+  m_number_geometry_blocks(0)
+{
+  assert(texel_dimensions.x() > 0 && texel_dimensions.y() > 0);
+  assert(geometry_alignment > 0);
+  m_texel_store = FASTUIDRAWnew BakeTexelStore(texel_dimensions);
+  m_geometry_store = FASTUIDRAWnew BakeGeometryStore(geometry_alignment);
+  m_atlas = FASTUIDRAWnew fastuidraw::GlyphAtlas(m_texel_store, m_geometry_store, m_packer);
+}
+
+void
+BakedGlyphAtlasPrivate::
+release_allocations(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> &atlas,
+                    const BakedGlyph &glyph,
+                    const fastuidraw::vecN<fastuidraw::GlyphLocation, 2> &locations)
+{
+  for(unsigned int i = 0; i < 2; ++i)
+    {
+      if(locations[i].valid())
+        {
+          atlas->deallocate(locations[i]);
+        }
+    }
+
+  if(glyph.m_geometry_offset != -1)
+    {
+      atlas->deallocate_geometry_data(glyph.m_geometry_offset, glyph.m_geometry_length);
+    }
+}
+
+enum fastuidraw::return_code
+BakedGlyphAtlasPrivate::
+replay_allocations(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> &atlas,
+                   std::vector<fastuidraw::vecN<fastuidraw::GlyphLocation, 2> > &locations) const
+{
+  locations.clear();
+  locations.reserve(m_glyphs.size());
+  for(unsigned int g = 0, endg = m_glyphs.size(); g < endg; ++g)
+    {
+      const BakedGlyph &glyph(m_glyphs[g]);
+      bool success(true);
+
+      locations.push_back(fastuidraw::vecN<fastuidraw::GlyphLocation, 2>());
+      for(unsigned int i = 0, endi = glyph.m_regions.size(); i < endi && success; ++i)
+        {
+          const BakedRegion &R(glyph.m_regions[i]);
+          fastuidraw::GlyphLocation L;
+
+          L = atlas->allocate(R.m_size, R.m_padding);
+          locations.back()[i] = L;
+          success = L.valid()
+            && L.location() == R.m_location
+            && L.layer() == R.m_layer;
+        }
+
+      if(success && glyph.m_geometry_offset != -1)
+        {
+          int offset;
+
+          offset = atlas->allocate_geometry_blocks(glyph.m_geometry_length);
+          if(offset != glyph.m_geometry_offset)
+            {
+              if(offset != -1)
+                {
+                  atlas->deallocate_geometry_data(offset, glyph.m_geometry_length);
+                }
+              success = false;
+            }
+        }
+
+      if(!success)
+        {
+          /* release the regions of the failed glyph, then
+             everything allocated for the previous glyphs
+           */
+          for(unsigned int i = 0; i < 2; ++i)
+            {
+              if(locations.back()[i].valid())
+                {
+                  atlas->deallocate(locations.back()[i]);
+                }
+            }
+          locations.pop_back();
+          for(unsigned int p = 0; p < g; ++p)
+            {
+              release_allocations(atlas, m_glyphs[p], locations[p]);
+            }
+          locations.clear();
+          return fastuidraw::routine_fail;
+        }
+    }
+  return fastuidraw::routine_success;
+}
+
+void
+BakedGlyphAtlasPrivate::
+write_file(std::vector<uint8_t> &bytes) const
+{
+  fastuidraw::detail::Writer dst(bytes);
+  FileHeader header;
+  unsigned int num_layers(m_texel_store->dimensions().z());
+
+  std::memcpy(header.m_magic, file_magic, sizeof(file_magic));
+  header.m_byte_order_mark = file_byte_order_mark;
+  header.m_version = file_version;
+  header.m_texel_width = m_texel_dimensions.x();
+  header.m_texel_height = m_texel_dimensions.y();
+  header.m_number_layers = num_layers;
+  header.m_geometry_alignment = m_geometry_alignment;
+  header.m_packer = m_packer;
+  header.m_number_geometry_blocks = m_number_geometry_blocks;
+  header.m_number_glyphs = m_glyphs.size();
+  dst.write(header);
+
+  for(unsigned int g = 0, endg = m_glyphs.size(); g < endg; ++g)
+    {
+      const BakedGlyph &glyph(m_glyphs[g]);
+
+      dst.write<uint64_t>(glyph.m_font_key);
+      dst.write<uint32_t>(glyph.m_glyph_code);
+      dst.write<uint32_t>(glyph.m_render.m_type);
+      dst.write<int32_t>(glyph.m_render.m_pixel_size);
+
+      dst.write<uint32_t>(glyph.m_regions.size());
+      for(unsigned int i = 0, endi = glyph.m_regions.size(); i < endi; ++i)
+        {
+          const BakedRegion &R(glyph.m_regions[i]);
+
+          dst.write(R.m_size);
+          dst.write<uint32_t>(R.m_padding.m_left);
+          dst.write<uint32_t>(R.m_padding.m_right);
+          dst.write<uint32_t>(R.m_padding.m_top);
+          dst.write<uint32_t>(R.m_padding.m_bottom);
+          dst.write(R.m_location);
+          dst.write<int32_t>(R.m_layer);
+        }
+      dst.write<int32_t>(glyph.m_geometry_offset);
+      dst.write<int32_t>(glyph.m_geometry_length);
+
+      dst.write<uint32_t>(glyph.m_layout_and_path.size());
+      if(!glyph.m_layout_and_path.empty())
+        {
+          dst.write_bytes(&glyph.m_layout_and_path[0], glyph.m_layout_and_path.size());
+        }
+    }
+
+  dst.write_bytes(&m_texel_store->m_texels[0], m_texel_store->m_texels.size());
+  if(m_number_geometry_blocks > 0)
+    {
+      dst.write_bytes(&m_geometry_store->m_values[0],
+                      sizeof(fastuidraw::generic_data) * m_number_geometry_blocks * m_geometry_alignment);
+    }
+}
+
+bool
+BakedGlyphAtlasPrivate::
+read_glyph(fastuidraw::detail::Reader &src, BakedGlyph &glyph)
+{
+  uint32_t type, num_regions, num_bytes;
+  const uint8_t *bytes;
+
+  glyph.m_font_key = src.read<uint64_t>();
+  glyph.m_glyph_code = src.read<uint32_t>();
+  type = src.read<uint32_t>();
+  glyph.m_render.m_pixel_size = src.read<int32_t>();
+  if(type != fastuidraw::coverage_glyph
+     && type != fastuidraw::distance_field_glyph
+     && type != fastuidraw::curve_pair_glyph)
+    {
+      return false;
+    }
+  glyph.m_render.m_type = static_cast<enum fastuidraw::glyph_type>(type);
+
+  num_regions = src.read<uint32_t>();
+  if(num_regions < 1 || num_regions > 2)
+    {
+      return false;
+    }
+
+  glyph.m_regions.resize(num_regions);
+  for(uint32_t i = 0; i < num_regions; ++i)
+    {
+      BakedRegion &R(glyph.m_regions[i]);
+
+      R.m_size = src.read_ivec2();
+      R.m_padding.m_left = src.read<uint32_t>();
+      R.m_padding.m_right = src.read<uint32_t>();
+      R.m_padding.m_top = src.read<uint32_t>();
+      R.m_padding.m_bottom = src.read<uint32_t>();
+      R.m_location = src.read_ivec2();
+      R.m_layer = src.read<int32_t>();
+    }
+  glyph.m_geometry_offset = src.read<int32_t>();
+  glyph.m_geometry_length = src.read<int32_t>();
+
+  num_bytes = src.read<uint32_t>();
+  bytes = src.read_bytes(num_bytes);
+  if(!src.ok())
+    {
+      return false;
+    }
+  glyph.m_layout_and_path.assign(bytes, bytes + num_bytes);
+
+  return (glyph.m_geometry_offset == -1 && glyph.m_geometry_length == 0)
+    || (glyph.m_geometry_offset >= 0 && glyph.m_geometry_length > 0
+        && static_cast<unsigned int>(glyph.m_geometry_offset + glyph.m_geometry_length) <= m_number_geometry_blocks);
+}
+
+bool
+BakedGlyphAtlasPrivate::
+read_file(const FileHeader &header, fastuidraw::detail::Reader &src)
+{
+  uint32_t num_glyphs(header.m_number_glyphs), num_layers(header.m_number_layers);
+  std::vector<fastuidraw::vecN<fastuidraw::GlyphLocation, 2> > locations;
+  uint64_t num_texels, num_values;
+  const uint8_t *bytes;
+
+  m_number_geometry_blocks = header.m_number_geometry_blocks;
+  if(num_layers == 0 || !src.can_read(num_glyphs, 1))
+    {
+      return false;
+    }
+
+  m_glyphs.resize(num_glyphs);
+  for(uint32_t g = 0; g < num_glyphs; ++g)
+    {
+      BakedGlyph &glyph(m_glyphs[g]);
+
+      if(!read_glyph(src, glyph))
+        {
+          return false;
+        }
+      m_keys.insert(BakedGlyphKey(glyph.m_font_key, glyph.m_glyph_code, glyph.m_render));
+    }
+
+  /* allocate the regions of the glyphs on m_atlas so that
+     glyphs can still be added; the replay also verifies that
+     the locations of the file are those the atlas gives.
+   */
+  if(replay_allocations(m_atlas, locations) != fastuidraw::routine_success
+     || m_texel_store->dimensions().z() > static_cast<int>(num_layers))
+    {
+      return false;
+    }
+
+  if(m_texel_store->dimensions().z() < static_cast<int>(num_layers))
+    {
+      m_texel_store->resize(num_layers);
+    }
+
+  num_texels = static_cast<uint64_t>(num_layers) * m_texel_dimensions.x() * m_texel_dimensions.y();
+  bytes = src.can_read(num_texels, 1) ?
+    src.read_bytes(num_texels) :
+    NULL;
+  if(bytes == NULL)
+    {
+      return false;
+    }
+  std::copy(bytes, bytes + num_texels, m_texel_store->m_texels.begin());
+
+  if(m_geometry_store->size() < m_number_geometry_blocks)
+    {
+      m_geometry_store->resize(m_number_geometry_blocks);
+    }
+  num_values = static_cast<uint64_t>(m_number_geometry_blocks) * m_geometry_alignment;
+  bytes = src.can_read(num_values, sizeof(fastuidraw::generic_data)) ?
+    src.read_bytes(num_values * sizeof(fastuidraw::generic_data)) :
+    NULL;
+  if(bytes == NULL)
+    {
+      return false;
+    }
+  if(num_values > 0)
+    {
+      std::memcpy(&m_geometry_store->m_values[0], bytes, num_values * sizeof(fastuidraw::generic_data));
+    }
+
+  return src.at_end();
+}
+
+////////////////////////////////////////
+// fastuidraw::BakedGlyphAtlas methods
+fastuidraw::BakedGlyphAtlas::
+BakedGlyphAtlas(ivec2 texel_dimensions, unsigned int geometry_alignment,
+                enum GlyphAtlas::packer_t packer)
+{
+  m_d = FASTUIDRAWnew BakedGlyphAtlasPrivate(texel_dimensions, geometry_alignment, packer);
+}
+
+fastuidraw::BakedGlyphAtlas::
+~BakedGlyphAtlas()
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::BakedGlyphAtlas>
+fastuidraw::BakedGlyphAtlas::
+load(const char *filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<uint8_t> bytes;
+  reference_counted_ptr<BakedGlyphAtlas> return_value;
+  BakedGlyphAtlasPrivate *d;
+  FileHeader header;
+
+  if(!file)
+    {
+      return return_value;
+    }
+
+  bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  detail::Reader src(make_c_array(bytes));
+  header = src.read<FileHeader>();
+  if(!src.ok())
+    {
+      return return_value;
+    }
+
+  if(std::memcmp(header.m_magic, file_magic, sizeof(file_magic)) != 0
+     || header.m_byte_order_mark != file_byte_order_mark
+     || header.m_version != file_version
+     || header.m_texel_width <= 0 || header.m_texel_height <= 0
+     || header.m_geometry_alignment == 0
+     || header.m_packer >= GlyphAtlas::number_packers)
+    {
+      return return_value;
+    }
+
+  return_value = FASTUIDRAWnew BakedGlyphAtlas(ivec2(header.m_texel_width, header.m_texel_height),
+                                               header.m_geometry_alignment,
+                                               static_cast<enum GlyphAtlas::packer_t>(header.m_packer));
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(return_value->m_d);
+  if(!d->read_file(header, src))
+    {
+      return_value = NULL;
+    }
+  return return_value;
+}
+
+fastuidraw::ivec2
+fastuidraw::BakedGlyphAtlas::
+texel_dimensions(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_texel_dimensions;
+}
+
+unsigned int
+fastuidraw::BakedGlyphAtlas::
+number_layers(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_texel_store->dimensions().z();
+}
+
+unsigned int
+fastuidraw::BakedGlyphAtlas::
+geometry_alignment(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_geometry_alignment;
+}
+
+enum fastuidraw::GlyphAtlas::packer_t
+fastuidraw::BakedGlyphAtlas::
+packer(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_packer;
+}
+
+unsigned int
+fastuidraw::BakedGlyphAtlas::
+number_geometry_blocks(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_number_geometry_blocks;
+}
+
+unsigned int
+fastuidraw::BakedGlyphAtlas::
+number_glyphs(void) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+  return d->m_glyphs.size();
+}
+
+enum fastuidraw::return_code
+fastuidraw::BakedGlyphAtlas::
+add_glyph(GlyphRender render,
+          const reference_counted_ptr<const FontBase> &font,
+          uint32_t glyph_code)
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+
+  uint64_t font_key;
+  font_key = (font && font->can_create_rendering_data(render.m_type)) ?
+    font->persistent_key() :
+    0;
+  if(font_key == 0)
+    {
+      return routine_fail;
+    }
+
+  BakedGlyphKey key(font_key, glyph_code, render);
+  if(d->m_keys.find(key) != d->m_keys.end())
+    {
+      return routine_success;
+    }
+
+  BakedGlyph glyph;
+  GlyphLayoutData layout;
+  Path path;
+  GlyphRenderData *data;
+  vecN<GlyphLocation, 2> locations;
+  enum return_code R;
+
+  data = font->compute_rendering_data(render, glyph_code, layout, path);
+  if(data == NULL)
+    {
+      return routine_fail;
+    }
+
+  detail::Writer dst(glyph.m_layout_and_path);
+  detail::write_layout(dst, layout);
+  if(!detail::write_path(dst, path))
+    {
+      FASTUIDRAWdelete(data);
+      return routine_fail;
+    }
+
+  d->m_texel_store->m_calls.clear();
+  R = data->upload_to_atlas(d->m_atlas, locations[0], locations[1],
+                            glyph.m_geometry_offset, glyph.m_geometry_length);
+  FASTUIDRAWdelete(data);
+
+  if(R != routine_success)
+    {
+      /* the atlas stores are resizeable, so an upload only
+         fails if the glyph is larger than a layer, in which
+         case nothing is left allocated.
+       */
+      return routine_fail;
+    }
+
+  /* each region allocated by GlyphRenderData::upload_to_atlas()
+     comes with a call to set_data() in the same order; the
+     padding is the difference between the region set and
+     the GlyphLocation.
+   */
+  assert(d->m_texel_store->m_calls.size() == (locations[1].valid() ? 2u : 1u));
+  glyph.m_regions.resize(d->m_texel_store->m_calls.size());
+  for(unsigned int i = 0, endi = glyph.m_regions.size(); i < endi; ++i)
+    {
+      const BakeTexelStore::SetDataCall &call(d->m_texel_store->m_calls[i]);
+      BakedRegion &region(glyph.m_regions[i]);
+      ivec2 loc(locations[i].location()), sz(locations[i].size());
+
+      region.m_size = call.m_wh;
+      region.m_padding.m_left = call.m_xy.x() - loc.x();
+      region.m_padding.m_top = call.m_xy.y() - loc.y();
+      region.m_padding.m_right = call.m_wh.x() - sz.x() - region.m_padding.m_left;
+      region.m_padding.m_bottom = call.m_wh.y() - sz.y() - region.m_padding.m_top;
+      region.m_location = loc;
+      region.m_layer = locations[i].layer();
+      assert(region.m_layer == call.m_layer);
+    }
+
+  if(glyph.m_geometry_offset != -1)
+    {
+      d->m_number_geometry_blocks = std::max(d->m_number_geometry_blocks,
+                                             static_cast<unsigned int>(glyph.m_geometry_offset + glyph.m_geometry_length));
+    }
+
+  glyph.m_font_key = font_key;
+  glyph.m_glyph_code = glyph_code;
+  glyph.m_render = render;
+  d->m_glyphs.push_back(glyph);
+  d->m_keys.insert(key);
+
+  return routine_success;
+}
+
+enum fastuidraw::return_code
+fastuidraw::BakedGlyphAtlas::
+save(const char *filename) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+
+  std::vector<uint8_t> bytes;
+  std::ofstream file(filename, std::ios::binary);
+
+  if(!file)
+    {
+      return routine_fail;
+    }
+
+  d->write_file(bytes);
+  file.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+  return file ?
+    routine_success :
+    routine_fail;
+}
+
+enum fastuidraw::return_code
+fastuidraw::BakedGlyphAtlas::
+load_into(const reference_counted_ptr<GlyphCache> &cache,
+          const_c_array<reference_counted_ptr<const FontBase> > fonts) const
+{
+  BakedGlyphAtlasPrivate *d;
+  d = reinterpret_cast<BakedGlyphAtlasPrivate*>(m_d);
+
+  reference_counted_ptr<GlyphAtlas> atlas(cache->atlas());
+  std::vector<vecN<GlyphLocation, 2> > locations;
+  std::map<uint64_t, reference_counted_ptr<const FontBase> > fonts_by_key;
+  ivec3 dims(atlas->texel_store()->dimensions());
+
+  if(dims.x() != d->m_texel_dimensions.x()
+     || dims.y() != d->m_texel_dimensions.y()
+     || atlas->geometry_store()->alignment() != d->m_geometry_alignment
+     || atlas->packer() != d->m_packer)
+    {
+      return routine_fail;
+    }
+
+  if(d->replay_allocations(atlas, locations) != routine_success)
+    {
+      return routine_fail;
+    }
+
+  /* the regions and geometry blocks are now allocated exactly
+     where they were when baked, so the stores are set in bulk
+     with the baked texels and geometry data.
+   */
+  for(int l = 0, endl = d->m_texel_store->dimensions().z(); l < endl; ++l)
+    {
+      atlas->set_texel_data(ivec2(0, 0), l, d->m_texel_dimensions, d->m_texel_store->layer(l));
+    }
+
+  if(d->m_number_geometry_blocks > 0)
+    {
+      const_c_array<generic_data> values(make_c_array(d->m_geometry_store->m_values));
+      atlas->set_geometry_data(0, values.sub_array(0, d->m_number_geometry_blocks * d->m_geometry_alignment));
+    }
+
+  for(unsigned int i = 0; i < fonts.size(); ++i)
+    {
+      if(fonts[i] && fonts[i]->persistent_key() != 0)
+        {
+          fonts_by_key[fonts[i]->persistent_key()] = fonts[i];
+        }
+    }
+
+  for(unsigned int g = 0, endg = d->m_glyphs.size(); g < endg; ++g)
+    {
+      const BakedGlyph &glyph(d->m_glyphs[g]);
+      std::map<uint64_t, reference_counted_ptr<const FontBase> >::const_iterator iter;
+
+      iter = fonts_by_key.find(glyph.m_font_key);
+      if(iter == fonts_by_key.end())
+        {
+          BakedGlyphAtlasPrivate::release_allocations(atlas, glyph, locations[g]);
+          continue;
+        }
+
+      detail::Reader src(make_c_array(glyph.m_layout_and_path));
+      GlyphLayoutData layout;
+      Path path;
+
+      detail::read_layout(src, layout);
+      detail::read_path(src, path);
+      layout.m_glyph_code = glyph.m_glyph_code;
+      layout.m_font = iter->second;
+      cache->add_uploaded_glyph(glyph.m_render, layout, path,
+                                locations[g][0], locations[g][1],
+                                glyph.m_geometry_offset, glyph.m_geometry_length);
+    }
+
+  return routine_success;
+}
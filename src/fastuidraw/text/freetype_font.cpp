@@ -18,6 +18,7 @@
 
 
 
+#include <fstream>
 #include <boost/thread.hpp>
 
 #include <fastuidraw/text/freetype_font.hpp>
@@ -33,6 +34,7 @@
 
 #include <ft2build.h>
 #include FT_OUTLINE_H
+#include FT_TRUETYPE_TABLES_H
 
 namespace
 {
@@ -58,20 +60,85 @@ namespace
     return v;
   }
 
+  /* an entry of the kerning cache of a FontFreeTypePrivate,
+     a pair is stored as (left << 32u) | right.
+   */
+  class kerning_entry
+  {
+  public:
+    kerning_entry(void):
+      m_key(0),
+      m_valid(false),
+      m_value(0.0f, 0.0f)
+    {}
+
+    uint64_t m_key;
+    bool m_valid;
+    fastuidraw::vec2 m_value;
+  };
+
+  /* number of entries of the kerning cache, must
+     be a power of 2.
+   */
+  const unsigned int kerning_cache_size_log2 = 10;
+  const unsigned int kerning_cache_size = 1u << kerning_cache_size_log2;
+
+  unsigned int
+  kerning_cache_slot(uint64_t key)
+  {
+    /* Fibonacci hashing: the high bits of the product
+       depend on all bits of the pair.
+     */
+    key *= 0x9E3779B97F4A7C15ull;
+    return static_cast<unsigned int>(key >> (64u - kerning_cache_size_log2));
+  }
+
   class RenderParamsPrivate
   {
   public:
     RenderParamsPrivate(void):
       m_distance_field_pixel_size(48),
       m_distance_field_max_distance(96.0f),
+      m_distance_field_max_threads(1),
       m_curve_pair_pixel_size(32)
     {}
 
     unsigned int m_distance_field_pixel_size;
     float m_distance_field_max_distance;
+    unsigned int m_distance_field_max_threads;
     unsigned int m_curve_pair_pixel_size;
   };
 
+  /* FNV-1a hash used to compute the value of
+     FontFreeType::persistent_key().
+   */
+  class PersistentHash
+  {
+  public:
+    PersistentHash(void):
+      m_value(0xcbf29ce484222325ull)
+    {}
+
+    void
+    add(const uint8_t *bytes, size_t length)
+    {
+      for(size_t i = 0; i < length; ++i)
+        {
+          m_value ^= bytes[i];
+          m_value *= 0x100000001b3ull;
+        }
+    }
+
+    template<typename T>
+    void
+    add_value(T v)
+    {
+      add(reinterpret_cast<const uint8_t*>(&v), sizeof(T));
+    }
+
+    uint64_t m_value;
+  };
+
   class PathCreator
   {
   public:
@@ -133,10 +200,29 @@ namespace
     common_init(void);
 
     void
-    common_compute_rendering_data(int pixel_size, FT_Int32 load_flags,
+    common_compute_rendering_data(FT_Face face, int pixel_size, FT_Int32 load_flags,
                                   fastuidraw::GlyphLayoutData &layout,
                                   uint32_t glyph_code);
 
+    /* An FT_Face can only be used by one thread at a time.
+       Returns an FT_Face that no other thread is using,
+       creating a new FT_Face from m_filename (with m_lib
+       locked) if all the faces are in use. If the font is not from a file,
+       only m_face is available and this waits until it
+       is released.
+     */
+    FT_Face
+    acquire_face(void);
+
+    void
+    release_face(FT_Face face);
+
+    /* hash of the font file, the face index and
+       the parameters that affect the glyph data.
+     */
+    uint64_t
+    compute_persistent_key(void);
+
     void
     compute_rendering_data(int pixel_size, uint32_t glyph_code,
                            fastuidraw::GlyphLayoutData &layout,
@@ -156,10 +242,46 @@ namespace
                            fastuidraw::Path &path);
 
     boost::mutex m_mutex;
+    boost::condition_variable m_face_released;
     FT_Face m_face;
     fastuidraw::FontFreeType::RenderParams m_render_params;
     fastuidraw::reference_counted_ptr<fastuidraw::FreetypeLib> m_lib;
     fastuidraw::FontFreeType *m_p;
+
+    /* file and face index from which the font was
+       created, empty if not created from a file
+     */
+    std::string m_filename;
+    int m_face_index;
+
+    /* faces not in use by any thread, initially just m_face,
+       and the faces made in addition to m_face.
+     */
+    std::vector<FT_Face> m_free_faces;
+    std::vector<FT_Face> m_extra_faces;
+
+    /* values of m_face that do not change, read once
+       so that they are read without acquiring a face.
+     */
+    bool m_has_kerning;
+    FT_UShort m_units_per_EM;
+    FT_Short m_ascender, m_descender, m_height;
+
+    /* direct mapped cache of the kerning of recently asked
+       glyph pairs, of kerning_cache_size entries (empty if
+       the face has no kerning); a pair replaces the pair in
+       its slot. Looking up a cached pair only locks
+       m_kerning_mutex instead of acquiring a face.
+     */
+    boost::mutex m_kerning_mutex;
+    std::vector<kerning_entry> m_kerning;
+
+    /* value for FontFreeType::persistent_key(),
+       computed on first use.
+     */
+    boost::mutex m_persistent_key_mutex;
+    bool m_persistent_key_ready;
+    uint64_t m_persistent_key;
   };
 }
 
@@ -289,7 +411,10 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p, FT_Face pface,
                     const fastuidraw::FontFreeType::RenderParams &render_params):
   m_face(pface),
   m_render_params(render_params),
-  m_p(p)
+  m_p(p),
+  m_face_index(0),
+  m_persistent_key_ready(false),
+  m_persistent_key(0)
 {
   common_init();
 }
@@ -301,7 +426,10 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p, FT_Face pface,
   m_face(pface),
   m_render_params(render_params),
   m_lib(lib),
-  m_p(p)
+  m_p(p),
+  m_face_index(0),
+  m_persistent_key_ready(false),
+  m_persistent_key(0)
 {
   common_init();
 }
@@ -309,9 +437,21 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p, FT_Face pface,
 FontFreeTypePrivate::
 ~FontFreeTypePrivate()
 {
+  if(!m_extra_faces.empty())
+    {
+      m_lib->lock();
+      for(unsigned int i = 0, endi = m_extra_faces.size(); i < endi; ++i)
+        {
+          FT_Done_Face(m_extra_faces[i]);
+        }
+      m_lib->unlock();
+    }
+
   if(m_lib)
     {
+      m_lib->lock();
       FT_Done_Face(m_face);
+      m_lib->unlock();
     }
 }
 
@@ -322,27 +462,148 @@ common_init(void)
   assert(m_face != NULL);
   assert(m_face->face_flags & FT_FACE_FLAG_SCALABLE);
   FT_Set_Transform(m_face, NULL, NULL);
+  m_has_kerning = FT_HAS_KERNING(m_face);
+  m_units_per_EM = m_face->units_per_EM;
+  m_ascender = m_face->ascender;
+  m_descender = m_face->descender;
+  m_height = m_face->height;
+  if(m_has_kerning)
+    {
+      m_kerning.resize(kerning_cache_size);
+    }
+  m_free_faces.push_back(m_face);
+}
+
+FT_Face
+FontFreeTypePrivate::
+acquire_face(void)
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+
+  if(m_free_faces.empty() && !m_filename.empty())
+    {
+      FT_Face face(NULL);
+      int error_code;
+
+      lock.unlock();
+      m_lib->lock();
+      error_code = FT_New_Face(m_lib->lib(), m_filename.c_str(), m_face_index, &face);
+      m_lib->unlock();
+      lock.lock();
+
+      if(error_code == 0 && face != NULL)
+        {
+          FT_Set_Transform(face, NULL, NULL);
+          m_extra_faces.push_back(face);
+          return face;
+        }
+    }
+
+  while(m_free_faces.empty())
+    {
+      m_face_released.wait(lock);
+    }
+
+  FT_Face return_value;
+  return_value = m_free_faces.back();
+  m_free_faces.pop_back();
+  return return_value;
 }
 
 void
 FontFreeTypePrivate::
-common_compute_rendering_data(int pixel_size, FT_Int32 load_flags,
+release_face(FT_Face face)
+{
+  m_mutex.lock();
+  m_free_faces.push_back(face);
+  m_mutex.unlock();
+  m_face_released.notify_one();
+}
+
+uint64_t
+FontFreeTypePrivate::
+compute_persistent_key(void)
+{
+  PersistentHash hash;
+  int face_index;
+
+  if(!m_filename.empty())
+    {
+      std::ifstream file(m_filename.c_str(), std::ios::binary);
+      std::vector<char> buffer(64 * 1024);
+
+      if(!file)
+        {
+          return 0;
+        }
+
+      while(file)
+        {
+          file.read(&buffer[0], buffer.size());
+          hash.add(reinterpret_cast<const uint8_t*>(&buffer[0]), file.gcount());
+        }
+      face_index = m_face_index;
+    }
+  else
+    {
+      /* the font is not from a file, hash the font data
+         as FreeType has it; a tag value of 0 loads the
+         entire font file of an sfnt-based font.
+       */
+      FT_Face face;
+      FT_ULong length(0);
+      FT_Error error_code;
+      std::vector<FT_Byte> buffer;
+
+      face = acquire_face();
+      error_code = FT_Load_Sfnt_Table(face, 0, 0, NULL, &length);
+      if(error_code == 0 && length > 0)
+        {
+          buffer.resize(length);
+          error_code = FT_Load_Sfnt_Table(face, 0, 0, &buffer[0], &length);
+        }
+      face_index = face->face_index;
+      release_face(face);
+
+      if(error_code != 0 || buffer.empty())
+        {
+          return 0;
+        }
+      hash.add(&buffer[0], buffer.size());
+    }
+
+  hash.add_value<int32_t>(face_index);
+  hash.add_value<uint32_t>(m_render_params.distance_field_pixel_size());
+  hash.add_value<float>(m_render_params.distance_field_max_distance());
+  hash.add_value<uint32_t>(m_render_params.curve_pair_pixel_size());
+  hash.add_value<int32_t>(FREETYPE_MAJOR);
+  hash.add_value<int32_t>(FREETYPE_MINOR);
+  hash.add_value<int32_t>(FREETYPE_PATCH);
+
+  /* 0 is reserved to indicate that the glyph data is not to be stored
+   */
+  return (hash.m_value != 0) ? hash.m_value : 1;
+}
+
+void
+FontFreeTypePrivate::
+common_compute_rendering_data(FT_Face face, int pixel_size, FT_Int32 load_flags,
                               fastuidraw::GlyphLayoutData &output,
                               uint32_t glyph_code)
 {
   fastuidraw::ivec2 bitmap_sz, bitmap_offset, iadvance;
 
-  FT_Set_Pixel_Sizes(m_face, pixel_size, pixel_size);
-  FT_Load_Glyph(m_face, glyph_code, load_flags);
-
-  output.m_size.x() = to_pixel_sizes(m_face->glyph->metrics.width);
-  output.m_size.y() = to_pixel_sizes(m_face->glyph->metrics.height);
-  output.m_horizontal_layout_offset.x() = to_pixel_sizes(m_face->glyph->metrics.horiBearingX);
-  output.m_horizontal_layout_offset.y() = to_pixel_sizes(m_face->glyph->metrics.horiBearingY) - output.m_size.y();
-  output.m_vertical_layout_offset.x() = to_pixel_sizes(m_face->glyph->metrics.vertBearingX);
-  output.m_vertical_layout_offset.y() = to_pixel_sizes(m_face->glyph->metrics.vertBearingY) - output.m_size.y();
-  output.m_advance.x() = to_pixel_sizes(m_face->glyph->metrics.horiAdvance);
-  output.m_advance.y() = to_pixel_sizes(m_face->glyph->metrics.vertAdvance);
+  FT_Set_Pixel_Sizes(face, pixel_size, pixel_size);
+  FT_Load_Glyph(face, glyph_code, load_flags);
+
+  output.m_size.x() = to_pixel_sizes(face->glyph->metrics.width);
+  output.m_size.y() = to_pixel_sizes(face->glyph->metrics.height);
+  output.m_horizontal_layout_offset.x() = to_pixel_sizes(face->glyph->metrics.horiBearingX);
+  output.m_horizontal_layout_offset.y() = to_pixel_sizes(face->glyph->metrics.horiBearingY) - output.m_size.y();
+  output.m_vertical_layout_offset.x() = to_pixel_sizes(face->glyph->metrics.vertBearingX);
+  output.m_vertical_layout_offset.y() = to_pixel_sizes(face->glyph->metrics.vertBearingY) - output.m_size.y();
+  output.m_advance.x() = to_pixel_sizes(face->glyph->metrics.horiAdvance);
+  output.m_advance.y() = to_pixel_sizes(face->glyph->metrics.vertAdvance);
   output.m_glyph_code = glyph_code;
   output.m_pixel_size = pixel_size;
   output.m_font = m_p;
@@ -356,14 +617,15 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
                        fastuidraw::Path &path)
 {
   fastuidraw::ivec2 bitmap_sz;
-  fastuidraw::autolock_mutex m(m_mutex);
+  FT_Face face;
 
-  common_compute_rendering_data(pixel_size, FT_LOAD_DEFAULT, layout, glyph_code);
-  PathCreator::decompose_to_path(&m_face->glyph->outline, path);
-  FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
+  face = acquire_face();
+  common_compute_rendering_data(face, pixel_size, FT_LOAD_DEFAULT, layout, glyph_code);
+  PathCreator::decompose_to_path(&face->glyph->outline, path);
+  FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
 
-  bitmap_sz.x() = m_face->glyph->bitmap.width;
-  bitmap_sz.y() = m_face->glyph->bitmap.rows;
+  bitmap_sz.x() = face->glyph->bitmap.width;
+  bitmap_sz.y() = face->glyph->bitmap.rows;
 
   /* add one pixel slack on glyph
    */
@@ -371,7 +633,7 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
     {
       int pitch;
 
-      pitch = m_face->glyph->bitmap.pitch;
+      pitch = face->glyph->bitmap.pitch;
       output.resize(bitmap_sz + fastuidraw::ivec2(1, 1));
       std::fill(output.coverage_values().begin(), output.coverage_values().end(), 0);
       for(int y = 0; y < bitmap_sz.y(); ++y)
@@ -382,7 +644,7 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
 
               write_location = x + y * output.resolution().x();
               read_location = x + (bitmap_sz.y() - 1 - y) * pitch;
-              output.coverage_values()[write_location] = m_face->glyph->bitmap.buffer[read_location];
+              output.coverage_values()[write_location] = face->glyph->bitmap.buffer[read_location];
             }
         }
     }
@@ -390,6 +652,7 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
     {
       output.resize(fastuidraw::ivec2(0, 0));
     }
+  release_face(face);
 }
 
 void
@@ -402,24 +665,23 @@ compute_rendering_data(uint32_t glyph_code,
   int pixel_size(m_render_params.distance_field_pixel_size());
   float max_distance(m_render_params.distance_field_max_distance());
   fastuidraw::ivec2 bitmap_sz, bitmap_offset;
+  FT_Face face;
 
   std::vector<fastuidraw::detail::point_type> pts;
   std::ostream *stream_ptr(NULL);
   fastuidraw::detail::geometry_data dbg(stream_ptr, pts);
 
-  m_mutex.lock();
-
-    common_compute_rendering_data(pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
-    FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
-
-    bitmap_sz.x() = m_face->glyph->bitmap.width;
-    bitmap_sz.y() = m_face->glyph->bitmap.rows;
-    bitmap_offset.x() = m_face->glyph->bitmap_left;
-    bitmap_offset.y() = m_face->glyph->bitmap_top - m_face->glyph->bitmap.rows;
+  face = acquire_face();
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
 
-    fastuidraw::detail::OutlineData outline_data(m_face->glyph->outline, bitmap_sz, bitmap_offset, dbg);
+    bitmap_sz.x() = face->glyph->bitmap.width;
+    bitmap_sz.y() = face->glyph->bitmap.rows;
+    bitmap_offset.x() = face->glyph->bitmap_left;
+    bitmap_offset.y() = face->glyph->bitmap_top - face->glyph->bitmap.rows;
 
-  m_mutex.unlock();
+    fastuidraw::detail::OutlineData outline_data(face->glyph->outline, bitmap_sz, bitmap_offset, dbg);
+  release_face(face);
 
   outline_data.extract_path(path);
   if(bitmap_sz.x() != 0 && bitmap_sz.y() != 0)
@@ -430,7 +692,8 @@ compute_rendering_data(uint32_t glyph_code,
       std::fill(output.distance_values().begin(), output.distance_values().end(), 0);
       boost::multi_array<fastuidraw::detail::distance_return_type, 2> distance_values(boost::extents[bitmap_sz.x()][bitmap_sz.y()]);
 
-      outline_data.compute_distance_values(distance_values, max_distance, true);
+      outline_data.compute_distance_values(distance_values, max_distance, true,
+                                           m_render_params.distance_field_max_threads());
       for(int y = 0; y < bitmap_sz.y(); ++y)
         {
           for(int x = 0; x < bitmap_sz.x(); ++x)
@@ -464,16 +727,17 @@ compute_rendering_data(uint32_t glyph_code,
 {
   int pixel_size(m_render_params.curve_pair_pixel_size());
   fastuidraw::ivec2 bitmap_offset, bitmap_sz;
-
-  m_mutex.lock();
-    common_compute_rendering_data(pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
-    FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
-    bitmap_sz.x() = m_face->glyph->bitmap.width;
-    bitmap_sz.y() = m_face->glyph->bitmap.rows;
-    bitmap_offset.x() = m_face->glyph->bitmap_left;
-    bitmap_offset.y() = m_face->glyph->bitmap_top - m_face->glyph->bitmap.rows;
-    fastuidraw::detail::CurvePairGenerator gen(m_face->glyph->outline, bitmap_sz, bitmap_offset, output);
-  m_mutex.unlock();
+  FT_Face face;
+
+  face = acquire_face();
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+    bitmap_sz.x() = face->glyph->bitmap.width;
+    bitmap_sz.y() = face->glyph->bitmap.rows;
+    bitmap_offset.x() = face->glyph->bitmap_left;
+    bitmap_offset.y() = face->glyph->bitmap_top - face->glyph->bitmap.rows;
+    fastuidraw::detail::CurvePairGenerator gen(face->glyph->outline, bitmap_sz, bitmap_offset, output);
+  release_face(face);
 
   gen.extract_data(output);
   gen.extract_path(path);
@@ -553,6 +817,25 @@ distance_field_max_distance(void) const
   return d->m_distance_field_max_distance;
 }
 
+fastuidraw::FontFreeType::RenderParams&
+fastuidraw::FontFreeType::RenderParams::
+distance_field_max_threads(unsigned int v)
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  d->m_distance_field_max_threads = v;
+  return *this;
+}
+
+unsigned int
+fastuidraw::FontFreeType::RenderParams::
+distance_field_max_threads(void) const
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  return d->m_distance_field_max_threads;
+}
+
 fastuidraw::FontFreeType::RenderParams&
 fastuidraw::FontFreeType::RenderParams::
 curve_pair_pixel_size(unsigned int v)
@@ -622,8 +905,12 @@ glyph_code(uint32_t pcharacter_code) const
   FontFreeTypePrivate *d;
   d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
 
+  FT_Face face;
   FT_UInt glyphcode;
-  glyphcode = FT_Get_Char_Index(d->m_face, FT_ULong(pcharacter_code));
+
+  face = d->acquire_face();
+  glyphcode = FT_Get_Char_Index(face, FT_ULong(pcharacter_code));
+  d->release_face(face);
   return glyphcode;
 }
 
@@ -679,6 +966,97 @@ compute_rendering_data(GlyphRender render, uint32_t glyph_code,
     }
 }
 
+fastuidraw::vec2
+fastuidraw::FontFreeType::
+kerning(uint32_t left_glyph_code, uint32_t right_glyph_code) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  if(!d->m_has_kerning || d->m_units_per_EM == 0)
+    {
+      return vec2(0.0f, 0.0f);
+    }
+
+  uint64_t key;
+  unsigned int slot;
+
+  key = (uint64_t(left_glyph_code) << 32u) | uint64_t(right_glyph_code);
+  slot = kerning_cache_slot(key);
+
+  {
+    autolock_mutex m(d->m_kerning_mutex);
+    const kerning_entry &entry(d->m_kerning[slot]);
+
+    if(entry.m_valid && entry.m_key == key)
+      {
+        return entry.m_value;
+      }
+  }
+
+  FT_Face face;
+  FT_Vector k;
+  float recip;
+  vec2 return_value;
+
+  /* unscaled kerning does not depend on the size
+     of the face, but the face still is to be used
+     by one thread at a time.
+   */
+  face = d->acquire_face();
+  if(FT_Get_Kerning(face, left_glyph_code, right_glyph_code, FT_KERNING_UNSCALED, &k) != 0)
+    {
+      k.x = k.y = 0;
+    }
+  d->release_face(face);
+
+  recip = 1.0f / static_cast<float>(d->m_units_per_EM);
+  return_value = vec2(recip * static_cast<float>(k.x), recip * static_cast<float>(k.y));
+
+  autolock_mutex m(d->m_kerning_mutex);
+  kerning_entry &entry(d->m_kerning[slot]);
+
+  entry.m_key = key;
+  entry.m_valid = true;
+  entry.m_value = return_value;
+  return return_value;
+}
+
+enum fastuidraw::return_code
+fastuidraw::FontFreeType::
+line_metrics(float &ascender, float &descender, float &line_height) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  if(d->m_units_per_EM == 0)
+    {
+      return routine_fail;
+    }
+
+  float recip;
+  recip = 1.0f / static_cast<float>(d->m_units_per_EM);
+  ascender = recip * static_cast<float>(d->m_ascender);
+  descender = -recip * static_cast<float>(d->m_descender);
+  line_height = recip * static_cast<float>(d->m_height);
+  return routine_success;
+}
+
+uint64_t
+fastuidraw::FontFreeType::
+persistent_key(void) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  autolock_mutex m(d->m_persistent_key_mutex);
+  if(!d->m_persistent_key_ready)
+    {
+      d->m_persistent_key = d->compute_persistent_key();
+      d->m_persistent_key_ready = true;
+    }
+  return d->m_persistent_key;
+}
 
 const fastuidraw::FontFreeType::RenderParams&
 fastuidraw::FontFreeType::
@@ -713,7 +1091,9 @@ create(c_array<reference_counted_ptr<FontFreeType> > fonts, const char *filename
   int error_code;
   unsigned int num(0);
 
+  lib->lock();
   error_code = FT_New_Face(lib->lib(), filename, -1, &face);
+  lib->unlock();
   if(error_code == 0 && face != NULL && (face->face_flags & FT_FACE_FLAG_SCALABLE) == 0)
     {
       reference_counted_ptr<fastuidraw::FontFreeType> f;
@@ -727,7 +1107,9 @@ create(c_array<reference_counted_ptr<FontFreeType> > fonts, const char *filename
 
   if(face != NULL)
     {
+      lib->lock();
       FT_Done_Face(face);
+      lib->unlock();
     }
 
   return num;
@@ -745,12 +1127,16 @@ create(const char *filename, reference_counted_ptr<FreetypeLib> lib,
 
   int error_code;
   FT_Face face(NULL);
+  lib->lock();
   error_code = FT_New_Face(lib->lib(), filename, face_index, &face);
+  lib->unlock();
   if(error_code != 0 || face == NULL || (face->face_flags & FT_FACE_FLAG_SCALABLE) == 0)
     {
       if(face != NULL)
         {
+          lib->lock();
           FT_Done_Face(face);
+          lib->unlock();
         }
       return reference_counted_ptr<FontFreeType>();
     }
@@ -762,7 +1148,14 @@ create(const char *filename, reference_counted_ptr<FreetypeLib> lib,
   compute_font_propertes_from_face(face, p);
   p.source_label(str.str().c_str());
 
-  return FASTUIDRAWnew FontFreeType(face, lib, p, render_params);
+  reference_counted_ptr<FontFreeType> return_value;
+  FontFreeTypePrivate *d;
+
+  return_value = FASTUIDRAWnew FontFreeType(face, lib, p, render_params);
+  d = reinterpret_cast<FontFreeTypePrivate*>(return_value->m_d);
+  d->m_filename = filename;
+  d->m_face_index = face_index;
+  return return_value;
 }
 
 fastuidraw::reference_counted_ptr<fastuidraw::FontFreeType>
@@ -17,7 +17,9 @@
  */
 
 
+#include <boost/thread.hpp>
 #include <fastuidraw/text/freetype_lib.hpp>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
 
 fastuidraw::FreetypeLib::
 FreetypeLib(void)
@@ -29,6 +31,7 @@ FreetypeLib(void)
     {
       m_lib = NULL;
     }
+  m_mutex = FASTUIDRAWnew boost::mutex();
 }
 
 fastuidraw::FreetypeLib::
@@ -38,4 +41,26 @@ fastuidraw::FreetypeLib::
     {
       FT_Done_FreeType(m_lib);
     }
+
+  boost::mutex *m;
+  m = reinterpret_cast<boost::mutex*>(m_mutex);
+  FASTUIDRAWdelete(m);
+}
+
+void
+fastuidraw::FreetypeLib::
+lock(void)
+{
+  boost::mutex *m;
+  m = reinterpret_cast<boost::mutex*>(m_mutex);
+  m->lock();
+}
+
+void
+fastuidraw::FreetypeLib::
+unlock(void)
+{
+  boost::mutex *m;
+  m = reinterpret_cast<boost::mutex*>(m_mutex);
+  m->unlock();
 }
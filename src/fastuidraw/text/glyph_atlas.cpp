@@ -18,6 +18,7 @@
 
 
 #include <fastuidraw/text/glyph_atlas.hpp>
+#include <fastuidraw/util/math.hpp>
 
 #include "../private/interval_allocator.hpp"
 #include "../private/util_private.hpp"
@@ -30,9 +31,9 @@ namespace
     public fastuidraw::detail::RectAtlas
   {
   public:
-    explicit
-    rect_atlas_layer(const fastuidraw::ivec2 &dimensions, int player):
-      fastuidraw::detail::RectAtlas(dimensions),
+    rect_atlas_layer(const fastuidraw::ivec2 &dimensions, int player,
+                     enum fastuidraw::GlyphAtlas::packer_t packer):
+      fastuidraw::detail::RectAtlas(dimensions, create_packer(dimensions, packer)),
       m_layer(player)
     {}
 
@@ -43,6 +44,25 @@ namespace
     }
 
   private:
+    static
+    fastuidraw::detail::RectPacker*
+    create_packer(const fastuidraw::ivec2 &dimensions,
+                  enum fastuidraw::GlyphAtlas::packer_t packer)
+    {
+      switch(packer)
+        {
+        case fastuidraw::GlyphAtlas::skyline_packer:
+          return FASTUIDRAWnew fastuidraw::detail::SkylinePacker(dimensions);
+
+        case fastuidraw::GlyphAtlas::max_rects_packer:
+          return FASTUIDRAWnew fastuidraw::detail::MaxRectsPacker(dimensions);
+
+        default:
+          /* NULL indicates to RectAtlas to use its tree */
+          return NULL;
+        }
+    }
+
     int m_layer;
 
   };
@@ -84,7 +104,9 @@ namespace
   {
   public:
     GlyphAtlasPrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase> ptexel_store,
-                      fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> pgeometry_store):
+                      fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+                      enum fastuidraw::GlyphAtlas::packer_t packer):
+      m_packer(packer),
       m_texel_store(ptexel_store),
       m_geometry_store(pgeometry_store),
       m_geometry_data_allocator(pgeometry_store->size())
@@ -104,11 +126,26 @@ namespace
       m_private_data.resize(new_size);
       for(int i = old_size; i < new_size; ++i)
         {
-          m_private_data[i] = FASTUIDRAWnew rect_atlas_layer(dims, i);
+          m_private_data[i] = FASTUIDRAWnew rect_atlas_layer(dims, i, m_packer);
         }
     }
 
+    /* allocate a rectangle, resizing the texel store if
+       necessary; the mutex must be locked by the caller.
+     */
+    const fastuidraw::detail::RectAtlas::rectangle*
+    allocate_rectangle(const fastuidraw::ivec2 &size,
+                       const fastuidraw::GlyphAtlas::Padding &padding,
+                       int &layer);
+
+    /* allocate geometry blocks, resizing the geometry store
+       if necessary; the mutex must be locked by the caller.
+     */
+    int
+    allocate_geometry_blocks(int block_count);
+
     boost::mutex m_mutex;
+    enum fastuidraw::GlyphAtlas::packer_t m_packer;
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase> m_texel_store;
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> m_geometry_store;
     std::vector<fastuidraw::reference_counted_ptr<rect_atlas_layer> > m_private_data;
@@ -116,6 +153,70 @@ namespace
   };
 }
 
+/////////////////////////////////////////////////////
+// GlyphAtlasPrivate methods
+const fastuidraw::detail::RectAtlas::rectangle*
+GlyphAtlasPrivate::
+allocate_rectangle(const fastuidraw::ivec2 &size,
+                   const fastuidraw::GlyphAtlas::Padding &padding,
+                   int &layer)
+{
+  const fastuidraw::detail::RectAtlas::rectangle *r(NULL);
+
+  if(size.x() > m_texel_store->dimensions().x()
+     || size.y() > m_texel_store->dimensions().y())
+    {
+      return NULL;
+    }
+
+  for(unsigned int i = 0, endi = m_private_data.size(); i < endi && r == NULL; ++i)
+    {
+      r = m_private_data[i]->add_rectangle(size,
+                                           padding.m_left, padding.m_right,
+                                           padding.m_top, padding.m_bottom);
+      layer = i;
+    }
+
+  if(r == NULL && m_texel_store->resizeable())
+    {
+      int old_size;
+
+      /* TODO:
+          Should we reallocate on powers of 2, or one layer
+          at a time? [Right now we are doing one layer at
+          a time].
+       */
+      old_size = m_texel_store->dimensions().z();
+      m_texel_store->resize(old_size + 1);
+      allocate_atlas_bookkeeping(m_texel_store->dimensions().z());
+
+      r = m_private_data[old_size]->add_rectangle(size,
+                                                  padding.m_left, padding.m_right,
+                                                  padding.m_top, padding.m_bottom);
+      layer = old_size;
+      assert(r != NULL);
+    }
+
+  return r;
+}
+
+int
+GlyphAtlasPrivate::
+allocate_geometry_blocks(int block_count)
+{
+  int return_value;
+
+  return_value = m_geometry_data_allocator.allocate_interval(block_count);
+  if(return_value == -1 && m_geometry_store->resizeable())
+    {
+      m_geometry_store->resize(block_count + 2 * m_geometry_store->size());
+      m_geometry_data_allocator.resize(m_geometry_store->size());
+      return_value = m_geometry_data_allocator.allocate_interval(block_count);
+      assert(return_value != -1);
+    }
+  return return_value;
+}
+
 /////////////////////////////////////////////////////
 // fastuidraw::GlyphAtlasTexelBackingStoreBase methods
 fastuidraw::GlyphAtlasTexelBackingStoreBase::
@@ -272,13 +373,35 @@ size(void) const
     ivec2(-1, -1);
 }
 
+///////////////////////////////////////////////
+// fastuidraw::GlyphAtlas::PackingStatistics methods
+float
+fastuidraw::GlyphAtlas::PackingStatistics::
+occupancy(void) const
+{
+  return (m_total_area > 0) ?
+    static_cast<float>(m_allocated_area) / static_cast<float>(m_total_area) :
+    0.0f;
+}
+
+float
+fastuidraw::GlyphAtlas::PackingStatistics::
+fragmentation(void) const
+{
+  uint64_t free_area(m_total_area - m_allocated_area);
+  return (free_area > 0) ?
+    1.0f - static_cast<float>(m_free_rectangle_area) / static_cast<float>(free_area) :
+    0.0f;
+}
+
 ///////////////////////////////////////////////
 // fastuidraw::GlyphAtlas methods
 fastuidraw::GlyphAtlas::
 GlyphAtlas(reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> ptexel_store,
-           reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store)
+           reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+           enum packer_t packer)
 {
-  m_d = FASTUIDRAWnew GlyphAtlasPrivate(ptexel_store, pgeometry_store);
+  m_d = FASTUIDRAWnew GlyphAtlasPrivate(ptexel_store, pgeometry_store, packer);
 };
 
 fastuidraw::GlyphAtlas::
@@ -300,45 +423,11 @@ allocate(fastuidraw::ivec2 size, const_c_array<uint8_t> pdata,
   d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
 
   GlyphLocation return_value;
-  const detail::RectAtlas::rectangle *r(NULL);
-  unsigned int layer;
-
-  if(size.x() > d->m_texel_store->dimensions().x()
-     || size.y() > d->m_texel_store->dimensions().y())
-    {
-      return return_value;
-    }
+  const detail::RectAtlas::rectangle *r;
+  int layer;
 
   autolock_mutex m(d->m_mutex);
-
-  for(unsigned int i = 0, endi = d->m_private_data.size(); i < endi && r == NULL; ++i)
-    {
-      r = d->m_private_data[i]->add_rectangle(size,
-                                              padding.m_left, padding.m_right,
-                                              padding.m_top, padding.m_bottom);
-      layer = i;
-    }
-
-  if(r == NULL && d->m_texel_store->resizeable())
-    {
-      int old_size;
-
-      /* TODO:
-          Should we reallocate on powers of 2, or one layer
-          at a time? [Right now we are doing one layer at
-          a time].
-       */
-      old_size = d->m_texel_store->dimensions().z();
-      d->m_texel_store->resize(old_size + 1);
-      d->allocate_atlas_bookkeeping(d->m_texel_store->dimensions().z());
-
-      r = d->m_private_data[old_size]->add_rectangle(size,
-                                                     padding.m_left, padding.m_right,
-                                                     padding.m_top, padding.m_bottom);
-      layer = old_size;
-      assert(r != NULL);
-    }
-
+  r = d->allocate_rectangle(size, padding, layer);
   if(r != NULL)
     {
       return_value.m_opaque = r;
@@ -349,6 +438,33 @@ allocate(fastuidraw::ivec2 size, const_c_array<uint8_t> pdata,
   return return_value;
 }
 
+fastuidraw::GlyphLocation
+fastuidraw::GlyphAtlas::
+allocate(fastuidraw::ivec2 size, const GlyphAtlas::Padding &padding)
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+
+  GlyphLocation return_value;
+  int layer;
+
+  autolock_mutex m(d->m_mutex);
+  return_value.m_opaque = d->allocate_rectangle(size, padding, layer);
+  return return_value;
+}
+
+void
+fastuidraw::GlyphAtlas::
+set_texel_data(ivec2 xy, int layer, ivec2 wh, const_c_array<uint8_t> data)
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+
+  assert(data.size() == static_cast<unsigned int>(wh.x() * wh.y()));
+  autolock_mutex m(d->m_mutex);
+  d->m_texel_store->set_data(xy.x(), xy.y(), layer, wh.x(), wh.y(), data);
+}
+
 void
 fastuidraw::GlyphAtlas::
 deallocate(fastuidraw::GlyphLocation G)
@@ -382,26 +498,41 @@ allocate_geometry_data(const_c_array<generic_data> pdata)
   assert(count % alignment == 0);
 
   block_count = count / alignment;
-  return_value = d->m_geometry_data_allocator.allocate_interval(block_count);
+  return_value = d->allocate_geometry_blocks(block_count);
   if(return_value == -1)
     {
-      if(d->m_geometry_store->resizeable())
-        {
-          d->m_geometry_store->resize(block_count + 2 * d->m_geometry_store->size());
-          d->m_geometry_data_allocator.resize(d->m_geometry_store->size());
-          return_value = d->m_geometry_data_allocator.allocate_interval(block_count);
-          assert(return_value != -1);
-        }
-      else
-        {
-          return return_value;
-        }
+      return return_value;
     }
 
   d->m_geometry_store->set_values(return_value, pdata);
   return return_value;
 }
 
+int
+fastuidraw::GlyphAtlas::
+allocate_geometry_blocks(unsigned int count)
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+
+  assert(count > 0);
+  autolock_mutex m(d->m_mutex);
+  return d->allocate_geometry_blocks(count);
+}
+
+void
+fastuidraw::GlyphAtlas::
+set_geometry_data(int location, const_c_array<generic_data> pdata)
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+
+  assert(location >= 0);
+  assert(pdata.size() % d->m_geometry_store->alignment() == 0);
+  autolock_mutex m(d->m_mutex);
+  d->m_geometry_store->set_values(location, pdata);
+}
+
 void
 fastuidraw::GlyphAtlas::
 deallocate_geometry_data(int location, int count)
@@ -450,6 +581,41 @@ flush(void) const
   d->m_geometry_store->flush();
 }
 
+enum fastuidraw::GlyphAtlas::packer_t
+fastuidraw::GlyphAtlas::
+packer(void) const
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+  return d->m_packer;
+}
+
+fastuidraw::GlyphAtlas::PackingStatistics
+fastuidraw::GlyphAtlas::
+packing_statistics(void) const
+{
+  GlyphAtlasPrivate *d;
+  d = reinterpret_cast<GlyphAtlasPrivate*>(m_d);
+
+  PackingStatistics return_value;
+  autolock_mutex m(d->m_mutex);
+
+  return_value.m_number_layers = d->m_private_data.size();
+  for(unsigned int i = 0, endi = d->m_private_data.size(); i < endi; ++i)
+    {
+      const rect_atlas_layer *layer(d->m_private_data[i].get());
+      uint64_t largest_free;
+
+      largest_free = layer->largest_free_area();
+      return_value.m_number_regions += layer->number_rectangles();
+      return_value.m_total_area += layer->size().x() * layer->size().y();
+      return_value.m_allocated_area += layer->allocated_area();
+      return_value.m_free_rectangle_area += largest_free;
+      return_value.m_largest_free_area = t_max(return_value.m_largest_free_area, largest_free);
+    }
+  return return_value;
+}
+
 fastuidraw::reference_counted_ptr<const fastuidraw::GlyphAtlasTexelBackingStoreBase>
 fastuidraw::GlyphAtlas::
 texel_store(void) const
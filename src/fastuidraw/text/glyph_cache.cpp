@@ -19,15 +19,22 @@
 
 #include <map>
 #include <vector>
+#include <list>
+#include <deque>
+#include <boost/thread.hpp>
 #include <fastuidraw/text/glyph_cache.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
+#include <fastuidraw/text/glyph_disk_cache.hpp>
 #include "../private/util_private.hpp"
+#include "../private/worker_pool.hpp"
 
 
 namespace
 {
 
   class GlyphCachePrivate;
+  class BatchPrivate;
+  class GlyphGenerator;
 
   class GlyphDataPrivate
   {
@@ -38,12 +45,24 @@ namespace
       m_geometry_offset(-1),
       m_geometry_length(0),
       m_uploaded_to_atlas(false),
-      m_glyph_data(NULL)
+      m_upload_generation(0),
+      m_last_used_frame(0),
+      m_hit_count(0),
+      m_glyph_data(NULL),
+      m_pending(NULL),
+      m_generated(false)
     {}
 
     void
     clear(void);
 
+    /* release the locations of the glyph in the atlas,
+       keeping the glyph data so that the glyph can be
+       uploaded again.
+     */
+    void
+    remove_from_atlas(void);
+
     enum fastuidraw::return_code
     upload_to_atlas(void);
 
@@ -66,6 +85,22 @@ namespace
     int m_geometry_offset, m_geometry_length;
     bool m_uploaded_to_atlas;
 
+    /* value of GlyphCachePrivate::m_number_uploads when the
+       glyph was last uploaded to the atlas, 0 if the glyph
+       is not uploaded
+     */
+    unsigned int m_upload_generation;
+
+    /* value of GlyphCachePrivate::m_current_frame
+       when the glyph was last fetched or uploaded
+     */
+    unsigned int m_last_used_frame;
+
+    /* number of times the glyph was fetched by
+       GlyphCache::fetch_glyph() or GlyphCache::fetch_glyphs_async()
+     */
+    uint32_t m_hit_count;
+
     /* Path of the glyph
      */
     fastuidraw::Path m_path;
@@ -73,16 +108,182 @@ namespace
     /* data to generate glyph data
      */
     fastuidraw::GlyphRenderData *m_glyph_data;
+
+    /* if non-NULL, m_layout, m_path and m_glyph_data are
+       being generated by a worker thread for the named
+       batch; m_generated is set by the worker (with the
+       mutex of the batch locked) when it is done.
+     */
+    BatchPrivate *m_pending;
+    bool m_generated;
   };
 
+  /* fetch the data of a glyph from disk_cache if it holds the
+     glyph, otherwise generate the data with the font, adding
+     the generated data to disk_cache.
+   */
+  fastuidraw::GlyphRenderData*
+  generate_glyph_data(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> &disk_cache,
+                      const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                      uint32_t glyph_code, GlyphDataPrivate *G)
+  {
+    fastuidraw::GlyphRenderData *return_value;
+
+    if(disk_cache)
+      {
+        return_value = disk_cache->fetch_glyph(G->m_render, font, glyph_code, G->m_layout, G->m_path);
+        if(return_value)
+          {
+            return return_value;
+          }
+      }
+
+    return_value = font->compute_rendering_data(G->m_render, glyph_code, G->m_layout, G->m_path);
+    if(disk_cache)
+      {
+        disk_cache->store_glyph(G->m_render, font, glyph_code, G->m_layout, G->m_path, return_value);
+      }
+    return return_value;
+  }
+
+  typedef std::map<uint64_t, fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> > FontsByKey;
+
+  void
+  make_fonts_by_key(fastuidraw::const_c_array<fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> > fonts,
+                    FontsByKey &out_fonts)
+  {
+    for(unsigned int i = 0, endi = fonts.size(); i < endi; ++i)
+      {
+        if(fonts[i] && fonts[i]->persistent_key() != 0)
+          {
+            out_fonts[fonts[i]->persistent_key()] = fonts[i];
+          }
+      }
+  }
+
+  class BatchPrivate
+  {
+  public:
+    explicit
+    BatchPrivate(fastuidraw::GlyphCache::Batch *p):
+      m_p(p),
+      m_generator(NULL),
+      m_remaining(0)
+    {}
+
+    /* called from a worker thread when
+       the data of a glyph is generated
+     */
+    void
+    glyph_generated(GlyphDataPrivate *G);
+
+    /* wait until G is generated; while waiting, the calling
+       thread generates the glyphs of m_generator that are
+       not yet taken by a thread of the worker_pool.
+     */
+    void
+    wait_glyph(GlyphDataPrivate *G);
+
+    /* wait until the glyphs of this batch are generated,
+       helping as in wait_glyph().
+     */
+    void
+    wait(void);
+
+    bool
+    ready(void);
+
+    /* remove this batch from the glyphs it generated,
+       must be called after all the glyphs are generated.
+     */
+    void
+    release_glyphs(void);
+
+    std::vector<fastuidraw::Glyph> m_glyphs;
+    std::vector<GlyphDataPrivate*> m_generating;
+
+    /* batches made before this batch that generate
+       some of the glyphs of m_glyphs
+     */
+    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache::Batch> > m_waits_on;
+    fastuidraw::GlyphCache::Batch *m_p;
+
+    /* the GlyphGenerator of the GlyphCache that generates
+       the glyphs of m_generating, only used while
+       m_remaining is not zero.
+     */
+    GlyphGenerator *m_generator;
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    unsigned int m_remaining;
+  };
+
+  class GlyphJob
+  {
+  public:
+    BatchPrivate *m_batch;
+    GlyphDataPrivate *m_glyph;
+    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> m_disk_cache;
+    uint32_t m_glyph_code;
+  };
+
+  /* a GlyphGenerator holds the glyph jobs of a GlyphCache
+     not yet started; each job added is posted to the shared
+     worker_pool, and a thread waiting on a batch takes jobs
+     as well, see BatchPrivate::wait().
+   */
+  class GlyphGenerator:
+    public fastuidraw::worker_pool::job,
+    fastuidraw::noncopyable
+  {
+  public:
+    GlyphGenerator(void);
+
+    /* waits until the worker_pool is done with this */
+    ~GlyphGenerator();
+
+    void
+    add_job(const GlyphJob &job);
+
+    /* run a job not yet started on the calling thread,
+       returns false if there was no such job.
+     */
+    bool
+    run_one(void);
+
+    /* called by the worker_pool, once for each job
+       posted; the job may already be taken by a
+       thread that called run_one().
+     */
+    virtual
+    void
+    run(void);
+
+  private:
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    std::deque<GlyphJob> m_jobs;
+
+    /* number of calls of run() the worker_pool is to make */
+    unsigned int m_posted;
+  };
+
+  /* A GlyphSource is the key of a glyph in a GlyphCache;
+     the font is a raw pointer so that looking up a glyph
+     does not touch the reference count of the font, the
+     tables holding a GlyphSource hold a reference to the
+     font as well.
+   */
   class GlyphSource
   {
   public:
     GlyphSource(void):
+      m_font(NULL),
       m_glyph_code(0)
     {}
 
-    GlyphSource(fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> f,
+    GlyphSource(const fastuidraw::FontBase *f,
                 uint32_t gc, fastuidraw::GlyphRender r):
       m_font(f),
       m_glyph_code(gc),
@@ -90,18 +291,230 @@ namespace
     {}
 
     bool
-    operator<(const GlyphSource &rhs) const
+    operator==(const GlyphSource &rhs) const
     {
-      return (m_font != rhs.m_font) ? m_font < rhs.m_font :
-        (m_glyph_code != rhs.m_glyph_code) ? m_glyph_code < rhs.m_glyph_code :
-        m_render < rhs.m_render;
+      return m_font == rhs.m_font
+        && m_glyph_code == rhs.m_glyph_code
+        && m_render == rhs.m_render;
     }
 
-    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
+    /* must be consistent with GlyphRender::operator==(),
+       which ignores m_pixel_size for scalable glyph types.
+     */
+    uint32_t
+    hash(void) const
+    {
+      uint64_t v;
+
+      v = reinterpret_cast<uintptr_t>(m_font);
+      v ^= uint64_t(m_glyph_code) << 24u;
+      v ^= uint64_t(m_render.m_type) << 56u;
+      if(!fastuidraw::GlyphRender::scalable(m_render.m_type))
+        {
+          v ^= uint64_t(m_render.m_pixel_size) << 40u;
+        }
+      v *= 0x9E3779B97F4A7C15ull;
+      return uint32_t(v >> 32u);
+    }
+
+    const fastuidraw::FontBase *m_font;
     uint32_t m_glyph_code;
     fastuidraw::GlyphRender m_render;
   };
 
+  /* Open addressing hash table with linear probing keyed
+     by GlyphSource; values are pointers with NULL
+     indicating not present.
+   */
+  template<typename T>
+  class GlyphSourceTable
+  {
+  public:
+    GlyphSourceTable(void):
+      m_number_full(0),
+      m_number_used(0)
+    {}
+
+    T*
+    find(const GlyphSource &key) const
+    {
+      if(m_slots.empty())
+        {
+          return NULL;
+        }
+
+      for(uint32_t mask = m_slots.size() - 1, i = key.hash() & mask;; i = (i + 1) & mask)
+        {
+          const Slot &S(m_slots[i]);
+          if(S.m_state == slot_empty)
+            {
+              return NULL;
+            }
+
+          if(S.m_state == slot_full && S.m_key == key)
+            {
+              return S.m_value;
+            }
+        }
+    }
+
+    /* key must not already be in the table */
+    void
+    insert(const GlyphSource &key,
+           const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+           T *value)
+    {
+      assert(value != NULL);
+      assert(font.get() == key.m_font);
+      assert(find(key) == NULL);
+
+      /* keep the load, counting erased slots, at most one half */
+      if(2 * (m_number_used + 1) > m_slots.size())
+        {
+          rehash();
+        }
+
+      for(uint32_t mask = m_slots.size() - 1, i = key.hash() & mask;; i = (i + 1) & mask)
+        {
+          Slot &S(m_slots[i]);
+          if(S.m_state != slot_full)
+            {
+              if(S.m_state == slot_empty)
+                {
+                  ++m_number_used;
+                }
+              S.m_state = slot_full;
+              S.m_key = key;
+              S.m_font = font;
+              S.m_value = value;
+              ++m_number_full;
+              return;
+            }
+        }
+    }
+
+    void
+    erase(const GlyphSource &key)
+    {
+      if(m_slots.empty())
+        {
+          return;
+        }
+
+      for(uint32_t mask = m_slots.size() - 1, i = key.hash() & mask;; i = (i + 1) & mask)
+        {
+          Slot &S(m_slots[i]);
+          if(S.m_state == slot_empty)
+            {
+              return;
+            }
+
+          if(S.m_state == slot_full && S.m_key == key)
+            {
+              S.m_state = slot_erased;
+              S.m_font = fastuidraw::reference_counted_ptr<const fastuidraw::FontBase>();
+              S.m_value = NULL;
+              --m_number_full;
+              return;
+            }
+        }
+    }
+
+    void
+    clear(void)
+    {
+      m_slots.clear();
+      m_number_full = 0;
+      m_number_used = 0;
+    }
+
+  private:
+    enum slot_state_t
+      {
+        slot_empty,
+        slot_full,
+        slot_erased
+      };
+
+    class Slot
+    {
+    public:
+      Slot(void):
+        m_state(slot_empty),
+        m_value(NULL)
+      {}
+
+      enum slot_state_t m_state;
+      GlyphSource m_key;
+      fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
+      T *m_value;
+    };
+
+    void
+    rehash(void)
+    {
+      std::vector<Slot> old_slots;
+      unsigned int sz;
+
+      /* grow only if the table has enough full slots,
+         otherwise rehashing just removes the erased slots.
+       */
+      for(sz = 16; sz < 4 * (m_number_full + 1); sz *= 2)
+        {}
+      sz = std::max(sz, static_cast<unsigned int>(m_slots.size()));
+
+      old_slots.resize(sz);
+      m_slots.swap(old_slots);
+      m_number_full = 0;
+      m_number_used = 0;
+
+      for(unsigned int i = 0, endi = old_slots.size(); i < endi; ++i)
+        {
+          if(old_slots[i].m_state == slot_full)
+            {
+              insert(old_slots[i].m_key, old_slots[i].m_font, old_slots[i].m_value);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    unsigned int m_number_full, m_number_used;
+  };
+
+  /* Glyphs with small glyph codes of a single font and
+     GlyphRender are stored in a flat array indexed
+     by glyph code.
+   */
+  class DenseGlyphs:fastuidraw::noncopyable
+  {
+  public:
+    enum
+      {
+        number_glyph_codes = 256
+      };
+
+    explicit
+    DenseGlyphs(unsigned int pool_location):
+      m_number_glyphs(0),
+      m_pool_location(pool_location)
+    {
+      std::fill(m_glyphs.begin(), m_glyphs.end(), static_cast<GlyphDataPrivate*>(NULL));
+    }
+
+    fastuidraw::vecN<GlyphDataPrivate*, number_glyph_codes> m_glyphs;
+
+    /* number of non-NULL entries of m_glyphs, the
+       DenseGlyphs is deleted when it drops to zero.
+     */
+    unsigned int m_number_glyphs;
+
+    /* location in GlyphCachePrivate::m_dense_glyphs_pool */
+    unsigned int m_pool_location;
+  };
+
+  typedef std::pair<fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache::Batch>,
+                    BatchPrivate*> BatchEntry;
+
   class GlyphCachePrivate
   {
   public:
@@ -118,13 +531,97 @@ namespace
      */
 
     GlyphDataPrivate*
-    fetch_or_allocate_glyph(GlyphSource src);
+    fetch_or_allocate_glyph(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                            uint32_t glyph_code, fastuidraw::GlyphRender render);
+
+    /* fetch or allocate a glyph, generating the glyph
+       data with the calling thread if it is not yet
+       generated.
+     */
+    GlyphDataPrivate*
+    fetch_glyph(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                uint32_t glyph_code, fastuidraw::GlyphRender render);
+
+    /* fetch or allocate a glyph for a batch, if the glyph data
+       is not yet generated, a job to generate it is added to
+       the GlyphGenerator.
+     */
+    GlyphDataPrivate*
+    fetch_glyph_async(BatchPrivate *b,
+                      const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                      uint32_t glyph_code, fastuidraw::GlyphRender render);
+
+    /* returns the location holding the glyph of a GlyphSource
+       if the GlyphSource is stored in a DenseGlyphs, otherwise
+       returns NULL; if create is true, the DenseGlyphs is
+       created if it is not present. The DenseGlyphs of the
+       returned location is m_last_dense.
+     */
+    GlyphDataPrivate**
+    dense_location(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                   const GlyphSource &src, bool create);
+
+    void
+    remove_glyph_from_map(GlyphDataPrivate *G);
+
+    void
+    clear_glyph_map(void);
+
+    /* if the glyph is being generated by a worker
+       thread, wait until the glyph is generated.
+     */
+    void
+    wait_glyph(GlyphDataPrivate *G);
+
+    /* wait for all batches to finish and release them.
+     */
+    void
+    wait_batches(void);
+
+    /* release the batches that are finished.
+     */
+    void
+    release_ready_batches(void);
+
+    /* remove from the atlas those uploaded glyphs that
+       were used least recently, i.e. those glyphs with the
+       smallest value of m_last_used_frame; glyphs used
+       in the current frame are never removed. Returns
+       false if there was no glyph to remove.
+     */
+    bool
+    evict_least_recently_used(void);
 
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_atlas;
-    std::map<GlyphSource, GlyphDataPrivate*> m_glyph_map;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> m_disk_cache;
+
+    /* glyphs with glyph code less than DenseGlyphs::number_glyph_codes
+       are in m_dense_glyphs, keyed by font and GlyphRender (with
+       glyph code 0), all other glyphs are in m_glyph_map. Looking
+       up a DenseGlyphs is skipped if the font and GlyphRender are
+       the same as the previous lookup. A DenseGlyphs (and with it
+       the reference to its font) is released when its last glyph
+       is removed.
+     */
+    GlyphSourceTable<GlyphDataPrivate> m_glyph_map;
+    GlyphSourceTable<DenseGlyphs> m_dense_glyphs;
+    std::vector<DenseGlyphs*> m_dense_glyphs_pool;
+    GlyphSource m_last_dense_source;
+    DenseGlyphs *m_last_dense;
     std::vector<GlyphDataPrivate*> m_glyphs;
     std::vector<unsigned int> m_free_slots;
     fastuidraw::GlyphCache *m_p;
+
+    /* batches whose glyphs may still be marked as being
+       generated, and the jobs generating them; the GlyphGenerator
+       is created on the first call to fetch_glyphs_async().
+     */
+    std::list<BatchEntry> m_batches;
+    GlyphGenerator *m_generator;
+
+    unsigned int m_current_frame;
+    unsigned int m_number_evicted;
+    unsigned int m_number_uploads;
   };
 }
 
@@ -136,7 +633,24 @@ clear(void)
 {
   m_render = fastuidraw::GlyphRender();
   assert(!m_render.valid());
+  m_hit_count = 0;
+
+  remove_from_atlas();
+  if(m_glyph_data)
+    {
+      FASTUIDRAWdelete(m_glyph_data);
+      m_glyph_data = NULL;
+    }
+  m_path.clear();
+
+  /* the free slot should not keep the font alive */
+  m_layout = fastuidraw::GlyphLayoutData();
+}
 
+void
+GlyphDataPrivate::
+remove_from_atlas(void)
+{
   if(m_atlas_location[0].valid())
     {
       m_cache->m_atlas->deallocate(m_atlas_location[0]);
@@ -157,101 +671,535 @@ clear(void)
     }
 
   m_uploaded_to_atlas = false;
-  if(m_glyph_data)
+  m_upload_generation = 0;
+}
+
+enum fastuidraw::return_code
+GlyphDataPrivate::
+upload_to_atlas(void)
+{
+  /* TODO:
+     1. this method is not thread safe if different threads
+        attempt to access the same glyph (or if different
+        threads call this routine and clear_atlas()
+        at the same time).
+
+     2. this routine is hideous to read due to the handling
+        of allocation failures. Should likely bunch the
+        allocation behind objects whose ctors and dtors
+        do the right thing.
+   */
+  enum fastuidraw::return_code return_value;
+
+  m_last_used_frame = m_cache->m_current_frame;
+  if(m_uploaded_to_atlas)
+    {
+      return fastuidraw::routine_success;
+    }
+
+  if(!m_glyph_data)
+    {
+      /* the glyph was added with GlyphCache::add_uploaded_glyph()
+         and then removed from the atlas, generate its data again.
+       */
+      fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> font(m_layout.m_font);
+      uint32_t glyph_code(m_layout.m_glyph_code);
+
+      m_path.clear();
+      m_glyph_data = generate_glyph_data(m_cache->m_disk_cache, font, glyph_code, this);
+    }
+
+  return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
+                                               m_atlas_location[0],
+                                               m_atlas_location[1],
+                                               m_geometry_offset,
+                                               m_geometry_length);
+
+  /* on failure, take the least recently used glyphs out
+     of the atlas until this glyph fits.
+   */
+  while(return_value != fastuidraw::routine_success
+        && m_cache->evict_least_recently_used())
+    {
+      return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
+                                                   m_atlas_location[0],
+                                                   m_atlas_location[1],
+                                                   m_geometry_offset,
+                                                   m_geometry_length);
+    }
+
+  if(return_value == fastuidraw::routine_success)
+    {
+      m_uploaded_to_atlas = true;
+      m_upload_generation = ++m_cache->m_number_uploads;
+    }
+
+  return return_value;
+}
+
+
+
+/////////////////////////////////////////////////
+// BatchPrivate methods
+void
+BatchPrivate::
+glyph_generated(GlyphDataPrivate *G)
+{
+  /* notify with the mutex locked because as soon as the
+     mutex is unlocked, the batch might be deleted by the
+     thread of the GlyphCache.
+   */
+  fastuidraw::autolock_mutex m(m_mutex);
+  G->m_generated = true;
+  --m_remaining;
+  m_cond.notify_all();
+}
+
+void
+BatchPrivate::
+wait_glyph(GlyphDataPrivate *G)
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(!G->m_generated)
+    {
+      bool helped;
+
+      lock.unlock();
+      helped = m_generator->run_one();
+      lock.lock();
+
+      if(!helped && !G->m_generated)
+        {
+          m_cond.wait(lock);
+        }
+    }
+}
+
+void
+BatchPrivate::
+wait(void)
+{
+  for(unsigned int i = 0, endi = m_waits_on.size(); i < endi; ++i)
+    {
+      m_waits_on[i]->wait();
+    }
+  m_waits_on.clear();
+
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(m_remaining > 0)
+    {
+      bool helped;
+
+      lock.unlock();
+      helped = m_generator->run_one();
+      lock.lock();
+
+      if(!helped && m_remaining > 0)
+        {
+          m_cond.wait(lock);
+        }
+    }
+}
+
+bool
+BatchPrivate::
+ready(void)
+{
+  bool return_value;
+
+  while(!m_waits_on.empty())
+    {
+      if(!m_waits_on.back()->ready())
+        {
+          return false;
+        }
+      m_waits_on.pop_back();
+    }
+
+  m_mutex.lock();
+  return_value = (m_remaining == 0);
+  m_mutex.unlock();
+  return return_value;
+}
+
+void
+BatchPrivate::
+release_glyphs(void)
+{
+  assert(m_remaining == 0);
+  for(unsigned int i = 0, endi = m_generating.size(); i < endi; ++i)
+    {
+      if(m_generating[i]->m_pending == this)
+        {
+          m_generating[i]->m_pending = NULL;
+        }
+    }
+  m_generating.clear();
+}
+
+/////////////////////////////////////////////////
+// GlyphGenerator methods
+GlyphGenerator::
+GlyphGenerator(void):
+  m_posted(0)
+{}
+
+GlyphGenerator::
+~GlyphGenerator()
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  assert(m_jobs.empty());
+  while(m_posted > 0)
+    {
+      m_cond.wait(lock);
+    }
+}
+
+void
+GlyphGenerator::
+add_job(const GlyphJob &job)
+{
+  m_mutex.lock();
+  m_jobs.push_back(job);
+  ++m_posted;
+  m_mutex.unlock();
+  fastuidraw::worker_pool::shared().post(this);
+}
+
+bool
+GlyphGenerator::
+run_one(void)
+{
+  GlyphJob job;
+  GlyphDataPrivate *G;
+
+  {
+    fastuidraw::autolock_mutex m(m_mutex);
+    if(m_jobs.empty())
+      {
+        return false;
+      }
+    job = m_jobs.front();
+    m_jobs.pop_front();
+  }
+
+  G = job.m_glyph;
+  G->m_glyph_data = generate_glyph_data(job.m_disk_cache, job.m_font, job.m_glyph_code, G);
+  job.m_font = fastuidraw::reference_counted_ptr<const fastuidraw::FontBase>();
+  job.m_disk_cache = fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache>();
+  job.m_batch->glyph_generated(G);
+  return true;
+}
+
+void
+GlyphGenerator::
+run(void)
+{
+  run_one();
+
+  /* notify with the mutex locked because as soon as the
+     mutex is unlocked, the GlyphGenerator might be deleted.
+   */
+  fastuidraw::autolock_mutex m(m_mutex);
+  --m_posted;
+  m_cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+// GlyphCachePrivate methods
+GlyphCachePrivate::
+GlyphCachePrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> patlas,
+                  fastuidraw::GlyphCache *p):
+  m_atlas(patlas),
+  m_last_dense(NULL),
+  m_p(p),
+  m_generator(NULL),
+  m_current_frame(0),
+  m_number_evicted(0),
+  m_number_uploads(0)
+{}
+
+GlyphCachePrivate::
+~GlyphCachePrivate()
+{
+  wait_batches();
+  if(m_generator)
+    {
+      FASTUIDRAWdelete(m_generator);
+    }
+
+  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
+    {
+      m_glyphs[i]->clear();
+      FASTUIDRAWdelete(m_glyphs[i]);
+    }
+  clear_glyph_map();
+}
+
+
+GlyphDataPrivate**
+GlyphCachePrivate::
+dense_location(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+               const GlyphSource &src, bool create)
+{
+  if(src.m_glyph_code >= DenseGlyphs::number_glyph_codes)
+    {
+      return NULL;
+    }
+
+  GlyphSource key(src.m_font, 0, src.m_render);
+  if(m_last_dense == NULL || !(key == m_last_dense_source))
+    {
+      DenseGlyphs *D;
+
+      D = m_dense_glyphs.find(key);
+      if(D == NULL)
+        {
+          if(!create)
+            {
+              return NULL;
+            }
+          D = FASTUIDRAWnew DenseGlyphs(m_dense_glyphs_pool.size());
+          m_dense_glyphs_pool.push_back(D);
+          m_dense_glyphs.insert(key, font, D);
+        }
+      m_last_dense = D;
+      m_last_dense_source = key;
+    }
+  return &m_last_dense->m_glyphs[src.m_glyph_code];
+}
+
+void
+GlyphCachePrivate::
+remove_glyph_from_map(GlyphDataPrivate *G)
+{
+  GlyphSource src(G->m_layout.m_font.get(), G->m_layout.m_glyph_code, G->m_render);
+  GlyphDataPrivate **dense;
+
+  dense = dense_location(G->m_layout.m_font, src, false);
+  if(dense != NULL)
+    {
+      DenseGlyphs *D(m_last_dense);
+
+      assert(*dense == G);
+      assert(D->m_number_glyphs > 0);
+      *dense = NULL;
+      --D->m_number_glyphs;
+      if(D->m_number_glyphs == 0)
+        {
+          DenseGlyphs *last(m_dense_glyphs_pool.back());
+
+          m_dense_glyphs.erase(m_last_dense_source);
+          last->m_pool_location = D->m_pool_location;
+          m_dense_glyphs_pool[D->m_pool_location] = last;
+          m_dense_glyphs_pool.pop_back();
+          FASTUIDRAWdelete(D);
+          m_last_dense = NULL;
+        }
+    }
+  else
+    {
+      m_glyph_map.erase(src);
+    }
+}
+
+void
+GlyphCachePrivate::
+clear_glyph_map(void)
+{
+  m_glyph_map.clear();
+  m_dense_glyphs.clear();
+  for(unsigned int i = 0, endi = m_dense_glyphs_pool.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_dense_glyphs_pool[i]);
+    }
+  m_dense_glyphs_pool.clear();
+  m_last_dense = NULL;
+}
+
+GlyphDataPrivate*
+GlyphCachePrivate::
+fetch_or_allocate_glyph(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                        uint32_t glyph_code, fastuidraw::GlyphRender render)
+{
+  GlyphSource src(font.get(), glyph_code, render);
+  GlyphDataPrivate *G, **dense;
+
+  dense = dense_location(font, src, true);
+  G = (dense != NULL) ? *dense : m_glyph_map.find(src);
+  if(G != NULL)
+    {
+      return G;
+    }
+
+
+  if(m_free_slots.empty())
+    {
+      G = FASTUIDRAWnew GlyphDataPrivate(this, m_glyphs.size());
+      m_glyphs.push_back(G);
+      assert(!G->m_render.valid());
+    }
+  else
+    {
+      unsigned int v(m_free_slots.back());
+      m_free_slots.pop_back();
+      G = m_glyphs[v];
+      assert(!G->m_render.valid());
+    }
+
+  if(dense != NULL)
+    {
+      *dense = G;
+      ++m_last_dense->m_number_glyphs;
+    }
+  else
+    {
+      m_glyph_map.insert(src, font, G);
+    }
+  return G;
+}
+
+GlyphDataPrivate*
+GlyphCachePrivate::
+fetch_glyph(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+            uint32_t glyph_code, fastuidraw::GlyphRender render)
+{
+  GlyphDataPrivate *q;
+
+  q = fetch_or_allocate_glyph(font, glyph_code, render);
+  q->m_last_used_frame = m_current_frame;
+
+  if(!q->m_render.valid())
+    {
+      q->m_render = render;
+      assert(!q->m_glyph_data);
+      q->m_glyph_data = generate_glyph_data(m_disk_cache, font, glyph_code, q);
+    }
+  else
     {
-      FASTUIDRAWdelete(m_glyph_data);
-      m_glyph_data = NULL;
+      wait_glyph(q);
     }
-  m_path.clear();
+  return q;
 }
 
-enum fastuidraw::return_code
-GlyphDataPrivate::
-upload_to_atlas(void)
+GlyphDataPrivate*
+GlyphCachePrivate::
+fetch_glyph_async(BatchPrivate *b,
+                  const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                  uint32_t glyph_code, fastuidraw::GlyphRender render)
 {
-  /* TODO:
-     1. this method is not thread safe if different threads
-        attempt to access the same glyph (or if different
-        threads call this routine and clear_atlas()
-        at the same time).
-
-     2. this routine is hideous to read due to the handling
-        of allocation failures. Should likely bunch the
-        allocation behind objects whose ctors and dtors
-        do the right thing.
-   */
-  enum fastuidraw::return_code return_value;
+  GlyphDataPrivate *q;
 
-  if(m_uploaded_to_atlas)
+  q = fetch_or_allocate_glyph(font, glyph_code, render);
+  q->m_last_used_frame = m_current_frame;
+  if(q->m_pending != NULL && q->m_pending != b)
     {
-      return fastuidraw::routine_success;
+      /* the glyph is still being generated for a
+         previous batch, make this batch wait on
+         that batch too.
+       */
+      if(b->m_waits_on.empty() || b->m_waits_on.back() != q->m_pending->m_p)
+        {
+          b->m_waits_on.push_back(q->m_pending->m_p);
+        }
     }
-
-  assert(m_glyph_data);
-  return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
-                                               m_atlas_location[0],
-                                               m_atlas_location[1],
-                                               m_geometry_offset,
-                                               m_geometry_length);
-  if(return_value == fastuidraw::routine_success)
+  else if(!q->m_render.valid())
     {
-      m_uploaded_to_atlas = true;
-    }
+      GlyphJob job;
 
-  return return_value;
-}
+      if(!m_generator)
+        {
+          m_generator = FASTUIDRAWnew GlyphGenerator();
+        }
 
+      q->m_render = render;
+      q->m_pending = b;
+      q->m_generated = false;
+      assert(!q->m_glyph_data);
 
+      job.m_batch = b;
+      job.m_glyph = q;
+      job.m_font = font;
+      job.m_disk_cache = m_disk_cache;
+      job.m_glyph_code = glyph_code;
+
+      b->m_generator = m_generator;
+      b->m_generating.push_back(q);
+      b->m_mutex.lock();
+      ++b->m_remaining;
+      b->m_mutex.unlock();
+      m_generator->add_job(job);
+    }
+  return q;
+}
 
-/////////////////////////////////////////////////
-// GlyphCachePrivate methods
+void
 GlyphCachePrivate::
-GlyphCachePrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> patlas,
-                  fastuidraw::GlyphCache *p):
-  m_atlas(patlas),
-  m_p(p)
-{}
+wait_glyph(GlyphDataPrivate *G)
+{
+  if(G->m_pending)
+    {
+      G->m_pending->wait_glyph(G);
+      G->m_pending = NULL;
+    }
+}
 
+void
 GlyphCachePrivate::
-~GlyphCachePrivate()
+wait_batches(void)
 {
-  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
+  for(std::list<BatchEntry>::iterator iter = m_batches.begin(),
+        end = m_batches.end(); iter != end; ++iter)
     {
-      m_glyphs[i]->clear();
-      FASTUIDRAWdelete(m_glyphs[i]);
+      BatchPrivate *b(iter->second);
+
+      b->wait();
+      b->release_glyphs();
     }
+  m_batches.clear();
 }
 
-
-GlyphDataPrivate*
+bool
 GlyphCachePrivate::
-fetch_or_allocate_glyph(GlyphSource src)
+evict_least_recently_used(void)
 {
-  std::map<GlyphSource, GlyphDataPrivate*>::iterator iter;
-  GlyphDataPrivate *G;
+  unsigned int oldest(m_current_frame);
 
-  iter = m_glyph_map.find(src);
-  if(iter != m_glyph_map.end())
+  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
     {
-      return iter->second;
+      GlyphDataPrivate *G(m_glyphs[i]);
+      if(G->m_uploaded_to_atlas && G->m_last_used_frame < oldest)
+        {
+          oldest = G->m_last_used_frame;
+        }
     }
 
+  if(oldest == m_current_frame)
+    {
+      return false;
+    }
 
-  if(m_free_slots.empty())
+  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
     {
-      G = FASTUIDRAWnew GlyphDataPrivate(this, m_glyphs.size());
-      m_glyphs.push_back(G);
-      assert(!G->m_render.valid());
+      GlyphDataPrivate *G(m_glyphs[i]);
+      if(G->m_uploaded_to_atlas && G->m_last_used_frame == oldest)
+        {
+          G->remove_from_atlas();
+          ++m_number_evicted;
+        }
     }
-  else
+  return true;
+}
+
+void
+GlyphCachePrivate::
+release_ready_batches(void)
+{
+  while(!m_batches.empty() && m_batches.front().second->ready())
     {
-      unsigned int v(m_free_slots.back());
-      m_free_slots.pop_back();
-      G = m_glyphs[v];
-      assert(!G->m_render.valid());
+      m_batches.front().second->release_glyphs();
+      m_batches.pop_front();
     }
-  m_glyph_map[src] = G;
-  return G;
 }
 
 ///////////////////////////////////////////////////////
@@ -326,6 +1274,16 @@ geometry_offset(void) const
   return p->m_geometry_offset;
 }
 
+unsigned int
+fastuidraw::Glyph::
+upload_generation(void) const
+{
+  GlyphDataPrivate *p;
+  p = reinterpret_cast<GlyphDataPrivate*>(m_opaque);
+  assert(p != NULL && p->m_render.valid());
+  return p->m_upload_generation;
+}
+
 enum fastuidraw::return_code
 fastuidraw::Glyph::
 upload_to_atlas(void) const
@@ -347,6 +1305,70 @@ path(void) const
 }
 
 
+//////////////////////////////////////////////////////////
+// fastuidraw::GlyphCache::Batch methods
+fastuidraw::GlyphCache::Batch::
+Batch(void)
+{
+  m_d = FASTUIDRAWnew BatchPrivate(this);
+}
+
+fastuidraw::GlyphCache::Batch::
+~Batch()
+{
+  BatchPrivate *d;
+  d = reinterpret_cast<BatchPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+bool
+fastuidraw::GlyphCache::Batch::
+ready(void) const
+{
+  BatchPrivate *d;
+  d = reinterpret_cast<BatchPrivate*>(m_d);
+  return d->ready();
+}
+
+void
+fastuidraw::GlyphCache::Batch::
+wait(void) const
+{
+  BatchPrivate *d;
+  d = reinterpret_cast<BatchPrivate*>(m_d);
+  d->wait();
+}
+
+fastuidraw::const_c_array<fastuidraw::Glyph>
+fastuidraw::GlyphCache::Batch::
+glyphs(void) const
+{
+  BatchPrivate *d;
+  d = reinterpret_cast<BatchPrivate*>(m_d);
+  d->wait();
+  return make_c_array(d->m_glyphs);
+}
+
+unsigned int
+fastuidraw::GlyphCache::Batch::
+upload_to_atlas(void) const
+{
+  BatchPrivate *d;
+  unsigned int return_value(0);
+
+  d = reinterpret_cast<BatchPrivate*>(m_d);
+  d->wait();
+  for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
+    {
+      if(d->m_glyphs[i].valid() && d->m_glyphs[i].upload_to_atlas() == routine_success)
+        {
+          ++return_value;
+        }
+    }
+  return return_value;
+}
+
 //////////////////////////////////////////////////////////
 // fastuidraw::GlyphCache methods
 fastuidraw::GlyphCache::
@@ -380,21 +1402,198 @@ fetch_glyph(GlyphRender render,
   d = reinterpret_cast<GlyphCachePrivate*>(m_d);
 
   GlyphDataPrivate *q;
-  GlyphSource src(font, glyph_code, render);
 
-  q = d->fetch_or_allocate_glyph(src);
+  q = d->fetch_glyph(font, glyph_code, render);
+  ++q->m_hit_count;
 
-  if(!q->m_render.valid())
+  return Glyph(q);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache::Batch>
+fastuidraw::GlyphCache::
+fetch_glyphs_async(GlyphRender render,
+                   const_c_array<reference_counted_ptr<const FontBase> > fonts,
+                   const_c_array<uint32_t> glyph_codes)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+
+  reference_counted_ptr<Batch> return_value;
+  BatchPrivate *b;
+
+  assert(fonts.size() == 1 || fonts.size() == glyph_codes.size());
+  d->release_ready_batches();
+
+  return_value = FASTUIDRAWnew Batch();
+  b = reinterpret_cast<BatchPrivate*>(return_value->m_d);
+  b->m_glyphs.resize(glyph_codes.size());
+
+  for(unsigned int i = 0, endi = glyph_codes.size(); i < endi; ++i)
+    {
+      const reference_counted_ptr<const FontBase> &font(fonts[fonts.size() == 1 ? 0 : i]);
+      GlyphDataPrivate *q;
+
+      if(!font || !font->can_create_rendering_data(render.m_type))
+        {
+          continue;
+        }
+
+      q = d->fetch_glyph_async(b, font, glyph_codes[i], render);
+      ++q->m_hit_count;
+      b->m_glyphs[i] = Glyph(q);
+    }
+
+  d->m_batches.push_back(BatchEntry(return_value, b));
+  return return_value;
+}
+
+void
+fastuidraw::GlyphCache::
+record_usage(GlyphUsageProfile &profile) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+
+  for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
+    {
+      GlyphDataPrivate *G(d->m_glyphs[i]);
+
+      if(G->m_render.valid() && G->m_hit_count > 0)
+        {
+          /* the layout of a glyph is written by a
+             worker thread while the glyph is generated.
+           */
+          d->wait_glyph(G);
+          profile.add_glyph(G->m_layout.m_font->persistent_key(),
+                            G->m_layout.m_glyph_code,
+                            G->m_render, G->m_hit_count);
+        }
+    }
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+prewarm(const GlyphUsageProfile &profile,
+        const_c_array<reference_counted_ptr<const FontBase> > fonts,
+        unsigned int max_glyphs)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+
+  const_c_array<GlyphUsageProfile::Entry> entries(profile.entries());
+  FontsByKey fonts_by_key;
+  unsigned int return_value(0);
+
+  make_fonts_by_key(fonts, fonts_by_key);
+  for(unsigned int i = 0, endi = entries.size(); i < endi && return_value < max_glyphs; ++i)
+    {
+      FontsByKey::const_iterator iter;
+      GlyphDataPrivate *q;
+
+      iter = fonts_by_key.find(entries[i].m_font_key);
+      if(iter == fonts_by_key.end()
+         || !entries[i].m_render.valid()
+         || !iter->second->can_create_rendering_data(entries[i].m_render.m_type))
+        {
+          continue;
+        }
+
+      q = d->fetch_glyph(iter->second, entries[i].m_glyph_code, entries[i].m_render);
+      if(q->upload_to_atlas() != routine_success)
+        {
+          break;
+        }
+      ++return_value;
+    }
+  return return_value;
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache::Batch>
+fastuidraw::GlyphCache::
+prewarm_async(const GlyphUsageProfile &profile,
+              const_c_array<reference_counted_ptr<const FontBase> > fonts,
+              unsigned int max_glyphs)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+
+  const_c_array<GlyphUsageProfile::Entry> entries(profile.entries());
+  reference_counted_ptr<Batch> return_value;
+  FontsByKey fonts_by_key;
+  BatchPrivate *b;
+
+  d->release_ready_batches();
+  make_fonts_by_key(fonts, fonts_by_key);
+
+  return_value = FASTUIDRAWnew Batch();
+  b = reinterpret_cast<BatchPrivate*>(return_value->m_d);
+
+  for(unsigned int i = 0, endi = entries.size(); i < endi && b->m_glyphs.size() < max_glyphs; ++i)
+    {
+      FontsByKey::const_iterator iter;
+      GlyphDataPrivate *q;
+
+      iter = fonts_by_key.find(entries[i].m_font_key);
+      if(iter == fonts_by_key.end()
+         || !entries[i].m_render.valid()
+         || !iter->second->can_create_rendering_data(entries[i].m_render.m_type))
+        {
+          continue;
+        }
+
+      q = d->fetch_glyph_async(b, iter->second, entries[i].m_glyph_code, entries[i].m_render);
+      b->m_glyphs.push_back(Glyph(q));
+    }
+
+  d->m_batches.push_back(BatchEntry(return_value, b));
+  return return_value;
+}
+
+fastuidraw::Glyph
+fastuidraw::GlyphCache::
+add_uploaded_glyph(GlyphRender render,
+                   const GlyphLayoutData &layout, const Path &path,
+                   GlyphLocation atlas_location,
+                   GlyphLocation secondary_atlas_location,
+                   int geometry_offset, int geometry_length)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+
+  GlyphDataPrivate *q;
+
+  assert(layout.m_font);
+  assert(atlas_location.valid());
+  q = d->fetch_or_allocate_glyph(layout.m_font, layout.m_glyph_code, render);
+  q->m_last_used_frame = d->m_current_frame;
+
+  if(q->m_render.valid())
+    {
+      d->m_atlas->deallocate(atlas_location);
+      if(secondary_atlas_location.valid())
+        {
+          d->m_atlas->deallocate(secondary_atlas_location);
+        }
+      d->m_atlas->deallocate_geometry_data(geometry_offset, geometry_length);
+      d->wait_glyph(q);
+    }
+  else
     {
-      q->m_render = render;
       assert(!q->m_glyph_data);
-      q->m_glyph_data = font->compute_rendering_data(q->m_render, glyph_code, q->m_layout, q->m_path);
+      q->m_render = render;
+      q->m_layout = layout;
+      q->m_path = path;
+      q->m_atlas_location[0] = atlas_location;
+      q->m_atlas_location[1] = secondary_atlas_location;
+      q->m_geometry_offset = geometry_offset;
+      q->m_geometry_length = geometry_length;
+      q->m_uploaded_to_atlas = true;
+      q->m_upload_generation = ++d->m_number_uploads;
     }
 
   return Glyph(q);
 }
 
-
 void
 fastuidraw::GlyphCache::
 delete_glyph(Glyph G)
@@ -408,8 +1607,9 @@ delete_glyph(Glyph G)
   assert(p->m_cache == d);
   assert(p->m_render.valid());
 
-  GlyphSource src(p->m_layout.m_font, p->m_layout.m_glyph_code, p->m_render);
-  d->m_glyph_map.erase(src);
+  d->wait_glyph(p);
+
+  d->remove_glyph_from_map(p);
   p->clear();
   d->m_free_slots.push_back(p->m_cache_location);
 }
@@ -425,6 +1625,7 @@ clear_atlas(void)
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
       d->m_glyphs[i]->m_uploaded_to_atlas = false;
+      d->m_glyphs[i]->m_upload_generation = 0;
       d->m_glyphs[i]->m_atlas_location[0] = fastuidraw::GlyphLocation();
       d->m_glyphs[i]->m_atlas_location[1] = fastuidraw::GlyphLocation();
       d->m_glyphs[i]->m_geometry_offset = -1;
@@ -432,6 +1633,59 @@ clear_atlas(void)
     }
 }
 
+const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&
+fastuidraw::GlyphCache::
+atlas(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_atlas;
+}
+
+void
+fastuidraw::GlyphCache::
+disk_cache(const reference_counted_ptr<GlyphDiskCache> &v)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  d->m_disk_cache = v;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache>&
+fastuidraw::GlyphCache::
+disk_cache(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_disk_cache;
+}
+
+void
+fastuidraw::GlyphCache::
+advance_frame(void)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  ++d->m_current_frame;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+current_frame(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_current_frame;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+number_evicted_glyphs(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_number_evicted;
+}
 
 void
 fastuidraw::GlyphCache::
@@ -440,9 +1694,13 @@ clear_cache(void)
   GlyphCachePrivate *d;
   d = reinterpret_cast<GlyphCachePrivate*>(m_d);
 
-  d->m_atlas->clear();
-  d->m_glyph_map.clear();
+  d->wait_batches();
+  d->clear_glyph_map();
 
+  /* release the glyphs before clearing the atlas, otherwise
+     GlyphDataPrivate::clear() returns locations to an atlas
+     that no longer has them allocated.
+   */
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
       GlyphDataPrivate *p;
@@ -453,4 +1711,5 @@ clear_cache(void)
           d->m_free_slots.push_back(p->m_cache_location);
         }
     }
+  d->m_atlas->clear();
 }
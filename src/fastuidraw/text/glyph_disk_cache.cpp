@@ -0,0 +1,699 @@
+/*!
+ * \file glyph_disk_cache.cpp
+ * \brief file glyph_disk_cache.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <map>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fastuidraw/text/glyph_disk_cache.hpp>
+#include <fastuidraw/text/glyph_render_data_coverage.hpp>
+#include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+#include <fastuidraw/text/glyph_render_data_curve_pair.hpp>
+#include "../private/util_private.hpp"
+#include "private/glyph_serialize.hpp"
+
+/* File format, all values are in the byte order of the machine:
+    - FileHeader
+    - FileHeader::m_number_entries FileEntry values, sorted by key
+    - the data of the glyphs, the data of each glyph starts at a
+      multiple of 8 bytes. The data of a glyph is:
+       - the GlyphLayoutData (except the glyph code and font)
+       - the Path as a sequence of contours, each contour
+         given by its number of points, if the contour is
+         ended, the points and for each edge of the contour
+         the control points of the edge
+       - the GlyphRenderData; the fields of the GlyphRenderData
+         in the order of the accessors of the type.
+ */
+
+namespace
+{
+  enum
+    {
+      file_version = 1,
+      file_data_alignment = 8
+    };
+
+  const char file_magic[8] = { 'F', 'U', 'I', 'G', 'L', 'Y', 'P', 'H' };
+  const uint32_t file_byte_order_mark = 0x01020304u;
+
+  /* counter to make the names of the temporary
+     files of save() unique within a process.
+   */
+  boost::atomic<unsigned int> temporary_file_counter(0);
+
+  /* Create a new file in the directory of filename whose
+     name no other process or GlyphDiskCache uses; the name
+     is made from filename, the process id and a counter and
+     the file is created with O_EXCL so that a name in use
+     (for example left by a process that died) is skipped.
+   */
+  bool
+  create_temporary_file(const std::string &filename, std::string &tmp_filename)
+  {
+    const unsigned int max_attempts = 64;
+
+    for(unsigned int attempt = 0; attempt < max_attempts; ++attempt)
+      {
+        std::ostringstream str;
+        int fd;
+
+        str << filename << ".tmp." << getpid() << "." << temporary_file_counter.fetch_add(1);
+        tmp_filename = str.str();
+        fd = open(tmp_filename.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+        if(fd != -1)
+          {
+            close(fd);
+            return true;
+          }
+
+        if(errno != EEXIST)
+          {
+            return false;
+          }
+      }
+    return false;
+  }
+
+  class FileHeader
+  {
+  public:
+    char m_magic[8];
+    uint32_t m_byte_order_mark;
+    uint32_t m_version;
+    uint64_t m_number_entries;
+  };
+
+  class FileEntry
+  {
+  public:
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    uint32_t m_type;
+    int32_t m_pixel_size;
+    uint32_t m_reserved;
+    uint64_t m_offset;
+    uint64_t m_size;
+  };
+
+  /* Key of a glyph in a GlyphDiskCache; the pixel size
+     is ignored for scalable glyph types, consistent with
+     GlyphRender::operator==().
+   */
+  class DiskGlyphKey
+  {
+  public:
+    DiskGlyphKey(uint64_t font_key, uint32_t glyph_code,
+                 fastuidraw::GlyphRender render):
+      m_font_key(font_key),
+      m_glyph_code(glyph_code),
+      m_type(render.m_type),
+      m_pixel_size(fastuidraw::GlyphRender::scalable(render.m_type) ?
+                   0 : render.m_pixel_size)
+    {}
+
+    explicit
+    DiskGlyphKey(const FileEntry &entry):
+      m_font_key(entry.m_font_key),
+      m_glyph_code(entry.m_glyph_code),
+      m_type(entry.m_type),
+      m_pixel_size(entry.m_pixel_size)
+    {}
+
+    bool
+    operator<(const DiskGlyphKey &rhs) const
+    {
+      if(m_font_key != rhs.m_font_key)
+        {
+          return m_font_key < rhs.m_font_key;
+        }
+      if(m_glyph_code != rhs.m_glyph_code)
+        {
+          return m_glyph_code < rhs.m_glyph_code;
+        }
+      if(m_type != rhs.m_type)
+        {
+          return m_type < rhs.m_type;
+        }
+      return m_pixel_size < rhs.m_pixel_size;
+    }
+
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    uint32_t m_type;
+    int32_t m_pixel_size;
+  };
+
+  void
+  write_curve(fastuidraw::detail::Writer &dst, const fastuidraw::GlyphRenderDataCurvePair::per_curve &c)
+  {
+    dst.write(c.m_m0);
+    dst.write(c.m_m1);
+    dst.write(c.m_q);
+    dst.write(c.m_quad_coeff);
+  }
+
+  void
+  read_curve(fastuidraw::detail::Reader &src, fastuidraw::GlyphRenderDataCurvePair::per_curve &c)
+  {
+    c.m_m0 = src.read<float>();
+    c.m_m1 = src.read<float>();
+    c.m_q = src.read_vec2();
+    c.m_quad_coeff = src.read<float>();
+  }
+
+  bool
+  write_render_data(fastuidraw::detail::Writer &dst, enum fastuidraw::glyph_type tp,
+                    const fastuidraw::GlyphRenderData *data)
+  {
+    switch(tp)
+      {
+      case fastuidraw::coverage_glyph:
+        {
+          const fastuidraw::GlyphRenderDataCoverage *p;
+          p = dynamic_cast<const fastuidraw::GlyphRenderDataCoverage*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write(p->resolution());
+          dst.write_bytes(p->coverage_values().c_ptr(), p->coverage_values().size());
+        }
+        return true;
+
+      case fastuidraw::distance_field_glyph:
+        {
+          const fastuidraw::GlyphRenderDataDistanceField *p;
+          p = dynamic_cast<const fastuidraw::GlyphRenderDataDistanceField*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write(p->resolution());
+          dst.write_bytes(p->distance_values().c_ptr(), p->distance_values().size());
+        }
+        return true;
+
+      case fastuidraw::curve_pair_glyph:
+        {
+          const fastuidraw::GlyphRenderDataCurvePair *p;
+          fastuidraw::const_c_array<fastuidraw::GlyphRenderDataCurvePair::entry> geometry;
+
+          p = dynamic_cast<const fastuidraw::GlyphRenderDataCurvePair*>(data);
+          if(!p)
+            {
+              return false;
+            }
+
+          dst.write(p->resolution());
+          dst.write_bytes(p->active_curve_pair().c_ptr(),
+                          p->active_curve_pair().size() * sizeof(uint16_t));
+
+          geometry = p->geometry_data();
+          dst.write<uint32_t>(geometry.size());
+          for(unsigned int i = 0; i < geometry.size(); ++i)
+            {
+              dst.write(geometry[i].m_p);
+              write_curve(dst, geometry[i].m_curve0);
+              write_curve(dst, geometry[i].m_curve1);
+              dst.write<uint32_t>(geometry[i].m_use_min ? 1 : 0);
+              dst.write(geometry[i].m_zeta);
+              dst.write<uint32_t>(geometry[i].m_type);
+            }
+        }
+        return true;
+
+      default:
+        return false;
+      }
+  }
+
+  /* returns NULL if the data is not valid
+   */
+  fastuidraw::GlyphRenderData*
+  read_render_data(fastuidraw::detail::Reader &src, enum fastuidraw::glyph_type tp)
+  {
+    fastuidraw::ivec2 res;
+    unsigned int num_texels;
+
+    res = src.read_ivec2();
+    if(res.x() < 0 || res.y() < 0 || !src.can_read(uint64_t(res.x()) * uint64_t(res.y()), 1))
+      {
+        return NULL;
+      }
+    num_texels = res.x() * res.y();
+
+    switch(tp)
+      {
+      case fastuidraw::coverage_glyph:
+        {
+          fastuidraw::GlyphRenderDataCoverage *p;
+          p = FASTUIDRAWnew fastuidraw::GlyphRenderDataCoverage();
+          p->resize(res);
+          std::memcpy(p->coverage_values().c_ptr(), src.read_bytes(num_texels), num_texels);
+          return p;
+        }
+
+      case fastuidraw::distance_field_glyph:
+        {
+          fastuidraw::GlyphRenderDataDistanceField *p;
+          p = FASTUIDRAWnew fastuidraw::GlyphRenderDataDistanceField();
+          p->resize(res);
+          std::memcpy(p->distance_values().c_ptr(), src.read_bytes(num_texels), num_texels);
+          return p;
+        }
+
+      case fastuidraw::curve_pair_glyph:
+        {
+          fastuidraw::GlyphRenderDataCurvePair *p;
+          const uint8_t *texels;
+          uint32_t num_entries;
+
+          texels = src.read_bytes(num_texels * sizeof(uint16_t));
+          num_entries = src.read<uint32_t>();
+          /* each entry is 15 values of 4 bytes
+           */
+          if(!texels || !src.can_read(num_entries, 15 * sizeof(uint32_t)))
+            {
+              return NULL;
+            }
+
+          p = FASTUIDRAWnew fastuidraw::GlyphRenderDataCurvePair();
+          p->resize_active_curve_pair(res);
+          std::memcpy(p->active_curve_pair().c_ptr(), texels, num_texels * sizeof(uint16_t));
+
+          p->resize_geometry_data(num_entries);
+          for(uint32_t i = 0; i < num_entries; ++i)
+            {
+              fastuidraw::GlyphRenderDataCurvePair::entry &e(p->geometry_data()[i]);
+              e.m_p = src.read_vec2();
+              read_curve(src, e.m_curve0);
+              read_curve(src, e.m_curve1);
+              e.m_use_min = (src.read<uint32_t>() != 0);
+              e.m_zeta = src.read<float>();
+              e.m_type = static_cast<enum fastuidraw::GlyphRenderDataCurvePair::entry_type>(src.read<uint32_t>());
+            }
+          return p;
+        }
+
+      default:
+        return NULL;
+      }
+  }
+
+  class GlyphDiskCachePrivate
+  {
+  public:
+    explicit
+    GlyphDiskCachePrivate(const char *filename);
+
+    /* map the file and read its table of glyphs, if the
+       file is not valid, the table is left empty.
+     */
+    void
+    map_file(void);
+
+    void
+    unmap_file(void);
+
+    std::string m_filename;
+    boost::mutex m_mutex;
+
+    boost::interprocess::mapped_region m_region;
+    std::map<DiskGlyphKey, fastuidraw::const_c_array<uint8_t> > m_in_file;
+    std::map<DiskGlyphKey, std::vector<uint8_t> > m_added;
+
+    unsigned int m_hits, m_misses;
+  };
+}
+
+////////////////////////////////////////
+// GlyphDiskCachePrivate methods
+GlyphDiskCachePrivate::
+GlyphDiskCachePrivate(const char *filename):
+  m_filename(filename),
+  m_hits(0),
+  m_misses(0)
+{
+  map_file();
+}
+
+void
+GlyphDiskCachePrivate::
+map_file(void)
+{
+  fastuidraw::const_c_array<uint8_t> bytes;
+  const FileHeader *header;
+  const FileEntry *entries;
+
+  /* boost::interprocess reports failures, for example that the
+     file does not exist, with exceptions; an unreadable file
+     is the same as an empty cache.
+   */
+  try
+    {
+      boost::interprocess::file_mapping file(m_filename.c_str(), boost::interprocess::read_only);
+      boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+      m_region.swap(region);
+    }
+  catch(const boost::interprocess::interprocess_exception&)
+    {
+      return;
+    }
+
+  bytes = fastuidraw::const_c_array<uint8_t>(static_cast<const uint8_t*>(m_region.get_address()),
+                                             m_region.get_size());
+  if(bytes.size() < sizeof(FileHeader))
+    {
+      unmap_file();
+      return;
+    }
+
+  header = reinterpret_cast<const FileHeader*>(bytes.c_ptr());
+  if(std::memcmp(header->m_magic, file_magic, sizeof(file_magic)) != 0
+     || header->m_byte_order_mark != file_byte_order_mark
+     || header->m_version != file_version
+     || header->m_number_entries > (bytes.size() - sizeof(FileHeader)) / sizeof(FileEntry))
+    {
+      unmap_file();
+      return;
+    }
+
+  entries = reinterpret_cast<const FileEntry*>(bytes.c_ptr() + sizeof(FileHeader));
+  for(uint64_t i = 0; i < header->m_number_entries; ++i)
+    {
+      const FileEntry &e(entries[i]);
+      if(e.m_offset <= bytes.size() && e.m_size <= bytes.size() - e.m_offset)
+        {
+          m_in_file[DiskGlyphKey(e)] = bytes.sub_array(e.m_offset, e.m_size);
+        }
+    }
+}
+
+void
+GlyphDiskCachePrivate::
+unmap_file(void)
+{
+  boost::interprocess::mapped_region empty;
+  m_region.swap(empty);
+  m_in_file.clear();
+}
+
+//////////////////////////////////////////
+// fastuidraw::GlyphDiskCache methods
+fastuidraw::GlyphDiskCache::
+GlyphDiskCache(const char *filename)
+{
+  m_d = FASTUIDRAWnew GlyphDiskCachePrivate(filename);
+}
+
+fastuidraw::GlyphDiskCache::
+~GlyphDiskCache()
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+const char*
+fastuidraw::GlyphDiskCache::
+filename(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+  return d->m_filename.c_str();
+}
+
+unsigned int
+fastuidraw::GlyphDiskCache::
+number_glyphs_in_file(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_in_file.size();
+}
+
+unsigned int
+fastuidraw::GlyphDiskCache::
+number_glyphs_added(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_added.size();
+}
+
+unsigned int
+fastuidraw::GlyphDiskCache::
+number_hits(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_hits;
+}
+
+unsigned int
+fastuidraw::GlyphDiskCache::
+number_misses(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_misses;
+}
+
+fastuidraw::GlyphRenderData*
+fastuidraw::GlyphDiskCache::
+fetch_glyph(GlyphRender render,
+            const reference_counted_ptr<const FontBase> &font,
+            uint32_t glyph_code,
+            GlyphLayoutData &layout, Path &path)
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  uint64_t font_key;
+  font_key = font ? font->persistent_key() : 0;
+  if(font_key == 0)
+    {
+      return NULL;
+    }
+
+  DiskGlyphKey key(font_key, glyph_code, render);
+  const_c_array<uint8_t> bytes;
+  std::map<DiskGlyphKey, std::vector<uint8_t> >::const_iterator added_iter;
+  std::map<DiskGlyphKey, const_c_array<uint8_t> >::const_iterator file_iter;
+
+  autolock_mutex m(d->m_mutex);
+  added_iter = d->m_added.find(key);
+  if(added_iter != d->m_added.end())
+    {
+      bytes = make_c_array(added_iter->second);
+    }
+  else
+    {
+      file_iter = d->m_in_file.find(key);
+      if(file_iter != d->m_in_file.end())
+        {
+          bytes = file_iter->second;
+        }
+    }
+
+  if(bytes.empty())
+    {
+      ++d->m_misses;
+      return NULL;
+    }
+
+  detail::Reader src(bytes);
+  GlyphRenderData *return_value;
+  GlyphLayoutData read_layout_value;
+  Path read_path_value;
+
+  detail::read_layout(src, read_layout_value);
+  detail::read_path(src, read_path_value);
+  return_value = src.ok() ?
+    read_render_data(src, render.m_type) :
+    NULL;
+
+  if(return_value && (!src.ok() || !src.at_end()))
+    {
+      FASTUIDRAWdelete(return_value);
+      return_value = NULL;
+    }
+
+  if(!return_value)
+    {
+      ++d->m_misses;
+      return NULL;
+    }
+
+  ++d->m_hits;
+  read_layout_value.m_glyph_code = glyph_code;
+  read_layout_value.m_font = font;
+  layout = read_layout_value;
+  path.swap(read_path_value);
+  return return_value;
+}
+
+enum fastuidraw::return_code
+fastuidraw::GlyphDiskCache::
+store_glyph(GlyphRender render,
+            const reference_counted_ptr<const FontBase> &font,
+            uint32_t glyph_code,
+            const GlyphLayoutData &layout, const Path &path,
+            const GlyphRenderData *data)
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  uint64_t font_key;
+  font_key = font ? font->persistent_key() : 0;
+  if(font_key == 0 || data == NULL)
+    {
+      return routine_fail;
+    }
+
+  std::vector<uint8_t> bytes;
+  detail::Writer dst(bytes);
+
+  detail::write_layout(dst, layout);
+  if(!detail::write_path(dst, path) || !write_render_data(dst, render.m_type, data))
+    {
+      return routine_fail;
+    }
+
+  autolock_mutex m(d->m_mutex);
+  d->m_added[DiskGlyphKey(font_key, glyph_code, render)].swap(bytes);
+  return routine_success;
+}
+
+enum fastuidraw::return_code
+fastuidraw::GlyphDiskCache::
+save(void)
+{
+  GlyphDiskCachePrivate *d;
+  d = reinterpret_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  if(d->m_added.empty())
+    {
+      return routine_success;
+    }
+
+  /* merge the glyphs of the file with the added glyphs,
+     the added glyphs replacing those of the file.
+   */
+  std::map<DiskGlyphKey, const_c_array<uint8_t> > glyphs(d->m_in_file);
+  for(std::map<DiskGlyphKey, std::vector<uint8_t> >::const_iterator
+        iter = d->m_added.begin(), end = d->m_added.end(); iter != end; ++iter)
+    {
+      glyphs[iter->first] = make_c_array(iter->second);
+    }
+
+  FileHeader header;
+  std::vector<FileEntry> entries;
+  uint64_t offset;
+
+  std::memcpy(header.m_magic, file_magic, sizeof(file_magic));
+  header.m_byte_order_mark = file_byte_order_mark;
+  header.m_version = file_version;
+  header.m_number_entries = glyphs.size();
+
+  offset = sizeof(FileHeader) + sizeof(FileEntry) * glyphs.size();
+  for(std::map<DiskGlyphKey, const_c_array<uint8_t> >::const_iterator
+        iter = glyphs.begin(), end = glyphs.end(); iter != end; ++iter)
+    {
+      FileEntry e;
+
+      offset = file_data_alignment * ((offset + file_data_alignment - 1) / file_data_alignment);
+      e.m_font_key = iter->first.m_font_key;
+      e.m_glyph_code = iter->first.m_glyph_code;
+      e.m_type = iter->first.m_type;
+      e.m_pixel_size = iter->first.m_pixel_size;
+      e.m_reserved = 0;
+      e.m_offset = offset;
+      e.m_size = iter->second.size();
+      entries.push_back(e);
+      offset += e.m_size;
+    }
+
+  std::string tmp_filename;
+  if(!create_temporary_file(d->m_filename, tmp_filename))
+    {
+      return routine_fail;
+    }
+
+  std::ofstream file(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+  uint64_t written;
+  const char padding[file_data_alignment] = { 0 };
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(&entries[0]), sizeof(FileEntry) * entries.size());
+  written = sizeof(FileHeader) + sizeof(FileEntry) * entries.size();
+
+  unsigned int i(0);
+  for(std::map<DiskGlyphKey, const_c_array<uint8_t> >::const_iterator
+        iter = glyphs.begin(), end = glyphs.end(); iter != end; ++iter, ++i)
+    {
+      file.write(padding, entries[i].m_offset - written);
+      file.write(reinterpret_cast<const char*>(iter->second.c_ptr()), iter->second.size());
+      written = entries[i].m_offset + entries[i].m_size;
+    }
+  file.close();
+
+  if(!file)
+    {
+      std::remove(tmp_filename.c_str());
+      return routine_fail;
+    }
+
+  /* the glyphs of the file are no longer needed, the
+     file is replaced and mapped again.
+   */
+  d->unmap_file();
+  if(std::rename(tmp_filename.c_str(), d->m_filename.c_str()) != 0)
+    {
+      std::remove(tmp_filename.c_str());
+      d->map_file();
+      return routine_fail;
+    }
+
+  d->m_added.clear();
+  d->map_file();
+  return routine_success;
+}
@@ -0,0 +1,347 @@
+/*!
+ * \file glyph_usage_profile.cpp
+ * \brief file glyph_usage_profile.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <map>
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include <fastuidraw/text/glyph_usage_profile.hpp>
+#include "../private/util_private.hpp"
+#include "private/glyph_serialize.hpp"
+
+/* File format, all values are in the byte order of the machine:
+    - FileHeader
+    - FileHeader::m_number_entries FileEntry values, sorted
+      by decreasing hit count
+ */
+
+namespace
+{
+  enum
+    {
+      file_version = 1
+    };
+
+  const char file_magic[8] = { 'F', 'U', 'I', 'U', 'S', 'A', 'G', 'E' };
+  const uint32_t file_byte_order_mark = 0x01020304u;
+
+  class FileHeader
+  {
+  public:
+    char m_magic[8];
+    uint32_t m_byte_order_mark;
+    uint32_t m_version;
+    uint64_t m_number_entries;
+  };
+
+  class FileEntry
+  {
+  public:
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    uint32_t m_type;
+    int32_t m_pixel_size;
+    uint32_t m_hit_count;
+  };
+
+  /* Key of a glyph in a GlyphUsageProfile; the pixel size
+     is 0 for scalable glyph types, consistent with
+     GlyphRender::operator==().
+   */
+  class UsageKey
+  {
+  public:
+    UsageKey(uint64_t font_key, uint32_t glyph_code,
+             fastuidraw::GlyphRender render):
+      m_font_key(font_key),
+      m_glyph_code(glyph_code),
+      m_render(render)
+    {
+      if(fastuidraw::GlyphRender::scalable(m_render.m_type))
+        {
+          m_render.m_pixel_size = 0;
+        }
+    }
+
+    bool
+    operator<(const UsageKey &rhs) const
+    {
+      if(m_font_key != rhs.m_font_key)
+        {
+          return m_font_key < rhs.m_font_key;
+        }
+      if(m_glyph_code != rhs.m_glyph_code)
+        {
+          return m_glyph_code < rhs.m_glyph_code;
+        }
+      return m_render < rhs.m_render;
+    }
+
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    fastuidraw::GlyphRender m_render;
+  };
+
+  bool
+  compare_hit_count(const fastuidraw::GlyphUsageProfile::Entry &lhs,
+                    const fastuidraw::GlyphUsageProfile::Entry &rhs)
+  {
+    return lhs.m_hit_count > rhs.m_hit_count;
+  }
+
+  class GlyphUsageProfilePrivate
+  {
+  public:
+    GlyphUsageProfilePrivate(void):
+      m_entries_dirty(false)
+    {}
+
+    void
+    add_glyph(uint64_t font_key, uint32_t glyph_code,
+              fastuidraw::GlyphRender render, uint32_t hit_count);
+
+    /* rebuild m_entries from m_hits if m_entries_dirty
+     */
+    void
+    ready_entries(void);
+
+    std::map<UsageKey, uint32_t> m_hits;
+    std::vector<fastuidraw::GlyphUsageProfile::Entry> m_entries;
+    bool m_entries_dirty;
+  };
+}
+
+////////////////////////////////////////////
+// GlyphUsageProfilePrivate methods
+void
+GlyphUsageProfilePrivate::
+add_glyph(uint64_t font_key, uint32_t glyph_code,
+          fastuidraw::GlyphRender render, uint32_t hit_count)
+{
+  if(font_key == 0 || !render.valid() || hit_count == 0)
+    {
+      return;
+    }
+
+  uint32_t &v(m_hits[UsageKey(font_key, glyph_code, render)]);
+  v = std::min(v, std::numeric_limits<uint32_t>::max() - hit_count) + hit_count;
+  m_entries_dirty = true;
+}
+
+void
+GlyphUsageProfilePrivate::
+ready_entries(void)
+{
+  if(!m_entries_dirty)
+    {
+      return;
+    }
+
+  m_entries.clear();
+  m_entries.reserve(m_hits.size());
+  for(std::map<UsageKey, uint32_t>::const_iterator iter = m_hits.begin(),
+        end = m_hits.end(); iter != end; ++iter)
+    {
+      fastuidraw::GlyphUsageProfile::Entry E;
+
+      E.m_font_key = iter->first.m_font_key;
+      E.m_glyph_code = iter->first.m_glyph_code;
+      E.m_render = iter->first.m_render;
+      E.m_hit_count = iter->second;
+      m_entries.push_back(E);
+    }
+
+  /* stable so that glyphs with the same hit count
+     are ordered by font, glyph code and GlyphRender.
+   */
+  std::stable_sort(m_entries.begin(), m_entries.end(), compare_hit_count);
+  m_entries_dirty = false;
+}
+
+//////////////////////////////////////////////
+// fastuidraw::GlyphUsageProfile methods
+fastuidraw::GlyphUsageProfile::
+GlyphUsageProfile(void)
+{
+  m_d = FASTUIDRAWnew GlyphUsageProfilePrivate();
+}
+
+fastuidraw::GlyphUsageProfile::
+~GlyphUsageProfile()
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphUsageProfile>
+fastuidraw::GlyphUsageProfile::
+load(const char *filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<uint8_t> bytes;
+  reference_counted_ptr<GlyphUsageProfile> return_value;
+  GlyphUsageProfilePrivate *d;
+  FileHeader header;
+
+  if(!file)
+    {
+      return return_value;
+    }
+
+  bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  detail::Reader src(make_c_array(bytes));
+  header = src.read<FileHeader>();
+  if(!src.ok()
+     || std::memcmp(header.m_magic, file_magic, sizeof(file_magic)) != 0
+     || header.m_byte_order_mark != file_byte_order_mark
+     || header.m_version != file_version
+     || header.m_number_entries != (bytes.size() - sizeof(FileHeader)) / sizeof(FileEntry))
+    {
+      return return_value;
+    }
+
+  return_value = FASTUIDRAWnew GlyphUsageProfile();
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(return_value->m_d);
+  for(uint64_t i = 0; i < header.m_number_entries; ++i)
+    {
+      FileEntry entry;
+      GlyphRender render;
+
+      entry = src.read<FileEntry>();
+      if(!src.ok() || entry.m_type > curve_pair_glyph)
+        {
+          return reference_counted_ptr<GlyphUsageProfile>();
+        }
+
+      render.m_type = static_cast<enum glyph_type>(entry.m_type);
+      render.m_pixel_size = entry.m_pixel_size;
+      d->add_glyph(entry.m_font_key, entry.m_glyph_code, render, entry.m_hit_count);
+    }
+
+  return return_value;
+}
+
+enum fastuidraw::return_code
+fastuidraw::GlyphUsageProfile::
+save(const char *filename) const
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+
+  std::vector<uint8_t> bytes;
+  std::ofstream file(filename, std::ios::binary);
+  FileHeader header;
+
+  if(!file)
+    {
+      return routine_fail;
+    }
+
+  d->ready_entries();
+  std::memcpy(header.m_magic, file_magic, sizeof(file_magic));
+  header.m_byte_order_mark = file_byte_order_mark;
+  header.m_version = file_version;
+  header.m_number_entries = d->m_entries.size();
+
+  detail::Writer dst(bytes);
+  dst.write(header);
+  for(unsigned int i = 0, endi = d->m_entries.size(); i < endi; ++i)
+    {
+      const Entry &E(d->m_entries[i]);
+      FileEntry entry;
+
+      entry.m_font_key = E.m_font_key;
+      entry.m_glyph_code = E.m_glyph_code;
+      entry.m_type = E.m_render.m_type;
+      entry.m_pixel_size = E.m_render.m_pixel_size;
+      entry.m_hit_count = E.m_hit_count;
+      dst.write(entry);
+    }
+
+  file.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+  return file ?
+    routine_success :
+    routine_fail;
+}
+
+void
+fastuidraw::GlyphUsageProfile::
+add_glyph(uint64_t font_key, uint32_t glyph_code,
+          GlyphRender render, uint32_t hit_count)
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  d->add_glyph(font_key, glyph_code, render, hit_count);
+}
+
+void
+fastuidraw::GlyphUsageProfile::
+merge(const GlyphUsageProfile &obj)
+{
+  GlyphUsageProfilePrivate *d, *obj_d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  obj_d = reinterpret_cast<GlyphUsageProfilePrivate*>(obj.m_d);
+
+  /* adding to a glyph already present does not insert into
+     m_hits, so merging a GlyphUsageProfile with itself is safe.
+   */
+  for(std::map<UsageKey, uint32_t>::const_iterator iter = obj_d->m_hits.begin(),
+        end = obj_d->m_hits.end(); iter != end; ++iter)
+    {
+      d->add_glyph(iter->first.m_font_key, iter->first.m_glyph_code,
+                   iter->first.m_render, iter->second);
+    }
+}
+
+fastuidraw::const_c_array<fastuidraw::GlyphUsageProfile::Entry>
+fastuidraw::GlyphUsageProfile::
+entries(void) const
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  d->ready_entries();
+  return make_c_array(d->m_entries);
+}
+
+unsigned int
+fastuidraw::GlyphUsageProfile::
+number_entries(void) const
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  return d->m_hits.size();
+}
+
+void
+fastuidraw::GlyphUsageProfile::
+clear(void)
+{
+  GlyphUsageProfilePrivate *d;
+  d = reinterpret_cast<GlyphUsageProfilePrivate*>(m_d);
+  d->m_hits.clear();
+  d->m_entries.clear();
+  d->m_entries_dirty = false;
+}
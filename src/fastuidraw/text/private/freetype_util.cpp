@@ -178,43 +178,6 @@ namespace
       }
   }
 
-  class polynomial_solution_solve
-  {
-  public:
-    /*!\fn polynomial_solution_solve& t
-      Sets \ref m_t
-      \param v value to use
-     */
-    polynomial_solution_solve&
-    t(float v)
-    {
-      m_t=v;
-      return *this;
-    }
-
-    /*!\fn polynomial_solution_solve& multiplicity
-      Sets \ref m_multiplicity
-      \param v value to use
-     */
-    polynomial_solution_solve&
-    multiplicity(int v)
-    {
-      m_multiplicity=v;
-      return *this;
-    }
-
-    /*!\var m_t
-      The solution point
-     */
-    float m_t;
-
-    /*!\var m_multiplicity
-      Absolute value gives the multiplicity of the solution.
-      Negative values indicate that the solution is outside
-      of the interval [0,1].
-     */
-    int m_multiplicity;
-  };
 
   void
   add_solution_if_should(float t,
@@ -1211,10 +1174,23 @@ namespace detail
                             enum coordinate_type tp,
                             std::vector<solution_point> &out_pts,
                             bool compute_derivatives) const
+  {
+    std::vector<polynomial_solution_solve> ts;
+    compute_line_intersection(in_pt, tp, out_pts, compute_derivatives, ts);
+  }
+
+  void
+  BezierCurve::
+  compute_line_intersection(int in_pt,
+                            enum coordinate_type tp,
+                            std::vector<solution_point> &out_pts,
+                            bool compute_derivatives,
+                            std::vector<polynomial_solution_solve> &ts) const
   {
     int sz;
     vecN<int, 4> work_array;
-    std::vector<polynomial_solution_solve> ts;
+
+    ts.clear();
 
 
 
@@ -1383,41 +1359,30 @@ namespace detail
 
   vec2
   BezierCurve::
-  compute_pt_at_t_worker(float t, const_c_array<ivec2> p0, const_c_array<ivec2> p1)
+  compute_pt_at_t_worker(float t, const_c_array<ivec2> pts)
   {
     //basic idea:
     // B(p0,p1,....., pN, t) = (1-t)*B(p0,p1,...,pN-1, t) + t*B(p1,p2,...,pN, t)
     // this algorthm is more numerially stable than multiplying out
-    // a polynomial, but is is *cough* O(2^N), but considering we have
-    // only N=1,2 or 3 it does not matter. We can refine this so
-    // it is O(N^3) but for now, I don't want to bother or care..
-    vec2 q0, q1;
+    // a polynomial. The recursion is unrolled as de Casteljau's
+    // algorithm, combining the values in the same order as the
+    // recursion does, so the result is the same.
+    vecN<vec2, 4> q;
 
-    assert(p0.size()>0);
-    if(p0.size()==1)
-      {
-        q0=vec2(p0[0].x(), p0[0].y());
-      }
-    else
+    assert(pts.size()>0 and pts.size()<=4);
+    for(unsigned int i=0, end_i=pts.size(); i<end_i; ++i)
       {
-        q0=compute_pt_at_t_worker(t,
-                                  const_c_array<ivec2>(p0.c_ptr(), p0.size()-1),
-                                  const_c_array<ivec2>(p0.c_ptr()+1, p0.size()-1));
+        q[i]=vec2(pts[i].x(), pts[i].y());
       }
 
-    assert(p1.size()>0);
-    if(p1.size()==1)
+    for(unsigned int level=pts.size()-1; level>0; --level)
       {
-        q1=vec2(p1[0].x(), p1[0].y());
-      }
-    else
-      {
-        q1=compute_pt_at_t_worker(t,
-                                  const_c_array<ivec2>(p1.c_ptr(), p1.size()-1),
-                                  const_c_array<ivec2>(p1.c_ptr()+1, p1.size()-1));
+        for(unsigned int i=0; i<level; ++i)
+          {
+            q[i]=q[i]*(1.0f-t) + q[i+1]*t;
+          }
       }
-    return q0*(1.0f-t) + q1*t;
-
+    return q[0];
   }
 
   void
@@ -2103,7 +2068,8 @@ namespace detail
   void
   OutlineData::
   compute_distance_values(boost::multi_array<distance_return_type, 2> &victim,
-                          float max_dist_value, bool compute_winding_number) const
+                          float max_dist_value, bool compute_winding_number,
+                          unsigned int max_threads) const
   {
     int radius;
 
@@ -2112,7 +2078,7 @@ namespace detail
     init_distance_values(victim, max_dist_value);
     compute_outline_point_values(victim, radius);
     compute_zero_derivative_values(victim, radius);
-    compute_fixed_line_values(victim, compute_winding_number);
+    compute_fixed_line_values(victim, compute_winding_number, max_threads);
   }
 
   void
@@ -2221,21 +2187,75 @@ namespace detail
   void
   OutlineData::
   compute_fixed_line_values(boost::multi_array<distance_return_type, 2> &victim,
-                            bool compute_winding_number) const
+                            bool compute_winding_number,
+                            unsigned int max_threads) const
   {
-    std::vector< std::vector<solution_point> > work_room;
+    std::vector<fixed_line_work_room> work_rooms;
 
     //note we only use the x_fixed computation to compute the winding numbers!
-    compute_fixed_line_values(x_fixed, victim, work_room, compute_winding_number);
-    compute_fixed_line_values(y_fixed, victim, work_room, false);
+    compute_fixed_line_values(x_fixed, victim, compute_winding_number, max_threads, work_rooms);
+    compute_fixed_line_values(y_fixed, victim, false, max_threads, work_rooms);
   }
 
   void
   OutlineData::
   compute_fixed_line_values(enum coordinate_type coord_tp,
                             boost::multi_array<distance_return_type, 2> &victim,
-                            std::vector< std::vector<solution_point> > &work_room,
-                            bool compute_winding_number) const
+                            bool compute_winding_number,
+                            unsigned int max_threads,
+                            std::vector<fixed_line_work_room> &work_rooms) const
+  {
+    /* A fixed line only modifies the texels on that line,
+       so the lines are split into bands, each band processed
+       by its own thread. The values written to a texel do not
+       depend on how the lines are split into bands, thus the
+       output is the same regardless of the number of threads.
+     */
+    const int min_lines_per_band(16);
+    int number_lines(bitmap_size()[coord_tp]);
+    int number_bands;
+
+    number_bands=std::max(1, std::min(static_cast<int>(max_threads), number_lines/min_lines_per_band));
+    work_rooms.resize(std::max(work_rooms.size(), static_cast<size_t>(number_bands)));
+    if(number_bands==1)
+      {
+        compute_fixed_line_values(coord_tp, 0, number_lines, victim,
+                                  compute_winding_number, work_rooms[0]);
+        return;
+      }
+
+    /* the bands are handed to the calling thread and to the
+       threads of the shared worker_pool, so no threads are
+       made per pass.
+     */
+    fixed_line_job job(this, coord_tp, number_lines, number_bands, victim,
+                       compute_winding_number, work_rooms);
+    worker_pool::shared().run(&job, number_bands-1);
+  }
+
+  void
+  OutlineData::fixed_line_job::
+  run(void)
+  {
+    int b;
+
+    while((b=m_next_band.fetch_add(1)) < m_number_bands)
+      {
+        m_outline->compute_fixed_line_values(m_coord_tp,
+                                             (b*m_number_lines)/m_number_bands,
+                                             ((b+1)*m_number_lines)/m_number_bands,
+                                             m_victim, m_compute_winding_number,
+                                             m_work_rooms[b]);
+      }
+  }
+
+  void
+  OutlineData::
+  compute_fixed_line_values(enum coordinate_type coord_tp,
+                            int begin_line, int end_line,
+                            boost::multi_array<distance_return_type, 2> &victim,
+                            bool compute_winding_number,
+                            fixed_line_work_room &work) const
   {
     const enum inside_outside_test_results::sol_type sol[2][2]=
       {
@@ -2245,11 +2265,13 @@ namespace detail
 
     int coord(coord_tp);
     enum coordinate_type other_coord_tp;
+    std::vector< std::vector<solution_point> > &work_room(work.m_solutions);
 
-    work_room.resize(std::max(static_cast<int>(work_room.size()),
-                              bitmap_size()[coord]) );
-
-    for(int i=0;i<bitmap_size()[coord];++i)
+    /* clear() keeps the capacity of the vectors, so that the
+       intersections of the next pass do not allocate again
+     */
+    work_room.resize(std::max(static_cast<int>(work_room.size()), end_line-begin_line));
+    for(int i=0; i<end_line-begin_line; ++i)
       {
         work_room[i].clear();
       }
@@ -2261,15 +2283,16 @@ namespace detail
         start_pt=bitmap_coord_from_point(bezier_curve(i)->min_corner()[coord], coord_tp);
         end_pt=bitmap_coord_from_point(bezier_curve(i)->max_corner()[coord], coord_tp);
 
-        for(int c=std::max(0, start_pt-1),
-              end_c=std::min(bitmap_size()[coord], end_pt+2);
+        for(int c=std::max(begin_line, start_pt-1),
+              end_c=std::min(end_line, end_pt+2);
             c<end_c; ++c)
           {
             int ip;
             ip=point_from_bitmap_coord(c, coord_tp);
 
-            bezier_curve(i)->compute_line_intersection(ip, coord_tp, work_room[c],
-                                                       compute_winding_number);
+            bezier_curve(i)->compute_line_intersection(ip, coord_tp, work_room[c-begin_line],
+                                                       compute_winding_number,
+                                                       work.m_solve);
           }
 
       }
@@ -2277,38 +2300,36 @@ namespace detail
 
     other_coord_tp=static_cast<enum coordinate_type>(1-coord);
 
-    for(int c=0, end_c=bitmap_size()[coord]; c<end_c; ++c)
+    /* the texel centers along a line are an arithmetic progression
+       in the coordinates of the curves and the texels of a line
+       are evenly spaced in victim.
+     */
+    int first_p(point_from_bitmap_coord(0, other_coord_tp));
+    int delta_p(point_from_bitmap_coord(1, other_coord_tp) - first_p);
+    std::ptrdiff_t line_stride(victim.strides()[coord]), texel_stride(victim.strides()[1-coord]);
+
+    for(int c=begin_line; c<end_line; ++c)
       {
-        int ip;
-        std::vector<solution_point> &L(work_room[c]);
+        std::vector<solution_point> &L(work_room[c-begin_line]);
         int total_count(0);
 
-        ip=point_from_bitmap_coord(c, coord_tp);
         std::sort(L.begin(), L.end());
 
-        (void)ip;
-
         for(int i=0, end_i=L.size(); i<end_i; ++i)
           {
             assert(L[i].m_multiplicity>0);
             total_count+=std::max(0, L[i].m_multiplicity);
           }
 
+        distance_return_type *texel_ptr(victim.data() + c*line_stride);
         for(int other_c=0, end_other_c=bitmap_size()[1-coord],
-              sz=L.size(), current_count=0, current_index=0;
-            other_c<end_other_c; ++other_c)
+              sz=L.size(), current_count=0, current_index=0, ip=first_p;
+            other_c<end_other_c; ++other_c, ip+=delta_p, texel_ptr+=texel_stride)
           {
             float p;
-            ivec2 pixel;
-            int prev_index, prev_count;
 
-            pixel[coord]=c;
-            pixel[1-coord]=other_c;
-
-            p=static_cast<float>( point_from_bitmap_coord(other_c, other_coord_tp) );
-            prev_index=current_index;
-            prev_count=current_count;
-            (void)prev_count;
+            p=static_cast<float>(ip);
+            assert(ip==point_from_bitmap_coord(other_c, other_coord_tp));
 
             while(current_index<sz
                   and L[current_index].m_value<=p)
@@ -2317,36 +2338,30 @@ namespace detail
                 ++current_index;
               }
 
+            distance_return_type &texel(*texel_ptr);
 
-
-
-            for(int cindex=std::max(0, prev_index-1),
-                  last_index=std::min(sz, current_index+2);
-                cindex<last_index; ++cindex)
+            /* L is sorted, so the closest intersections to p are
+               the last one not after p and the first one after p.
+             */
+            if(current_index>0)
               {
-
-                float dc;
-
-                dc= std::abs(p-L[cindex].m_value);
-                dc*=distance_scale_factor();
-                victim[pixel.x()][pixel.y()].m_distance.update_value(dc);
-
+                texel.m_distance.update_value((p-L[current_index-1].m_value)*distance_scale_factor());
               }
 
+            if(current_index<sz)
+              {
+                texel.m_distance.update_value((L[current_index].m_value-p)*distance_scale_factor());
+              }
 
-            victim[pixel.x()][pixel.y()].
-              m_solution_count.increment(sol[coord][0], current_count);
-
-            victim[pixel.x()][pixel.y()].
-              m_solution_count.increment(sol[coord][1], total_count - current_count);
+            texel.m_solution_count.increment(sol[coord][0], current_count);
+            texel.m_solution_count.increment(sol[coord][1], total_count - current_count);
           }
 
 
 
         if(compute_winding_number)
           {
-
-            std::vector<int> cts;
+            std::vector<int> &cts(work.m_winding_counts);
 
             increment_sub_winding_numbers(L, coord_tp, cts);
 
@@ -2416,7 +2431,7 @@ namespace detail
     enum coordinate_type other_coord_tp;
 
     other_coord_tp=static_cast<enum coordinate_type>(1-coord);
-    cts.resize(bitmap_size()[1-coord]+1, 0);
+    cts.assign(bitmap_size()[1-coord]+1, 0);
 
     for(int i=0, sz=L.size(); i<sz; ++i)
       {
@@ -35,6 +35,8 @@
 #include <unistd.h>
 #include <boost/signals2.hpp>
 #include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
 #include <boost/multi_array.hpp>
 #include <boost/tuple/tuple.hpp>
 
@@ -46,6 +48,7 @@
 #include <fastuidraw/path.hpp>
 
 #include "../../private/util_private.hpp"
+#include "../../private/worker_pool.hpp"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -392,6 +395,50 @@ namespace detail
 
   class BezierCurve;
 
+  /*!\class polynomial_solution_solve
+    A polynomial_solution_solve holds a root
+    of a polynomial as found by the polynomial
+    solvers.
+   */
+  class polynomial_solution_solve
+  {
+  public:
+    /*!\fn polynomial_solution_solve& t
+      Sets \ref m_t
+      \param v value to use
+     */
+    polynomial_solution_solve&
+    t(float v)
+    {
+      m_t=v;
+      return *this;
+    }
+
+    /*!\fn polynomial_solution_solve& multiplicity
+      Sets \ref m_multiplicity
+      \param v value to use
+     */
+    polynomial_solution_solve&
+    multiplicity(int v)
+    {
+      m_multiplicity=v;
+      return *this;
+    }
+
+    /*!\var m_t
+      The solution point
+     */
+    float m_t;
+
+    /*!\var m_multiplicity
+      Absolute value gives the multiplicity of the solution.
+      Negative values indicate that the solution is outside
+      of the interval [0,1].
+     */
+    int m_multiplicity;
+  };
+
+
   /*!\class solution_point
     A solution_point stores a solution to a polynomial
     together with a multiplicity.
@@ -1388,6 +1435,30 @@ namespace detail
                               std::vector<solution_point> &out_pts,
                               bool compute_derivatives) const;
 
+    /*!\fn void compute_line_intersection(int, enum coordinate_type,
+                                          std::vector<solution_point>&, bool,
+                                          std::vector<polynomial_solution_solve>&) const
+      Same as compute_line_intersection(int, enum coordinate_type,
+      std::vector<solution_point>&, bool) const, but using
+      a caller provided work room for solving the polynomial
+      to avoid an allocation per call.
+      \param in_pt coordinate of line
+      \param tp type of file, x_fixed indicates
+                a vertical line and y_fixed indicates
+                a horizontal line.
+      \param out_pts record of intersection to add to if
+                     an intersecion is found.
+      \param compute_derivatives if true, compute the value of
+                                 the derivatives at the intersecion
+                                 points
+      \param work_room work room for the polynomial solver
+     */
+    void
+    compute_line_intersection(int in_pt, enum coordinate_type tp,
+                              std::vector<solution_point> &out_pts,
+                              bool compute_derivatives,
+                              std::vector<polynomial_solution_solve> &work_room) const;
+
     /*!\fn void print_info
       Print data (in a human readable format)
       of this BezierCurve to an std::ostream.
@@ -1405,9 +1476,7 @@ namespace detail
     vec2
     compute_pt_at_t(float t) const
     {
-      return compute_pt_at_t_worker(t,
-                                    const_c_array<ivec2>(&m_raw_curve[0], m_raw_curve.size()-1),
-                                    const_c_array<ivec2>(&m_raw_curve[1], m_raw_curve.size()-1));
+      return compute_pt_at_t_worker(t, const_c_array<ivec2>(&m_raw_curve[0], m_raw_curve.size()));
     }
 
     /*!\fn vec2 compute_deriv_at_t
@@ -1498,7 +1567,7 @@ namespace detail
 
     static
     vec2
-    compute_pt_at_t_worker(float t, const_c_array<ivec2> p0, const_c_array<ivec2> p1);
+    compute_pt_at_t_worker(float t, const_c_array<ivec2> pts);
 
     void
     compute_maximal_minimal_points(void);
@@ -2309,11 +2378,14 @@ namespace detail
       \param max_dist The recorded distance is saturated to max_dist
       \param compute_winding_number if true, compute the winding number
                                     as well for each texel.
+      \param max_threads maximum number of threads to use; the output
+                         does not depend on the number of threads.
      */
     void
     compute_distance_values(boost::multi_array<distance_return_type, 2> &victim,
                             float max_dist,
-                            bool compute_winding_number) const;
+                            bool compute_winding_number,
+                            unsigned int max_threads = 1) const;
 
     /*!\fn void compute_winding_numbers
       Compute the winding numbers, if you are calling already
@@ -2521,13 +2593,69 @@ namespace detail
 
     void
     compute_fixed_line_values(boost::multi_array<distance_return_type, 2> &victim,
-                              bool compute_winding_number) const;
+                              bool compute_winding_number,
+                              unsigned int max_threads) const;
+
+    /* work room of compute_fixed_line_values() for
+       one band of lines.
+     */
+    class fixed_line_work_room
+    {
+    public:
+      std::vector< std::vector<solution_point> > m_solutions;
+      std::vector<polynomial_solution_solve> m_solve;
+      std::vector<int> m_winding_counts;
+    };
+
+    void
+    compute_fixed_line_values(enum coordinate_type coord_tp,
+                              boost::multi_array<distance_return_type, 2> &victim,
+                              bool compute_winding_number,
+                              unsigned int max_threads,
+                              std::vector<fixed_line_work_room> &work_rooms) const;
 
     void
     compute_fixed_line_values(enum coordinate_type coord_tp,
+                              int begin_line, int end_line,
                               boost::multi_array<distance_return_type, 2> &victim,
-                              std::vector< std::vector<solution_point> > &work_room,
-                              bool compute_winding_number) const;
+                              bool compute_winding_number,
+                              fixed_line_work_room &work_room) const;
+
+    /* job run on the worker_pool to process the bands
+       of lines of one pass of compute_fixed_line_values();
+       band b is processed with work room b.
+     */
+    class fixed_line_job:public worker_pool::job
+    {
+    public:
+      fixed_line_job(const OutlineData *outline, enum coordinate_type coord_tp,
+                     int number_lines, int number_bands,
+                     boost::multi_array<distance_return_type, 2> &victim,
+                     bool compute_winding_number,
+                     std::vector<fixed_line_work_room> &work_rooms):
+        m_outline(outline),
+        m_coord_tp(coord_tp),
+        m_number_lines(number_lines),
+        m_number_bands(number_bands),
+        m_victim(victim),
+        m_compute_winding_number(compute_winding_number),
+        m_work_rooms(work_rooms),
+        m_next_band(0)
+      {}
+
+      virtual
+      void
+      run(void);
+
+    private:
+      const OutlineData *m_outline;
+      enum coordinate_type m_coord_tp;
+      int m_number_lines, m_number_bands;
+      boost::multi_array<distance_return_type, 2> &m_victim;
+      bool m_compute_winding_number;
+      std::vector<fixed_line_work_room> &m_work_rooms;
+      boost::atomic<int> m_next_band;
+    };
 
     void
     compute_outline_point_values(boost::multi_array<distance_return_type, 2> &victim,
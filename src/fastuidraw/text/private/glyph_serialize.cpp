@@ -0,0 +1,178 @@
+/*!
+ * \file glyph_serialize.cpp
+ * \brief file glyph_serialize.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include "glyph_serialize.hpp"
+
+namespace
+{
+  bool
+  write_edge(fastuidraw::detail::Writer &dst,
+             const fastuidraw::reference_counted_ptr<const fastuidraw::PathContour::interpolator_base> &h)
+  {
+    const fastuidraw::PathContour::bezier *b;
+
+    if(dynamic_cast<const fastuidraw::PathContour::flat*>(h.get()))
+      {
+        dst.write<uint32_t>(0);
+        return true;
+      }
+
+    b = dynamic_cast<const fastuidraw::PathContour::bezier*>(h.get());
+    if(b)
+      {
+        fastuidraw::const_c_array<fastuidraw::vec2> pts(b->control_pts());
+        dst.write<uint32_t>(pts.size());
+        for(unsigned int i = 0; i < pts.size(); ++i)
+          {
+            dst.write(pts[i]);
+          }
+        return true;
+      }
+
+    /* arcs and custom interpolators are not supported
+     */
+    return false;
+  }
+
+  void
+  read_edge_control_points(fastuidraw::detail::Reader &src, fastuidraw::Path &path)
+  {
+    uint32_t num_control_pts;
+
+    num_control_pts = src.read<uint32_t>();
+    if(src.can_read(num_control_pts, 2 * sizeof(float)))
+      {
+        for(uint32_t i = 0; i < num_control_pts; ++i)
+          {
+            path << fastuidraw::Path::control_point(src.read_vec2());
+          }
+      }
+  }
+}
+
+////////////////////////////////////////////
+// fastuidraw::detail glyph serialization methods
+void
+fastuidraw::detail::
+write_layout(Writer &dst, const fastuidraw::GlyphLayoutData &layout)
+{
+  dst.write(layout.m_horizontal_layout_offset);
+  dst.write(layout.m_vertical_layout_offset);
+  dst.write(layout.m_size);
+  dst.write(layout.m_advance);
+  dst.write<int32_t>(layout.m_pixel_size);
+}
+
+void
+fastuidraw::detail::
+read_layout(Reader &src, fastuidraw::GlyphLayoutData &layout)
+{
+  layout.m_horizontal_layout_offset = src.read_vec2();
+  layout.m_vertical_layout_offset = src.read_vec2();
+  layout.m_size = src.read_vec2();
+  layout.m_advance = src.read_vec2();
+  layout.m_pixel_size = src.read<int32_t>();
+}
+
+bool
+fastuidraw::detail::
+write_path(Writer &dst, const fastuidraw::Path &path)
+{
+  uint32_t num_contours(0);
+
+  /* a contour without points has no edges and nothing to
+     draw; it is not written, since read_path() treats a
+     contour without points as the data being bad.
+   */
+  for(unsigned int c = 0, endc = path.number_contours(); c < endc; ++c)
+    {
+      if(path.contour(c)->number_points() > 0)
+        {
+          ++num_contours;
+        }
+    }
+
+  dst.write<uint32_t>(num_contours);
+  for(unsigned int c = 0, endc = path.number_contours(); c < endc; ++c)
+    {
+      fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(path.contour(c));
+      unsigned int num_pts(contour->number_points());
+      bool ended(contour->ended());
+
+      if(num_pts == 0)
+        {
+          continue;
+        }
+
+      dst.write<uint32_t>(num_pts);
+      dst.write<uint32_t>(ended ? 1 : 0);
+      for(unsigned int i = 0; i < num_pts; ++i)
+        {
+          dst.write(contour->point(i));
+        }
+
+      for(unsigned int i = 0, endi = ended ? num_pts : num_pts - 1; i < endi; ++i)
+        {
+          if(!write_edge(dst, contour->interpolator(i)))
+            {
+              return false;
+            }
+        }
+    }
+  return true;
+}
+
+void
+fastuidraw::detail::
+read_path(Reader &src, fastuidraw::Path &path)
+{
+  uint32_t num_contours;
+  std::vector<fastuidraw::vec2> pts;
+
+  num_contours = src.read<uint32_t>();
+  for(uint32_t c = 0; c < num_contours && src.ok(); ++c)
+    {
+      uint32_t num_pts, ended;
+
+      num_pts = src.read<uint32_t>();
+      ended = src.read<uint32_t>();
+      if(num_pts == 0 || !src.can_read(num_pts, 2 * sizeof(float)))
+        {
+          return;
+        }
+
+      pts.resize(num_pts);
+      for(uint32_t i = 0; i < num_pts; ++i)
+        {
+          pts[i] = src.read_vec2();
+        }
+
+      path.move(pts[0]);
+      for(uint32_t i = 1; i < num_pts && src.ok(); ++i)
+        {
+          read_edge_control_points(src, path);
+          path << pts[i];
+        }
+
+      if(ended && src.ok())
+        {
+          read_edge_control_points(src, path);
+          path << fastuidraw::Path::contour_end();
+        }
+    }
+}
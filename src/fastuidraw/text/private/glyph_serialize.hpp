@@ -0,0 +1,195 @@
+/*!
+ * \file glyph_serialize.hpp
+ * \brief file glyph_serialize.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+
+/* Utilities to write and read glyph data to and from bytes
+   in the byte order of the machine, used by the files of
+   GlyphDiskCache and BakedGlyphAtlas.
+ */
+
+namespace fastuidraw {
+namespace detail {
+
+class Writer
+{
+public:
+  explicit
+  Writer(std::vector<uint8_t> &dst):
+    m_dst(dst)
+  {}
+
+  void
+  write_bytes(const void *bytes, size_t length)
+  {
+    const uint8_t *p;
+    p = reinterpret_cast<const uint8_t*>(bytes);
+    m_dst.insert(m_dst.end(), p, p + length);
+  }
+
+  template<typename T>
+  void
+  write(const T &v)
+  {
+    write_bytes(&v, sizeof(T));
+  }
+
+  void
+  write(const vec2 &v)
+  {
+    write(v.x());
+    write(v.y());
+  }
+
+  void
+  write(const ivec2 &v)
+  {
+    write<int32_t>(v.x());
+    write<int32_t>(v.y());
+  }
+
+private:
+  std::vector<uint8_t> &m_dst;
+};
+
+/* a Reader reads values from a range of bytes; reading
+   past the end of the range marks the Reader as failed
+   (see ok()) and returns zero values.
+ */
+class Reader
+{
+public:
+  explicit
+  Reader(const_c_array<uint8_t> src):
+    m_src(src),
+    m_pos(0),
+    m_ok(true)
+  {}
+
+  bool
+  ok(void) const
+  {
+    return m_ok;
+  }
+
+  bool
+  at_end(void) const
+  {
+    return m_pos == m_src.size();
+  }
+
+  const uint8_t*
+  read_bytes(size_t length)
+  {
+    const uint8_t *return_value;
+    if(!m_ok || length > m_src.size() - m_pos)
+      {
+        m_ok = false;
+        return NULL;
+      }
+    return_value = m_src.c_ptr() + m_pos;
+    m_pos += length;
+    return return_value;
+  }
+
+  template<typename T>
+  T
+  read(void)
+  {
+    T return_value = T();
+    const uint8_t *p;
+
+    p = read_bytes(sizeof(T));
+    if(p)
+      {
+        std::memcpy(&return_value, p, sizeof(T));
+      }
+    return return_value;
+  }
+
+  vec2
+  read_vec2(void)
+  {
+    vec2 return_value;
+    return_value.x() = read<float>();
+    return_value.y() = read<float>();
+    return return_value;
+  }
+
+  ivec2
+  read_ivec2(void)
+  {
+    ivec2 return_value;
+    return_value.x() = read<int32_t>();
+    return_value.y() = read<int32_t>();
+    return return_value;
+  }
+
+  /* returns true if count elements of size element_size
+     can still be read, used to validate counts read from
+     the file before allocating for them.
+   */
+  bool
+  can_read(uint64_t count, size_t element_size)
+  {
+    if(!m_ok || count > (m_src.size() - m_pos) / element_size)
+      {
+        m_ok = false;
+      }
+    return m_ok;
+  }
+
+private:
+  const_c_array<uint8_t> m_src;
+  size_t m_pos;
+  bool m_ok;
+};
+
+/* write the fields of a GlyphLayoutData except
+   the glyph code and font.
+ */
+void
+write_layout(Writer &dst, const GlyphLayoutData &layout);
+
+void
+read_layout(Reader &src, GlyphLayoutData &layout);
+
+/* write a Path as a sequence of contours, each contour
+   given by its number of points, if the contour is
+   ended, the points and for each edge of the contour
+   the control points of the edge. Returns false if
+   the path has an edge that is neither flat nor a
+   Bezier curve.
+ */
+bool
+write_path(Writer &dst, const Path &path);
+
+void
+read_path(Reader &src, Path &path);
+
+} //namespace detail
+} //namespace fastuidraw
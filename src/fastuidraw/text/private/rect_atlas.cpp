@@ -20,6 +20,7 @@
 #include <algorithm>
 
 #include "rect_atlas.hpp"
+#include "../../private/util_private.hpp"
 
 ////////////////////////////////////////
 // fastuidraw::detail::RectAtlas::tree_sorter methods
@@ -262,6 +263,22 @@ empty(void)
   return m_rectangle == NULL;
 }
 
+int
+fastuidraw::detail::RectAtlas::tree_node_without_children::
+largest_free_area(void) const
+{
+  if(m_rectangle == NULL)
+    {
+      return area();
+    }
+
+  /* a rectangle can only go into one of the two
+     regions that a split of this node makes.
+   */
+  return std::max(size().x() * (size().y() - m_rectangle->size().y()),
+                  (size().x() - m_rectangle->size().x()) * size().y());
+}
+
 ////////////////////////////////////
 // fastuidraw::detail::RectAtlas::tree_node_with_children methods
 fastuidraw::detail::RectAtlas::tree_node_with_children::
@@ -401,6 +418,15 @@ empty(void)
     and m_children[2]->empty();
 }
 
+int
+fastuidraw::detail::RectAtlas::tree_node_with_children::
+largest_free_area(void) const
+{
+  return std::max(m_children[0]->largest_free_area(),
+                  std::max(m_children[1]->largest_free_area(),
+                           m_children[2]->largest_free_area()));
+}
+
 //////////////////////////////////////
 // fastuidraw::detail::RectAtlas::freesize_tracker methods
 bool
@@ -438,10 +464,14 @@ fast_check(ivec2 psize)
 ////////////////////////////////////
 // fastuidraw::detail::RectAtlas methods
 fastuidraw::detail::RectAtlas::
-RectAtlas(const ivec2 &dimensions):
+RectAtlas(const ivec2 &dimensions, RectPacker *packer):
   m_root(NULL),
-  m_empty_rect(this, ivec2(0, 0))
+  m_empty_rect(this, ivec2(0, 0)),
+  m_packer(packer),
+  m_number_rectangles(0),
+  m_allocated_area(0)
 {
+  assert(m_packer == NULL || m_packer->dimensions() == dimensions);
   m_root = FASTUIDRAWnew tree_node_without_children(NULL, &m_tracker, ivec2(0,0), dimensions, NULL);
 }
 
@@ -450,6 +480,23 @@ fastuidraw::detail::RectAtlas::
 {
   assert(m_root != NULL);
   FASTUIDRAWdelete(m_root);
+  delete_packed_rectangles();
+  if(m_packer)
+    {
+      FASTUIDRAWdelete(m_packer);
+    }
+}
+
+void
+fastuidraw::detail::RectAtlas::
+delete_packed_rectangles(void)
+{
+  for(std::set<rectangle*>::iterator iter = m_packed_rectangles.begin(),
+        end = m_packed_rectangles.end(); iter != end; ++iter)
+    {
+      FASTUIDRAWdelete(*iter);
+    }
+  m_packed_rectangles.clear();
 }
 
 fastuidraw::ivec2
@@ -469,9 +516,42 @@ clear(void)
   m_mutex.lock();
   FASTUIDRAWdelete(m_root);
   m_root = FASTUIDRAWnew tree_node_without_children(NULL, &m_tracker, ivec2(0,0), dimensions, NULL);
+  if(m_packer)
+    {
+      delete_packed_rectangles();
+      m_packer->clear();
+    }
+  m_number_rectangles = 0;
+  m_allocated_area = 0;
   m_mutex.unlock();
 }
 
+unsigned int
+fastuidraw::detail::RectAtlas::
+number_rectangles(void) const
+{
+  autolock_mutex m(m_mutex);
+  return m_number_rectangles;
+}
+
+int
+fastuidraw::detail::RectAtlas::
+allocated_area(void) const
+{
+  autolock_mutex m(m_mutex);
+  return m_allocated_area;
+}
+
+int
+fastuidraw::detail::RectAtlas::
+largest_free_area(void) const
+{
+  autolock_mutex m(m_mutex);
+  return (m_packer) ?
+    m_packer->largest_free_area() :
+    m_root->largest_free_area();
+}
+
 const fastuidraw::detail::RectAtlas::rectangle*
 fastuidraw::detail::RectAtlas::
 add_rectangle(const ivec2 &dimensions,
@@ -481,40 +561,56 @@ add_rectangle(const ivec2 &dimensions,
   rectangle *return_value(NULL);
 
   m_mutex.lock();
-  if(m_tracker.fast_check(dimensions))
+  if(dimensions.x() <= 0 or dimensions.y() <= 0)
     {
-      add_remove_return_value R;
-
+      return_value = &m_empty_rect;
+    }
+  else if(m_packer)
+    {
+      ivec2 minX_minY;
 
-      if(dimensions.x() > 0 and dimensions.y() > 0)
+      if(m_packer->allocate(dimensions, minX_minY) == routine_success)
         {
-          //attempt to add the rect:
           return_value = FASTUIDRAWnew rectangle(this, dimensions);
-          R = m_root->add(return_value);
+          set_minX_minY(return_value, minX_minY);
+          m_packed_rectangles.insert(return_value);
+        }
+    }
+  else if(m_tracker.fast_check(dimensions))
+    {
+      add_remove_return_value R;
 
-          if(R.second == routine_success)
-            {
-              if(R.first != m_root)
-                {
-                  FASTUIDRAWdelete(m_root);
-                  m_root = R.first;
-                }
-            }
-          else
+      //attempt to add the rect:
+      return_value = FASTUIDRAWnew rectangle(this, dimensions);
+      R = m_root->add(return_value);
+
+      if(R.second == routine_success)
+        {
+          if(R.first != m_root)
             {
-              FASTUIDRAWdelete(return_value);
-              return_value = NULL;
+              FASTUIDRAWdelete(m_root);
+              m_root = R.first;
             }
         }
       else
         {
-          return_value = &m_empty_rect;
+          FASTUIDRAWdelete(return_value);
+          return_value = NULL;
         }
     }
+
+  if(return_value != NULL and return_value != &m_empty_rect)
+    {
+      ++m_number_rectangles;
+      m_allocated_area += dimensions.x() * dimensions.y();
+    }
   m_mutex.unlock();
 
-  return_value->finalize(left_padding, right_padding,
-                         top_padding, bottom_padding);
+  if(return_value)
+    {
+      return_value->finalize(left_padding, right_padding,
+                             top_padding, bottom_padding);
+    }
   return return_value;
 }
 
@@ -534,12 +630,49 @@ remove_rectangle_implement(const rectangle *im)
     }
   else
     {
+      /* the tree deletes im when removing it */
+      ivec2 im_minX_minY(im->minX_minY()), im_size(im->size());
+
       m_mutex.lock();
-      R = m_root->api_remove(im);
-      if(R.second == routine_success and R.first != m_root)
+      if(m_packer)
+        {
+          std::set<rectangle*>::iterator iter;
+
+          iter = m_packed_rectangles.find(const_cast<rectangle*>(im));
+          assert(iter != m_packed_rectangles.end());
+          m_packed_rectangles.erase(iter);
+          R.second = routine_success;
+        }
+      else
+        {
+          R = m_root->api_remove(im);
+          if(R.second == routine_success and R.first != m_root)
+            {
+              FASTUIDRAWdelete(m_root);
+              m_root = R.first;
+            }
+        }
+
+      if(R.second == routine_success)
         {
-          FASTUIDRAWdelete(m_root);
-          m_root = R.first;
+          assert(m_number_rectangles > 0);
+          --m_number_rectangles;
+          m_allocated_area -= im_size.x() * im_size.y();
+          if(m_packer)
+            {
+              /* once empty, start the packer afresh
+                 so that no fragmentation remains.
+               */
+              if(m_number_rectangles == 0)
+                {
+                  m_packer->clear();
+                }
+              else
+                {
+                  m_packer->free(im_minX_minY, im_size);
+                }
+              FASTUIDRAWdelete(im);
+            }
         }
       m_mutex.unlock();
       return R.second;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <assert.h>
+#include <set>
 
 #include <boost/utility.hpp>
 #include <boost/thread.hpp>
@@ -29,13 +30,18 @@
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/util/c_array.hpp>
 
+#include "rect_packer.hpp"
+
 
 namespace fastuidraw {
 namespace detail {
 
 /*!\class RectAtlas
   Provides an interface to allocate and free rectangle
-  regions from a large rectangle.
+  regions from a large rectangle. By default the regions
+  are placed with a tree that splits the free room of
+  a node each time a rectangle is added to it; the
+  placement can instead be done by a RectPacker.
  */
 class RectAtlas:public fastuidraw::noncopyable
 {
@@ -128,9 +134,12 @@ public:
   /*!\fn
     Ctor
     \param dimensions dimension of the atlas, this is then the return value to size().
+    \param packer if non-NULL, the RectPacker used to place the rectangles
+                  instead of the tree; the RectAtlas takes ownership of it.
+                  The dimensions of the packer must be the same as dimensions.
    */
   explicit
-  RectAtlas(const ivec2 &dimensions);
+  RectAtlas(const ivec2 &dimensions, RectPacker *packer = NULL);
 
   virtual
   ~RectAtlas();
@@ -180,6 +189,27 @@ public:
   enum return_code
   delete_rectangle(const rectangle *im);
 
+  /*!\fn unsigned int number_rectangles
+    Returns the number of rectangles (of positive
+    area) in the RectAtlas.
+   */
+  unsigned int
+  number_rectangles(void) const;
+
+  /*!\fn int allocated_area
+    Returns the sum of the areas of the rectangles
+    in the RectAtlas.
+   */
+  int
+  allocated_area(void) const;
+
+  /*!\fn int largest_free_area
+    Returns the area of the largest rectangle that
+    add_rectangle() can place.
+   */
+  int
+  largest_free_area(void) const;
+
 private:
   /*
     Tree structure to construct the texture atlas,
@@ -274,6 +304,11 @@ private:
     bool
     empty(void)=0;
 
+    /* area of the largest rectangle that add() can place */
+    virtual
+    int
+    largest_free_area(void) const=0;
+
     freesize_tracker*
     tracker(void)
     {
@@ -312,6 +347,10 @@ private:
     bool
     empty(void);
 
+    virtual
+    int
+    largest_free_area(void) const;
+
     rectangle*
     data(void);
 
@@ -353,6 +392,10 @@ private:
     bool
     empty(void);
 
+    virtual
+    int
+    largest_free_area(void) const;
+
   private:
     vecN<tree_base*,3> m_children;
   };
@@ -371,6 +414,9 @@ private:
   enum return_code
   remove_rectangle_implement(const rectangle *im);
 
+  void
+  delete_packed_rectangles(void);
+
   static
   void
   move_rectangle(rectangle *rect, const ivec2 &moveby)
@@ -388,9 +434,18 @@ private:
   }
 
   freesize_tracker m_tracker;
-  boost::mutex m_mutex;
+  mutable boost::mutex m_mutex;
   tree_base *m_root;
   rectangle m_empty_rect;
+
+  /* if non-NULL the rectangles are placed by m_packer
+     and owned by m_packed_rectangles instead of the
+     nodes of the tree.
+   */
+  RectPacker *m_packer;
+  std::set<rectangle*> m_packed_rectangles;
+  unsigned int m_number_rectangles;
+  int m_allocated_area;
 };
 
 } //namespace detail_private
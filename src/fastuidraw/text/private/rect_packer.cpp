@@ -0,0 +1,592 @@
+/*!
+ * \file rect_packer.cpp
+ * \brief file rect_packer.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include <assert.h>
+
+#include "rect_packer.hpp"
+
+namespace
+{
+  typedef fastuidraw::detail::RectPacker::free_rect free_rect;
+
+  /* returns true if a and b overlap or touch along x */
+  bool
+  touch_x(const free_rect &a, const free_rect &b)
+  {
+    return a.m_minX_minY.x() <= b.m_maxX_maxY.x()
+      && b.m_minX_minY.x() <= a.m_maxX_maxY.x();
+  }
+
+  /* returns true if a and b overlap or touch along y */
+  bool
+  touch_y(const free_rect &a, const free_rect &b)
+  {
+    return a.m_minX_minY.y() <= b.m_maxX_maxY.y()
+      && b.m_minX_minY.y() <= a.m_maxX_maxY.y();
+  }
+
+  /* returns true if the y-range of a contains the y-range of b */
+  bool
+  covers_y(const free_rect &a, const free_rect &b)
+  {
+    return a.m_minX_minY.y() <= b.m_minX_minY.y()
+      && a.m_maxX_maxY.y() >= b.m_maxX_maxY.y();
+  }
+
+  /* returns true if the x-range of a contains the x-range of b */
+  bool
+  covers_x(const free_rect &a, const free_rect &b)
+  {
+    return a.m_minX_minY.x() <= b.m_minX_minY.x()
+      && a.m_maxX_maxY.x() >= b.m_maxX_maxY.x();
+  }
+
+  /* the rectangle with the x-range of the union of a and b
+     and the y-range of y_src
+   */
+  free_rect
+  join_x(const free_rect &a, const free_rect &b, const free_rect &y_src)
+  {
+    free_rect R;
+    R.m_minX_minY.x() = std::min(a.m_minX_minY.x(), b.m_minX_minY.x());
+    R.m_maxX_maxY.x() = std::max(a.m_maxX_maxY.x(), b.m_maxX_maxY.x());
+    R.m_minX_minY.y() = y_src.m_minX_minY.y();
+    R.m_maxX_maxY.y() = y_src.m_maxX_maxY.y();
+    return R;
+  }
+
+  /* the rectangle with the y-range of the union of a and b
+     and the x-range of x_src
+   */
+  free_rect
+  join_y(const free_rect &a, const free_rect &b, const free_rect &x_src)
+  {
+    free_rect R;
+    R.m_minX_minY.y() = std::min(a.m_minX_minY.y(), b.m_minX_minY.y());
+    R.m_maxX_maxY.y() = std::max(a.m_maxX_maxY.y(), b.m_maxX_maxY.y());
+    R.m_minX_minY.x() = x_src.m_minX_minY.x();
+    R.m_maxX_maxY.x() = x_src.m_maxX_maxY.x();
+    return R;
+  }
+
+  bool
+  contained_in_any(const free_rect &R, const std::vector<free_rect> &rects)
+  {
+    for(unsigned int i = 0, endi = rects.size(); i < endi; ++i)
+      {
+        if(rects[i].contains(R))
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+}
+
+/////////////////////////////////////////////
+// fastuidraw::detail::MaxRectsPacker methods
+fastuidraw::detail::MaxRectsPacker::
+MaxRectsPacker(const ivec2 &dimensions, bool initially_free):
+  RectPacker(dimensions),
+  m_initially_free(initially_free)
+{
+  clear();
+}
+
+void
+fastuidraw::detail::MaxRectsPacker::
+clear(void)
+{
+  m_free_rects.clear();
+  if(m_initially_free)
+    {
+      m_free_rects.push_back(free_rect(ivec2(0, 0), dimensions()));
+    }
+}
+
+int
+fastuidraw::detail::MaxRectsPacker::
+largest_free_area(void) const
+{
+  int return_value(0);
+  for(unsigned int i = 0, endi = m_free_rects.size(); i < endi; ++i)
+    {
+      return_value = std::max(return_value, m_free_rects[i].area());
+    }
+  return return_value;
+}
+
+enum fastuidraw::return_code
+fastuidraw::detail::MaxRectsPacker::
+allocate(const ivec2 &size, ivec2 &out_minX_minY)
+{
+  int best(-1);
+  int best_short_side(std::numeric_limits<int>::max());
+  int best_long_side(std::numeric_limits<int>::max());
+
+  assert(size.x() > 0 && size.y() > 0);
+  for(unsigned int i = 0, endi = m_free_rects.size(); i < endi; ++i)
+    {
+      const free_rect &F(m_free_rects[i]);
+      int dx, dy, short_side, long_side;
+
+      dx = F.width() - size.x();
+      dy = F.height() - size.y();
+      if(dx < 0 || dy < 0)
+        {
+          continue;
+        }
+
+      short_side = std::min(dx, dy);
+      long_side = std::max(dx, dy);
+      if(short_side < best_short_side
+         || (short_side == best_short_side && long_side < best_long_side))
+        {
+          best = i;
+          best_short_side = short_side;
+          best_long_side = long_side;
+        }
+    }
+
+  if(best == -1)
+    {
+      return routine_fail;
+    }
+
+  out_minX_minY = m_free_rects[best].m_minX_minY;
+  split_free_rects(free_rect(out_minX_minY, size));
+  return routine_success;
+}
+
+void
+fastuidraw::detail::MaxRectsPacker::
+split_free_rects(const free_rect &used)
+{
+  std::vector<free_rect> new_rects;
+
+  for(unsigned int i = 0; i < m_free_rects.size();)
+    {
+      free_rect F(m_free_rects[i]);
+
+      if(!F.intersects(used))
+        {
+          ++i;
+          continue;
+        }
+
+      /* replace F by the (up to 4) maximal pieces
+         of F that are outside of used.
+       */
+      if(used.m_minX_minY.x() > F.m_minX_minY.x())
+        {
+          free_rect R(F);
+          R.m_maxX_maxY.x() = used.m_minX_minY.x();
+          new_rects.push_back(R);
+        }
+
+      if(used.m_maxX_maxY.x() < F.m_maxX_maxY.x())
+        {
+          free_rect R(F);
+          R.m_minX_minY.x() = used.m_maxX_maxY.x();
+          new_rects.push_back(R);
+        }
+
+      if(used.m_minX_minY.y() > F.m_minX_minY.y())
+        {
+          free_rect R(F);
+          R.m_maxX_maxY.y() = used.m_minX_minY.y();
+          new_rects.push_back(R);
+        }
+
+      if(used.m_maxX_maxY.y() < F.m_maxX_maxY.y())
+        {
+          free_rect R(F);
+          R.m_minX_minY.y() = used.m_maxX_maxY.y();
+          new_rects.push_back(R);
+        }
+
+      m_free_rects[i] = m_free_rects.back();
+      m_free_rects.pop_back();
+    }
+
+  add_free_rects(new_rects);
+}
+
+void
+fastuidraw::detail::MaxRectsPacker::
+free(const ivec2 &minX_minY, const ivec2 &size)
+{
+  free_rect R(minX_minY, size);
+  std::vector<free_rect> neighbours, new_rects;
+
+  /* A freed rectangle alone is rarely a maximal free
+     rectangle; grow it (and the free rectangles next
+     to it) across the free rectangles with which it
+     lines up. Only the free rectangles that touch the
+     freed rectangle are used, which keeps the number
+     of rectangles made small. A rectangle contained in
+     one already made is dropped so that the process
+     ends.
+   */
+  for(unsigned int i = 0, endi = m_free_rects.size(); i < endi; ++i)
+    {
+      if(touch_x(m_free_rects[i], R) && touch_y(m_free_rects[i], R))
+        {
+          neighbours.push_back(m_free_rects[i]);
+        }
+    }
+
+  new_rects.push_back(R);
+  for(unsigned int c = 0; c < new_rects.size(); ++c)
+    {
+      for(unsigned int i = 0, endi = neighbours.size(); i < endi; ++i)
+        {
+          const free_rect &F(neighbours[i]);
+          free_rect C(new_rects[c]);
+          vecN<free_rect, 4> candidates;
+          unsigned int num_candidates(0);
+
+          if(touch_x(F, C))
+            {
+              if(covers_y(F, C))
+                {
+                  candidates[num_candidates++] = join_x(F, C, C);
+                }
+              if(covers_y(C, F))
+                {
+                  candidates[num_candidates++] = join_x(F, C, F);
+                }
+            }
+
+          if(touch_y(F, C))
+            {
+              if(covers_x(F, C))
+                {
+                  candidates[num_candidates++] = join_y(F, C, C);
+                }
+              if(covers_x(C, F))
+                {
+                  candidates[num_candidates++] = join_y(F, C, F);
+                }
+            }
+
+          for(unsigned int k = 0; k < num_candidates; ++k)
+            {
+              if(!contained_in_any(candidates[k], new_rects))
+                {
+                  new_rects.push_back(candidates[k]);
+                }
+            }
+        }
+    }
+
+  add_free_rects(new_rects);
+}
+
+void
+fastuidraw::detail::MaxRectsPacker::
+add_free_rects(std::vector<free_rect> &new_rects)
+{
+  std::vector<bool> keep_new(new_rects.size(), true);
+  std::vector<unsigned int> nearby;
+  free_rect bbox;
+
+  if(new_rects.empty())
+    {
+      return;
+    }
+
+  /* only the existing free rectangles that intersect the
+     bounding box of the new rectangles can contain or be
+     contained in a new rectangle.
+   */
+  bbox = new_rects[0];
+  for(unsigned int i = 1, endi = new_rects.size(); i < endi; ++i)
+    {
+      bbox.m_minX_minY.x() = std::min(bbox.m_minX_minY.x(), new_rects[i].m_minX_minY.x());
+      bbox.m_minX_minY.y() = std::min(bbox.m_minX_minY.y(), new_rects[i].m_minX_minY.y());
+      bbox.m_maxX_maxY.x() = std::max(bbox.m_maxX_maxY.x(), new_rects[i].m_maxX_maxY.x());
+      bbox.m_maxX_maxY.y() = std::max(bbox.m_maxX_maxY.y(), new_rects[i].m_maxX_maxY.y());
+    }
+
+  for(unsigned int i = 0, endi = m_free_rects.size(); i < endi; ++i)
+    {
+      if(m_free_rects[i].intersects(bbox))
+        {
+          nearby.push_back(i);
+        }
+    }
+
+  /* drop the new rectangles contained in another new
+     rectangle (of equal rectangles the first is kept)
+     or in an existing free rectangle.
+   */
+  for(unsigned int i = 0, endi = new_rects.size(); i < endi; ++i)
+    {
+      for(unsigned int j = 0; j < endi && keep_new[i]; ++j)
+        {
+          if(j != i && keep_new[j] && new_rects[j].contains(new_rects[i]))
+            {
+              keep_new[i] = false;
+            }
+        }
+
+      for(unsigned int j = 0, endj = nearby.size(); j < endj && keep_new[i]; ++j)
+        {
+          if(m_free_rects[nearby[j]].contains(new_rects[i]))
+            {
+              keep_new[i] = false;
+            }
+        }
+    }
+
+  /* drop the existing free rectangles contained in a
+     new rectangle; walk nearby backwards so that the
+     swap with the last element does not move an
+     element that is yet to be visited.
+   */
+  for(unsigned int n = nearby.size(); n > 0; --n)
+    {
+      unsigned int i(nearby[n - 1]);
+      bool contained(false);
+
+      for(unsigned int j = 0, endj = new_rects.size(); j < endj && !contained; ++j)
+        {
+          contained = keep_new[j] && new_rects[j].contains(m_free_rects[i]);
+        }
+
+      if(contained)
+        {
+          m_free_rects[i] = m_free_rects.back();
+          m_free_rects.pop_back();
+        }
+    }
+
+  for(unsigned int i = 0, endi = new_rects.size(); i < endi; ++i)
+    {
+      if(keep_new[i])
+        {
+          m_free_rects.push_back(new_rects[i]);
+        }
+    }
+}
+
+//////////////////////////////////////////
+// fastuidraw::detail::SkylinePacker methods
+fastuidraw::detail::SkylinePacker::
+SkylinePacker(const ivec2 &dimensions):
+  RectPacker(dimensions),
+  m_waste(dimensions, false)
+{
+  clear();
+}
+
+void
+fastuidraw::detail::SkylinePacker::
+clear(void)
+{
+  m_skyline.clear();
+  m_skyline.push_back(segment(0, 0, dimensions().x()));
+  m_waste.clear();
+}
+
+int
+fastuidraw::detail::SkylinePacker::
+fit(unsigned int segment_index, const ivec2 &size) const
+{
+  int x, y, width_left;
+
+  x = m_skyline[segment_index].m_x;
+  if(x + size.x() > dimensions().x())
+    {
+      return -1;
+    }
+
+  y = 0;
+  width_left = size.x();
+  for(unsigned int i = segment_index; width_left > 0; ++i)
+    {
+      assert(i < m_skyline.size());
+      y = std::max(y, m_skyline[i].m_y);
+      width_left -= m_skyline[i].m_width;
+    }
+
+  return (y + size.y() <= dimensions().y()) ? y : -1;
+}
+
+void
+fastuidraw::detail::SkylinePacker::
+set_height(int x, int w, int y)
+{
+  std::vector<segment> new_skyline;
+
+  new_skyline.reserve(m_skyline.size() + 2);
+  for(unsigned int i = 0, endi = m_skyline.size(); i < endi; ++i)
+    {
+      const segment &S(m_skyline[i]);
+      int s_end(S.m_x + S.m_width);
+
+      /* the part of S before x */
+      if(S.m_x < x)
+        {
+          new_skyline.push_back(segment(S.m_x, S.m_y, std::min(s_end, x) - S.m_x));
+        }
+
+      /* the new segment goes right after
+         the segment that contains x
+       */
+      if(S.m_x <= x && x < s_end)
+        {
+          new_skyline.push_back(segment(x, y, w));
+        }
+
+      /* the part of S after x + w */
+      if(s_end > x + w)
+        {
+          int start(std::max(S.m_x, x + w));
+          new_skyline.push_back(segment(start, S.m_y, s_end - start));
+        }
+    }
+
+  /* merge neighbouring segments of the same height */
+  m_skyline.clear();
+  for(unsigned int i = 0, endi = new_skyline.size(); i < endi; ++i)
+    {
+      if(!m_skyline.empty() && m_skyline.back().m_y == new_skyline[i].m_y)
+        {
+          m_skyline.back().m_width += new_skyline[i].m_width;
+        }
+      else
+        {
+          m_skyline.push_back(new_skyline[i]);
+        }
+    }
+}
+
+enum fastuidraw::return_code
+fastuidraw::detail::SkylinePacker::
+allocate(const ivec2 &size, ivec2 &out_minX_minY)
+{
+  int best(-1), best_y(-1);
+  int best_top(std::numeric_limits<int>::max());
+
+  assert(size.x() > 0 && size.y() > 0);
+  if(m_waste.allocate(size, out_minX_minY) == routine_success)
+    {
+      return routine_success;
+    }
+
+  /* bottom left rule: lowest top, then left most */
+  for(unsigned int i = 0, endi = m_skyline.size(); i < endi; ++i)
+    {
+      int y;
+
+      y = fit(i, size);
+      if(y >= 0 && y + size.y() < best_top)
+        {
+          best = i;
+          best_y = y;
+          best_top = y + size.y();
+        }
+    }
+
+  if(best == -1)
+    {
+      return routine_fail;
+    }
+
+  int x(m_skyline[best].m_x), x_end(x + size.x());
+
+  /* the room between the skyline and the
+     rectangle goes to the waste map.
+   */
+  for(unsigned int i = best, endi = m_skyline.size(); i < endi && m_skyline[i].m_x < x_end; ++i)
+    {
+      const segment &S(m_skyline[i]);
+      if(S.m_y < best_y)
+        {
+          int s_end(std::min(S.m_x + S.m_width, x_end));
+          m_waste.free(ivec2(S.m_x, S.m_y), ivec2(s_end - S.m_x, best_y - S.m_y));
+        }
+    }
+
+  set_height(x, size.x(), best_top);
+  out_minX_minY = ivec2(x, best_y);
+  return routine_success;
+}
+
+void
+fastuidraw::detail::SkylinePacker::
+free(const ivec2 &minX_minY, const ivec2 &size)
+{
+  int x_end(minX_minY.x() + size.x()), top(minX_minY.y() + size.y());
+  bool on_skyline(true);
+
+  for(unsigned int i = 0, endi = m_skyline.size(); i < endi && on_skyline; ++i)
+    {
+      const segment &S(m_skyline[i]);
+      if(S.m_x < x_end && S.m_x + S.m_width > minX_minY.x())
+        {
+          on_skyline = (S.m_y == top);
+        }
+    }
+
+  if(on_skyline)
+    {
+      /* nothing is above the rectangle, so the
+         skyline drops to the bottom of it.
+       */
+      set_height(minX_minY.x(), size.x(), minX_minY.y());
+    }
+  else
+    {
+      m_waste.free(minX_minY, size);
+    }
+}
+
+int
+fastuidraw::detail::SkylinePacker::
+largest_free_area(void) const
+{
+  int return_value(m_waste.largest_free_area());
+
+  /* the largest rectangle above the skyline whose bottom
+     is at the height of a segment spans the neighbouring
+     segments that are no higher.
+   */
+  for(int i = 0, endi = m_skyline.size(); i < endi; ++i)
+    {
+      int y(m_skyline[i].m_y), width(m_skyline[i].m_width);
+
+      for(int j = i - 1; j >= 0 && m_skyline[j].m_y <= y; --j)
+        {
+          width += m_skyline[j].m_width;
+        }
+
+      for(int j = i + 1; j < endi && m_skyline[j].m_y <= y; ++j)
+        {
+          width += m_skyline[j].m_width;
+        }
+
+      return_value = std::max(return_value, width * (dimensions().y() - y));
+    }
+
+  return return_value;
+}
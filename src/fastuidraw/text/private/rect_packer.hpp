@@ -0,0 +1,264 @@
+/*!
+ * \file rect_packer.hpp
+ * \brief file rect_packer.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+
+namespace fastuidraw {
+namespace detail {
+
+/*!\class RectPacker
+  A RectPacker chooses where to place rectangles within
+  a large rectangle. A RectPacker only tracks what region
+  is free, the rectangles themselves are owned by the
+  RectAtlas that uses the RectPacker. The methods of a
+  RectPacker are NOT thread safe, the owning RectAtlas
+  serializes the calls.
+ */
+class RectPacker:public fastuidraw::noncopyable
+{
+public:
+  /*!\class free_rect
+    A free_rect is a region of a RectPacker that is free.
+   */
+  class free_rect
+  {
+  public:
+    free_rect(void)
+    {}
+
+    free_rect(const ivec2 &bl, const ivec2 &sz):
+      m_minX_minY(bl),
+      m_maxX_maxY(bl + sz)
+    {}
+
+    int
+    width(void) const
+    {
+      return m_maxX_maxY.x() - m_minX_minY.x();
+    }
+
+    int
+    height(void) const
+    {
+      return m_maxX_maxY.y() - m_minX_minY.y();
+    }
+
+    int
+    area(void) const
+    {
+      return width() * height();
+    }
+
+    bool
+    contains(const free_rect &obj) const
+    {
+      return m_minX_minY.x() <= obj.m_minX_minY.x()
+        && m_minX_minY.y() <= obj.m_minX_minY.y()
+        && m_maxX_maxY.x() >= obj.m_maxX_maxY.x()
+        && m_maxX_maxY.y() >= obj.m_maxX_maxY.y();
+    }
+
+    bool
+    intersects(const free_rect &obj) const
+    {
+      return m_minX_minY.x() < obj.m_maxX_maxY.x()
+        && obj.m_minX_minY.x() < m_maxX_maxY.x()
+        && m_minX_minY.y() < obj.m_maxX_maxY.y()
+        && obj.m_minX_minY.y() < m_maxX_maxY.y();
+    }
+
+    ivec2 m_minX_minY, m_maxX_maxY;
+  };
+
+  explicit
+  RectPacker(const ivec2 &dimensions):
+    m_dimensions(dimensions)
+  {}
+
+  virtual
+  ~RectPacker()
+  {}
+
+  /*!\fn const ivec2& dimensions
+    Returns the size of the rectangle from which
+    the RectPacker allocates.
+   */
+  const ivec2&
+  dimensions(void) const
+  {
+    return m_dimensions;
+  }
+
+  /*!\fn enum return_code allocate
+    To be implemented by a derived class to find room for
+    a rectangle and mark it as used. Returns routine_fail
+    if there is no room.
+    \param size width and height of the rectangle, both
+                are positive
+    \param[out] out_minX_minY location of the rectangle
+   */
+  virtual
+  enum return_code
+  allocate(const ivec2 &size, ivec2 &out_minX_minY) = 0;
+
+  /*!\fn void free
+    To be implemented by a derived class to mark
+    as free a rectangle returned by allocate(). The
+    owning RectAtlas calls clear() instead when the
+    last of its rectangles is freed.
+    \param minX_minY location of the rectangle
+    \param size size of the rectangle
+   */
+  virtual
+  void
+  free(const ivec2 &minX_minY, const ivec2 &size) = 0;
+
+  /*!\fn void clear
+    To be implemented by a derived class to
+    mark the entire rectangle as free.
+   */
+  virtual
+  void
+  clear(void) = 0;
+
+  /*!\fn int largest_free_area
+    To be implemented by a derived class to return
+    the area of the largest rectangle that allocate()
+    would find room for.
+   */
+  virtual
+  int
+  largest_free_area(void) const = 0;
+
+private:
+  ivec2 m_dimensions;
+};
+
+/*!\class MaxRectsPacker
+  A MaxRectsPacker tracks the free region as a list of
+  maximal free rectangles (that may overlap) and places
+  a rectangle in the free rectangle that leaves the
+  least room along its shorter side (best short side
+  fit). A freed rectangle is merged with the free
+  rectangles it lines up with so that free room is
+  recovered as large rectangles.
+ */
+class MaxRectsPacker:public RectPacker
+{
+public:
+  /*!\fn MaxRectsPacker
+    Ctor.
+    \param dimensions size of the rectangle from which to allocate
+    \param initially_free if false, no region is free until it is
+                          passed to free(); clear() returns the
+                          MaxRectsPacker to this state
+   */
+  explicit
+  MaxRectsPacker(const ivec2 &dimensions, bool initially_free = true);
+
+  virtual
+  enum return_code
+  allocate(const ivec2 &size, ivec2 &out_minX_minY);
+
+  virtual
+  void
+  free(const ivec2 &minX_minY, const ivec2 &size);
+
+  virtual
+  void
+  clear(void);
+
+  virtual
+  int
+  largest_free_area(void) const;
+
+private:
+  void
+  split_free_rects(const free_rect &used);
+
+  void
+  add_free_rects(std::vector<free_rect> &new_rects);
+
+  bool m_initially_free;
+  std::vector<free_rect> m_free_rects;
+};
+
+/*!\class SkylinePacker
+  A SkylinePacker tracks the top of the used region
+  as a skyline, a list of horizontal segments, and
+  places a rectangle where its top is lowest (bottom
+  left rule). The room left below the skyline when a
+  rectangle is placed and rectangles that are freed
+  below the skyline are tracked by a MaxRectsPacker
+  (a waste map) which is tried first on allocation.
+ */
+class SkylinePacker:public RectPacker
+{
+public:
+  explicit
+  SkylinePacker(const ivec2 &dimensions);
+
+  virtual
+  enum return_code
+  allocate(const ivec2 &size, ivec2 &out_minX_minY);
+
+  virtual
+  void
+  free(const ivec2 &minX_minY, const ivec2 &size);
+
+  virtual
+  void
+  clear(void);
+
+  virtual
+  int
+  largest_free_area(void) const;
+
+private:
+  class segment
+  {
+  public:
+    segment(int x, int y, int w):
+      m_x(x), m_y(y), m_width(w)
+    {}
+
+    int m_x, m_y, m_width;
+  };
+
+  /* returns the y-coordinate of the rectangle if
+     placed at the start of the named segment, or
+     -1 if it does not fit there.
+   */
+  int
+  fit(unsigned int segment_index, const ivec2 &size) const;
+
+  /* set the skyline height to y on [x, x + w) */
+  void
+  set_height(int x, int w, int y);
+
+  std::vector<segment> m_skyline;
+  MaxRectsPacker m_waste;
+};
+
+} //namespace detail
+} //namespace fastuidraw
@@ -0,0 +1,1189 @@
+/*!
+ * \file text_layout.cpp
+ * \brief file text_layout.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <string.h>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/text/text_layout.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include <fastuidraw/painter/painter_attribute_data_filler_glyphs.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* style index of a paragraph ending
+     that was never given a style.
+   */
+  const unsigned int no_style = ~0u;
+
+  /* when the word cache gets larger than this,
+     it is cleared before a word is added.
+   */
+  const unsigned int max_number_cached_words = 16384;
+
+  inline
+  bool
+  is_space(uint32_t character_code)
+  {
+    return character_code == ' ' || character_code == '\t';
+  }
+
+  /* decode UTF-8, invalid bytes are taken as Latin-1 characters
+   */
+  void
+  decode_utf8(const char *begin, const char *end, std::vector<uint32_t> &out_character_codes)
+  {
+    while(begin < end)
+      {
+        uint8_t b(*begin);
+        uint32_t code;
+        int num_continue;
+
+        if(b < 0x80)
+          {
+            code = b;
+            num_continue = 0;
+          }
+        else if((b & 0xE0) == 0xC0)
+          {
+            code = b & 0x1F;
+            num_continue = 1;
+          }
+        else if((b & 0xF0) == 0xE0)
+          {
+            code = b & 0x0F;
+            num_continue = 2;
+          }
+        else if((b & 0xF8) == 0xF0)
+          {
+            code = b & 0x07;
+            num_continue = 3;
+          }
+        else
+          {
+            code = b;
+            num_continue = -1;
+          }
+
+        bool valid(num_continue >= 0 && num_continue < end - begin);
+        for(int c = 1; c <= num_continue && valid; ++c)
+          {
+            uint8_t v(begin[c]);
+            valid = (v & 0xC0) == 0x80;
+            code = (code << 6) | (v & 0x3F);
+          }
+
+        if(valid)
+          {
+            out_character_codes.push_back(code);
+            begin += num_continue + 1;
+          }
+        else
+          {
+            out_character_codes.push_back(b);
+            ++begin;
+          }
+      }
+  }
+
+  bool
+  same_properties(const fastuidraw::FontProperties &lhs,
+                  const fastuidraw::FontProperties &rhs)
+  {
+    return lhs.bold() == rhs.bold()
+      && lhs.italic() == rhs.italic()
+      && strcmp(lhs.style(), rhs.style()) == 0
+      && strcmp(lhs.family(), rhs.family()) == 0
+      && strcmp(lhs.foundry(), rhs.foundry()) == 0
+      && strcmp(lhs.source_label(), rhs.source_label()) == 0;
+  }
+
+  float
+  compute_kerning(const fastuidraw::Glyph &left, const fastuidraw::Glyph &right,
+                  float pixel_size)
+  {
+    if(!left.valid() || !right.valid()
+       || left.layout().m_font != right.layout().m_font
+       || !left.layout().m_font)
+      {
+        return 0.0f;
+      }
+
+    return pixel_size * left.layout().m_font->kerning(left.layout().m_glyph_code,
+                                                      right.layout().m_glyph_code).x();
+  }
+
+  class TextStyle
+  {
+  public:
+    TextStyle(const fastuidraw::FontProperties &props, float pixel_size,
+              fastuidraw::GlyphRender render,
+              const fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> &selector);
+
+    fastuidraw::FontProperties m_properties;
+    float m_pixel_size;
+    fastuidraw::GlyphRender m_render;
+    fastuidraw::GlyphSelector::FontGroup m_group;
+
+    /* line metrics of the font that m_properties selects,
+       scaled to m_pixel_size. If the font does not give
+       line metrics, lines are sized by their glyphs.
+     */
+    bool m_has_line_metrics;
+    float m_ascender, m_descender, m_line_height;
+  };
+
+  class ShapedCharacter
+  {
+  public:
+    fastuidraw::Glyph m_glyph;
+
+    /* all values are in pixels, m_kerning is the kerning
+       between the previous character and this character
+     */
+    float m_advance, m_kerning, m_scale_factor;
+    float m_ascent, m_descent;
+  };
+
+  class WordKey
+  {
+  public:
+    bool
+    operator<(const WordKey &rhs) const
+    {
+      return (m_style != rhs.m_style) ?
+        m_style < rhs.m_style :
+        m_character_codes < rhs.m_character_codes;
+    }
+
+    unsigned int m_style;
+    std::vector<uint32_t> m_character_codes;
+  };
+
+  typedef std::map<WordKey, std::vector<ShapedCharacter> > WordCache;
+
+  class Line
+  {
+  public:
+    /* range into the characters of the paragraph */
+    unsigned int m_begin, m_end;
+
+    /* m_top is relative to the top of the paragraph */
+    float m_top, m_ascent, m_height, m_width;
+  };
+
+  class Paragraph
+  {
+  public:
+    explicit
+    Paragraph(unsigned int break_style):
+      m_break_style(break_style),
+      m_shaping_dirty(true),
+      m_lines_dirty(true),
+      m_width(0.0f),
+      m_height(0.0f)
+    {}
+
+    unsigned int
+    size(void) const
+    {
+      return m_character_codes.size();
+    }
+
+    std::vector<uint32_t> m_character_codes;
+    std::vector<unsigned int> m_styles;
+
+    /* style of the '\n' that ends the paragraph, for the
+       last paragraph it is the style of the last characters
+       added to the end; gives the size of an empty line.
+     */
+    unsigned int m_break_style;
+
+    bool m_shaping_dirty, m_lines_dirty;
+    std::vector<ShapedCharacter> m_shaped;
+    std::vector<float> m_pen_x;
+    std::vector<Line> m_lines;
+    float m_width, m_height;
+  };
+
+  class TextLayoutPrivate
+  {
+  public:
+    TextLayoutPrivate(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> &glyph_selector,
+                      fastuidraw::GlyphRender render,
+                      enum fastuidraw::PainterEnums::glyph_orientation orientation);
+
+    ~TextLayoutPrivate();
+
+    unsigned int
+    fetch_style(const fastuidraw::FontProperties &props, float pixel_size);
+
+    /* find the paragraph and location within the
+       paragraph of a character location, a location
+       at the end of a paragraph is of its '\n'.
+     */
+    void
+    locate(unsigned int location, unsigned int &paragraph, unsigned int &offset) const;
+
+    void
+    insert(unsigned int location, const std::vector<uint32_t> &character_codes,
+           unsigned int style);
+
+    void
+    erase(unsigned int location, unsigned int count);
+
+    void
+    set_style(unsigned int location, unsigned int count, unsigned int style);
+
+    void
+    clear(void);
+
+    void
+    mark_dirty(bool shaping);
+
+    const std::vector<ShapedCharacter>&
+    shape_word(unsigned int style,
+               const uint32_t *begin, const uint32_t *end);
+
+    void
+    shape_paragraph(Paragraph &p);
+
+    void
+    break_lines(Paragraph &p);
+
+    void
+    add_line(Paragraph &p, unsigned int begin, unsigned int end);
+
+    void
+    update(void);
+
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> m_glyph_selector;
+    fastuidraw::GlyphRender m_render;
+    enum fastuidraw::PainterEnums::glyph_orientation m_orientation;
+    float m_max_line_width, m_line_spacing;
+    bool m_kerning;
+
+    std::vector<TextStyle> m_styles;
+    std::vector<Paragraph*> m_paragraphs;
+    unsigned int m_number_characters;
+    WordCache m_word_cache;
+
+    /* the layout of all the text, rebuilt
+       from the paragraphs when m_dirty
+     */
+    bool m_dirty;
+    unsigned int m_number_lines;
+    fastuidraw::vec2 m_dimensions;
+    std::vector<fastuidraw::Glyph> m_glyphs;
+    std::vector<fastuidraw::vec2> m_glyph_positions;
+    std::vector<float> m_glyph_scale_factors;
+    std::vector<unsigned int> m_glyph_character_locations;
+
+    /* the glyphs of the last call to fill_attribute_data()
+       with their Glyph::upload_generation() after the fill
+     */
+    std::vector<fastuidraw::Glyph> m_filled_glyphs;
+    std::vector<unsigned int> m_filled_upload_generations;
+  };
+}
+
+///////////////////////////////
+// TextStyle methods
+TextStyle::
+TextStyle(const fastuidraw::FontProperties &props, float pixel_size,
+          fastuidraw::GlyphRender render,
+          const fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> &selector):
+  m_properties(props),
+  m_pixel_size(pixel_size),
+  m_render(render),
+  m_has_line_metrics(false),
+  m_ascender(0.0f),
+  m_descender(0.0f),
+  m_line_height(0.0f)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> font;
+
+  /* coverage glyphs are rendered at the size they are drawn
+   */
+  if(m_render.m_type == fastuidraw::coverage_glyph)
+    {
+      m_render = fastuidraw::GlyphRender(std::max(1, static_cast<int>(pixel_size + 0.5f)));
+    }
+
+  m_group = selector->fetch_group(props);
+  font = selector->fetch_font(props);
+  if(font && font->line_metrics(m_ascender, m_descender, m_line_height) == fastuidraw::routine_success)
+    {
+      m_has_line_metrics = true;
+      m_ascender *= pixel_size;
+      m_descender *= pixel_size;
+      m_line_height *= pixel_size;
+    }
+}
+
+///////////////////////////////////
+// TextLayoutPrivate methods
+TextLayoutPrivate::
+TextLayoutPrivate(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> &glyph_selector,
+                  fastuidraw::GlyphRender render,
+                  enum fastuidraw::PainterEnums::glyph_orientation orientation):
+  m_glyph_selector(glyph_selector),
+  m_render(render),
+  m_orientation(orientation),
+  m_max_line_width(0.0f),
+  m_line_spacing(0.0f),
+  m_kerning(true),
+  m_number_characters(0),
+  m_dirty(true),
+  m_number_lines(0),
+  m_dimensions(0.0f, 0.0f)
+{
+  m_paragraphs.push_back(FASTUIDRAWnew Paragraph(no_style));
+}
+
+TextLayoutPrivate::
+~TextLayoutPrivate()
+{
+  for(unsigned int i = 0, endi = m_paragraphs.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_paragraphs[i]);
+    }
+}
+
+unsigned int
+TextLayoutPrivate::
+fetch_style(const fastuidraw::FontProperties &props, float pixel_size)
+{
+  for(unsigned int i = 0, endi = m_styles.size(); i < endi; ++i)
+    {
+      if(m_styles[i].m_pixel_size == pixel_size
+         && same_properties(m_styles[i].m_properties, props))
+        {
+          return i;
+        }
+    }
+  m_styles.push_back(TextStyle(props, pixel_size, m_render, m_glyph_selector));
+  return m_styles.size() - 1;
+}
+
+void
+TextLayoutPrivate::
+locate(unsigned int location, unsigned int &paragraph, unsigned int &offset) const
+{
+  location = std::min(location, m_number_characters);
+  for(unsigned int i = 0, endi = m_paragraphs.size(); i < endi; ++i)
+    {
+      if(location <= m_paragraphs[i]->size())
+        {
+          paragraph = i;
+          offset = location;
+          return;
+        }
+      location -= m_paragraphs[i]->size() + 1;
+    }
+  assert(!"Bad character location");
+  paragraph = m_paragraphs.size() - 1;
+  offset = m_paragraphs.back()->size();
+}
+
+void
+TextLayoutPrivate::
+insert(unsigned int location, const std::vector<uint32_t> &character_codes,
+       unsigned int style)
+{
+  unsigned int k, offset;
+  Paragraph *p;
+
+  if(character_codes.empty())
+    {
+      return;
+    }
+
+  locate(location, k, offset);
+  p = m_paragraphs[k];
+  p->m_shaping_dirty = true;
+  m_number_characters += character_codes.size();
+  m_dirty = true;
+
+  if(std::find(character_codes.begin(), character_codes.end(), '\n') == character_codes.end())
+    {
+      p->m_character_codes.insert(p->m_character_codes.begin() + offset,
+                                  character_codes.begin(), character_codes.end());
+      p->m_styles.insert(p->m_styles.begin() + offset, character_codes.size(), style);
+      if(k + 1 == m_paragraphs.size() && offset + character_codes.size() == p->size())
+        {
+          p->m_break_style = style;
+        }
+      return;
+    }
+
+  /* the characters of p after the insertion point and its
+     ending go to the paragraph made by the last '\n'
+   */
+  std::vector<uint32_t> tail_codes(p->m_character_codes.begin() + offset, p->m_character_codes.end());
+  std::vector<unsigned int> tail_styles(p->m_styles.begin() + offset, p->m_styles.end());
+  unsigned int tail_break_style(p->m_break_style);
+
+  p->m_character_codes.resize(offset);
+  p->m_styles.resize(offset);
+  for(unsigned int i = 0, endi = character_codes.size(); i < endi; ++i)
+    {
+      if(character_codes[i] == '\n')
+        {
+          p->m_break_style = style;
+          p = FASTUIDRAWnew Paragraph(no_style);
+          m_paragraphs.insert(m_paragraphs.begin() + (++k), p);
+        }
+      else
+        {
+          p->m_character_codes.push_back(character_codes[i]);
+          p->m_styles.push_back(style);
+        }
+    }
+
+  p->m_break_style = (k + 1 == m_paragraphs.size() && tail_codes.empty()) ?
+    style : tail_break_style;
+  p->m_character_codes.insert(p->m_character_codes.end(), tail_codes.begin(), tail_codes.end());
+  p->m_styles.insert(p->m_styles.end(), tail_styles.begin(), tail_styles.end());
+}
+
+void
+TextLayoutPrivate::
+erase(unsigned int location, unsigned int count)
+{
+  unsigned int k0, offset0, k1, offset1;
+  Paragraph *p0;
+
+  if(location >= m_number_characters || count == 0)
+    {
+      return;
+    }
+
+  count = std::min(count, m_number_characters - location);
+  locate(location, k0, offset0);
+  locate(location + count, k1, offset1);
+
+  p0 = m_paragraphs[k0];
+  if(k0 == k1)
+    {
+      p0->m_character_codes.erase(p0->m_character_codes.begin() + offset0,
+                                  p0->m_character_codes.begin() + offset1);
+      p0->m_styles.erase(p0->m_styles.begin() + offset0,
+                         p0->m_styles.begin() + offset1);
+    }
+  else
+    {
+      Paragraph *p1(m_paragraphs[k1]);
+
+      p0->m_character_codes.resize(offset0);
+      p0->m_styles.resize(offset0);
+      p0->m_character_codes.insert(p0->m_character_codes.end(),
+                                   p1->m_character_codes.begin() + offset1,
+                                   p1->m_character_codes.end());
+      p0->m_styles.insert(p0->m_styles.end(),
+                          p1->m_styles.begin() + offset1,
+                          p1->m_styles.end());
+      p0->m_break_style = p1->m_break_style;
+
+      for(unsigned int i = k0 + 1; i <= k1; ++i)
+        {
+          FASTUIDRAWdelete(m_paragraphs[i]);
+        }
+      m_paragraphs.erase(m_paragraphs.begin() + k0 + 1, m_paragraphs.begin() + k1 + 1);
+    }
+
+  p0->m_shaping_dirty = true;
+  m_number_characters -= count;
+  m_dirty = true;
+}
+
+void
+TextLayoutPrivate::
+set_style(unsigned int location, unsigned int count, unsigned int style)
+{
+  unsigned int k, offset;
+
+  if(location >= m_number_characters || count == 0)
+    {
+      return;
+    }
+
+  count = std::min(count, m_number_characters - location);
+  locate(location, k, offset);
+  while(count > 0)
+    {
+      Paragraph *p(m_paragraphs[k]);
+      unsigned int n;
+
+      n = std::min(count, p->size() - offset);
+      std::fill(p->m_styles.begin() + offset, p->m_styles.begin() + offset + n, style);
+      p->m_shaping_dirty = true;
+      count -= n;
+
+      if(count > 0)
+        {
+          /* the '\n' that ends p */
+          p->m_break_style = style;
+          --count;
+          ++k;
+          offset = 0;
+        }
+    }
+  m_dirty = true;
+}
+
+void
+TextLayoutPrivate::
+clear(void)
+{
+  for(unsigned int i = 0, endi = m_paragraphs.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_paragraphs[i]);
+    }
+  m_paragraphs.clear();
+  m_paragraphs.push_back(FASTUIDRAWnew Paragraph(no_style));
+  m_styles.clear();
+  m_word_cache.clear();
+  m_number_characters = 0;
+  m_dirty = true;
+}
+
+void
+TextLayoutPrivate::
+mark_dirty(bool shaping)
+{
+  for(unsigned int i = 0, endi = m_paragraphs.size(); i < endi; ++i)
+    {
+      m_paragraphs[i]->m_lines_dirty = true;
+      m_paragraphs[i]->m_shaping_dirty = m_paragraphs[i]->m_shaping_dirty || shaping;
+    }
+  m_dirty = true;
+}
+
+const std::vector<ShapedCharacter>&
+TextLayoutPrivate::
+shape_word(unsigned int style, const uint32_t *begin, const uint32_t *end)
+{
+  WordKey key;
+  WordCache::iterator iter;
+
+  key.m_style = style;
+  key.m_character_codes.assign(begin, end);
+  iter = m_word_cache.find(key);
+  if(iter != m_word_cache.end())
+    {
+      return iter->second;
+    }
+
+  if(m_word_cache.size() >= max_number_cached_words)
+    {
+      m_word_cache.clear();
+    }
+
+  const TextStyle &S(m_styles[style]);
+  std::vector<ShapedCharacter> &word(m_word_cache[key]);
+  std::vector<fastuidraw::Glyph> glyphs(key.m_character_codes.size());
+
+  /* tabs are drawn as spaces */
+  std::replace(key.m_character_codes.begin(), key.m_character_codes.end(), uint32_t('\t'), uint32_t(' '));
+  m_glyph_selector->create_glyph_sequence(S.m_render, S.m_group,
+                                          key.m_character_codes.begin(),
+                                          key.m_character_codes.end(),
+                                          glyphs.begin());
+
+  word.resize(glyphs.size());
+  for(unsigned int i = 0, endi = glyphs.size(); i < endi; ++i)
+    {
+      ShapedCharacter &C(word[i]);
+
+      C.m_glyph = glyphs[i];
+      C.m_kerning = 0.0f;
+      if(glyphs[i].valid())
+        {
+          const fastuidraw::GlyphLayoutData &L(glyphs[i].layout());
+          float scale;
+
+          scale = S.m_pixel_size / static_cast<float>(L.m_pixel_size);
+          C.m_advance = scale * L.m_advance.x();
+          C.m_scale_factor = scale;
+          C.m_ascent = scale * (L.m_horizontal_layout_offset.y() + L.m_size.y());
+          C.m_descent = -scale * L.m_horizontal_layout_offset.y();
+          if(i > 0 && m_kerning)
+            {
+              C.m_kerning = compute_kerning(glyphs[i - 1], glyphs[i], S.m_pixel_size);
+            }
+        }
+      else
+        {
+          C.m_advance = 0.0f;
+          C.m_scale_factor = 1.0f;
+          C.m_ascent = 0.0f;
+          C.m_descent = 0.0f;
+        }
+    }
+  return word;
+}
+
+void
+TextLayoutPrivate::
+shape_paragraph(Paragraph &p)
+{
+  const uint32_t *codes;
+
+  p.m_shaped.clear();
+  p.m_shaped.reserve(p.size());
+  codes = (p.size() > 0) ? &p.m_character_codes[0] : NULL;
+
+  /* a word is a run of characters of the same style
+     that are all spaces or all not spaces.
+   */
+  for(unsigned int i = 0, endi = p.size(); i < endi;)
+    {
+      unsigned int style(p.m_styles[i]), j;
+      bool space(is_space(codes[i]));
+
+      for(j = i + 1; j < endi && p.m_styles[j] == style && is_space(codes[j]) == space; ++j)
+        {}
+
+      const std::vector<ShapedCharacter> &word(shape_word(style, codes + i, codes + j));
+      p.m_shaped.insert(p.m_shaped.end(), word.begin(), word.end());
+
+      /* kerning between the words, only if they
+         are of the same pixel size
+       */
+      if(i > 0 && m_kerning && m_styles[p.m_styles[i - 1]].m_pixel_size == m_styles[style].m_pixel_size)
+        {
+          p.m_shaped[i].m_kerning = compute_kerning(p.m_shaped[i - 1].m_glyph,
+                                                    p.m_shaped[i].m_glyph,
+                                                    m_styles[style].m_pixel_size);
+        }
+      i = j;
+    }
+  p.m_shaping_dirty = false;
+  p.m_lines_dirty = true;
+}
+
+void
+TextLayoutPrivate::
+break_lines(Paragraph &p)
+{
+  p.m_lines.clear();
+  p.m_pen_x.resize(p.size());
+  p.m_width = 0.0f;
+  p.m_height = 0.0f;
+
+  if(p.size() == 0)
+    {
+      add_line(p, 0, 0);
+    }
+
+  for(unsigned int begin = 0, endi = p.size(); begin < endi;)
+    {
+      unsigned int end, last_break(begin);
+      float x(0.0f);
+
+      for(end = begin; end < endi; ++end)
+        {
+          const ShapedCharacter &C(p.m_shaped[end]);
+          bool space(is_space(p.m_character_codes[end]));
+
+          if(end > begin)
+            {
+              x += C.m_kerning;
+              if(!space && is_space(p.m_character_codes[end - 1]))
+                {
+                  last_break = end;
+                }
+            }
+
+          /* spaces at the end of a line may go past the line width;
+             a word that does not fit on a line by itself is broken
+             at the character that does not fit.
+           */
+          if(m_max_line_width > 0.0f && !space && end > begin
+             && x + C.m_advance > m_max_line_width)
+            {
+              if(last_break > begin)
+                {
+                  end = last_break;
+                }
+              break;
+            }
+          p.m_pen_x[end] = x;
+          x += C.m_advance;
+        }
+      add_line(p, begin, end);
+      begin = end;
+    }
+  p.m_lines_dirty = false;
+}
+
+void
+TextLayoutPrivate::
+add_line(Paragraph &p, unsigned int begin, unsigned int end)
+{
+  Line L;
+  float descent(0.0f), line_height(0.0f);
+
+  L.m_begin = begin;
+  L.m_end = end;
+  L.m_ascent = 0.0f;
+  L.m_width = 0.0f;
+  for(unsigned int i = begin; i < end; ++i)
+    {
+      const TextStyle &S(m_styles[p.m_styles[i]]);
+      const ShapedCharacter &C(p.m_shaped[i]);
+
+      if(S.m_has_line_metrics)
+        {
+          L.m_ascent = std::max(L.m_ascent, S.m_ascender);
+          descent = std::max(descent, S.m_descender);
+          line_height = std::max(line_height, S.m_line_height);
+        }
+      else
+        {
+          L.m_ascent = std::max(L.m_ascent, C.m_ascent);
+          descent = std::max(descent, C.m_descent);
+        }
+
+      if(!is_space(p.m_character_codes[i]))
+        {
+          L.m_width = std::max(L.m_width, p.m_pen_x[i] + C.m_advance);
+        }
+    }
+
+  if(begin == end && p.m_break_style != no_style)
+    {
+      const TextStyle &S(m_styles[p.m_break_style]);
+      if(S.m_has_line_metrics)
+        {
+          L.m_ascent = S.m_ascender;
+          descent = S.m_descender;
+          line_height = S.m_line_height;
+        }
+      else
+        {
+          L.m_ascent = S.m_pixel_size;
+        }
+    }
+
+  L.m_height = std::max(line_height, L.m_ascent + descent);
+  L.m_top = (p.m_lines.empty()) ? 0.0f : p.m_height + m_line_spacing;
+
+  p.m_height = L.m_top + L.m_height;
+  p.m_width = std::max(p.m_width, L.m_width);
+  p.m_lines.push_back(L);
+}
+
+void
+TextLayoutPrivate::
+update(void)
+{
+  float top(0.0f);
+  unsigned int location(0);
+
+  if(!m_dirty)
+    {
+      return;
+    }
+
+  m_glyphs.clear();
+  m_glyph_positions.clear();
+  m_glyph_scale_factors.clear();
+  m_glyph_character_locations.clear();
+  m_number_lines = 0;
+  m_dimensions = fastuidraw::vec2(0.0f, 0.0f);
+
+  for(unsigned int k = 0, endk = m_paragraphs.size(); k < endk; ++k)
+    {
+      Paragraph &p(*m_paragraphs[k]);
+
+      if(p.m_shaping_dirty)
+        {
+          shape_paragraph(p);
+        }
+
+      if(p.m_lines_dirty)
+        {
+          break_lines(p);
+        }
+
+      if(k > 0)
+        {
+          top += m_line_spacing;
+        }
+
+      for(unsigned int l = 0, endl = p.m_lines.size(); l < endl; ++l)
+        {
+          const Line &L(p.m_lines[l]);
+          float y;
+
+          y = top + L.m_top + L.m_ascent;
+          if(m_orientation != fastuidraw::PainterEnums::y_increases_downwards)
+            {
+              y = -y;
+            }
+
+          for(unsigned int i = L.m_begin; i < L.m_end; ++i)
+            {
+              const ShapedCharacter &C(p.m_shaped[i]);
+              if(C.m_glyph.valid() && !is_space(p.m_character_codes[i]))
+                {
+                  m_glyphs.push_back(C.m_glyph);
+                  m_glyph_positions.push_back(fastuidraw::vec2(p.m_pen_x[i], y));
+                  m_glyph_scale_factors.push_back(C.m_scale_factor);
+                  m_glyph_character_locations.push_back(location + i);
+                }
+            }
+        }
+
+      top += p.m_height;
+      location += p.size() + 1;
+      m_number_lines += p.m_lines.size();
+      m_dimensions.x() = std::max(m_dimensions.x(), p.m_width);
+    }
+
+  m_dimensions.y() = top;
+  m_dirty = false;
+}
+
+///////////////////////////////
+// fastuidraw::TextLayout methods
+fastuidraw::TextLayout::
+TextLayout(const reference_counted_ptr<GlyphSelector> &glyph_selector,
+           GlyphRender render,
+           enum PainterEnums::glyph_orientation orientation)
+{
+  m_d = FASTUIDRAWnew TextLayoutPrivate(glyph_selector, render, orientation);
+}
+
+fastuidraw::TextLayout::
+~TextLayout()
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector>&
+fastuidraw::TextLayout::
+glyph_selector(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_glyph_selector;
+}
+
+fastuidraw::GlyphRender
+fastuidraw::TextLayout::
+glyph_render(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_render;
+}
+
+enum fastuidraw::PainterEnums::glyph_orientation
+fastuidraw::TextLayout::
+orientation(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_orientation;
+}
+
+fastuidraw::TextLayout&
+fastuidraw::TextLayout::
+max_line_width(float v)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  if(v != d->m_max_line_width)
+    {
+      d->m_max_line_width = v;
+      d->mark_dirty(false);
+    }
+  return *this;
+}
+
+float
+fastuidraw::TextLayout::
+max_line_width(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_max_line_width;
+}
+
+fastuidraw::TextLayout&
+fastuidraw::TextLayout::
+line_spacing(float v)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  if(v != d->m_line_spacing)
+    {
+      d->m_line_spacing = v;
+      d->mark_dirty(false);
+    }
+  return *this;
+}
+
+float
+fastuidraw::TextLayout::
+line_spacing(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_line_spacing;
+}
+
+fastuidraw::TextLayout&
+fastuidraw::TextLayout::
+kerning(bool v)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  if(v != d->m_kerning)
+    {
+      d->m_kerning = v;
+      d->m_word_cache.clear();
+      d->mark_dirty(true);
+    }
+  return *this;
+}
+
+bool
+fastuidraw::TextLayout::
+kerning(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_kerning;
+}
+
+void
+fastuidraw::TextLayout::
+append(const char *utf8_begin, const char *utf8_end,
+       const FontProperties &props, float pixel_size)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  insert(d->m_number_characters, utf8_begin, utf8_end, props, pixel_size);
+}
+
+void
+fastuidraw::TextLayout::
+append(const char *utf8, const FontProperties &props, float pixel_size)
+{
+  append(utf8, utf8 + strlen(utf8), props, pixel_size);
+}
+
+void
+fastuidraw::TextLayout::
+insert(unsigned int location,
+       const char *utf8_begin, const char *utf8_end,
+       const FontProperties &props, float pixel_size)
+{
+  TextLayoutPrivate *d;
+  std::vector<uint32_t> character_codes;
+
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  decode_utf8(utf8_begin, utf8_end, character_codes);
+  if(!character_codes.empty())
+    {
+      d->insert(location, character_codes, d->fetch_style(props, pixel_size));
+    }
+}
+
+void
+fastuidraw::TextLayout::
+insert(unsigned int location, const char *utf8,
+       const FontProperties &props, float pixel_size)
+{
+  insert(location, utf8, utf8 + strlen(utf8), props, pixel_size);
+}
+
+void
+fastuidraw::TextLayout::
+erase(unsigned int location, unsigned int count)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->erase(location, count);
+}
+
+void
+fastuidraw::TextLayout::
+set_style(unsigned int location, unsigned int count,
+          const FontProperties &props, float pixel_size)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  if(location < d->m_number_characters && count > 0)
+    {
+      d->set_style(location, count, d->fetch_style(props, pixel_size));
+    }
+}
+
+void
+fastuidraw::TextLayout::
+clear(void)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->clear();
+}
+
+unsigned int
+fastuidraw::TextLayout::
+number_characters(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_number_characters;
+}
+
+unsigned int
+fastuidraw::TextLayout::
+number_lines(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return d->m_number_lines;
+}
+
+fastuidraw::vec2
+fastuidraw::TextLayout::
+dimensions(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return d->m_dimensions;
+}
+
+fastuidraw::const_c_array<fastuidraw::Glyph>
+fastuidraw::TextLayout::
+glyphs(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return make_c_array(d->m_glyphs);
+}
+
+fastuidraw::const_c_array<fastuidraw::vec2>
+fastuidraw::TextLayout::
+glyph_positions(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return make_c_array(d->m_glyph_positions);
+}
+
+fastuidraw::const_c_array<float>
+fastuidraw::TextLayout::
+glyph_scale_factors(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return make_c_array(d->m_glyph_scale_factors);
+}
+
+fastuidraw::const_c_array<unsigned int>
+fastuidraw::TextLayout::
+glyph_character_locations(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+  return make_c_array(d->m_glyph_character_locations);
+}
+
+unsigned int
+fastuidraw::TextLayout::
+fill_attribute_data(PainterAttributeData &dst) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->update();
+
+  PainterAttributeDataFillerGlyphs filler(make_c_array(d->m_glyph_positions),
+                                          make_c_array(d->m_glyphs),
+                                          make_c_array(d->m_glyph_scale_factors),
+                                          d->m_orientation);
+  dst.set_data(filler);
+
+  d->m_filled_glyphs.clear();
+  d->m_filled_upload_generations.clear();
+  for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
+    {
+      if(d->m_glyphs[i].valid())
+        {
+          d->m_filled_glyphs.push_back(d->m_glyphs[i]);
+          d->m_filled_upload_generations.push_back(d->m_glyphs[i].upload_generation());
+        }
+    }
+
+  return filler.number_glyphs();
+}
+
+bool
+fastuidraw::TextLayout::
+attribute_data_evicted(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+
+  for(unsigned int i = 0, endi = d->m_filled_glyphs.size(); i < endi; ++i)
+    {
+      unsigned int v(d->m_filled_glyphs[i].upload_generation());
+      if(v == 0 || v != d->m_filled_upload_generations[i])
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+fastuidraw::TextLayout::
+clear_word_cache(void)
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  d->m_word_cache.clear();
+  d->m_filled_glyphs.clear();
+  d->m_filled_upload_generations.clear();
+  d->mark_dirty(true);
+}
+
+unsigned int
+fastuidraw::TextLayout::
+number_cached_words(void) const
+{
+  TextLayoutPrivate *d;
+  d = reinterpret_cast<TextLayoutPrivate*>(m_d);
+  return d->m_word_cache.size();
+}
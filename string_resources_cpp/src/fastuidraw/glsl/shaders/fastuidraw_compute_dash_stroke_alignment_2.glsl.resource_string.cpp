@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+102,108,111,97,116,10,70,65,83,84,85,73,68,82,65,87,95,67,79,77,80,85,84,69,95,68,65,83,72,95,83,84,82,79,75,69,40,105,110,32,117,105,110,116,32,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,100,97,116,97,95,108,111,99,97,116,105,111,110,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,102,105,114,115,116,95,105,110,116,101,114,118,97,108,95,115,116,97,114,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,105,110,95,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,100,105,115,116,97,110,99,101,95,116,111,95,101,110,100,95,111,102,95,101,100,103,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,115,116,114,111,107,101,95,119,105,100,116,104,41,10,123,10,32,32,102,108,111,97,116,32,100,44,32,108,97,115,116,100,44,32,114,44,32,102,102,59,10,32,32,117,105,110,116,32,108,111,99,59,10,10,35,100,101,102,105,110,101,32,72,69,76,80,69,82,95,77,65,67,82,79,40,98,48,44,32,98,49,41,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,92,10,32,32,70,65,83,84,85,73,68,82,65,87,95,67,79,77,80,85,84,69,95,68,65,83,72,95,83,84,82,79,75,69,95,72,69,76,80,69,82,40,105,110,95,100,105,115,116,97,110,99,101,44,32,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,44,32,100,105,115,116,97,110,99,101,95,116,111,95,101,110,100,95,111,102,95,101,100,103,101,44,32,98,48,32,43,32,102,102,44,32,98,49,32,43,32,102,102,44,32,115,116,114,111,107,101,95,119,105,100,116,104,41,10,10,32,32,114,32,61,32,48,46,48,59,10,32,32,102,102,32,61,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,32,42,32,102,108,111,111,114,40,105,110,95,100,105,115,116,97,110,99,101,32,47,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,41,59,10,32,32,100,32,61,32,105,110,95,100,105,115,116,97,110,99,101,32,45,32,102,102,59,10,32,32,108,111,99,32,61,32,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,108,97,115,116,100,32,61,32,102,105,114,115,116,95,105,110,116,101,114,118,97,108,95,115,116,97,114,116,59,10,10,32,32,47,42,32,68,97,116,97,32,105,115,32,112,97,99,107,101,100,32,113,117,105,116,101,32,116,114,105,118,105,97,108,108,121,44,32,119,104,101,114,101,32,116,104,101,32,118,97,108,117,101,115,32,97,114,101,32,106,117,115,116,10,32,32,32,32,32,116,104,101,32,115,117,99,99,101,115,115,105,118,101,32,116,111,116,97,108,32,108,101,110,103,116,104,115,44,32,115,111,32,119,101,32,106,117,115,116,32,107,101,101,112,32,114,101,97,100,105,110,103,10,32,32,32,32,32,117,110,116,105,108,32,116,104,97,116,32,118,97,108,117,101,32,105,115,32,103,114,101,97,116,101,114,32,116,104,97,110,32,100,46,32,87,101,32,97,108,115,111,32,104,97,118,101,32,116,104,97,116,10,32,32,32,32,32,116,104,101,32,102,105,114,115,116,32,105,110,116,101,114,118,97,108,32,105,115,32,104,111,119,32,109,117,99,104,32,116,111,32,100,114,97,119,44,32,115,111,32,116,104,101,32,115,105,103,110,32,100,101,116,101,114,109,105,110,101,115,10,32,32,32,32,32,116,104,101,32,100,105,115,116,97,110,99,101,46,10,32,32,32,42,47,10,32,32,100,111,10,32,32,32,32,123,10,32,32,32,32,32,32,117,118,101,99,50,32,86,59,10,32,32,32,32,32,32,118,101,99,50,32,102,86,59,10,10,32,32,32,32,32,32,86,32,61,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,121,59,10,32,32,32,32,32,32,102,86,32,61,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,86,41,59,10,10,32,32,32,32,32,32,105,102,40,100,32,60,32,102,86,46,120,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,114,32,61,32,72,69,76,80,69,82,95,77,65,67,82,79,40,108,97,115,116,100,44,32,102,86,46,120,41,59,10,10,32,32,32,32,32,32,32,32,32,32,47,47,98,114,101,97,107,32,111,117,116,10,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,114,59,10,32,32,32,32,32,32,32,32,32,32,108,97,115,116,100,32,61,32,50,46,48,32,42,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,32,43,32,49,46,48,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,101,108,115,101,32,105,102,40,100,32,60,32,102,86,46,121,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,114,32,61,32,45,72,69,76,80,69,82,95,77,65,67,82,79,40,102,86,46,120,44,32,102,86,46,121,41,59,10,10,32,32,32,32,32,32,32,32,32,32,47,47,98,114,101,97,107,32,111,117,116,10,32,32,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,114,59,10,32,32,32,32,32,32,32,32,32,32,108,97,115,116,100,32,61,32,50,46,48,32,42,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,32,43,32,49,46,48,59,10,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,108,97,115,116,100,32,61,32,102,86,46,121,59,10,32,32,32,32,32,32,43,43,108,111,99,59,10,32,32,32,32,125,10,32,32,119,104,105,108,101,40,108,97,115,116,100,32,60,32,116,111,116,97,108,95,100,105,115,116,97,110,99,101,41,59,10,10,32,32,114,101,116,117,114,110,32,114,59,10,125,10,10,35,117,110,100,101,102,32,72,69,76,80,69,82,95,77,65,67,82,79,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_compute_dash_stroke_alignment_2.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+102,108,111,97,116,10,70,65,83,84,85,73,68,82,65,87,95,67,79,77,80,85,84,69,95,68,65,83,72,95,83,84,82,79,75,69,95,72,69,76,80,69,82,40,105,110,32,102,108,111,97,116,32,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,100,105,115,116,97,110,99,101,95,116,111,95,101,100,103,101,95,101,110,100,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,98,111,117,110,100,97,114,121,48,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,98,111,117,110,100,97,114,121,49,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,102,108,111,97,116,32,115,116,114,111,107,101,95,119,105,100,116,104,41,10,123,10,32,32,102,108,111,97,116,32,114,44,32,100,48,44,32,100,49,59,10,32,32,47,42,32,67,111,109,112,117,116,101,32,116,104,101,32,100,105,115,116,97,110,99,101,32,116,111,32,116,104,101,32,110,101,97,114,101,115,116,32,98,111,117,110,100,97,114,121,59,10,32,32,32,32,32,119,101,32,110,101,101,100,32,116,104,101,32,100,105,115,116,97,110,99,101,32,118,97,108,117,101,32,102,111,114,32,116,119,111,32,114,101,97,115,111,110,115,58,10,32,32,32,32,32,32,45,32,99,111,109,112,117,116,101,32,97,110,116,105,45,97,108,105,97,115,32,99,111,118,101,114,97,103,101,10,32,32,32,32,32,32,45,32,100,114,97,119,32,99,97,112,115,32,105,110,100,117,99,101,100,32,102,114,111,109,32,100,97,115,104,105,110,103,46,10,32,32,32,32,32,70,111,114,32,116,104,101,32,108,97,116,116,101,114,44,32,119,101,32,111,110,108,121,32,99,97,114,101,32,97,98,111,117,116,32,116,104,111,115,101,10,32,32,32,32,32,98,111,117,110,100,97,114,121,32,112,111,105,110,116,115,32,111,102,32,116,104,101,32,100,97,115,104,32,112,97,116,116,101,114,110,32,116,104,97,116,10,32,32,32,32,32,97,114,101,32,119,105,116,104,105,110,32,116,104,101,32,101,100,103,101,46,32,87,101,32,105,110,105,116,105,97,108,105,122,101,32,114,32,97,115,10,32,32,32,32,32,115,116,114,111,107,101,95,119,105,100,116,104,32,98,101,99,97,117,115,101,44,32,105,102,32,116,104,101,32,110,101,97,114,101,115,116,32,98,111,117,110,100,97,114,121,10,32,32,32,32,32,105,115,32,111,102,102,32,116,104,101,32,101,100,103,101,44,32,116,104,101,110,32,108,101,116,116,105,110,103,32,114,32,98,101,32,115,116,114,111,107,101,95,119,105,100,116,104,10,32,32,32,32,32,109,97,114,107,115,32,97,115,32,116,104,101,32,98,111,117,110,100,97,114,121,32,97,115,32,115,111,32,102,97,114,32,97,119,97,121,32,116,111,32,110,111,116,32,104,101,108,112,10,32,32,32,32,32,100,114,97,119,32,97,32,99,97,112,32,119,104,101,110,32,119,101,32,97,114,101,32,105,110,32,97,32,115,107,105,112,32,105,110,116,101,114,118,97,108,46,32,73,102,10,32,32,32,32,32,119,101,32,97,114,101,32,105,110,32,97,32,100,114,97,119,32,105,110,116,101,114,118,97,108,32,111,102,32,116,104,101,32,100,97,115,104,32,112,97,116,116,101,114,110,44,10,32,32,32,32,32,116,104,101,110,32,115,105,110,99,101,32,116,104,101,32,98,111,117,110,100,97,114,121,32,105,115,32,115,111,32,102,97,114,32,97,119,97,121,44,32,119,101,32,109,97,107,101,10,32,32,32,32,32,116,104,101,32,100,105,115,116,97,110,99,101,32,34,108,97,114,103,101,34,32,116,111,32,98,101,32,115,111,108,105,100,108,121,32,110,111,110,45,111,112,97,113,117,101,46,10,32,32,32,42,47,10,32,32,114,32,61,32,115,116,114,111,107,101,95,119,105,100,116,104,59,10,32,32,100,48,32,61,32,100,105,115,116,97,110,99,101,32,45,32,98,111,117,110,100,97,114,121,48,59,10,32,32,100,49,32,61,32,98,111,117,110,100,97,114,121,49,32,45,32,100,105,115,116,97,110,99,101,59,10,10,32,32,114,32,61,32,40,100,48,32,60,61,32,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,41,32,63,10,32,32,32,32,109,105,110,40,100,48,44,32,114,41,32,58,10,32,32,32,32,114,59,10,10,32,32,114,101,116,117,114,110,32,40,100,49,32,60,61,32,100,105,115,116,97,110,99,101,95,116,111,95,101,100,103,101,95,101,110,100,41,32,63,10,32,32,32,32,109,105,110,40,114,44,32,100,49,41,32,58,10,32,32,32,32,114,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_compute_dash_stroke_helper.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
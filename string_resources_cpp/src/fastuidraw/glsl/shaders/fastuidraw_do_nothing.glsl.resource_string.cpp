@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,111,105,100,32,102,97,115,116,117,105,100,114,97,119,95,100,111,95,110,111,116,104,105,110,103,40,118,111,105,100,41,32,123,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_do_nothing.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,102,114,97,103,95,109,97,105,110,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,105,110,116,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,41,10,123,10,32,32,102,108,111,97,116,32,97,108,112,104,97,59,10,32,32,117,105,110,116,32,114,101,110,100,101,114,95,112,97,115,115,44,32,100,97,115,104,95,115,116,121,108,101,59,10,10,32,32,114,101,110,100,101,114,95,112,97,115,115,32,61,32,70,65,83,84,85,73,68,82,65,87,95,69,88,84,82,65,67,84,95,66,73,84,83,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,115,117,98,95,115,104,97,100,101,114,95,114,101,110,100,101,114,95,112,97,115,115,95,98,105,116,48,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,115,117,98,95,115,104,97,100,101,114,95,114,101,110,100,101,114,95,112,97,115,115,95,110,117,109,95,98,105,116,115,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,117,98,95,115,104,97,100,101,114,41,59,10,10,32,32,97,108,112,104,97,32,61,32,49,46,48,59,10,10,32,32,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,83,84,82,79,75,69,95,68,65,83,72,69,68,10,32,32,105,102,40,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,112,97,99,107,101,100,95,100,97,116,97,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,106,111,105,110,95,109,97,115,107,41,41,32,61,61,32,48,117,41,10,32,32,32,32,123,10,32,32,32,32,32,32,102,108,111,97,116,32,100,44,32,113,44,32,102,119,59,10,32,32,32,32,32,32,117,105,110,116,32,100,97,115,104,95,112,97,116,116,101,114,110,95,97,116,44,32,100,97,115,104,95,115,116,121,108,101,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,112,97,114,97,109,115,95,104,101,97,100,101,114,32,115,116,114,111,107,101,95,112,97,114,97,109,115,59,10,10,32,32,32,32,32,32,100,97,115,104,95,115,116,121,108,101,32,61,32,70,65,83,84,85,73,68,82,65,87,95,69,88,84,82,65,67,84,95,66,73,84,83,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,115,117,98,95,115,104,97,100,101,114,95,100,97,115,104,95,115,116,121,108,101,95,98,105,116,48,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,115,117,98,95,115,104,97,100,101,114,95,100,97,115,104,95,115,116,121,108,101,95,110,117,109,95,98,105,116,115,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,117,98,95,115,104,97,100,101,114,41,59,10,10,32,32,32,32,32,32,47,42,32,115,116,114,111,107,101,95,112,97,114,97,109,115,32,116,97,107,101,115,32,52,32,101,108,101,109,101,110,116,115,10,32,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,100,97,115,104,95,112,97,116,116,101,114,110,95,97,116,32,61,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,32,43,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,112,97,114,97,109,115,95,104,101,97,100,101,114,95,110,117,109,95,98,108,111,99,107,115,41,59,10,10,32,32,32,32,32,32,47,42,32,114,101,97,100,32,116,104,101,32,104,101,97,100,101,114,32,100,97,116,97,32,40,105,110,99,108,117,100,101,115,32,116,104,101,32,115,116,114,111,107,105,110,103,32,119,105,100,116,104,32,97,110,100,32,116,111,116,97,108,32,108,101,110,103,116,104,10,32,32,32,32,32,32,32,32,32,111,102,32,116,104,101,32,100,97,115,104,32,112,97,116,116,101,114,110,41,46,10,32,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,114,101,97,100,95,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,112,97,114,97,109,115,95,104,101,97,100,101,114,40,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,44,32,115,116,114,111,107,101,95,112,97,114,97,109,115,41,59,10,10,32,32,32,32,32,32,105,102,40,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,112,97,99,107,101,100,95,100,97,116,97,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,99,97,112,95,106,111,105,110,95,109,97,115,107,41,41,32,33,61,32,48,117,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,113,32,61,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,101,108,115,101,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,113,32,61,32,102,97,115,116,117,105,100,114,97,119,95,99,111,109,112,117,116,101,95,100,97,115,104,95,105,110,116,101,114,118,97,108,40,100,97,115,104,95,112,97,116,116,101,114,110,95,97,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,116,114,111,107,101,95,112,97,114,97,109,115,46,116,111,116,97,108,95,108,101,110,103,116,104,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,116,114,111,107,101,95,112,97,114,97,109,115,46,102,105,114,115,116,95,105,110,116,101,114,118,97,108,95,115,116,97,114,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,100,105,115,116,97,110,99,101,95,102,114,111,109,95,101,100,103,101,95,115,116,97,114,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,100,105,115,116,97,110,99,101,95,116,111,95,101,110,100,95,111,102,95,101,100,103,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,116,114,111,107,101,95,112,97,114,97,109,115,46,119,105,100,116,104,41,59,10,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,102,119,32,61,32,102,119,105,100,116,104,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,100,105,115,116,97,110,99,101,41,59,10,10,32,32,32,32,32,32,47,42,32,116,104,101,32,118,97,108,117,101,32,111,102,32,113,32,105,115,32,98,114,97,110,99,104,121,45,112,105,120,101,108,45,100,101,112,101,110,100,101,110,116,44,32,116,104,101,10,32,32,32,32,32,32,32,32,32,99,111,100,101,32,112,97,116,104,32,105,102,32,119,101,32,97,114,101,32,116,111,32,104,105,116,32,114,111,117,110,100,101,100,45,99,97,112,32,99,111,100,101,32,105,115,10,32,32,32,32,32,32,32,32,32,100,101,112,101,110,100,101,110,116,32,111,110,32,116,104,101,32,118,97,108,117,101,32,111,102,32,113,46,32,84,111,32,107,101,101,112,32,116,104,101,32,97,110,116,105,45,97,108,105,97,115,105,110,103,10,32,32,32,32,32,32,32,32,32,102,114,111,109,32,103,111,105,110,103,32,117,103,108,121,32,97,116,32,98,111,117,110,100,97,114,105,101,115,44,32,119,101,32,101,120,112,108,105,99,105,116,101,108,121,32,99,111,109,112,117,116,101,10,32,32,32,32,32,32,32,32,32,102,119,105,100,116,104,40,41,32,102,114,111,109,32,118,97,108,117,101,115,32,116,104,97,116,32,97,114,101,32,110,111,116,32,98,114,97,110,99,104,121,45,112,105,120,101,108,45,100,101,112,101,110,100,101,110,116,46,10,32,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,102,108,111,97,116,32,121,44,32,114,44,32,113,113,95,121,121,44,32,102,119,105,100,116,104,95,113,113,95,121,121,59,10,32,32,32,32,32,32,114,32,61,32,115,116,114,111,107,101,95,112,97,114,97,109,115,46,119,105,100,116,104,32,42,32,48,46,53,59,10,32,32,32,32,32,32,121,32,61,32,114,32,42,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,111,110,95,98,111,117,110,100,97,114,121,59,10,32,32,32,32,32,32,113,113,95,121,121,32,61,32,113,32,42,32,113,32,43,32,121,32,42,32,121,59,10,32,32,32,32,32,32,102,119,105,100,116,104,95,113,113,95,121,121,32,61,32,50,46,48,32,42,32,97,98,115,40,113,41,32,42,32,102,119,32,43,32,50,46,48,32,42,32,97,98,115,40,121,41,32,42,32,102,119,105,100,116,104,40,121,41,59,10,32,32,32,32,32,32,105,102,40,100,97,115,104,95,115,116,121,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,100,97,115,104,101,100,95,114,111,117,110,100,101,100,95,99,97,112,115,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,47,42,32,102,119,32,114,101,112,114,101,115,101,110,116,115,32,116,104,101,32,116,111,108,101,114,97,110,99,101,32,111,102,32,97,32,112,105,120,101,108,46,32,84,104,101,32,101,120,112,101,99,116,101,100,10,32,32,32,32,32,32,32,32,32,32,32,32,32,99,111,110,100,105,116,105,111,110,32,105,115,32,105,102,40,113,32,60,32,48,46,48,41,44,32,98,117,116,32,116,104,97,116,32,103,105,118,101,115,32,98,108,97,99,107,45,108,105,110,101,10,32,32,32,32,32,32,32,32,32,32,32,32,32,114,101,110,100,101,114,32,105,115,115,117,101,32,111,110,32,116,104,101,32,98,111,117,110,100,97,114,121,32,98,101,116,119,101,101,110,32,116,104,101,32,99,97,112,32,97,110,100,32,116,104,101,10,32,32,32,32,32,32,32,32,32,32,32,32,32,100,97,115,104,45,112,97,116,116,101,114,110,32,98,111,117,110,100,97,114,121,46,32,66,121,32,114,101,108,97,120,105,110,103,32,116,104,101,32,99,111,110,100,105,116,105,111,110,32,98,121,10,32,32,32,32,32,32,32,32,32,32,32,32,32,40,101,115,115,101,110,116,105,97,108,108,121,41,32,49,45,112,105,120,101,108,44,32,119,101,32,99,97,110,32,97,118,111,105,100,32,116,104,97,116,32,114,101,110,100,101,114,105,110,103,10,32,32,32,32,32,32,32,32,32,32,32,32,32,105,115,115,117,101,46,10,32,32,32,32,32,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,32,32,32,32,105,102,40,113,32,60,32,102,119,32,38,38,32,113,32,62,32,45,102,119,32,45,32,114,41,10,32,32,32,32,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,115,113,59,10,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,113,32,61,32,115,113,114,116,40,113,113,95,121,121,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,113,32,61,32,114,32,45,32,115,113,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,119,32,61,32,48,46,53,32,42,32,102,119,105,100,116,104,95,113,113,95,121,121,32,47,32,115,113,59,10,32,32,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,101,108,115,101,32,105,102,40,100,97,115,104,95,115,116,121,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,100,97,115,104,101,100,95,115,113,117,97,114,101,95,99,97,112,115,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,113,32,43,61,32,115,116,114,111,107,101,95,112,97,114,97,109,115,46,119,105,100,116,104,32,42,32,48,46,53,59,10,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,100,32,61,32,109,97,120,40,97,98,115,40,113,41,44,32,102,119,41,59,10,32,32,32,32,32,32,97,108,112,104,97,32,61,32,109,97,120,40,48,46,48,44,32,113,32,47,32,100,41,59,10,10,32,32,32,32,32,32,105,102,40,114,101,110,100,101,114,95,112,97,115,115,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,110,111,110,95,97,97,41,32,38,38,32,113,32,60,32,48,46,48,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,70,65,83,84,85,73,68,82,65,87,95,68,73,83,67,65,82,68,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,83,84,82,79,75,69,95,85,83,69,95,68,73,83,67,65,82,68,10,32,32,32,32,123,10,32,32,32,32,32,32,102,108,111,97,116,32,100,100,44,32,113,59,10,32,32,32,32,32,32,113,32,61,32,49,46,48,32,45,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,111,110,95,98,111,117,110,100,97,114,121,59,10,32,32,32,32,32,32,100,100,32,61,32,109,97,120,40,113,44,32,102,119,105,100,116,104,40,113,41,41,59,10,32,32,32,32,32,32,97,108,112,104,97,32,42,61,32,113,32,47,32,100,100,59,10,10,32,32,32,32,32,32,47,42,32,82,97,116,104,101,114,32,116,104,97,110,32,100,105,115,99,97,114,100,105,110,103,32,111,110,32,111,112,97,113,117,101,32,112,97,115,115,101,115,44,32,119,101,32,99,111,117,108,100,10,32,32,32,32,32,32,32,32,32,105,110,115,116,101,97,100,32,114,101,110,100,101,114,32,105,110,32,97,32,115,105,110,103,108,101,32,112,97,115,115,32,97,110,100,32,98,101,32,79,107,32,119,105,116,104,10,32,32,32,32,32,32,32,32,32,104,97,118,105,110,103,32,97,110,116,105,45,97,108,105,97,115,32,115,109,117,100,103,101,32,115,111,109,101,116,105,109,101,115,32,111,99,99,108,117,100,101,10,32,32,32,32,32,32,32,32,32,110,111,110,45,97,110,116,105,45,97,108,105,97,115,101,100,32,102,114,97,103,109,101,110,116,115,46,32,68,111,105,110,103,32,116,104,105,115,32,114,101,113,117,105,114,101,115,10,32,32,32,32,32,32,32,32,32,116,104,97,116,32,109,101,97,110,115,32,116,104,97,116,32,119,101,32,102,111,114,32,97,110,116,105,45,97,108,105,97,115,101,100,32,114,101,110,100,101,114,105,110,103,10,32,32,32,32,32,32,32,32,32,116,104,101,114,101,32,105,115,32,111,110,108,121,32,97,32,115,105,110,103,108,101,32,114,101,110,100,101,114,105,110,103,32,112,97,115,115,46,10,10,32,32,32,32,32,32,32,32,32,65,110,111,116,104,101,114,32,97,112,112,114,111,97,99,104,32,105,115,32,116,111,32,104,97,118,101,32,116,119,111,32,112,97,115,115,101,115,32,119,104,101,114,101,10,32,32,32,32,32,32,32,32,32,116,104,101,32,49,115,116,32,112,97,115,115,32,119,114,105,116,101,115,32,116,111,32,97,32,99,111,118,101,114,97,103,101,32,98,117,102,102,101,114,32,119,105,116,104,10,32,32,32,32,32,32,32,32,32,97,32,34,98,108,101,110,100,32,109,111,100,101,34,32,111,102,32,77,65,88,32,97,110,100,32,116,104,101,32,50,110,100,32,112,97,115,115,32,114,101,97,100,115,10,32,32,32,32,32,32,32,32,32,116,104,101,32,99,111,118,101,114,97,103,101,32,118,97,108,117,101,44,32,114,101,115,101,116,115,32,105,116,32,116,111,32,122,101,114,111,44,32,97,110,100,32,101,109,105,116,115,10,32,32,32,32,32,32,32,32,32,116,104,97,116,32,97,115,32,97,108,112,104,97,46,32,84,104,105,115,32,97,112,112,114,111,97,99,104,44,32,104,111,119,101,118,101,114,32,114,101,113,117,105,114,101,115,10,32,32,32,32,32,32,32,32,32,101,105,116,104,101,114,32,102,114,97,109,101,98,117,102,102,101,114,95,102,101,116,99,104,32,79,82,32,102,114,97,103,109,101,110,116,95,115,104,97,100,101,114,95,105,110,116,101,114,108,111,99,107,46,10,32,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,105,102,40,114,101,110,100,101,114,95,112,97,115,115,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,111,112,97,113,117,101,95,112,97,115,115,41,32,38,38,32,97,108,112,104,97,32,60,32,49,46,48,32,45,32,49,46,48,32,47,32,50,53,53,46,48,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,70,65,83,84,85,73,68,82,65,87,95,68,73,83,67,65,82,68,59,10,32,32,32,32,32,32,32,32,125,10,10,32,32,32,32,32,32,105,102,40,114,101,110,100,101,114,95,112,97,115,115,32,33,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,97,97,95,112,97,115,115,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,97,108,112,104,97,32,61,32,49,46,48,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,125,10,32,32,35,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,105,102,40,114,101,110,100,101,114,95,112,97,115,115,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,101,95,97,97,95,112,97,115,115,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,100,100,44,32,113,59,10,10,32,32,32,32,32,32,32,32,32,32,113,32,61,32,49,46,48,32,45,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,111,110,95,98,111,117,110,100,97,114,121,59,10,32,32,32,32,32,32,32,32,32,32,100,100,32,61,32,109,97,120,40,113,44,32,102,119,105,100,116,104,40,113,41,41,59,10,32,32,32,32,32,32,32,32,32,32,97,108,112,104,97,32,42,61,32,113,32,47,32,100,100,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,101,108,115,101,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,97,108,112,104,97,32,61,32,49,46,48,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,114,101,116,117,114,110,32,118,101,99,52,40,49,46,48,44,32,49,46,48,44,32,49,46,48,44,32,97,108,112,104,97,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_stroke.frag.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+